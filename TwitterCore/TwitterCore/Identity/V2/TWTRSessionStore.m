@@ -29,6 +29,81 @@
 
 static NSString *const TWTRSessionStoreGuestUserName = @"com.twitter.sdk.ios.core.guest-session-user";
 
+/**
+ *  Set on the concurrent session queue so blocks running on it can tell they must not wait on it.
+ */
+static void *const TWTRSessionStoreQueueKey = (void *)&TWTRSessionStoreQueueKey;
+
+/**
+ *  Immutable view of the sessions held by a store. A new snapshot is built for every
+ *  mutation and published in a single pointer swap so readers never need to take a lock.
+ */
+@interface TWTRSessionStoreSnapshot : NSObject
+
+@property (nonatomic, readonly, nullable) TWTRGuestSession *guestSession;
+
+/**
+ *  User sessions ordered from least to most recently saved.
+ */
+@property (nonatomic, copy, readonly) NSArray *userSessions;
+@property (nonatomic, copy, readonly) NSDictionary *userSessionsByID;
+
+- (instancetype)initWithGuestSession:(nullable TWTRGuestSession *)guestSession userSessions:(NSArray *)userSessions;
+- (instancetype)snapshotBySettingGuestSession:(nullable TWTRGuestSession *)guestSession;
+- (instancetype)snapshotByAddingUserSession:(id<TWTRAuthSession>)session;
+- (instancetype)snapshotByRemovingUserSessionWithID:(NSString *)sessionID;
+
+@end
+
+@implementation TWTRSessionStoreSnapshot
+
+- (instancetype)initWithGuestSession:(nullable TWTRGuestSession *)guestSession userSessions:(NSArray *)userSessions
+{
+    if (self = [super init]) {
+        NSMutableArray *orderedSessions = [NSMutableArray arrayWithCapacity:userSessions.count];
+        NSMutableDictionary *sessionsByID = [NSMutableDictionary dictionaryWithCapacity:userSessions.count];
+
+        // Later sessions for the same user win, matching the keychain's last-saved ordering.
+        for (id<TWTRAuthSession> session in userSessions) {
+            id<TWTRAuthSession> existingSession = sessionsByID[session.userID];
+            if (existingSession) {
+                [orderedSessions removeObjectIdenticalTo:existingSession];
+            }
+            [orderedSessions addObject:session];
+            sessionsByID[session.userID] = session;
+        }
+
+        _guestSession = guestSession;
+        _userSessions = [orderedSessions copy];
+        _userSessionsByID = [sessionsByID copy];
+    }
+    return self;
+}
+
+- (instancetype)snapshotBySettingGuestSession:(nullable TWTRGuestSession *)guestSession
+{
+    return [[[self class] alloc] initWithGuestSession:guestSession userSessions:self.userSessions];
+}
+
+- (instancetype)snapshotByAddingUserSession:(id<TWTRAuthSession>)session
+{
+    return [[[self class] alloc] initWithGuestSession:self.guestSession userSessions:[self.userSessions arrayByAddingObject:session]];
+}
+
+- (instancetype)snapshotByRemovingUserSessionWithID:(NSString *)sessionID
+{
+    id<TWTRAuthSession> existingSession = self.userSessionsByID[sessionID];
+    if (!existingSession) {
+        return self;
+    }
+
+    NSMutableArray *userSessions = [self.userSessions mutableCopy];
+    [userSessions removeObjectIdenticalTo:existingSession];
+    return [[[self class] alloc] initWithGuestSession:self.guestSession userSessions:userSessions];
+}
+
+@end
+
 @interface TWTRSessionStore ()
 
 /**
@@ -37,9 +112,16 @@ static NSString *const TWTRSessionStoreGuestUserName = @"com.twitter.sdk.ios.cor
 @property (nonatomic, readonly) NSURLSession *URLSession;
 
 /**
- *  In-memory cache of authenticated user sessions.
+ *  Most recently published snapshot of the guest and user sessions. Reads are a single
+ *  atomic load; writers build a replacement under `snapshotWriteLock` and swap it in.
+ *  Nil until the keychain has been loaded for the first time.
+ */
+@property (atomic, nullable) TWTRSessionStoreSnapshot *snapshot;
+
+/**
+ *  Serializes snapshot writers so concurrent mutations are not lost.
  */
-@property (nonatomic) NSMutableArray *authSessionCache;
+@property (nonatomic, readonly) NSObject *snapshotWriteLock;
 
 /**
  *  List of registered refresh strategies to fetch new sessions with.
@@ -60,7 +142,6 @@ static NSString *const TWTRSessionStoreGuestUserName = @"com.twitter.sdk.ios.cor
 
 @implementation TWTRSessionStore
 @synthesize authConfig = _authConfig;
-@synthesize guestSession = _guestSession;
 
 #pragma mark - Initialization
 
@@ -78,7 +159,7 @@ static NSString *const TWTRSessionStoreGuestUserName = @"com.twitter.sdk.ios.cor
         _authConfig = authConfig;
         _accessGroup = [accessGroup copy];
 
-        _authSessionCache = [NSMutableArray array];
+        _snapshotWriteLock = [[NSObject alloc] init];
 
         _refreshStrategies = [refreshStrategies copy];
         _URLSession = URLSession;
@@ -91,7 +172,10 @@ static NSString *const TWTRSessionStoreGuestUserName = @"com.twitter.sdk.ios.cor
 
 - (void)reloadSessionStore
 {
-    [self primeWriteThroughCaches];
+    // Callers expect to observe the reloaded sessions as soon as this returns.
+    dispatch_barrier_sync([[self class] concurrentSessionQueue], ^{
+        [self unsafePrimeCaches];
+    });
 }
 
 #pragma mark - TWTRSessionStore Methods
@@ -142,22 +226,12 @@ static NSString *const TWTRSessionStoreGuestUserName = @"com.twitter.sdk.ios.cor
 - (id<TWTRAuthSession>)sessionForUserID:(NSString *)userID
 {
     TWTRParameterAssertOrReturnValue(userID, nil);
-    NSArray *existingSessions = [self existingUserSessions];
-    NSUInteger indexOfMatchingSession = [existingSessions indexOfObjectPassingTest:^BOOL(id<TWTRAuthSession> session, NSUInteger idx, BOOL *stop) {
-        if ([session.userID isEqualToString:userID]) {
-            *stop = YES;
-            return YES;
-        }
-        return NO;
-    }];
-
-    return indexOfMatchingSession != NSNotFound ? existingSessions[indexOfMatchingSession] : nil;
+    return [self currentSnapshot].userSessionsByID[userID];
 }
 
 - (NSArray *)existingUserSessions
 {
-    NSArray *sessions = [self allUserSessions];
-    return sessions;
+    return [self allUserSessions];
 }
 
 - (BOOL)hasLoggedInUsers
@@ -293,12 +367,14 @@ static NSString *const TWTRSessionStoreGuestUserName = @"com.twitter.sdk.ios.cor
 
 + (dispatch_queue_t)concurrentSessionQueue
 {
-    /// We need a queue which all classes can use since multiple instances of one store can manage the same sessions
+    /// We need a queue which all classes can use since multiple instances of one store can manage the same sessions.
+    /// Keychain reads and writes run as barriers on this queue; in-memory reads go through the published snapshot.
     static dispatch_queue_t queue = nil;
     static dispatch_once_t onceToken;
 
     dispatch_once(&onceToken, ^{
         queue = dispatch_queue_create("com.twitter.sdk.ios.core.session-store", DISPATCH_QUEUE_CONCURRENT);
+        dispatch_queue_set_specific(queue, TWTRSessionStoreQueueKey, TWTRSessionStoreQueueKey, NULL);
     });
 
     return queue;
@@ -321,33 +397,60 @@ static NSString *const TWTRSessionStoreGuestUserName = @"com.twitter.sdk.ios.cor
     return [NSString stringWithFormat:@"%@.%@", self.APIServiceConfig.serviceName, name];
 }
 
-#pragma mark - Guest Keychain Access Control (These methods are thread-safe, reads are synchronous and writes are async)
+#pragma mark - Snapshot Access (Reads are lock-free, writes publish immediately and persist asynchronously)
 
-- (TWTRGuestSession *)guestSession
+- (TWTRSessionStoreSnapshot *)currentSnapshot
 {
-    TWTRGuestSession *__block session = nil;
+    TWTRSessionStoreSnapshot *snapshot = self.snapshot;
 
-    dispatch_sync([[self class] concurrentSessionQueue], ^{
-        session = self->_guestSession;
-    });
-    return session;
+    if (!snapshot && dispatch_get_specific(TWTRSessionStoreQueueKey)) {
+        // Waiting on the queue from one of its barriers would deadlock, so load the keychain here instead.
+        [self unsafePrimeCaches];
+        snapshot = self.snapshot;
+    } else if (!snapshot) {
+        // The initial keychain load is still in flight, wait for it to publish.
+        dispatch_sync([[self class] concurrentSessionQueue], ^{});
+        snapshot = self.snapshot;
+    }
+
+    return snapshot ?: [[TWTRSessionStoreSnapshot alloc] initWithGuestSession:nil userSessions:@[]];
+}
+
+- (void)updateSnapshot:(TWTRSessionStoreSnapshot * (^)(TWTRSessionStoreSnapshot *snapshot))transform
+{
+    TWTRSessionStoreSnapshot *currentSnapshot = [self currentSnapshot];
+
+    @synchronized(self.snapshotWriteLock)
+    {
+        self.snapshot = transform(self.snapshot ?: currentSnapshot);
+    }
+}
+
+#pragma mark - Guest Keychain Access Control (These methods are thread-safe, reads are lock-free and writes are async)
+
+- (TWTRGuestSession *)guestSession
+{
+    return [self currentSnapshot].guestSession;
 }
 
 - (void)setGuestSession:(nullable TWTRGuestSession *)guestSession
 {
+    [self updateSnapshot:^TWTRSessionStoreSnapshot *(TWTRSessionStoreSnapshot *snapshot) {
+        return [snapshot snapshotBySettingGuestSession:guestSession];
+    }];
+
     dispatch_barrier_async([[self class] concurrentSessionQueue], ^{
-        [self unsafeSetGuestSession:guestSession];
+        [self unsafeWriteGuestSession:guestSession];
     });
 }
 
-- (void)unsafeSetGuestSession:(nullable TWTRGuestSession *)guestSession
+- (void)unsafeWriteGuestSession:(nullable TWTRGuestSession *)guestSession
 {
     if (guestSession) {
         [self unsafePersistGuestSession:guestSession];
     } else {
         [self unsafeDeleteGuestSession];
     }
-    self->_guestSession = guestSession;
 }
 
 - (TWTRGenericKeychainQuery *)guestSessionQuery
@@ -355,26 +458,23 @@ static NSString *const TWTRSessionStoreGuestUserName = @"com.twitter.sdk.ios.cor
     return [TWTRGenericKeychainQuery queryForService:[self guestSessionServiceName] account:TWTRSessionStoreGuestUserName];
 }
 
-#pragma mark - User Keychain Access (These methods are thread-safe, reads are synchronous and writes are async)
+#pragma mark - User Keychain Access (These methods are thread-safe, reads are lock-free and writes are async)
 
 - (nullable id<TWTRAuthSession>)sessionWithSessionID:(NSString *)sessionID
 {
     TWTRParameterAssertOrReturnValue(sessionID, nil);
-
-    __block id<TWTRAuthSession> session = nil;
-    dispatch_sync([[self class] concurrentSessionQueue], ^{
-        session = [self unsafeCachedSessionWithSessionID:sessionID];
-    });
-
-    return session;
+    return [self currentSnapshot].userSessionsByID[sessionID];
 }
 
 - (void)removeSessionWithSessionID:(NSString *)sessionID
 {
     TWTRParameterAssertOrReturn(sessionID);
 
+    [self updateSnapshot:^TWTRSessionStoreSnapshot *(TWTRSessionStoreSnapshot *snapshot) {
+        return [snapshot snapshotByRemovingUserSessionWithID:sessionID];
+    }];
+
     dispatch_barrier_async([[self class] concurrentSessionQueue], ^{
-        [self unsafePurgeCachedSessionWithSessionID:sessionID];
         [self unsafeDeleteUserSessionWithSessionID:sessionID];
     });
 }
@@ -387,21 +487,18 @@ static NSString *const TWTRSessionStoreGuestUserName = @"com.twitter.sdk.ios.cor
         self.userSessionSavedCompletion(session);
     }
 
+    [self updateSnapshot:^TWTRSessionStoreSnapshot *(TWTRSessionStoreSnapshot *snapshot) {
+        return [snapshot snapshotByAddingUserSession:session];
+    }];
+
     dispatch_barrier_async([[self class] concurrentSessionQueue], ^{
-        [self unsafeCacheSession:session];
         [self unsafePersistAuthSession:session];
     });
 }
 
 - (NSArray *)allUserSessions
 {
-    NSArray *__block sessions = [NSMutableArray array];
-
-    dispatch_sync([[self class] concurrentSessionQueue], ^{
-        sessions = [self unsafeAllCachedUserSessions];
-    });
-
-    return sessions;
+    return [self currentSnapshot].userSessions;
 }
 
 /**
@@ -432,76 +529,32 @@ static NSString *const TWTRSessionStoreGuestUserName = @"com.twitter.sdk.ios.cor
 - (void)primeWriteThroughCaches
 {
     dispatch_barrier_async([[self class] concurrentSessionQueue], ^{
-        [self unsafePrimeGuestSessionCache];
-        [self unsafePrimeUserSessionCache];
+        // A read from an earlier barrier may have loaded the keychain already, and sessions saved since then are not persisted yet
+        if (!self.snapshot) {
+            [self unsafePrimeCaches];
+        }
     });
 }
 
-- (void)unsafePrimeGuestSessionCache
+- (void)unsafePrimeCaches
 {
-    TWTRGuestSession *session = [self unsafeLoadGuestSession];
+    TWTRGuestSession *guestSession = [self unsafeLoadGuestSession];
 
     // Check if we should keep using this token.
-    if (!session.probablyNeedsRefreshing) {
-        [self unsafeSetGuestSession:session];
-    } else {
-        [self unsafeSetGuestSession:nil];
-    }
-}
-
-- (void)unsafePrimeUserSessionCache
-{
-    NSArray *sessions = [self unsafeLoadAllUserSessions];
-    [self.authSessionCache removeAllObjects];
-
-    for (id<TWTRAuthSession> session in sessions) {
-        [self unsafeCacheSession:session];
-    }
-}
-
-#pragma mark - Session Cache (These methods are not thread-safe)
-
-- (void)unsafeCacheSession:(id<TWTRAuthSession>)session
-{
-    TWTRParameterAssertOrReturn(session);
-    [self.authSessionCache removeObject:session];
-    [self.authSessionCache addObject:session];
-}
-
-- (NSArray *)unsafeAllCachedUserSessions
-{
-    return self.authSessionCache;
-}
-
-- (nullable id<TWTRAuthSession>)unsafeCachedSessionWithSessionID:(NSString *)sessionID
-{
-    TWTRParameterAssertOrReturnValue(sessionID, nil);
-    NSInteger index = [self indexOfCachedSessionWithSessionID:sessionID];
-
-    if (index != NSNotFound) {
-        return self.authSessionCache[index];
+    if (guestSession.probablyNeedsRefreshing) {
+        [self unsafeDeleteGuestSession];
+        guestSession = nil;
     }
-    return nil;
-}
 
-- (void)unsafePurgeCachedSessionWithSessionID:(NSString *)sessionID
-{
-    TWTRParameterAssertOrReturn(sessionID);
-    NSInteger index = [self indexOfCachedSessionWithSessionID:sessionID];
+    NSArray *userSessions = [self unsafeLoadAllUserSessions];
+    TWTRSessionStoreSnapshot *snapshot = [[TWTRSessionStoreSnapshot alloc] initWithGuestSession:guestSession userSessions:userSessions];
 
-    if (index != NSNotFound) {
-        [self.authSessionCache removeObjectAtIndex:index];
+    @synchronized(self.snapshotWriteLock)
+    {
+        self.snapshot = snapshot;
     }
 }
 
-- (NSInteger)indexOfCachedSessionWithSessionID:(NSString *)sessionID
-{
-    TWTRParameterAssertOrReturnValue(sessionID, NSNotFound);
-    return [self.authSessionCache indexOfObjectPassingTest:^BOOL(id<TWTRAuthSession> obj, NSUInteger idx, BOOL *stop) {
-        return [obj.userID isEqualToString:sessionID];
-    }];
-}
-
 #pragma mark - Session Keychain Persistence (These methods are not thread-safe)
 
 - (void)unsafePersistAuthSession:(id<TWTRAuthSession>)session
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ This header is private to the Twitter Core SDK and not exposed for public SDK consumption
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Keeps a running estimate of the download throughput the device is currently
+ * getting, smoothed with an exponentially weighted moving average so a single
+ * slow or fast transfer does not swing it too far.
+ *
+ * Transfers that are too small to say anything about bandwidth (where latency
+ * dominates) are ignored. All methods are safe to call from any thread.
+ *
+ * Conforms to `NSURLSessionTaskDelegate` so it can be used directly as the
+ * delegate of a session that has no other delegate needs.
+ */
+@interface TWTRNetworkThroughputEstimator : NSObject <NSURLSessionTaskDelegate>
+
+/**
+ * The estimate in bits per second, or 0 if nothing has been recorded yet.
+ */
+@property (nonatomic, readonly) double estimatedBitsPerSecond;
+
+/**
+ * The estimator fed by the Twitter Kit API and media sessions.
+ */
++ (instancetype)sharedEstimator;
+
+/**
+ * Records a completed transfer of `byteCount` bytes whose payload took
+ * `duration` seconds to arrive.
+ */
+- (void)recordTransferOfByteCount:(int64_t)byteCount duration:(NSTimeInterval)duration;
+
+/**
+ * Records a throughput that was measured elsewhere, e.g. the observed bitrate
+ * reported in an `AVPlayerItem` access log.
+ */
+- (void)recordThroughputSample:(double)bitsPerSecond;
+
+/**
+ * Records the response phase of the last transaction in `metrics`.
+ */
+- (void)recordTaskMetrics:(NSURLSessionTaskMetrics *)metrics forTask:(NSURLSessionTask *)task API_AVAILABLE(ios(10.0), tvos(10.0));
+
+/**
+ * Forgets every recorded sample.
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
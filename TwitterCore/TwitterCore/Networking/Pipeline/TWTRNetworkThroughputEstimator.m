@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRNetworkThroughputEstimator.h"
+#import <TwitterCore/TWTRAssertionMacros.h>
+
+/**
+ * Transfers smaller than this are dominated by connection latency.
+ */
+static const int64_t TWTRThroughputMinimumSampleByteCount = 16 * 1024;
+
+/**
+ * The weight given to each new sample.
+ */
+static const double TWTRThroughputSmoothingFactor = 0.3;
+
+@interface TWTRNetworkThroughputEstimator ()
+
+@property (nonatomic) double smoothedBitsPerSecond;
+
+@end
+
+@implementation TWTRNetworkThroughputEstimator
+
++ (instancetype)sharedEstimator
+{
+    static TWTRNetworkThroughputEstimator *sharedEstimator;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedEstimator = [[self alloc] init];
+    });
+    return sharedEstimator;
+}
+
+- (double)estimatedBitsPerSecond
+{
+    @synchronized(self)
+    {
+        return self.smoothedBitsPerSecond;
+    }
+}
+
+- (void)recordTransferOfByteCount:(int64_t)byteCount duration:(NSTimeInterval)duration
+{
+    if (byteCount < TWTRThroughputMinimumSampleByteCount || duration <= 0) {
+        return;
+    }
+
+    [self recordThroughputSample:(byteCount * 8.0) / duration];
+}
+
+- (void)recordThroughputSample:(double)bitsPerSecond
+{
+    TWTRParameterAssertOrReturn(bitsPerSecond > 0 && isfinite(bitsPerSecond));
+
+    @synchronized(self)
+    {
+        if (self.smoothedBitsPerSecond == 0) {
+            self.smoothedBitsPerSecond = bitsPerSecond;
+        } else {
+            self.smoothedBitsPerSecond += TWTRThroughputSmoothingFactor * (bitsPerSecond - self.smoothedBitsPerSecond);
+        }
+    }
+}
+
+- (void)recordTaskMetrics:(NSURLSessionTaskMetrics *)metrics forTask:(NSURLSessionTask *)task
+{
+    NSURLSessionTaskTransactionMetrics *transaction = metrics.transactionMetrics.lastObject;
+    if (transaction.resourceFetchType != NSURLSessionTaskMetricsResourceFetchTypeNetworkLoad || !transaction.responseStartDate || !transaction.responseEndDate) {
+        return;
+    }
+
+    NSTimeInterval duration = [transaction.responseEndDate timeIntervalSinceDate:transaction.responseStartDate];
+    [self recordTransferOfByteCount:task.countOfBytesReceived duration:duration];
+}
+
+- (void)reset
+{
+    @synchronized(self)
+    {
+        self.smoothedBitsPerSecond = 0;
+    }
+}
+
+#pragma mark - NSURLSessionTaskDelegate
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics API_AVAILABLE(ios(10.0), tvos(10.0))
+{
+    [self recordTaskMetrics:metrics forTask:task];
+}
+
+@end
@@ -27,6 +27,25 @@ NS_ASSUME_NONNULL_BEGIN
 
 typedef void (^TWTRNetworkingPipelineCallback)(NSData *_Nullable data, NSURLResponse *_Nullable response, NSError *_Nullable error);
 
+typedef NS_ENUM(NSInteger, TWTRNetworkingPipelinePriority) {
+    /**
+     * Work the user is not waiting on, e.g. prefetches. These requests are
+     * delayed or shed when the rate limit budget for their endpoint runs low.
+     */
+    TWTRNetworkingPipelinePriorityBackground = -1,
+
+    /**
+     * The priority used when none is specified.
+     */
+    TWTRNetworkingPipelinePriorityDefault = 0,
+
+    /**
+     * Requests the user is actively waiting on. These jump ahead of
+     * default and background requests waiting to be sent.
+     */
+    TWTRNetworkingPipelinePriorityInteractive = 1
+};
+
 @interface TWTRNetworkingPipeline : NSObject
 
 /**
@@ -68,6 +87,32 @@ typedef void (^TWTRNetworkingPipelineCallback)(NSData *_Nullable data, NSURLResp
  */
 - (NSProgress *)enqueueRequest:(NSURLRequest *)request sessionStore:(id<TWTRSessionStore>)sessionStore requestingUser:(nullable NSString *)userID completion:(nullable TWTRNetworkingPipelineCallback)completion;
 
+/**
+ *  Enqueues a request in the pipeline with the given priority.
+ *
+ *  @param request      The HTTP request to send.
+ *  @param sessionStore The session store that will provide the session.
+ *  @param userID       The user to sign the request for or nil if using the guest session.
+ *  @param priority     The priority of the request relative to other requests in the same queue.
+ *  @param completion   The completion block to invoke on completion.
+ */
+- (NSProgress *)enqueueRequest:(NSURLRequest *)request sessionStore:(id<TWTRSessionStore>)sessionStore requestingUser:(nullable NSString *)userID priority:(TWTRNetworkingPipelinePriority)priority completion:(nullable TWTRNetworkingPipelineCallback)completion;
+
+/**
+ *  Holds newly enqueued requests until a matching call to `-resume`. Calls nest, so requests are
+ *  only released once every `-suspend` has been balanced. Held requests can still be cancelled
+ *  through the progress object returned when they were enqueued.
+ *
+ *  This is used to keep requests from being signed while startup work that can change the stored
+ *  sessions is still running.
+ */
+- (void)suspend;
+
+/**
+ *  Balances a call to `-suspend`, enqueueing any held requests in the order they were received.
+ */
+- (void)resume;
+
 @end
 
 @protocol TWTRNetworkingResponseValidating <NSObject>
@@ -39,6 +39,14 @@ static NSString *const TWTRNetworkingPipelineGuestKey = @"TWTRNetworkingPipeline
  */
 @property (nonatomic, readonly) NSURLSession *URLSession;
 
+/**
+ * Packages enqueued while the pipeline is suspended along with the progress objects that were
+ * handed out for them. Both arrays are guarded by synchronizing on `heldPackages`.
+ */
+@property (nonatomic, readonly) NSMutableArray<TWTRNetworkingPipelinePackage *> *heldPackages;
+@property (nonatomic, readonly) NSMutableArray<NSProgress *> *heldProgresses;
+@property (nonatomic) NSUInteger suspensionCount;
+
 @end
 
 @implementation TWTRNetworkingPipeline
@@ -53,6 +61,8 @@ static NSString *const TWTRNetworkingPipelineGuestKey = @"TWTRNetworkingPipeline
         _userQueueLookupTable = [NSMutableDictionary dictionary];
         _URLSession = URLSession;
         _responseValidator = responseValidator;
+        _heldPackages = [NSMutableArray array];
+        _heldProgresses = [NSMutableArray array];
     }
     return self;
 }
@@ -68,6 +78,11 @@ static NSString *const TWTRNetworkingPipelineGuestKey = @"TWTRNetworkingPipeline
 }
 
 - (NSProgress *)enqueueRequest:(NSURLRequest *)request sessionStore:(id<TWTRSessionStore>)sessionStore requestingUser:(NSString *)userID completion:(TWTRNetworkingPipelineCallback)completion
+{
+    return [self enqueueRequest:request sessionStore:sessionStore requestingUser:userID priority:TWTRNetworkingPipelinePriorityDefault completion:completion];
+}
+
+- (NSProgress *)enqueueRequest:(NSURLRequest *)request sessionStore:(id<TWTRSessionStore>)sessionStore requestingUser:(NSString *)userID priority:(TWTRNetworkingPipelinePriority)priority completion:(TWTRNetworkingPipelineCallback)completion
 {
     TWTRParameterAssertOrReturnValue(request, nil);
     TWTRParameterAssertOrReturnValue(sessionStore, nil);
@@ -77,12 +92,90 @@ static NSString *const TWTRNetworkingPipelineGuestKey = @"TWTRNetworkingPipeline
         }
     }
 
-    TWTRNetworkingPipelinePackage *package = [TWTRNetworkingPipelinePackage packageWithRequest:request sessionStore:sessionStore userID:userID completion:completion];
+    TWTRNetworkingPipelinePackage *package = [TWTRNetworkingPipelinePackage packageWithRequest:request sessionStore:sessionStore userID:userID priority:priority completion:completion];
 
-    if (userID && [userID longLongValue]) {
-        return [self enqueueUserPackage:package];
-    } else {
-        return [self enqueueGuestPackage:package];
+    @synchronized(self.heldPackages)
+    {
+        if (self.suspensionCount > 0) {
+            return [self holdPackage:package];
+        }
+    }
+
+    return [self enqueuePackage:package];
+}
+
+#pragma mark - Suspension
+
+- (void)suspend
+{
+    @synchronized(self.heldPackages)
+    {
+        self.suspensionCount++;
+    }
+}
+
+- (void)resume
+{
+    NSArray<TWTRNetworkingPipelinePackage *> *packages;
+    NSArray<NSProgress *> *progresses;
+
+    @synchronized(self.heldPackages)
+    {
+        TWTRParameterAssertOrReturn(self.suspensionCount > 0);
+
+        self.suspensionCount--;
+        if (self.suspensionCount > 0) {
+            return;
+        }
+
+        packages = [self.heldPackages copy];
+        progresses = [self.heldProgresses copy];
+        [self.heldPackages removeAllObjects];
+        [self.heldProgresses removeAllObjects];
+    }
+
+    [packages enumerateObjectsUsingBlock:^(TWTRNetworkingPipelinePackage *package, NSUInteger idx, BOOL *stop) {
+        NSProgress *queueProgress = [self enqueuePackage:package];
+        progresses[idx].cancellationHandler = ^{
+            [queueProgress cancel];
+        };
+    }];
+}
+
+/**
+ * Must be called while synchronized on `heldPackages`.
+ */
+- (NSProgress *)holdPackage:(TWTRNetworkingPipelinePackage *)package
+{
+    NSProgress *progress = [[NSProgress alloc] initWithParent:nil userInfo:nil];
+
+    @weakify(self) progress.cancellationHandler = ^{
+        @strongify(self);
+        [self cancelHeldPackage:package];
+    };
+
+    [self.heldPackages addObject:package];
+    [self.heldProgresses addObject:progress];
+    return progress;
+}
+
+- (void)cancelHeldPackage:(TWTRNetworkingPipelinePackage *)package
+{
+    BOOL wasHeld = NO;
+
+    @synchronized(self.heldPackages)
+    {
+        NSUInteger index = [self.heldPackages indexOfObjectIdenticalTo:package];
+        if (index != NSNotFound) {
+            [self.heldPackages removeObjectAtIndex:index];
+            [self.heldProgresses removeObjectAtIndex:index];
+            wasHeld = YES;
+        }
+    }
+
+    if (wasHeld && package.callback) {
+        NSDictionary *userInfo = @{NSURLErrorFailingURLErrorKey: package.request.URL, NSURLErrorFailingURLStringErrorKey: package.request.URL.absoluteString};
+        package.callback(nil, nil, [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:userInfo]);
     }
 }
 
@@ -108,6 +201,15 @@ static NSString *const TWTRNetworkingPipelineGuestKey = @"TWTRNetworkingPipeline
 }
 
 #pragma mark - Private Methods
+- (NSProgress *)enqueuePackage:(TWTRNetworkingPipelinePackage *)package
+{
+    if (package.userID && [package.userID longLongValue]) {
+        return [self enqueueUserPackage:package];
+    } else {
+        return [self enqueueGuestPackage:package];
+    }
+}
+
 - (NSProgress *)enqueueGuestPackage:(TWTRNetworkingPipelinePackage *)package
 {
     return [self.guestQueue enqueuePipelinePackage:package];
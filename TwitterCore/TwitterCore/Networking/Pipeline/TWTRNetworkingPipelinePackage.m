@@ -25,6 +25,11 @@
 @implementation TWTRNetworkingPipelinePackage
 
 - (instancetype)initWithRequest:(NSURLRequest *)request sessionStore:(id<TWTRSessionStore>)sessionStore userID:(NSString *)userID completion:(TWTRNetworkingPipelineCallback)callback
+{
+    return [self initWithRequest:request sessionStore:sessionStore userID:userID priority:TWTRNetworkingPipelinePriorityDefault completion:callback];
+}
+
+- (instancetype)initWithRequest:(NSURLRequest *)request sessionStore:(id<TWTRSessionStore>)sessionStore userID:(NSString *)userID priority:(TWTRNetworkingPipelinePriority)priority completion:(TWTRNetworkingPipelineCallback)callback
 {
     TWTRParameterAssertOrReturnValue(request, nil);
     TWTRParameterAssertOrReturnValue(sessionStore, nil);
@@ -37,6 +42,7 @@
         _callback = [callback copy];
         _attemptCounter = 1;  // starts with 1
         _UUID = [NSUUID UUID];
+        _priority = priority;
     }
     return self;
 }
@@ -51,12 +57,17 @@
 
 + (instancetype)packageWithRequest:(NSURLRequest *)request sessionStore:(id<TWTRSessionStore>)sessionStore userID:(NSString *)userID completion:(TWTRNetworkingPipelineCallback)callback
 {
-    return [[self alloc] initWithRequest:request sessionStore:sessionStore userID:userID completion:callback];
+    return [self packageWithRequest:request sessionStore:sessionStore userID:userID priority:TWTRNetworkingPipelinePriorityDefault completion:callback];
+}
+
++ (instancetype)packageWithRequest:(NSURLRequest *)request sessionStore:(id<TWTRSessionStore>)sessionStore userID:(NSString *)userID priority:(TWTRNetworkingPipelinePriority)priority completion:(TWTRNetworkingPipelineCallback)callback
+{
+    return [[self alloc] initWithRequest:request sessionStore:sessionStore userID:userID priority:priority completion:callback];
 }
 
 - (id)copyWithZone:(NSZone *)zone
 {
-    TWTRNetworkingPipelinePackage *copy = [[TWTRNetworkingPipelinePackage alloc] initWithRequest:_request sessionStore:_sessionStore userID:_userID completion:_callback];
+    TWTRNetworkingPipelinePackage *copy = [[TWTRNetworkingPipelinePackage alloc] initWithRequest:_request sessionStore:_sessionStore userID:_userID priority:_priority completion:_callback];
     copy->_UUID = self.UUID;
     return copy;
 }
@@ -23,6 +23,7 @@
 #import <TwitterCore/TWTRNetworkingPipeline.h>
 
 @class TWTRNetworkingPipelinePackage;
+@class TWTRRateLimitTracker;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -50,6 +51,11 @@ typedef NS_ENUM(NSInteger, TWTRNetworkingPipelineQueueType) {
  */
 @property (nonatomic, readonly, nullable) id<TWTRNetworkingResponseValidating> responseValidator;
 
+/**
+ * Tracks the rate limit budgets reported for requests sent through this queue.
+ */
+@property (nonatomic, readonly) TWTRRateLimitTracker *rateLimitTracker;
+
 /**
  * Initializes the queue witht the given type.
  *
@@ -70,7 +76,9 @@ typedef NS_ENUM(NSInteger, TWTRNetworkingPipelineQueueType) {
 + (instancetype)userPipelineQueueWithURLSession:(NSURLSession *)session responseValidator:(nullable id<TWTRNetworkingResponseValidating>)responseValidator;
 
 /**
- * Enqueues a package for processing.
+ * Enqueues a package for processing. Packages may be held back or failed with
+ * `TWTRAPIErrorCodeRateLimitExceeded` depending on their priority and the
+ * remaining rate limit budget for their endpoint.
  * @return an NSProgress object which can be used to cancel the request.
  */
 - (NSProgress *)enqueuePipelinePackage:(TWTRNetworkingPipelinePackage *)package;
@@ -20,6 +20,7 @@
 #import <TwitterCore/TWTRConstants.h>
 #import "TWTRAPIDateSync.h"
 #import "TWTRNetworkingPipelinePackage.h"
+#import "TWTRRateLimitTracker.h"
 #import "TWTRRequestSigningOperation.h"
 
 // the cap on the number of TWTRNetworkingPipelineQueue level attempts (including retries) of a failed networking request.
@@ -104,6 +105,8 @@
         _responseValidator = responseValidator;
         _invokedPackages = [NSHashTable weakObjectsHashTable];
 
+        _rateLimitTracker = [[TWTRRateLimitTracker alloc] init];
+
         _inFlightTasks = [NSMapTable strongToWeakObjectsMapTable];
         _pendingCancellations = [NSMutableSet set];
         _cancellationSupportQueue = dispatch_queue_create("com.twitterkit.network-pipeline-queue.cancellation-support-queue", DISPATCH_QUEUE_SERIAL);
@@ -133,12 +136,64 @@
         [self markPackageAsCancelled:package];
     };
 
+    NSTimeInterval delay = 0;
+    TWTRRateLimitDecision decision = [self.rateLimitTracker decisionForRequest:package.request priority:package.priority delay:&delay];
+
+    if (decision == TWTRRateLimitDecisionShed) {
+        dispatch_async(self.serialAccessQueue, ^{
+            NSError *error = [TWTRRateLimitTracker rateLimitExceededErrorForRequest:package.request];
+            [self invokeCallbackForPackage:package withData:nil response:nil error:error];
+        });
+    } else {
+        [self addSigningOperationForPackage:package afterDelay:delay];
+    }
+
+    return progress;
+}
+
+/**
+ * Adds the signing operation for the package to the operation queue, optionally after
+ * a delay. The delay is applied before signing so that the OAuth timestamp is fresh
+ * when the request goes out.
+ */
+- (void)addSigningOperationForPackage:(TWTRNetworkingPipelinePackage *)package afterDelay:(NSTimeInterval)delay
+{
     [self fetchSessionIfNeededForPackage:package];
 
     TWTRRequestSigningOperation *operation = [self requestSigningOperationWithPackage:package];
-    [self.operationQueue addOperation:operation];
+    operation.queuePriority = [[self class] operationQueuePriorityForPriority:package.priority];
 
-    return progress;
+    if (delay > 0) {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.serialAccessQueue, ^{
+            [self.operationQueue addOperation:operation];
+        });
+    } else {
+        [self.operationQueue addOperation:operation];
+    }
+}
+
++ (NSOperationQueuePriority)operationQueuePriorityForPriority:(TWTRNetworkingPipelinePriority)priority
+{
+    switch (priority) {
+        case TWTRNetworkingPipelinePriorityBackground:
+            return NSOperationQueuePriorityLow;
+        case TWTRNetworkingPipelinePriorityInteractive:
+            return NSOperationQueuePriorityHigh;
+        default:
+            return NSOperationQueuePriorityNormal;
+    }
+}
+
++ (float)taskPriorityForPriority:(TWTRNetworkingPipelinePriority)priority
+{
+    switch (priority) {
+        case TWTRNetworkingPipelinePriorityBackground:
+            return NSURLSessionTaskPriorityLow;
+        case TWTRNetworkingPipelinePriorityInteractive:
+            return NSURLSessionTaskPriorityHigh;
+        default:
+            return NSURLSessionTaskPriorityDefault;
+    }
 }
 
 - (void)setSession:(id)session
@@ -378,6 +433,11 @@
 
     NSURLSessionDataTask *task = [self.URLSession dataTaskWithRequest:signedRequest completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
         [self syncLocalTime:response];
+        [self.rateLimitTracker updateWithResponse:response forRequest:package.request];
+
+        if ([self shouldRetryPackage:package afterResponse:response]) {
+            return;
+        }
 
         if (error || ![self validateResponse:response data:data error:&error]) {
             [self packageRequest:package session:localSession didReceiveError:error];
@@ -386,10 +446,39 @@
         }
     }];
 
+    task.priority = [[self class] taskPriorityForPriority:package.priority];
+
     [self appendInFlightTask:task forPackage:package];
     [task resume];
 }
 
+/**
+ * Schedules a retry with backoff if the API asked us to slow down. Background packages
+ * are not retried, they fail with the original response instead.
+ *
+ * @return YES if a retry was scheduled and the package callback must not be invoked.
+ */
+- (BOOL)shouldRetryPackage:(TWTRNetworkingPipelinePackage *)package afterResponse:(NSURLResponse *)response
+{
+    if (![TWTRRateLimitTracker isRetryableResponse:response] || package.priority == TWTRNetworkingPipelinePriorityBackground || package.attemptCounter >= SAME_REQUEST_ATTEMPT_CAP) {
+        return NO;
+    }
+
+    NSTimeInterval backoff = [self.rateLimitTracker backoffIntervalForResponse:response attempt:package.attemptCounter];
+    if (backoff > self.rateLimitTracker.maximumDelay) {
+        return NO;
+    }
+
+#ifdef DEBUG
+    if (self.logNetworkRequest) {
+        NSLog(@"Retrying request to %@ in %f seconds", package.request.URL.absoluteString, backoff);
+    }
+#endif
+
+    [self addSigningOperationForPackage:[package copyForRetry] afterDelay:backoff];
+    return YES;
+}
+
 - (void)packageRequest:(TWTRNetworkingPipelinePackage *)package session:(id)localSesion didReceiveError:(NSError *)error
 {
     const BOOL needsRefresh = [package.sessionStore isExpiredSession:localSesion error:error];
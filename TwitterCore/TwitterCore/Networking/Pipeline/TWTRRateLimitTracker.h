@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ This header is private to the Twitter Core SDK and not exposed for public SDK consumption
+ */
+
+#import <Foundation/Foundation.h>
+#import <TwitterCore/TWTRNetworkingPipeline.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, TWTRRateLimitDecision) {
+    /**
+     * The request can be sent right away.
+     */
+    TWTRRateLimitDecisionSend,
+
+    /**
+     * The request should be held back until the returned delay has passed.
+     */
+    TWTRRateLimitDecisionDelay,
+
+    /**
+     * The request should fail without being sent because the budget
+     * for its endpoint will not recover in time.
+     */
+    TWTRRateLimitDecisionShed
+};
+
+/**
+ * Tracks the rate limit budget reported by the API through the `x-rate-limit-*`
+ * response headers, keyed by endpoint. Each pipeline queue owns one tracker so
+ * budgets are kept separately for the guest session and for every user.
+ *
+ * This class is thread safe.
+ */
+@interface TWTRRateLimitTracker : NSObject
+
+/**
+ * The fraction of an endpoint's limit under which the budget is considered
+ * low and background requests are held back.
+ */
+@property (nonatomic, readonly) double lowBudgetFraction;
+
+/**
+ * The longest a request will be held back waiting for a budget to reset or
+ * for a retry backoff. Requests that would wait longer fail immediately.
+ */
+@property (nonatomic, readonly) NSTimeInterval maximumDelay;
+
+/**
+ * Initializes a tracker with the default low budget fraction and maximum delay.
+ */
+- (instancetype)init;
+
+/**
+ * Initializes a tracker.
+ *
+ * @param lowBudgetFraction The fraction of the limit under which background requests are held back.
+ * @param maximumDelay      The longest a request will be held back.
+ */
+- (instancetype)initWithLowBudgetFraction:(double)lowBudgetFraction maximumDelay:(NSTimeInterval)maximumDelay NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Returns the key rate limits are tracked under for the given URL. Numeric
+ * path components and the `.json` extension are ignored so that, for example,
+ * `/1.1/statuses/show/20.json` and `/1.1/statuses/show/21.json` share a budget.
+ */
++ (NSString *)endpointForURL:(NSURL *)URL;
+
+/**
+ * Returns YES if the response asks the client to back off and try again (HTTP 429 or 503).
+ */
++ (BOOL)isRetryableResponse:(nullable NSURLResponse *)response;
+
+/**
+ * Records the budget reported by the response headers for the endpoint of the given request.
+ */
+- (void)updateWithResponse:(nullable NSURLResponse *)response forRequest:(NSURLRequest *)request;
+
+/**
+ * Decides whether a request may be sent now. Requests that are admitted are
+ * counted against the remaining budget until the next response corrects it.
+ *
+ * @param request  The request about to be sent.
+ * @param priority The priority of the request.
+ * @param delay    Set to the time to wait when `TWTRRateLimitDecisionDelay` is returned.
+ */
+- (TWTRRateLimitDecision)decisionForRequest:(NSURLRequest *)request priority:(TWTRNetworkingPipelinePriority)priority delay:(NSTimeInterval *)delay;
+
+/**
+ * Returns how long to wait before retrying a request that received the given
+ * response. `Retry-After` is honored when present, otherwise the delay grows
+ * exponentially with the attempt number and is jittered.
+ *
+ * @param response The response that failed.
+ * @param attempt  The attempt that failed, starting at 1.
+ */
+- (NSTimeInterval)backoffIntervalForResponse:(nullable NSURLResponse *)response attempt:(NSInteger)attempt;
+
+/**
+ * Returns an error describing a request that was shed because the rate limit
+ * for its endpoint was exhausted.
+ */
++ (NSError *)rateLimitExceededErrorForRequest:(NSURLRequest *)request;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRRateLimitTracker.h"
+#import "TWTRAPIErrorCode.h"
+#import "TWTRDateFormatters.h"
+
+static NSString *const TWTRRateLimitLimitHeader = @"x-rate-limit-limit";
+static NSString *const TWTRRateLimitRemainingHeader = @"x-rate-limit-remaining";
+static NSString *const TWTRRateLimitResetHeader = @"x-rate-limit-reset";
+static NSString *const TWTRRetryAfterHeader = @"retry-after";
+
+static double const TWTRRateLimitDefaultLowBudgetFraction = 0.1;
+static NSTimeInterval const TWTRRateLimitDefaultMaximumDelay = 60;
+static NSTimeInterval const TWTRRateLimitBackoffBaseInterval = 1;
+
+@interface TWTRRateLimitBudget : NSObject
+
+@property (nonatomic) NSInteger limit;
+@property (nonatomic) NSInteger remaining;
+@property (nonatomic) NSDate *resetDate;
+
+@end
+
+@implementation TWTRRateLimitBudget
+@end
+
+@interface TWTRRateLimitTracker ()
+
+/**
+ * Serializes access to the budgets.
+ */
+@property (nonatomic, readonly) dispatch_queue_t accessQueue;
+
+/**
+ * Maps endpoints to the last budget the API reported for them.
+ */
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, TWTRRateLimitBudget *> *budgets;
+
+@end
+
+@implementation TWTRRateLimitTracker
+
+- (instancetype)init
+{
+    return [self initWithLowBudgetFraction:TWTRRateLimitDefaultLowBudgetFraction maximumDelay:TWTRRateLimitDefaultMaximumDelay];
+}
+
+- (instancetype)initWithLowBudgetFraction:(double)lowBudgetFraction maximumDelay:(NSTimeInterval)maximumDelay
+{
+    self = [super init];
+    if (self) {
+        _lowBudgetFraction = lowBudgetFraction;
+        _maximumDelay = maximumDelay;
+        _accessQueue = dispatch_queue_create("com.twittercore.rate-limit-tracker.access-queue", DISPATCH_QUEUE_SERIAL);
+        _budgets = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark - Endpoints
+
++ (NSString *)endpointForURL:(NSURL *)URL
+{
+    NSString *path = URL.path.stringByDeletingPathExtension ?: @"";
+    NSMutableArray<NSString *> *components = [NSMutableArray array];
+    NSCharacterSet *nonDigits = [[NSCharacterSet decimalDigitCharacterSet] invertedSet];
+
+    for (NSString *component in [path componentsSeparatedByString:@"/"]) {
+        if (component.length > 0 && [component rangeOfCharacterFromSet:nonDigits].location == NSNotFound) {
+            [components addObject:@":id"];
+        } else {
+            [components addObject:component];
+        }
+    }
+
+    return [NSString stringWithFormat:@"%@%@", URL.host ?: @"", [components componentsJoinedByString:@"/"]];
+}
+
++ (BOOL)isRetryableResponse:(NSURLResponse *)response
+{
+    if (![response isKindOfClass:[NSHTTPURLResponse class]]) {
+        return NO;
+    }
+
+    NSInteger statusCode = [(NSHTTPURLResponse *)response statusCode];
+    return statusCode == 429 || statusCode == 503;
+}
+
+#pragma mark - Budget Tracking
+
+- (void)updateWithResponse:(NSURLResponse *)response forRequest:(NSURLRequest *)request
+{
+    if (![response isKindOfClass:[NSHTTPURLResponse class]]) {
+        return;
+    }
+
+    NSHTTPURLResponse *HTTPResponse = (NSHTTPURLResponse *)response;
+    NSString *limit = [[self class] valueForHeader:TWTRRateLimitLimitHeader inResponse:HTTPResponse];
+    NSString *remaining = [[self class] valueForHeader:TWTRRateLimitRemainingHeader inResponse:HTTPResponse];
+    NSString *reset = [[self class] valueForHeader:TWTRRateLimitResetHeader inResponse:HTTPResponse];
+
+    if (!remaining || !reset) {
+        return;
+    }
+
+    TWTRRateLimitBudget *budget = [[TWTRRateLimitBudget alloc] init];
+    budget.limit = [limit integerValue];
+    budget.remaining = HTTPResponse.statusCode == 429 ? 0 : [remaining integerValue];
+    budget.resetDate = [NSDate dateWithTimeIntervalSince1970:[reset doubleValue]];
+
+    NSString *endpoint = [[self class] endpointForURL:request.URL];
+    dispatch_sync(self.accessQueue, ^{
+        self.budgets[endpoint] = budget;
+    });
+}
+
+- (TWTRRateLimitDecision)decisionForRequest:(NSURLRequest *)request priority:(TWTRNetworkingPipelinePriority)priority delay:(NSTimeInterval *)delay
+{
+    NSString *endpoint = [[self class] endpointForURL:request.URL];
+    TWTRRateLimitDecision __block decision = TWTRRateLimitDecisionSend;
+    NSTimeInterval __block waitInterval = 0;
+
+    dispatch_sync(self.accessQueue, ^{
+        TWTRRateLimitBudget *budget = self.budgets[endpoint];
+        if (!budget) {
+            return;
+        }
+
+        NSTimeInterval untilReset = [budget.resetDate timeIntervalSinceNow];
+        if (untilReset <= 0) {
+            // The window has rolled over, we will learn the new budget from the next response.
+            [self.budgets removeObjectForKey:endpoint];
+            return;
+        }
+
+        const BOOL exhausted = budget.remaining <= 0;
+        const BOOL low = budget.remaining <= (NSInteger)ceil(budget.limit * self.lowBudgetFraction);
+        const BOOL background = priority == TWTRNetworkingPipelinePriorityBackground;
+
+        if (exhausted || (low && background)) {
+            if (untilReset <= self.maximumDelay && !(exhausted && background)) {
+                decision = TWTRRateLimitDecisionDelay;
+                waitInterval = untilReset;
+            } else {
+                decision = TWTRRateLimitDecisionShed;
+            }
+        } else {
+            budget.remaining -= 1;
+        }
+    });
+
+    if (delay) {
+        *delay = waitInterval;
+    }
+    return decision;
+}
+
+#pragma mark - Backoff
+
+- (NSTimeInterval)backoffIntervalForResponse:(NSURLResponse *)response attempt:(NSInteger)attempt
+{
+    NSHTTPURLResponse *HTTPResponse = [response isKindOfClass:[NSHTTPURLResponse class]] ? (NSHTTPURLResponse *)response : nil;
+
+    NSString *retryAfter = [[self class] valueForHeader:TWTRRetryAfterHeader inResponse:HTTPResponse];
+    if (retryAfter.length > 0) {
+        return MAX(0, [[self class] intervalForRetryAfterValue:retryAfter]);
+    }
+
+    NSString *reset = [[self class] valueForHeader:TWTRRateLimitResetHeader inResponse:HTTPResponse];
+    if (HTTPResponse.statusCode == 429 && reset.length > 0) {
+        return MAX(0, [[NSDate dateWithTimeIntervalSince1970:[reset doubleValue]] timeIntervalSinceNow]);
+    }
+
+    // Equal jitter: half of the exponential interval is fixed, the other half is random.
+    NSTimeInterval exponential = MIN(self.maximumDelay, TWTRRateLimitBackoffBaseInterval * pow(2, MAX(0, attempt - 1)));
+    double jitter = arc4random_uniform(1000) / 1000.0;
+    return exponential / 2 + (exponential / 2) * jitter;
+}
+
++ (NSTimeInterval)intervalForRetryAfterValue:(NSString *)value
+{
+    NSCharacterSet *nonDigits = [[NSCharacterSet decimalDigitCharacterSet] invertedSet];
+    NSString *trimmedValue = [value stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+
+    if ([trimmedValue rangeOfCharacterFromSet:nonDigits].location == NSNotFound) {
+        return [trimmedValue doubleValue];
+    }
+
+    NSDate *date = [[TWTRDateFormatters HTTPDateHeaderParsingFormatter] dateFromString:trimmedValue];
+    return date ? [date timeIntervalSinceNow] : 0;
+}
+
+#pragma mark - Helpers
+
++ (NSString *)valueForHeader:(NSString *)header inResponse:(NSHTTPURLResponse *)response
+{
+    for (NSString *key in response.allHeaderFields) {
+        if ([key caseInsensitiveCompare:header] == NSOrderedSame) {
+            return [response.allHeaderFields[key] description];
+        }
+    }
+    return nil;
+}
+
++ (NSError *)rateLimitExceededErrorForRequest:(NSURLRequest *)request
+{
+    NSDictionary *userInfo = @{NSLocalizedDescriptionKey: @"Rate limit exceeded", NSURLErrorFailingURLErrorKey: request.URL};
+    return [NSError errorWithDomain:TWTRAPIErrorDomain code:TWTRAPIErrorCodeRateLimitExceeded userInfo:userInfo];
+}
+
+@end
@@ -16,6 +16,7 @@
  */
 
 #import "TWTRURLSessionDelegate.h"
+#import "TWTRNetworkThroughputEstimator.h"
 #import "TWTRServerTrustEvaluator.h"
 
 @interface TWTRURLSessionDelegate ()
@@ -56,4 +57,9 @@
     }
 }
 
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics API_AVAILABLE(ios(10.0), tvos(10.0))
+{
+    [[TWTRNetworkThroughputEstimator sharedEstimator] recordTaskMetrics:metrics forTask:task];
+}
+
 @end
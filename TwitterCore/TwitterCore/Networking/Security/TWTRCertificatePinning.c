@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "TWTRCertificatePinning.h"
+#include <CommonCrypto/CommonDigest.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct TWTRPinSet {
+    size_t count;
+    uint8_t digests[][TWTR_PIN_DIGEST_LENGTH];
+};
+
+static const uint8_t TWTR_RSA_OID_BYTES[] = {0x06, 0x09, 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x01};
+static const uint8_t TWTR_DER_SEQUENCE_TAG = 0x30;
+
+#pragma mark - Pin Set
+
+static int TWTRHexValue(char character)
+{
+    if (character >= '0' && character <= '9') {
+        return character - '0';
+    } else if (character >= 'a' && character <= 'f') {
+        return character - 'a' + 10;
+    } else if (character >= 'A' && character <= 'F') {
+        return character - 'A' + 10;
+    }
+    return -1;
+}
+
+static bool TWTRHexDecodeDigest(const char *hexDigest, uint8_t digest[TWTR_PIN_DIGEST_LENGTH])
+{
+    if (hexDigest == NULL || strlen(hexDigest) != TWTR_PIN_DIGEST_LENGTH * 2) {
+        return false;
+    }
+
+    for (size_t i = 0; i < TWTR_PIN_DIGEST_LENGTH; i++) {
+        int high = TWTRHexValue(hexDigest[2 * i]);
+        int low = TWTRHexValue(hexDigest[2 * i + 1]);
+
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        digest[i] = (uint8_t)((high << 4) | low);
+    }
+
+    return true;
+}
+
+static int TWTRCompareDigests(const void *lhs, const void *rhs)
+{
+    return memcmp(lhs, rhs, TWTR_PIN_DIGEST_LENGTH);
+}
+
+TWTRPinSet *TWTRPinSetCreateWithHexDigests(const char *const *hexDigests, size_t count)
+{
+    if (hexDigests == NULL && count > 0) {
+        return NULL;
+    }
+
+    TWTRPinSet *pinSet = malloc(sizeof(TWTRPinSet) + count * TWTR_PIN_DIGEST_LENGTH);
+    if (pinSet == NULL) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (!TWTRHexDecodeDigest(hexDigests[i], pinSet->digests[i])) {
+            free(pinSet);
+            return NULL;
+        }
+    }
+
+    if (count > 1) {
+        qsort(pinSet->digests, count, TWTR_PIN_DIGEST_LENGTH, TWTRCompareDigests);
+    }
+
+    // Collapse duplicates now that equal digests are adjacent.
+    size_t uniqueCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (uniqueCount == 0 || TWTRCompareDigests(pinSet->digests[uniqueCount - 1], pinSet->digests[i]) != 0) {
+            memmove(pinSet->digests[uniqueCount], pinSet->digests[i], TWTR_PIN_DIGEST_LENGTH);
+            uniqueCount++;
+        }
+    }
+    pinSet->count = uniqueCount;
+
+    return pinSet;
+}
+
+void TWTRPinSetFree(TWTRPinSet *pinSet)
+{
+    free(pinSet);
+}
+
+size_t TWTRPinSetGetCount(const TWTRPinSet *pinSet)
+{
+    return pinSet ? pinSet->count : 0;
+}
+
+bool TWTRPinSetContainsDigest(const TWTRPinSet *pinSet, const uint8_t digest[TWTR_PIN_DIGEST_LENGTH])
+{
+    if (pinSet == NULL || digest == NULL || pinSet->count == 0) {
+        return false;
+    }
+
+    return bsearch(digest, pinSet->digests, pinSet->count, TWTR_PIN_DIGEST_LENGTH, TWTRCompareDigests) != NULL;
+}
+
+#pragma mark - DER Parsing
+
+/**
+ *  Finds the rsaEncryption OID, then walks back to the AlgorithmIdentifier sequence and from there to
+ *  the enclosing SubjectPublicKeyInfo sequence.
+ */
+static bool TWTRFindRSAOIDOffset(const uint8_t *bytes, size_t length, size_t *outOffset)
+{
+    if (length < sizeof(TWTR_RSA_OID_BYTES)) {
+        return false;
+    }
+
+    const size_t lastCandidate = length - sizeof(TWTR_RSA_OID_BYTES);
+    for (size_t i = 0; i <= lastCandidate; i++) {
+        if (bytes[i] == TWTR_RSA_OID_BYTES[0] && memcmp(bytes + i, TWTR_RSA_OID_BYTES, sizeof(TWTR_RSA_OID_BYTES)) == 0) {
+            *outOffset = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool TWTRFindEnclosingSequence(const uint8_t *bytes, size_t offset, size_t *outOffset)
+{
+    for (size_t i = offset; i > 0; i--) {
+        if (bytes[i - 1] == TWTR_DER_SEQUENCE_TAG) {
+            *outOffset = i - 1;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool TWTRParseSequenceLength(const uint8_t *bytes, size_t offset, size_t length, size_t *outLength)
+{
+    if (offset + 1 >= length || bytes[offset] != TWTR_DER_SEQUENCE_TAG) {
+        return false;
+    }
+
+    size_t lengthByte = bytes[offset + 1];
+    if (lengthByte < 0x80) {
+        *outLength = lengthByte + 2;
+        return true;
+    }
+
+    size_t lengthLength = lengthByte & 0x7F;
+    if (lengthLength == 0 || lengthLength > 4 || offset + 1 + lengthLength >= length) {
+        return false;
+    }
+
+    size_t contentLength = 0;
+    for (size_t i = 0; i < lengthLength; i++) {
+        contentLength = (contentLength << 8) | bytes[offset + 2 + i];
+    }
+
+    *outLength = contentLength + 2 + lengthLength;
+    return true;
+}
+
+bool TWTRCertificateGetSubjectPublicKeyInfo(const uint8_t *certificate, size_t length, size_t *outSPKIOffset, size_t *outSPKILength)
+{
+    if (certificate == NULL || outSPKIOffset == NULL || outSPKILength == NULL) {
+        return false;
+    }
+
+    size_t oidOffset;
+    size_t algorithmOffset;
+    size_t spkiOffset;
+    size_t spkiLength;
+
+    if (!TWTRFindRSAOIDOffset(certificate, length, &oidOffset) || !TWTRFindEnclosingSequence(certificate, oidOffset, &algorithmOffset) || !TWTRFindEnclosingSequence(certificate, algorithmOffset, &spkiOffset) || !TWTRParseSequenceLength(certificate, spkiOffset, length, &spkiLength)) {
+        return false;
+    }
+
+    if (spkiLength > length - spkiOffset) {
+        return false;
+    }
+
+    *outSPKIOffset = spkiOffset;
+    *outSPKILength = spkiLength;
+    return true;
+}
+
+bool TWTRPinSetMatchesCertificate(const TWTRPinSet *pinSet, const uint8_t *certificate, size_t length)
+{
+    size_t spkiOffset;
+    size_t spkiLength;
+
+    if (!TWTRCertificateGetSubjectPublicKeyInfo(certificate, length, &spkiOffset, &spkiLength)) {
+        return false;
+    }
+
+    uint8_t digest[CC_SHA1_DIGEST_LENGTH];
+    CC_SHA1(certificate + spkiOffset, (CC_LONG)spkiLength, digest);
+
+    return TWTRPinSetContainsDigest(pinSet, digest);
+}
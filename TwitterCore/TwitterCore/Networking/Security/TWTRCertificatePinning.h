@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ This header is private to the Twitter Core SDK and not exposed for public SDK consumption
+ */
+
+//  Certificate pinning primitives written in plain C so they can run on every
+//  TLS challenge without allocating Objective-C objects.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Length of a pin, the SHA-1 digest of a DER encoded SubjectPublicKeyInfo.
+ */
+#define TWTR_PIN_DIGEST_LENGTH 20
+
+/**
+ *  Immutable set of pinned SPKI digests, stored sorted so lookups are a binary search.
+ */
+typedef struct TWTRPinSet TWTRPinSet;
+
+/**
+ *  Decodes hex encoded SPKI digests into a new pin set. Duplicate pins are collapsed.
+ *
+ *  @param hexDigests Array of 40 character hex strings.
+ *  @param count      Number of entries in `hexDigests`.
+ *
+ *  @return A pin set to release with `TWTRPinSetFree`, or NULL if any digest is malformed.
+ */
+TWTRPinSet *TWTRPinSetCreateWithHexDigests(const char *const *hexDigests, size_t count);
+
+void TWTRPinSetFree(TWTRPinSet *pinSet);
+
+size_t TWTRPinSetGetCount(const TWTRPinSet *pinSet);
+
+bool TWTRPinSetContainsDigest(const TWTRPinSet *pinSet, const uint8_t digest[TWTR_PIN_DIGEST_LENGTH]);
+
+/**
+ *  Locates the SubjectPublicKeyInfo of an RSA certificate inside its DER encoding.
+ *
+ *  @param certificate   DER encoded X.509 certificate.
+ *  @param length        Length of `certificate` in bytes.
+ *  @param outSPKIOffset Set to the offset of the SubjectPublicKeyInfo sequence.
+ *  @param outSPKILength Set to the length of the sequence, including its header.
+ *
+ *  @return false if no RSA public key could be found.
+ */
+bool TWTRCertificateGetSubjectPublicKeyInfo(const uint8_t *certificate, size_t length, size_t *outSPKIOffset, size_t *outSPKILength);
+
+/**
+ *  @return true if the SHA-1 digest of the certificate's SubjectPublicKeyInfo is in `pinSet`.
+ */
+bool TWTRPinSetMatchesCertificate(const TWTRPinSet *pinSet, const uint8_t *certificate, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
@@ -17,10 +17,10 @@
 
 #import "TWTRServerTrustEvaluator.h"
 #import <CommonCrypto/CommonDigest.h>
-#import "TWTRX509Certificate.h"
+#import "TWTRCertificatePinning.h"
+#import "TWTRMemoryPressureCoordinator.h"
 
-static const int TWTR_DIGEST_HEX_STRING_LENGTH = 41;
-static char TWTR_TWITTER_PINS[][TWTR_DIGEST_HEX_STRING_LENGTH] = {
+static const char *const TWTR_TWITTER_PINS[] = {
     "1a21b4952b6293ce18b365ec9c0e934cb381e6d4",
     "2343d148a255899b947d461a797ec04cfed170b7",
     "5519b278acb281d7eda7abc18399c3bb690424b5",
@@ -43,15 +43,19 @@ static char TWTR_TWITTER_PINS[][TWTR_DIGEST_HEX_STRING_LENGTH] = {
     "68330e61358521592983a3c8d2d2e1406e7ab3c1",
     "56fef3c2147d4ed38837fdbd3052387201e5778d",
 };
-static const int TWTR_NUM_PINNED_CERTS = sizeof(TWTR_TWITTER_PINS) / TWTR_DIGEST_HEX_STRING_LENGTH;
+static const size_t TWTR_NUM_PINNED_CERTS = sizeof(TWTR_TWITTER_PINS) / sizeof(TWTR_TWITTER_PINS[0]);
 
-static NSCache *TWTRCertificateCache;
+// Decoded once; lookups against it are a binary search over raw digests.
+static TWTRPinSet *TWTRTwitterPinSet;
 
-@interface TWTRServerTrustEvaluator ()
+// SHA-256 digests of the DER bytes of leaf certificates that already passed. Guarded by synchronizing on itself.
+static NSMutableSet<NSData *> *TWTRCertificateCache;
 
-@property (nonatomic, strong, readwrite) NSArray *pinnedPublicKeys;
+// Twitter serves a handful of leaf certificates, so this only bounds the set if something keeps presenting new ones.
+static NSUInteger const TWTRCertificateCacheMaxCount = 32;
 
-@end
+// Digest, set slot and object overhead per cached certificate.
+static NSUInteger const TWTRCertificateCacheEstimatedEntryCost = 128;
 
 @implementation TWTRServerTrustEvaluator
 
@@ -60,78 +64,87 @@ static NSCache *TWTRCertificateCache;
     if (self == [TWTRServerTrustEvaluator class]) {
         static dispatch_once_t onceToken;
         dispatch_once(&onceToken, ^{
-            TWTRCertificateCache = [[NSCache alloc] init];
+            TWTRTwitterPinSet = TWTRPinSetCreateWithHexDigests(TWTR_TWITTER_PINS, TWTR_NUM_PINNED_CERTS);
+            NSAssert(TWTRTwitterPinSet != NULL, @"Malformed certificate pin");
+            TWTRCertificateCache = [NSMutableSet set];
+
+            TWTRMemoryCostBlock cost = ^NSUInteger {
+                @synchronized(TWTRCertificateCache)
+                {
+                    return TWTRCertificateCache.count * TWTRCertificateCacheEstimatedEntryCost;
+                }
+            };
+            TWTRMemoryTrimBlock trim = ^(NSUInteger targetCost) {
+                @synchronized(TWTRCertificateCache)
+                {
+                    if (TWTRCertificateCache.count * TWTRCertificateCacheEstimatedEntryCost > targetCost) {
+                        [TWTRCertificateCache removeAllObjects];
+                    }
+                }
+            };
+            [[TWTRMemoryPressureCoordinator sharedCoordinator] registerCacheNamed:@"TWTRServerTrustEvaluator.certificates" priority:TWTRMemoryPurgePriorityHigh cost:cost trim:trim];
         });
     }
 }
 
 - (BOOL)evaluateServerTrust:(SecTrustRef)serverTrust forDomain:(NSString *)domain
 {
-    if ([TWTRServerTrustEvaluator isCertificateChainCached:serverTrust]) {
-        return YES;
+    CFIndex chainLength = SecTrustGetCertificateCount(serverTrust);
+    if (chainLength == 0) {
+        return NO;
     }
 
-    CFIndex chainLength = SecTrustGetCertificateCount(serverTrust);
-    for (int i = 0; i < chainLength; i++) {
-        SecCertificateRef certificate = SecTrustGetCertificateAtIndex(serverTrust, i);
-        TWTRX509Certificate *x509 = [[TWTRX509Certificate alloc] initWithCertificate:certificate];
-        NSData *publicKeyBytes = [x509 publicKey];
-        if ([TWTRServerTrustEvaluator isPinnedSPKI:publicKeyBytes]) {
-            [TWTRServerTrustEvaluator cacheValidCertificateChain:serverTrust];
-            return YES;
+    NSData *leafDigest = [TWTRServerTrustEvaluator digestForCertificate:SecTrustGetCertificateAtIndex(serverTrust, 0)];
+    if (leafDigest) {
+        @synchronized(TWTRCertificateCache)
+        {
+            if ([TWTRCertificateCache containsObject:leafDigest]) {
+                return YES;
+            }
         }
     }
-    return NO;
-}
-
-+ (BOOL)isPinnedSPKI:(NSData *)encodedSpki
-{
-    unsigned char digest[CC_SHA1_DIGEST_LENGTH];
-    unsigned char pin[CC_SHA1_DIGEST_LENGTH];
 
-    if (CC_SHA1([encodedSpki bytes], (CC_LONG)[encodedSpki length], digest)) {
-        for (int i = 0; i < TWTR_NUM_PINNED_CERTS; i++) {
-            [self hexDecode:TWTR_TWITTER_PINS[i] decoded:pin];
-
-            if (memcmp(digest, pin, CC_SHA1_DIGEST_LENGTH) == 0) {
-                return TRUE;
+    for (CFIndex i = 0; i < chainLength; i++) {
+        SecCertificateRef certificate = SecTrustGetCertificateAtIndex(serverTrust, i);
+        if ([TWTRServerTrustEvaluator isPinnedCertificate:certificate]) {
+            if (leafDigest) {
+                @synchronized(TWTRCertificateCache)
+                {
+                    if (TWTRCertificateCache.count >= TWTRCertificateCacheMaxCount) {
+                        [TWTRCertificateCache removeObject:TWTRCertificateCache.anyObject];
+                    }
+                    [TWTRCertificateCache addObject:leafDigest];
+                }
             }
+            return YES;
         }
     }
-    return FALSE;
+    return NO;
 }
 
-+ (void)hexDecode:(const char *)hexString decoded:(unsigned char *)decoded
++ (BOOL)isPinnedCertificate:(SecCertificateRef)certificate
 {
-    size_t length = strlen(hexString);
-
-    for (size_t i = 0; i < length; i += 2) {
-        char hexByte[3];
-        hexByte[0] = hexString[i];
-        hexByte[1] = hexString[i + 1];
-        hexByte[2] = '\0';
-
-        decoded[i / 2] = (unsigned char)strtoul(hexByte, NULL, 16);
+    CFDataRef data = SecCertificateCopyData(certificate);
+    if (data == NULL) {
+        return NO;
     }
+
+    BOOL isPinned = TWTRPinSetMatchesCertificate(TWTRTwitterPinSet, CFDataGetBytePtr(data), (size_t)CFDataGetLength(data));
+    CFRelease(data);
+    return isPinned;
 }
 
-+ (BOOL)isCertificateChainCached:(SecTrustRef)serverTrust
++ (NSData *)digestForCertificate:(SecCertificateRef)certificate
 {
-    SecCertificateRef certificate = SecTrustGetCertificateAtIndex(serverTrust, 0);
-    TWTRX509Certificate *x509 = [[TWTRX509Certificate alloc] initWithCertificate:certificate];
-    NSString *fingerprint = [x509 fingerprint];
-    if ([TWTRCertificateCache objectForKey:fingerprint]) {
-        return YES;
+    CFDataRef data = SecCertificateCopyData(certificate);
+    if (data == NULL) {
+        return nil;
     }
-    return NO;
-}
 
-+ (void)cacheValidCertificateChain:(SecTrustRef)serverTrust
-{
-    SecCertificateRef certificate = SecTrustGetCertificateAtIndex(serverTrust, 0);
-    TWTRX509Certificate *x509 = [[TWTRX509Certificate alloc] initWithCertificate:certificate];
-    NSString *fingerprint = [x509 fingerprint];
-    [TWTRCertificateCache setObject:[NSNull null] forKey:fingerprint];
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(CFDataGetBytePtr(data), (CC_LONG)CFDataGetLength(data), digest);
+    CFRelease(data);
+    return [NSData dataWithBytes:digest length:CC_SHA256_DIGEST_LENGTH];
 }
 
 @end
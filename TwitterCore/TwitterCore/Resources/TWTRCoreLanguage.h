@@ -23,4 +23,11 @@
 
 + (NSString *)preferredLanguage;
 
+/**
+ *  Forgets the cached language so the next call to `preferredLanguage` reads it again. The user can
+ *  change their language without relaunching the app, so `TWTRResourcesUtil` calls this when the
+ *  current locale changes.
+ */
++ (void)resetPreferredLanguage;
+
 @end
@@ -19,22 +19,31 @@
 
 @implementation TWTRCoreLanguage
 
+static NSString *TWTRPreferredLanguage;
+
 + (NSString *)preferredLanguage
 {
-    static NSString *preferred;
-
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        // We are using preferredLanguages instead of preferredLocalizations
-        // http://mjtsai.com/blog/2014/12/09/nslocale-preferredlanguages-vs-nsbundle-preferredlocalizations/
-        // which will show return the OS's preferred language, not the app's language necessarly.
-        // If the OS was in German and the App in English, this method will return "German".
-        // (MD) We might want to obey the app's preference but for now I am leaving the same behavior;
-        // just centralizing this call.
-        preferred = [[NSLocale preferredLanguages] firstObject];
-    });
+    @synchronized(self)
+    {
+        if (TWTRPreferredLanguage == nil) {
+            // We are using preferredLanguages instead of preferredLocalizations
+            // http://mjtsai.com/blog/2014/12/09/nslocale-preferredlanguages-vs-nsbundle-preferredlocalizations/
+            // which will show return the OS's preferred language, not the app's language necessarly.
+            // If the OS was in German and the App in English, this method will return "German".
+            // (MD) We might want to obey the app's preference but for now I am leaving the same behavior;
+            // just centralizing this call.
+            TWTRPreferredLanguage = [[NSLocale preferredLanguages] firstObject];
+        }
+        return TWTRPreferredLanguage;
+    }
+}
 
-    return preferred;
++ (void)resetPreferredLanguage
+{
+    @synchronized(self)
+    {
+        TWTRPreferredLanguage = nil;
+    }
 }
 
 @end
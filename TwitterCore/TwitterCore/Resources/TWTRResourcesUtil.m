@@ -26,8 +26,86 @@ NSString *const TWTRResourcesUtilFallbackLanguage = @"en";
 NSString *const TWTRResourcesUtilDefaultValue = @"com.twitter.resourcesutil.default_value";
 static NSString *kitVersion;
 
+/**
+ *  Strings resolved from one resource bundle in the current language. Bundles are looked up once
+ *  and every string is memoized after its first lookup, so repeated lookups never touch the disk.
+ */
+@interface TWTRLocalizedStringTable : NSObject
+
+- (instancetype)initWithBundlePath:(NSString *)bundlePath localizedBundle:(NSBundle *)localizedBundle;
+- (NSString *)stringForKey:(NSString *)key;
+
+@end
+
+@implementation TWTRLocalizedStringTable {
+    NSString *_bundlePath;
+    NSBundle *_localizedBundle;
+    NSBundle *_fallbackBundle;
+    NSMutableDictionary<NSString *, NSString *> *_strings;
+}
+
+- (instancetype)initWithBundlePath:(NSString *)bundlePath localizedBundle:(NSBundle *)localizedBundle
+{
+    if (self = [super init]) {
+        _bundlePath = [bundlePath copy];
+        _localizedBundle = localizedBundle;
+        _strings = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSString *)stringForKey:(NSString *)key
+{
+    @synchronized(self)
+    {
+        NSString *string = _strings[key];
+        if (string == nil) {
+            string = [self resolveStringForKey:key];
+            if (string) {
+                _strings[key] = string;
+            }
+        }
+        return string;
+    }
+}
+
+- (NSString *)resolveStringForKey:(NSString *)key
+{
+    NSString *localizedString = [_localizedBundle localizedStringForKey:key value:TWTRResourcesUtilDefaultValue table:nil];
+    if (localizedString == nil || [localizedString isEqualToString:TWTRResourcesUtilDefaultValue]) {
+        NSAssert(false, @"Could not find key '%@' in current locale bundle", key);
+        localizedString = [[self fallbackBundle] localizedStringForKey:key value:nil table:nil];
+    }
+    return localizedString;
+}
+
+- (NSBundle *)fallbackBundle
+{
+    if (_fallbackBundle == nil) {
+        NSBundle *kitBundle = [TWTRResourcesUtil bundleWithBundlePath:_bundlePath];
+        NSString *fallbackBundlePath = [kitBundle pathForResource:TWTRResourcesUtilFallbackLanguage ofType:TWTRResourcesUtilLanguageType];
+        _fallbackBundle = [NSBundle bundleWithPath:fallbackBundlePath];
+    }
+    return _fallbackBundle;
+}
+
+@end
+
 @implementation TWTRResourcesUtil
 
++ (void)initialize
+{
+    if (self == [TWTRResourcesUtil class]) {
+        // A single observer resets the language before the strings resolved in it, so a table can't be rebuilt from the stale language
+        [[NSNotificationCenter defaultCenter] addObserverForName:NSCurrentLocaleDidChangeNotification
+                                                          object:nil
+                                                           queue:nil
+                                                      usingBlock:^(NSNotification *note) {
+                                                          [TWTRResourcesUtil resetLocalizedStringTables];
+                                                      }];
+    }
+}
+
 + (NSBundle *)bundleWithBundlePath:(NSString *)bundlePath
 {
     NSString *bundleName = [bundlePath stringByDeletingPathExtension];
@@ -58,16 +136,42 @@ static NSString *kitVersion;
 
 + (NSString *)localizedStringForKey:(NSString *)key bundlePath:(NSString *)bundlePath
 {
-    NSBundle *localizedBundle = [TWTRResourcesUtil localizedBundleWithBundlePath:bundlePath];
-    NSString *localizedString = [localizedBundle localizedStringForKey:key value:TWTRResourcesUtilDefaultValue table:nil];
-    if (localizedString == nil || [localizedString isEqualToString:TWTRResourcesUtilDefaultValue]) {
-        NSAssert(false, @"Could not find key '%@' in current locale bundle", key);
-        NSBundle *kitBundle = [TWTRResourcesUtil bundleWithBundlePath:bundlePath];
-        NSString *fallbackBundlePath = [kitBundle pathForResource:TWTRResourcesUtilFallbackLanguage ofType:TWTRResourcesUtilLanguageType];
-        NSBundle *fallbackBundle = [NSBundle bundleWithPath:fallbackBundlePath];
-        localizedString = [fallbackBundle localizedStringForKey:key value:nil table:nil];
+    return [[self localizedStringTableWithBundlePath:bundlePath] stringForKey:key];
+}
+
++ (NSMutableDictionary<NSString *, TWTRLocalizedStringTable *> *)localizedStringTables
+{
+    static NSMutableDictionary *tables;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        tables = [NSMutableDictionary dictionary];
+    });
+    return tables;
+}
+
++ (TWTRLocalizedStringTable *)localizedStringTableWithBundlePath:(NSString *)bundlePath
+{
+    NSMutableDictionary *tables = [self localizedStringTables];
+    @synchronized(tables)
+    {
+        TWTRLocalizedStringTable *table = tables[bundlePath];
+        if (table == nil) {
+            table = [[TWTRLocalizedStringTable alloc] initWithBundlePath:bundlePath localizedBundle:[TWTRResourcesUtil localizedBundleWithBundlePath:bundlePath]];
+            tables[bundlePath] = table;
+        }
+        return table;
+    }
+}
+
++ (void)resetLocalizedStringTables
+{
+    NSMutableDictionary *tables = [self localizedStringTables];
+    @synchronized(tables)
+    {
+        // Tables are built while holding the same lock, so none can pick up the old language in between
+        [TWTRCoreLanguage resetPreferredLanguage];
+        [tables removeAllObjects];
     }
-    return localizedString;
 }
 
 + (CGFloat)screenScale
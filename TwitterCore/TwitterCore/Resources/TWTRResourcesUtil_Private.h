@@ -26,4 +26,10 @@
 + (NSString *)deviceModel;
 + (NSString *)OSVersionString;
 
+/**
+ *  Drops every resolved localized string along with the cached preferred language. Called automatically
+ *  when the current locale changes.
+ */
++ (void)resetLocalizedStringTables;
+
 @end
@@ -16,6 +16,7 @@
  */
 
 #import "TWTRDateFormatters.h"
+#import "TWTRMemoryPressureCoordinator.h"
 
 static NSString *const TWTRDateFormatterLock = @"TWTRDateFormatterLock";
 static NSString *const TWTRDateFormatterShortHistorical = @"TWTRDateFormatterShortHistorical";
@@ -27,8 +28,32 @@ static NSString *const TWTRDateHTTPHeaderParsing = @"TWTRDateHTTPHeaderParsing";
 static NSMutableDictionary *internalCache;
 static NSLocale *internalLocale;
 
+// Formatters load their locale's ICU data, so each one is expensive to create but only tens of KB.
+static NSUInteger const TWTRDateFormatterEstimatedCost = 32 * 1024;
+
 @implementation TWTRDateFormatters
 
++ (void)initialize
+{
+    if (self == [TWTRDateFormatters class]) {
+        TWTRMemoryCostBlock cost = ^NSUInteger {
+            @synchronized(TWTRDateFormatterLock)
+            {
+                return internalCache.count * TWTRDateFormatterEstimatedCost;
+            }
+        };
+        TWTRMemoryTrimBlock trim = ^(NSUInteger targetCost) {
+            @synchronized(TWTRDateFormatterLock)
+            {
+                if (internalCache.count * TWTRDateFormatterEstimatedCost > targetCost) {
+                    [self resetCache];
+                }
+            }
+        };
+        [[TWTRMemoryPressureCoordinator sharedCoordinator] registerCacheNamed:@"TWTRDateFormatters" priority:TWTRMemoryPurgePriorityDefault cost:cost trim:trim];
+    }
+}
+
 + (NSDateFormatter *)serverParsingDateFormatter
 {
     NSString *key = TWTRDateFormatterAPIParsing;
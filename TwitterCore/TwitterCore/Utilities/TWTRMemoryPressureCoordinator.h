@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ This header is private to the Twitter Core SDK and not exposed for public SDK consumption
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  The order caches are trimmed in under memory pressure.
+ */
+typedef NS_ENUM(NSUInteger, TWTRMemoryPurgePriority) {
+    /**
+     *  Cheap to rebuild, e.g. memoized values. Trimmed first.
+     */
+    TWTRMemoryPurgePriorityHigh,
+    TWTRMemoryPurgePriorityDefault,
+    /**
+     *  Expensive to rebuild, e.g. decoded media or warmed up players. Trimmed last.
+     */
+    TWTRMemoryPurgePriorityLow,
+};
+
+/**
+ *  Returns the approximate number of bytes a cache holds.
+ */
+typedef NSUInteger (^TWTRMemoryCostBlock)(void);
+
+/**
+ *  Frees memory until the cache holds no more than `targetCost` bytes. A target of 0 empties it.
+ */
+typedef void (^TWTRMemoryTrimBlock)(NSUInteger targetCost);
+
+/**
+ *  Registry of the in-memory caches across the kits. When memory runs low or the app enters the
+ *  background, caches are trimmed in priority order until the registered caches fit in
+ *  `memoryBudget`. Within a priority the largest caches go first. Caches are left alone while
+ *  the total is within budget, so a short trip to the background does not cost warm caches.
+ *
+ *  Costs are estimates reported by each cache, meant for comparing caches and tuning limits
+ *  rather than exact accounting.
+ *
+ *  This class is thread-safe. Cost and trim blocks are called without any lock held, on the
+ *  thread that signalled the pressure, which is the main thread for system notifications. Caches
+ *  confined to the main thread should hop to it rather than report nothing.
+ *
+ *  Exposed publicly through `-[TWTRTwitter cacheMemoryUsage]` and `TWTRTwitter.cacheMemoryBudget`.
+ */
+@interface TWTRMemoryPressureCoordinator : NSObject
+
+/**
+ *  The number of bytes the registered caches may keep after being trimmed. Defaults to 16 MB.
+ */
+@property (nonatomic) NSUInteger memoryBudget;
+
+/**
+ *  The coordinator that the kits' shared caches register with. Observes the default
+ *  notification center.
+ */
++ (instancetype)sharedCoordinator;
+
+/**
+ *  Creates a coordinator trimming its caches when `notificationCenter` posts memory warnings or
+ *  background notifications.
+ */
+- (instancetype)initWithNotificationCenter:(NSNotificationCenter *)notificationCenter NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ *  Registers a cache. Registering a name again replaces the earlier registration.
+ *
+ *  @param name     Unique name reported in `memoryUsage`.
+ *  @param priority When the cache is trimmed relative to the other caches.
+ *  @param cost     Returns the approximate bytes the cache holds.
+ *  @param trim     Frees memory down to the given cost.
+ */
+- (void)registerCacheNamed:(NSString *)name priority:(TWTRMemoryPurgePriority)priority cost:(TWTRMemoryCostBlock)cost trim:(TWTRMemoryTrimBlock)trim;
+- (void)unregisterCacheNamed:(NSString *)name;
+
+/**
+ *  The approximate bytes held by each registered cache, keyed by name.
+ */
+- (NSDictionary<NSString *, NSNumber *> *)memoryUsage;
+
+/**
+ *  Trims the registered caches, in priority order, until they fit in `memoryBudget`. Called for
+ *  memory warnings and backgrounding; can also be called directly to signal pressure.
+ */
+- (void)handleMemoryPressure;
+
+/**
+ *  Trims the registered caches, in priority order, until they fit in `budget` bytes.
+ */
+- (void)trimToBudget:(NSUInteger)budget;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRMemoryPressureCoordinator.h"
+#import <UIKit/UIKit.h>
+#import "TWTRAssertionMacros.h"
+
+static NSUInteger const TWTRMemoryPressureCoordinatorDefaultBudget = 16 * 1024 * 1024;
+
+@interface TWTRMemoryPressureRegistration : NSObject
+
+@property (nonatomic, copy, readonly) NSString *name;
+@property (nonatomic, readonly) TWTRMemoryPurgePriority priority;
+@property (nonatomic, copy, readonly) TWTRMemoryCostBlock cost;
+@property (nonatomic, copy, readonly) TWTRMemoryTrimBlock trim;
+
+@end
+
+@implementation TWTRMemoryPressureRegistration
+
+- (instancetype)initWithName:(NSString *)name priority:(TWTRMemoryPurgePriority)priority cost:(TWTRMemoryCostBlock)cost trim:(TWTRMemoryTrimBlock)trim
+{
+    self = [super init];
+    if (self) {
+        _name = [name copy];
+        _priority = priority;
+        _cost = [cost copy];
+        _trim = [trim copy];
+    }
+    return self;
+}
+
+@end
+
+@interface TWTRMemoryPressureCoordinator ()
+
+@property (nonatomic, readonly) NSNotificationCenter *notificationCenter;
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, TWTRMemoryPressureRegistration *> *registrations;
+
+@end
+
+@implementation TWTRMemoryPressureCoordinator
+
++ (instancetype)sharedCoordinator
+{
+    static TWTRMemoryPressureCoordinator *sharedCoordinator;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCoordinator = [[TWTRMemoryPressureCoordinator alloc] initWithNotificationCenter:[NSNotificationCenter defaultCenter]];
+    });
+
+    return sharedCoordinator;
+}
+
+- (instancetype)initWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+{
+    TWTRParameterAssertOrReturnValue(notificationCenter, nil);
+
+    self = [super init];
+    if (self) {
+        _notificationCenter = notificationCenter;
+        _registrations = [NSMutableDictionary dictionary];
+        _memoryBudget = TWTRMemoryPressureCoordinatorDefaultBudget;
+
+        [notificationCenter addObserver:self selector:@selector(handleMemoryPressure) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+        [notificationCenter addObserver:self selector:@selector(handleMemoryPressure) name:UIApplicationDidEnterBackgroundNotification object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_notificationCenter removeObserver:self];
+}
+
+- (NSUInteger)memoryBudget
+{
+    @synchronized(self)
+    {
+        return _memoryBudget;
+    }
+}
+
+- (void)setMemoryBudget:(NSUInteger)memoryBudget
+{
+    @synchronized(self)
+    {
+        _memoryBudget = memoryBudget;
+    }
+}
+
+#pragma mark - Registration
+
+- (void)registerCacheNamed:(NSString *)name priority:(TWTRMemoryPurgePriority)priority cost:(TWTRMemoryCostBlock)cost trim:(TWTRMemoryTrimBlock)trim
+{
+    TWTRParameterAssertOrReturn(name);
+    TWTRParameterAssertOrReturn(cost);
+    TWTRParameterAssertOrReturn(trim);
+
+    TWTRMemoryPressureRegistration *registration = [[TWTRMemoryPressureRegistration alloc] initWithName:name priority:priority cost:cost trim:trim];
+
+    @synchronized(self)
+    {
+        self.registrations[name] = registration;
+    }
+}
+
+- (void)unregisterCacheNamed:(NSString *)name
+{
+    TWTRParameterAssertOrReturn(name);
+
+    @synchronized(self)
+    {
+        [self.registrations removeObjectForKey:name];
+    }
+}
+
+#pragma mark - Usage
+
+- (NSDictionary<NSString *, NSNumber *> *)memoryUsage
+{
+    NSMutableDictionary<NSString *, NSNumber *> *usage = [NSMutableDictionary dictionary];
+    for (TWTRMemoryPressureRegistration *registration in [self registrationSnapshot]) {
+        usage[registration.name] = @(registration.cost());
+    }
+
+    return usage;
+}
+
+#pragma mark - Trimming
+
+- (void)handleMemoryPressure
+{
+    [self trimToBudget:self.memoryBudget];
+}
+
+- (void)trimToBudget:(NSUInteger)budget
+{
+    NSArray<TWTRMemoryPressureRegistration *> *registrations = [self registrationSnapshot];
+
+    // Measure once up front; caches are only measured again after they have been trimmed
+    NSMutableArray<NSNumber *> *costs = [NSMutableArray arrayWithCapacity:registrations.count];
+    NSUInteger totalCost = 0;
+    for (TWTRMemoryPressureRegistration *registration in registrations) {
+        NSUInteger cost = registration.cost();
+        [costs addObject:@(cost)];
+        totalCost += cost;
+    }
+
+    NSArray<NSNumber *> *trimOrder = [[self class] trimOrderForRegistrations:registrations costs:costs];
+    for (NSNumber *index in trimOrder) {
+        if (totalCost <= budget) {
+            break;
+        }
+
+        TWTRMemoryPressureRegistration *registration = registrations[index.unsignedIntegerValue];
+        NSUInteger cost = costs[index.unsignedIntegerValue].unsignedIntegerValue;
+        if (cost == 0) {
+            continue;
+        }
+
+        // Only take what is over budget from this cache, the rest can stay warm
+        NSUInteger excess = totalCost - budget;
+        registration.trim(cost > excess ? cost - excess : 0);
+
+        NSUInteger trimmedCost = MIN(registration.cost(), cost);
+        totalCost -= cost - trimmedCost;
+    }
+}
+
+/**
+ *  Indexes of the registrations ordered by priority, then by descending cost.
+ */
++ (NSArray<NSNumber *> *)trimOrderForRegistrations:(NSArray<TWTRMemoryPressureRegistration *> *)registrations costs:(NSArray<NSNumber *> *)costs
+{
+    NSMutableArray<NSNumber *> *indexes = [NSMutableArray arrayWithCapacity:registrations.count];
+    for (NSUInteger i = 0; i < registrations.count; i++) {
+        [indexes addObject:@(i)];
+    }
+
+    [indexes sortUsingComparator:^NSComparisonResult(NSNumber *lhs, NSNumber *rhs) {
+        TWTRMemoryPurgePriority lhsPriority = registrations[lhs.unsignedIntegerValue].priority;
+        TWTRMemoryPurgePriority rhsPriority = registrations[rhs.unsignedIntegerValue].priority;
+        if (lhsPriority != rhsPriority) {
+            return lhsPriority < rhsPriority ? NSOrderedAscending : NSOrderedDescending;
+        }
+        return [costs[rhs.unsignedIntegerValue] compare:costs[lhs.unsignedIntegerValue]];
+    }];
+
+    return indexes;
+}
+
+- (NSArray<TWTRMemoryPressureRegistration *> *)registrationSnapshot
+{
+    @synchronized(self)
+    {
+        return [self.registrations allValues];
+    }
+}
+
+@end
@@ -37,6 +37,7 @@
 
 @interface TWTRSessionStore ()
 
++ (dispatch_queue_t)concurrentSessionQueue;
 - (void)destroyAllSessions;
 
 @end
@@ -546,6 +547,79 @@
     XCTAssertEqual([[self.sessionStore existingUserSessions] count], 1);
 }
 
+- (void)testStoreSession_isVisibleBeforePersistenceCompletes
+{
+    [self.sessionStore saveSession:self.userSession withVerification:NO completion:^(id<TWTRAuthSession> s, NSError *e){
+    }];
+
+    XCTAssertEqualObjects([self.sessionStore sessionForUserID:self.userSession.userID], self.userSession);
+    XCTAssertEqualObjects([self.sessionStore sessionWithSessionID:self.userSession.userID], self.userSession);
+    XCTAssertEqualObjects([self.sessionStore existingUserSessions], @[self.userSession]);
+}
+
+- (void)testStoreSession_replacesExistingSessionForSameUser
+{
+    TWTRSession *firstSession = [[TWTRSession alloc] initWithSessionDictionary:@{ TWTRAuthOAuthTokenKey: @"first_token", TWTRAuthOAuthSecretKey: @"first_secret", TWTRAuthAppOAuthScreenNameKey: @"screen_name", TWTRAuthAppOAuthUserIDKey: @"2" }];
+    TWTRSession *otherSession = [[TWTRSession alloc] initWithSessionDictionary:@{ TWTRAuthOAuthTokenKey: @"second_token", TWTRAuthOAuthSecretKey: @"second_secret", TWTRAuthAppOAuthScreenNameKey: @"screen_name", TWTRAuthAppOAuthUserIDKey: @"2" }];
+
+    [self.sessionStore saveSession:firstSession withVerification:NO completion:^(id<TWTRAuthSession> s, NSError *e){
+    }];
+    [self.sessionStore saveSession:self.userSession withVerification:NO completion:^(id<TWTRAuthSession> s, NSError *e){
+    }];
+    [self.sessionStore saveSession:otherSession withVerification:NO completion:^(id<TWTRAuthSession> s, NSError *e){
+    }];
+
+    NSArray *expectedSessions = @[self.userSession, otherSession];
+    XCTAssertEqualObjects([self.sessionStore existingUserSessions], expectedSessions);
+    XCTAssertEqual([self.sessionStore sessionForUserID:@"2"], otherSession);
+}
+
+- (void)testRemoveSession_isHiddenBeforeDeletionCompletes
+{
+    [self.sessionStore saveSession:self.userSession withVerification:NO completion:^(id<TWTRAuthSession> s, NSError *e){
+    }];
+    [self.sessionStore logOutUserID:self.userSession.userID];
+
+    XCTAssertNil([self.sessionStore sessionForUserID:self.userSession.userID]);
+    XCTAssertFalse([self.sessionStore hasLoggedInUsers]);
+}
+
+- (void)testSessionReads_areConsistentDuringConcurrentWrites
+{
+    NSMutableArray *sessions = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 20; i++) {
+        NSString *userID = [NSString stringWithFormat:@"%lu", (unsigned long)(100 + i)];
+        [sessions addObject:[[TWTRSession alloc] initWithSessionDictionary:@{ TWTRAuthOAuthTokenKey: @"token", TWTRAuthOAuthSecretKey: @"secret", TWTRAuthAppOAuthScreenNameKey: @"screen_name", TWTRAuthAppOAuthUserIDKey: userID }]];
+    }
+
+    dispatch_apply(sessions.count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t index) {
+        TWTRSession *session = sessions[index];
+        [self.sessionStore saveSession:session withVerification:NO completion:^(id<TWTRAuthSession> s, NSError *e){
+        }];
+
+        NSArray *existingSessions = [self.sessionStore existingUserSessions];
+        XCTAssertTrue([existingSessions containsObject:session]);
+        XCTAssertEqual([self.sessionStore sessionForUserID:session.userID], session);
+    });
+
+    XCTAssertEqual([[self.sessionStore existingUserSessions] count], sessions.count);
+}
+
+- (void)testFirstRead_loadsKeychainWhenCalledFromSessionQueue
+{
+    [self.sessionStore saveSession:self.userSession withVerification:NO completion:^(id<TWTRAuthSession> s, NSError *e){
+    }];
+
+    // The new store's initial load is queued behind this barrier, so waiting for it here would never return
+    __block NSArray *sessions;
+    dispatch_barrier_sync([TWTRSessionStore concurrentSessionQueue], ^{
+        TWTRSessionStore *store = [self instantiateSessionStore];
+        sessions = [store existingUserSessions];
+    });
+
+    XCTAssertEqualObjects(sessions, @[self.userSession]);
+}
+
 #pragma mark - Custom Hooks
 
 - (void)testSaveSessionWithoutVerification_invokesSessionSavedCompletion
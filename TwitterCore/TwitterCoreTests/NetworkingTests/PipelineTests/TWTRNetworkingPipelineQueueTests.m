@@ -17,6 +17,7 @@
 
 #import <Foundation/Foundation.h>
 #import <XCTest/XCTest.h>
+#import "TWTRAPIErrorCode.h"
 #import "TWTRAuthenticationConstants.h"
 #import "TWTRGuestSession.h"
 #import "TWTRMockURLSessionProtocol.h"
@@ -24,6 +25,7 @@
 #import "TWTRNetworkingPipelinePackage.h"
 #import "TWTRNetworkingPipelineQueue.h"
 #import "TWTRPipelineSessionMock.h"
+#import "TWTRRateLimitTracker.h"
 #import "TWTRSession.h"
 #import "TWTRSessionFixtureLoader.h"
 #import "TWTRSessionStore.h"
@@ -477,6 +479,65 @@
     [self waitForExpectationsWithTimeout:1 handler:nil];
 }
 
+#pragma mark - Rate Limiting
+- (void)testTooManyRequestsResponseIsRetried
+{
+    [TWTRMockURLSessionProtocol pushResponse:[TWTRMockURLResponse responseWithString:@"slow down" statusCode:429 headerFields:@{ @"Retry-After": @"0" }]];
+    [TWTRMockURLSessionProtocol pushResponse:[TWTRMockURLResponse responseWithString:@"Success"]];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"should retry request"];
+    self.sessionStoreMock.guestSession = [self guestSession];
+
+    TWTRNetworkingPipelinePackage *package = [self guestPackageWithCompletion:^(NSData *data, NSURLResponse *response, NSError *error) {
+        XCTAssertEqual([(NSHTTPURLResponse *)response statusCode], 200);
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+
+    [self.noValidatorQueue enqueuePipelinePackage:package];
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
+- (void)testBackgroundRequestIsNotRetried
+{
+    [TWTRMockURLSessionProtocol pushResponse:[TWTRMockURLResponse responseWithString:@"slow down" statusCode:503 headerFields:@{ @"Retry-After": @"0" }]];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"should not retry request"];
+    self.sessionStoreMock.guestSession = [self guestSession];
+
+    TWTRNetworkingPipelinePackage *package = [TWTRNetworkingPipelinePackage packageWithRequest:self.twitterRequest sessionStore:self.sessionStoreMock userID:nil priority:TWTRNetworkingPipelinePriorityBackground completion:^(NSData *data, NSURLResponse *response, NSError *error) {
+        XCTAssertEqual([(NSHTTPURLResponse *)response statusCode], 503);
+        [expectation fulfill];
+    }];
+
+    [self.noValidatorQueue enqueuePipelinePackage:package];
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
+- (void)testBackgroundRequestIsShedWhenBudgetIsExhausted
+{
+    NSString *reset = [@((long long)[[NSDate dateWithTimeIntervalSinceNow:900] timeIntervalSince1970]) stringValue];
+    NSDictionary *headers = @{ @"x-rate-limit-limit": @"15", @"x-rate-limit-remaining": @"0", @"x-rate-limit-reset": reset };
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.twitterRequest.URL statusCode:200 HTTPVersion:@"HTTP/1.1" headerFields:headers];
+    [self.guestQueue.rateLimitTracker updateWithResponse:response forRequest:self.twitterRequest];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"should shed request"];
+    self.sessionStoreMock.guestSession = [self guestSession];
+
+    TWTRNetworkingPipelinePackage *package = [TWTRNetworkingPipelinePackage packageWithRequest:self.twitterRequest sessionStore:self.sessionStoreMock userID:nil priority:TWTRNetworkingPipelinePriorityBackground completion:^(NSData *data, NSURLResponse *receivedResponse, NSError *error) {
+        XCTAssertNil(receivedResponse);
+        XCTAssertEqualObjects(error.domain, TWTRAPIErrorDomain);
+        XCTAssertEqual(error.code, TWTRAPIErrorCodeRateLimitExceeded);
+        [expectation fulfill];
+    }];
+
+    [self.guestQueue enqueuePipelinePackage:package];
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
 #pragma mark - Error Tests
 - (void)testCorrectErrorReturnedWhenFetchFails
 {
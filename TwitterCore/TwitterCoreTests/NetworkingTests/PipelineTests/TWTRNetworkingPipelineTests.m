@@ -181,4 +181,49 @@
     [self waitForExpectationsWithTimeout:1.0 handler:nil];
 }
 
+- (void)testSuspend_holdsRequestsUntilResumed
+{
+    id mock = OCMPartialMock(self.pipeline.guestQueue);
+    [[mock reject] enqueuePipelinePackage:OCMOCK_ANY];
+
+    [self.pipeline suspend];
+    [self.pipeline suspend];
+    [self.pipeline enqueueRequest:self.twitterRequest sessionStore:self.sessionStoreMock];
+    [self.pipeline resume];
+
+    OCMVerifyAll(mock);
+    [mock stopMocking];
+
+    mock = OCMPartialMock(self.pipeline.guestQueue);
+    OCMExpect([mock enqueuePipelinePackage:[OCMArg checkWithBlock:^BOOL(TWTRNetworkingPipelinePackage *package) {
+                        return [package.request isEqual:self.twitterRequest];
+                    }]]);
+
+    [self.pipeline resume];
+
+    OCMVerifyAll(mock);
+    [mock stopMocking];
+}
+
+- (void)testCancelWhileSuspended_invokesCallbackWithCancelledError
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"wait for cancel"];
+    id mock = OCMPartialMock(self.pipeline.guestQueue);
+    [[mock reject] enqueuePipelinePackage:OCMOCK_ANY];
+
+    [self.pipeline suspend];
+    NSProgress *progress = [self.pipeline enqueueRequest:self.twitterRequest sessionStore:self.sessionStoreMock requestingUser:nil completion:^(NSData *data, NSURLResponse *response, NSError *error) {
+        XCTAssertEqualObjects(error.domain, NSURLErrorDomain);
+        XCTAssertEqual(error.code, NSURLErrorCancelled);
+        [expectation fulfill];
+    }];
+
+    [progress cancel];
+    [self.pipeline resume];
+
+    [self waitForExpectationsWithTimeout:1.0 handler:nil];
+    OCMVerifyAll(mock);
+    [mock stopMocking];
+}
+
 @end
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+#import "TWTRAPIErrorCode.h"
+#import "TWTRRateLimitTracker.h"
+
+@interface TWTRRateLimitTrackerTests : XCTestCase
+
+@property (nonatomic) TWTRRateLimitTracker *tracker;
+@property (nonatomic) NSURLRequest *request;
+
+@end
+
+@implementation TWTRRateLimitTrackerTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.tracker = [[TWTRRateLimitTracker alloc] initWithLowBudgetFraction:0.1 maximumDelay:60];
+    self.request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://api.twitter.com/1.1/statuses/lookup.json?id=20"]];
+}
+
+#pragma mark - Endpoints
+
+- (void)testEndpointIgnoresNumericComponentsAndExtension
+{
+    NSString *first = [TWTRRateLimitTracker endpointForURL:[NSURL URLWithString:@"https://api.twitter.com/1.1/statuses/show/20.json"]];
+    NSString *second = [TWTRRateLimitTracker endpointForURL:[NSURL URLWithString:@"https://api.twitter.com/1.1/statuses/show/21.json?include_entities=1"]];
+
+    XCTAssertEqualObjects(first, second);
+    XCTAssertEqualObjects(first, @"api.twitter.com/1.1/statuses/show/:id");
+}
+
+- (void)testEndpointDistinguishesPaths
+{
+    NSString *lookup = [TWTRRateLimitTracker endpointForURL:[NSURL URLWithString:@"https://api.twitter.com/1.1/statuses/lookup.json"]];
+    NSString *timeline = [TWTRRateLimitTracker endpointForURL:[NSURL URLWithString:@"https://api.twitter.com/1.1/statuses/user_timeline.json"]];
+
+    XCTAssertNotEqualObjects(lookup, timeline);
+}
+
+#pragma mark - Decisions
+
+- (void)testUnknownEndpointIsSent
+{
+    XCTAssertEqual([self.tracker decisionForRequest:self.request priority:TWTRNetworkingPipelinePriorityBackground delay:NULL], TWTRRateLimitDecisionSend);
+}
+
+- (void)testHealthyBudgetIsSent
+{
+    [self recordLimit:100 remaining:50 resetIn:600 statusCode:200];
+
+    XCTAssertEqual([self.tracker decisionForRequest:self.request priority:TWTRNetworkingPipelinePriorityBackground delay:NULL], TWTRRateLimitDecisionSend);
+}
+
+- (void)testLowBudgetShedsBackgroundRequestsWhenResetIsFar
+{
+    [self recordLimit:100 remaining:5 resetIn:600 statusCode:200];
+
+    XCTAssertEqual([self.tracker decisionForRequest:self.request priority:TWTRNetworkingPipelinePriorityBackground delay:NULL], TWTRRateLimitDecisionShed);
+    XCTAssertEqual([self.tracker decisionForRequest:self.request priority:TWTRNetworkingPipelinePriorityDefault delay:NULL], TWTRRateLimitDecisionSend);
+}
+
+- (void)testLowBudgetDelaysBackgroundRequestsWhenResetIsNear
+{
+    [self recordLimit:100 remaining:5 resetIn:10 statusCode:200];
+
+    NSTimeInterval delay = 0;
+    XCTAssertEqual([self.tracker decisionForRequest:self.request priority:TWTRNetworkingPipelinePriorityBackground delay:&delay], TWTRRateLimitDecisionDelay);
+    XCTAssertGreaterThan(delay, 0);
+    XCTAssertLessThanOrEqual(delay, 10);
+}
+
+- (void)testExhaustedBudgetDelaysInteractiveRequests
+{
+    [self recordLimit:100 remaining:0 resetIn:10 statusCode:200];
+
+    NSTimeInterval delay = 0;
+    XCTAssertEqual([self.tracker decisionForRequest:self.request priority:TWTRNetworkingPipelinePriorityInteractive delay:&delay], TWTRRateLimitDecisionDelay);
+    XCTAssertGreaterThan(delay, 0);
+}
+
+- (void)testExhaustedBudgetShedsWhenResetIsFar
+{
+    [self recordLimit:100 remaining:0 resetIn:600 statusCode:200];
+
+    XCTAssertEqual([self.tracker decisionForRequest:self.request priority:TWTRNetworkingPipelinePriorityInteractive delay:NULL], TWTRRateLimitDecisionShed);
+}
+
+- (void)testTooManyRequestsResponseExhaustsBudget
+{
+    [self recordLimit:100 remaining:40 resetIn:600 statusCode:429];
+
+    XCTAssertEqual([self.tracker decisionForRequest:self.request priority:TWTRNetworkingPipelinePriorityDefault delay:NULL], TWTRRateLimitDecisionShed);
+}
+
+- (void)testAdmittedRequestsConsumeBudget
+{
+    [self recordLimit:10 remaining:2 resetIn:600 statusCode:200];
+
+    XCTAssertEqual([self.tracker decisionForRequest:self.request priority:TWTRNetworkingPipelinePriorityDefault delay:NULL], TWTRRateLimitDecisionSend);
+    XCTAssertEqual([self.tracker decisionForRequest:self.request priority:TWTRNetworkingPipelinePriorityDefault delay:NULL], TWTRRateLimitDecisionSend);
+    XCTAssertEqual([self.tracker decisionForRequest:self.request priority:TWTRNetworkingPipelinePriorityDefault delay:NULL], TWTRRateLimitDecisionShed);
+}
+
+- (void)testExpiredBudgetIsForgotten
+{
+    [self recordLimit:100 remaining:0 resetIn:-1 statusCode:200];
+
+    XCTAssertEqual([self.tracker decisionForRequest:self.request priority:TWTRNetworkingPipelinePriorityBackground delay:NULL], TWTRRateLimitDecisionSend);
+}
+
+- (void)testBudgetsAreTrackedPerEndpoint
+{
+    [self recordLimit:100 remaining:0 resetIn:600 statusCode:200];
+    NSURLRequest *otherRequest = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://api.twitter.com/1.1/search/tweets.json"]];
+
+    XCTAssertEqual([self.tracker decisionForRequest:otherRequest priority:TWTRNetworkingPipelinePriorityBackground delay:NULL], TWTRRateLimitDecisionSend);
+}
+
+#pragma mark - Backoff
+
+- (void)testRetryableResponses
+{
+    XCTAssertTrue([TWTRRateLimitTracker isRetryableResponse:[self responseWithStatusCode:429 headers:@{}]]);
+    XCTAssertTrue([TWTRRateLimitTracker isRetryableResponse:[self responseWithStatusCode:503 headers:@{}]]);
+    XCTAssertFalse([TWTRRateLimitTracker isRetryableResponse:[self responseWithStatusCode:500 headers:@{}]]);
+    XCTAssertFalse([TWTRRateLimitTracker isRetryableResponse:nil]);
+}
+
+- (void)testBackoffHonorsRetryAfterSeconds
+{
+    NSHTTPURLResponse *response = [self responseWithStatusCode:503 headers:@{ @"Retry-After": @"7" }];
+
+    XCTAssertEqualWithAccuracy([self.tracker backoffIntervalForResponse:response attempt:1], 7, 0.001);
+}
+
+- (void)testBackoffGrowsExponentiallyWithJitter
+{
+    NSHTTPURLResponse *response = [self responseWithStatusCode:503 headers:@{}];
+
+    for (NSInteger attempt = 1; attempt <= 4; attempt++) {
+        NSTimeInterval ceiling = pow(2, attempt - 1);
+        NSTimeInterval backoff = [self.tracker backoffIntervalForResponse:response attempt:attempt];
+        XCTAssertGreaterThanOrEqual(backoff, ceiling / 2);
+        XCTAssertLessThanOrEqual(backoff, ceiling);
+    }
+}
+
+- (void)testBackoffIsCappedAtMaximumDelay
+{
+    NSHTTPURLResponse *response = [self responseWithStatusCode:503 headers:@{}];
+
+    XCTAssertLessThanOrEqual([self.tracker backoffIntervalForResponse:response attempt:20], self.tracker.maximumDelay);
+}
+
+- (void)testRateLimitExceededError
+{
+    NSError *error = [TWTRRateLimitTracker rateLimitExceededErrorForRequest:self.request];
+
+    XCTAssertEqualObjects(error.domain, TWTRAPIErrorDomain);
+    XCTAssertEqual(error.code, TWTRAPIErrorCodeRateLimitExceeded);
+}
+
+#pragma mark - Helpers
+
+- (void)recordLimit:(NSInteger)limit remaining:(NSInteger)remaining resetIn:(NSTimeInterval)resetInterval statusCode:(NSInteger)statusCode
+{
+    NSTimeInterval reset = [[NSDate dateWithTimeIntervalSinceNow:resetInterval] timeIntervalSince1970];
+    NSDictionary *headers = @{ @"x-rate-limit-limit": [@(limit) stringValue], @"x-rate-limit-remaining": [@(remaining) stringValue], @"x-rate-limit-reset": [@((long long)reset) stringValue] };
+    [self.tracker updateWithResponse:[self responseWithStatusCode:statusCode headers:headers] forRequest:self.request];
+}
+
+- (NSHTTPURLResponse *)responseWithStatusCode:(NSInteger)statusCode headers:(NSDictionary *)headers
+{
+    return [[NSHTTPURLResponse alloc] initWithURL:self.request.URL statusCode:statusCode HTTPVersion:@"HTTP/1.1" headerFields:headers];
+}
+
+@end
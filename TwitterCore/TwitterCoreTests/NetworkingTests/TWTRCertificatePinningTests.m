@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <CommonCrypto/CommonDigest.h>
+#import <Security/Security.h>
+#import <XCTest/XCTest.h>
+#import "TWTRCertificatePinning.h"
+#import "TWTRServerTrustEvaluator.h"
+
+// Self-signed RSA CA and a leaf it issued, DER encoded.
+static NSString *const TWTRFixtureCACertificate =
+    @"MIIDJzCCAg+gAwIBAgIUHGtfUl4lJSnNdZT0Jt6CO6m1XsQwDQYJKoZIhvcNAQELBQAwIjEgMB4G"
+    @"A1UEAwwXVHdpdHRlcktpdCBUZXN0IFJvb3QgQ0EwIBcNMjYxMDE5MDg0NTM0WhgPMjEyNjA5MjUw"
+    @"ODQ1MzRaMCIxIDAeBgNVBAMMF1R3aXR0ZXJLaXQgVGVzdCBSb290IENBMIIBIjANBgkqhkiG9w0B"
+    @"AQEFAAOCAQ8AMIIBCgKCAQEAu4QCSg2OkF25s497/n1iWext2a7ZWmfnkQqtd3s855qM9HBmrGnr"
+    @"Xy/HpB1zH2Ka7k1GH35xTOxNpqpJiW9SuSgzteGKW44/ViMqZMqPaQkIANmx65cp6n5YKQXx9rfo"
+    @"ddZnxlgE4OneuX/rFWrm9ijXsgB0zCfP/GYYH1YTe0n8bcp3Aed5bQzx5HlNt/s1jPQ04OuyTIfF"
+    @"kPYrXWO29k3YElIncslPg6CJKa3vo4HLzcAHW0C+a0D1zPBt2Zlb98/t0mgS9Pk1IZckSXk6esWd"
+    @"mErUop1O7hXk1A3purcXPFtlMJX5o4iT/uwoZI/gN8v86ZQ5SCDXS44Y6ba03wIDAQABo1MwUTAd"
+    @"BgNVHQ4EFgQULpfN+Q195F/Cm1kLBm/8tOmLGOEwHwYDVR0jBBgwFoAULpfN+Q195F/Cm1kLBm/8"
+    @"tOmLGOEwDwYDVR0TAQH/BAUwAwEB/zANBgkqhkiG9w0BAQsFAAOCAQEApIUsW5TfRxC5DxqCEDeg"
+    @"j2tUYVYx+4Jp82iZAzjPHSqE9f1BfgNZXBkE5/EzMeHX1fxi58+DmEzaniu7Zzz1A9aUSxqQyf96"
+    @"u60C1y1U7wSHAijL1q/hJUZmnkz3yz1Uy01G2+NkXeCav6bj5HKtTSBPWC+5kohazZ+9ISUtSGXa"
+    @"0Dn6f3glZ0s7jzbaEzKAPs7ftMsbQoNlkg3wfuPDs+2lvfe6U8dioIFUPB0/IaZMLNggOF2ZfI/R"
+    @"bvwt8uEQB1Cg3x2zoSMGNQZEu6RGhnHy02wtznWvwb0Pgth9rLtuEJKX3iyi72nAGcz/n64FI1jy"
+    @"ExeglyeUya8emZ+Bxw==";
+
+static NSString *const TWTRFixtureLeafCertificate =
+    @"MIICxjCCAa4CFAGEdkycrqpOY3P59JdHPEy1AYzrMA0GCSqGSIb3DQEBCwUAMCIxIDAeBgNVBAMM"
+    @"F1R3aXR0ZXJLaXQgVGVzdCBSb290IENBMCAXDTI2MTAxOTA4NDUzNFoYDzIxMjYwOTI1MDg0NTM0"
+    @"WjAbMRkwFwYDVQQDDBBhcGkudHdpdHRlci50ZXN0MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIB"
+    @"CgKCAQEAlHPjv5/cpRpmrUmW9Pcw7hf7NRV6ARlbpu3T0QXBThulvrt3OCfTxdCTi5Va+k/zPSIp"
+    @"tQz0Y4juvbKnm6yjs9lq+PlUdukcnLIrmMsoLylcM6O7XM6ARX9NdMC01bg+xa2/go0OtJM2EORu"
+    @"6K2ooAEgU1zqI0FL6zoUSfSffvD+a1Ffg2/1lxmz1ItxeMVi0E8ItoVmtR1ji6JZTSG3foMvHRrc"
+    @"dRM6rgl2+Z1qM7WUc/HaTULrwCBhIBGzMLT2vddHsBuHZj1D1O/yIZ+91Uc9SfVqX9U5PGJos5lb"
+    @"UtE2HNRf5pgp1VEIccm9u1F1kWxhYG3x14bm1pb4Gogf5QIDAQABMA0GCSqGSIb3DQEBCwUAA4IB"
+    @"AQC0b5qL/htmIqmPxN88HWEu67VaS/fS6GAWp+7DEhkJbxM5+Xd2Hj8MpMQOjzSHcSGtoeSXPUxv"
+    @"lZlNoLIxnJtOMLRGnqEyQu9QXbquDwv5rXG2uHcPnlrv6mFsnBsUllX9oeIodGYbbX7e3xR9I6+w"
+    @"FwrT4cjnT2up5pgVhx2SM9h8jnB8dRNsUo/dGjul1OMT2j4czhk6ngeNVW3VGY/8sUhzJMZ2QoPm"
+    @"dNcrhXVl75uBalXjPWMeZZ/ifvHUImEJO9c1fsQPjQu5r53hDmuG4xcePdjQUOqz4MAfZNWb48Q+"
+    @"QZgh/b13ot4vwrHq6YtEjcFzwhKucQttpDxL1ZHv";
+
+// SHA-1 of each certificate's SubjectPublicKeyInfo.
+static const char *const TWTRFixtureCAPin = "499283345a0242485070adf99f1ba20492be184c";
+static const char *const TWTRFixtureLeafPin = "494af153160c314c7c4999ad69d9cada2272c2e0";
+
+static const NSUInteger TWTRBenchmarkIterations = 10000;
+
+@interface TWTRCertificatePinningTests : XCTestCase
+
+@property (nonatomic) NSData *caData;
+@property (nonatomic) NSData *leafData;
+
+@end
+
+@implementation TWTRCertificatePinningTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.caData = [[NSData alloc] initWithBase64EncodedString:TWTRFixtureCACertificate options:0];
+    self.leafData = [[NSData alloc] initWithBase64EncodedString:TWTRFixtureLeafCertificate options:0];
+}
+
+#pragma mark - Pin Set
+
+- (void)testCreate_collapsesDuplicatePins
+{
+    const char *pins[] = {TWTRFixtureCAPin, "499283345A0242485070ADF99F1BA20492BE184C", TWTRFixtureLeafPin};
+    TWTRPinSet *pinSet = TWTRPinSetCreateWithHexDigests(pins, 3);
+
+    XCTAssertEqual(TWTRPinSetGetCount(pinSet), 2);
+    TWTRPinSetFree(pinSet);
+}
+
+- (void)testCreate_rejectsMalformedPins
+{
+    const char *wrongLength[] = {"499283345a02"};
+    const char *notHex[] = {"z99283345a0242485070adf99f1ba20492be184c"};
+
+    XCTAssertTrue(TWTRPinSetCreateWithHexDigests(wrongLength, 1) == NULL);
+    XCTAssertTrue(TWTRPinSetCreateWithHexDigests(notHex, 1) == NULL);
+}
+
+- (void)testContainsDigest
+{
+    const char *pins[] = {TWTRFixtureLeafPin, TWTRFixtureCAPin};
+    TWTRPinSet *pinSet = TWTRPinSetCreateWithHexDigests(pins, 2);
+    uint8_t digest[TWTR_PIN_DIGEST_LENGTH] = {0x49, 0x92, 0x83, 0x34, 0x5a, 0x02, 0x42, 0x48, 0x50, 0x70, 0xad, 0xf9, 0x9f, 0x1b, 0xa2, 0x04, 0x92, 0xbe, 0x18, 0x4c};
+
+    XCTAssertTrue(TWTRPinSetContainsDigest(pinSet, digest));
+    digest[TWTR_PIN_DIGEST_LENGTH - 1] ^= 0xFF;
+    XCTAssertFalse(TWTRPinSetContainsDigest(pinSet, digest));
+    TWTRPinSetFree(pinSet);
+}
+
+#pragma mark - Certificates
+
+- (void)testGetSubjectPublicKeyInfo_matchesPinnedDigest
+{
+    size_t offset = 0;
+    size_t length = 0;
+    XCTAssertTrue(TWTRCertificateGetSubjectPublicKeyInfo(self.caData.bytes, self.caData.length, &offset, &length));
+    XCTAssertEqual(length, 294);
+
+    unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+    CC_SHA1((const uint8_t *)self.caData.bytes + offset, (CC_LONG)length, digest);
+    const char *pins[] = {TWTRFixtureCAPin};
+    TWTRPinSet *pinSet = TWTRPinSetCreateWithHexDigests(pins, 1);
+
+    XCTAssertTrue(TWTRPinSetContainsDigest(pinSet, digest));
+    TWTRPinSetFree(pinSet);
+}
+
+- (void)testGetSubjectPublicKeyInfo_rejectsTruncatedCertificates
+{
+    size_t offset = 0;
+    size_t length = 0;
+
+    for (NSUInteger truncatedLength = 0; truncatedLength < 256; truncatedLength++) {
+        XCTAssertFalse(TWTRCertificateGetSubjectPublicKeyInfo(self.leafData.bytes, truncatedLength, &offset, &length));
+    }
+}
+
+- (void)testMatchesCertificate
+{
+    const char *pins[] = {TWTRFixtureCAPin};
+    TWTRPinSet *pinSet = TWTRPinSetCreateWithHexDigests(pins, 1);
+
+    XCTAssertTrue(TWTRPinSetMatchesCertificate(pinSet, self.caData.bytes, self.caData.length));
+    XCTAssertFalse(TWTRPinSetMatchesCertificate(pinSet, self.leafData.bytes, self.leafData.length));
+    TWTRPinSetFree(pinSet);
+}
+
+#pragma mark - Evaluator
+
+- (void)testEvaluateServerTrust_rejectsUnpinnedChain
+{
+    SecTrustRef trust = [self createFixtureTrust];
+    TWTRServerTrustEvaluator *evaluator = [[TWTRServerTrustEvaluator alloc] init];
+
+    XCTAssertFalse([evaluator evaluateServerTrust:trust forDomain:@"api.twitter.com"]);
+    CFRelease(trust);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testPerformance_matchChain
+{
+    const char *pins[] = {TWTRFixtureCAPin};
+    TWTRPinSet *pinSet = TWTRPinSetCreateWithHexDigests(pins, 1);
+    NSArray<NSData *> *chain = @[self.leafData, self.caData];
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < TWTRBenchmarkIterations; i++) {
+            for (NSData *certificate in chain) {
+                if (TWTRPinSetMatchesCertificate(pinSet, certificate.bytes, certificate.length)) {
+                    break;
+                }
+            }
+        }
+    }];
+    TWTRPinSetFree(pinSet);
+}
+
+- (void)testPerformance_evaluateUnpinnedChain
+{
+    SecTrustRef trust = [self createFixtureTrust];
+    TWTRServerTrustEvaluator *evaluator = [[TWTRServerTrustEvaluator alloc] init];
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < TWTRBenchmarkIterations; i++) {
+            [evaluator evaluateServerTrust:trust forDomain:@"api.twitter.com"];
+        }
+    }];
+    CFRelease(trust);
+}
+
+#pragma mark - Helpers
+
+- (SecTrustRef)createFixtureTrust
+{
+    SecCertificateRef leaf = SecCertificateCreateWithData(NULL, (__bridge CFDataRef)self.leafData);
+    SecCertificateRef ca = SecCertificateCreateWithData(NULL, (__bridge CFDataRef)self.caData);
+    NSArray *certificates = @[(__bridge id)leaf, (__bridge id)ca];
+    SecPolicyRef policy = SecPolicyCreateBasicX509();
+
+    SecTrustRef trust = NULL;
+    SecTrustCreateWithCertificates((__bridge CFArrayRef)certificates, policy, &trust);
+
+    CFRelease(policy);
+    CFRelease(ca);
+    CFRelease(leaf);
+    return trust;
+}
+
+@end
@@ -38,11 +38,13 @@
     _bundlePath = @"TestKit.Resources.bundle";
     self.kitBundle = [TWTRResourcesUtil bundleWithBundlePath:self.bundlePath];
     self.mockResourcesUtil = [OCMockObject mockForClass:[TWTRResourcesUtil class]];
+    [TWTRResourcesUtil resetLocalizedStringTables];
 }
 
 - (void)tearDown
 {
     [self.mockResourcesUtil stopMocking];
+    [TWTRResourcesUtil resetLocalizedStringTables];
 
     [super tearDown];
 }
@@ -108,6 +110,60 @@
     [self.mockResourcesUtil verify];
 }
 
+- (void)testLocalizedStringForKey_resolvesBundleAndStringOnce
+{
+    NSString *key = @"tw__share_tweet";
+    NSString *value = @"Share Tweet";
+
+    id localizedBundleMock = [OCMockObject mockForClass:[NSBundle class]];
+    [[[localizedBundleMock expect] andReturn:value] localizedStringForKey:key value:OCMOCK_ANY table:OCMOCK_ANY];
+
+    [[[[self.mockResourcesUtil expect] classMethod] andReturn:localizedBundleMock] localizedBundleWithBundlePath:self.bundlePath];
+
+    XCTAssertEqualObjects(value, [TWTRResourcesUtil localizedStringForKey:key bundlePath:self.bundlePath]);
+    // The strict mocks would raise if either lookup were repeated
+    XCTAssertEqualObjects(value, [TWTRResourcesUtil localizedStringForKey:key bundlePath:self.bundlePath]);
+
+    [localizedBundleMock verify];
+    [self.mockResourcesUtil verify];
+}
+
+- (void)testLocalizedStringForKey_resolvesAgainAfterLocaleChange
+{
+    NSString *key = @"tw__share_tweet";
+
+    id englishBundleMock = [OCMockObject mockForClass:[NSBundle class]];
+    [[[englishBundleMock expect] andReturn:@"Share Tweet"] localizedStringForKey:key value:OCMOCK_ANY table:OCMOCK_ANY];
+    id frenchBundleMock = [OCMockObject mockForClass:[NSBundle class]];
+    [[[frenchBundleMock expect] andReturn:@"Partager le Tweet"] localizedStringForKey:key value:OCMOCK_ANY table:OCMOCK_ANY];
+
+    [[[[self.mockResourcesUtil expect] classMethod] andReturn:englishBundleMock] localizedBundleWithBundlePath:self.bundlePath];
+    XCTAssertEqualObjects(@"Share Tweet", [TWTRResourcesUtil localizedStringForKey:key bundlePath:self.bundlePath]);
+
+    [[NSNotificationCenter defaultCenter] postNotificationName:NSCurrentLocaleDidChangeNotification object:nil];
+
+    [[[[self.mockResourcesUtil expect] classMethod] andReturn:frenchBundleMock] localizedBundleWithBundlePath:self.bundlePath];
+    XCTAssertEqualObjects(@"Partager le Tweet", [TWTRResourcesUtil localizedStringForKey:key bundlePath:self.bundlePath]);
+
+    [englishBundleMock verify];
+    [frenchBundleMock verify];
+    [self.mockResourcesUtil verify];
+}
+
+- (void)testLocaleChange_resetsPreferredLanguage
+{
+    NSString *originalLanguage = [TWTRCoreLanguage preferredLanguage];
+
+    id mockLocale = [OCMockObject mockForClass:[NSLocale class]];
+    [[[[mockLocale stub] classMethod] andReturn:@[@"fr"]] preferredLanguages];
+    [[NSNotificationCenter defaultCenter] postNotificationName:NSCurrentLocaleDidChangeNotification object:nil];
+    XCTAssertEqualObjects([TWTRCoreLanguage preferredLanguage], @"fr");
+
+    [mockLocale stopMocking];
+    [[NSNotificationCenter defaultCenter] postNotificationName:NSCurrentLocaleDidChangeNotification object:nil];
+    XCTAssertEqualObjects([TWTRCoreLanguage preferredLanguage], originalLanguage);
+}
+
 - (void)xtestLocalizedStringForKey_returnsStringFromFallbackBundleIfNotFound
 {
     NSString *key = @"tw__share_tweet";
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <TwitterCore/TWTRMemoryPressureCoordinator.h>
+#import <UIKit/UIKit.h>
+#import <XCTest/XCTest.h>
+
+@interface TWTRMemoryPressureCoordinatorTests : XCTestCase
+
+@property (nonatomic) NSNotificationCenter *notificationCenter;
+@property (nonatomic) TWTRMemoryPressureCoordinator *coordinator;
+@property (nonatomic) NSMutableDictionary<NSString *, NSNumber *> *costs;
+@property (nonatomic) NSMutableArray<NSString *> *trimmedNames;
+
+@end
+
+@implementation TWTRMemoryPressureCoordinatorTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.notificationCenter = [[NSNotificationCenter alloc] init];
+    self.coordinator = [[TWTRMemoryPressureCoordinator alloc] initWithNotificationCenter:self.notificationCenter];
+    self.costs = [NSMutableDictionary dictionary];
+    self.trimmedNames = [NSMutableArray array];
+}
+
+/**
+ *  Registers a fake cache holding `cost` bytes that frees down to whatever target it is given.
+ */
+- (void)registerCacheNamed:(NSString *)name priority:(TWTRMemoryPurgePriority)priority cost:(NSUInteger)cost
+{
+    self.costs[name] = @(cost);
+
+    TWTRMemoryCostBlock costBlock = ^NSUInteger {
+        return self.costs[name].unsignedIntegerValue;
+    };
+    TWTRMemoryTrimBlock trimBlock = ^(NSUInteger targetCost) {
+        [self.trimmedNames addObject:name];
+        self.costs[name] = @(MIN(targetCost, self.costs[name].unsignedIntegerValue));
+    };
+    [self.coordinator registerCacheNamed:name priority:priority cost:costBlock trim:trimBlock];
+}
+
+- (void)testMemoryBudget_defaultsToSixteenMegabytes
+{
+    XCTAssertEqual(self.coordinator.memoryBudget, 16 * 1024 * 1024);
+}
+
+- (void)testMemoryUsage_reportsEachCache
+{
+    [self registerCacheNamed:@"heights" priority:TWTRMemoryPurgePriorityHigh cost:100];
+    [self registerCacheNamed:@"players" priority:TWTRMemoryPurgePriorityLow cost:2000];
+
+    XCTAssertEqualObjects([self.coordinator memoryUsage], (@{@"heights": @100, @"players": @2000}));
+}
+
+- (void)testRegister_sameNameReplacesCache
+{
+    [self registerCacheNamed:@"heights" priority:TWTRMemoryPurgePriorityHigh cost:100];
+    [self registerCacheNamed:@"heights" priority:TWTRMemoryPurgePriorityHigh cost:50];
+
+    XCTAssertEqualObjects([self.coordinator memoryUsage], @{@"heights": @50});
+}
+
+- (void)testUnregister_removesCache
+{
+    [self registerCacheNamed:@"heights" priority:TWTRMemoryPurgePriorityHigh cost:100];
+    [self.coordinator unregisterCacheNamed:@"heights"];
+    [self.coordinator trimToBudget:0];
+
+    XCTAssertEqualObjects([self.coordinator memoryUsage], @{});
+    XCTAssertEqual(self.trimmedNames.count, 0);
+}
+
+- (void)testTrim_underBudgetLeavesCachesAlone
+{
+    [self registerCacheNamed:@"heights" priority:TWTRMemoryPurgePriorityHigh cost:100];
+    [self registerCacheNamed:@"players" priority:TWTRMemoryPurgePriorityLow cost:200];
+
+    [self.coordinator trimToBudget:300];
+
+    XCTAssertEqual(self.trimmedNames.count, 0);
+}
+
+- (void)testTrim_followsPriorityOrder
+{
+    [self registerCacheNamed:@"players" priority:TWTRMemoryPurgePriorityLow cost:100];
+    [self registerCacheNamed:@"frames" priority:TWTRMemoryPurgePriorityDefault cost:100];
+    [self registerCacheNamed:@"heights" priority:TWTRMemoryPurgePriorityHigh cost:100];
+
+    [self.coordinator trimToBudget:0];
+
+    XCTAssertEqualObjects(self.trimmedNames, (@[@"heights", @"frames", @"players"]));
+}
+
+- (void)testTrim_largestCacheFirstWithinPriority
+{
+    [self registerCacheNamed:@"small" priority:TWTRMemoryPurgePriorityDefault cost:100];
+    [self registerCacheNamed:@"large" priority:TWTRMemoryPurgePriorityDefault cost:500];
+
+    [self.coordinator trimToBudget:0];
+
+    XCTAssertEqualObjects(self.trimmedNames, (@[@"large", @"small"]));
+}
+
+- (void)testTrim_stopsOnceWithinBudget
+{
+    [self registerCacheNamed:@"heights" priority:TWTRMemoryPurgePriorityHigh cost:500];
+    [self registerCacheNamed:@"players" priority:TWTRMemoryPurgePriorityLow cost:400];
+
+    [self.coordinator trimToBudget:400];
+
+    XCTAssertEqualObjects(self.trimmedNames, @[@"heights"]);
+    XCTAssertEqualObjects([self.coordinator memoryUsage], (@{@"heights": @0, @"players": @400}));
+}
+
+- (void)testTrim_onlyTakesExcess
+{
+    [self registerCacheNamed:@"heights" priority:TWTRMemoryPurgePriorityHigh cost:500];
+    [self registerCacheNamed:@"players" priority:TWTRMemoryPurgePriorityLow cost:400];
+
+    [self.coordinator trimToBudget:700];
+
+    XCTAssertEqualObjects([self.coordinator memoryUsage], (@{@"heights": @300, @"players": @400}));
+}
+
+- (void)testTrim_movesOnWhenCacheCannotFree
+{
+    [self registerCacheNamed:@"players" priority:TWTRMemoryPurgePriorityLow cost:400];
+    TWTRMemoryCostBlock cost = ^NSUInteger {
+        return 500;
+    };
+    TWTRMemoryTrimBlock trim = ^(NSUInteger targetCost) {
+    };
+    [self.coordinator registerCacheNamed:@"pinned" priority:TWTRMemoryPurgePriorityHigh cost:cost trim:trim];
+
+    [self.coordinator trimToBudget:500];
+
+    XCTAssertEqualObjects([self.coordinator memoryUsage], (@{@"pinned": @500, @"players": @0}));
+}
+
+- (void)testMemoryWarning_trimsToBudget
+{
+    [self registerCacheNamed:@"heights" priority:TWTRMemoryPurgePriorityHigh cost:500];
+    self.coordinator.memoryBudget = 100;
+
+    [self.notificationCenter postNotificationName:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+
+    XCTAssertEqualObjects([self.coordinator memoryUsage], @{@"heights": @100});
+}
+
+- (void)testEnteringBackground_trimsToBudget
+{
+    [self registerCacheNamed:@"heights" priority:TWTRMemoryPurgePriorityHigh cost:500];
+    self.coordinator.memoryBudget = 0;
+
+    [self.notificationCenter postNotificationName:UIApplicationDidEnterBackgroundNotification object:nil];
+
+    XCTAssertEqualObjects([self.coordinator memoryUsage], @{@"heights": @0});
+}
+
+- (void)testEnteringBackground_keepsCachesWithinBudget
+{
+    [self registerCacheNamed:@"heights" priority:TWTRMemoryPurgePriorityHigh cost:500];
+    [self registerCacheNamed:@"players" priority:TWTRMemoryPurgePriorityLow cost:500];
+
+    [self.notificationCenter postNotificationName:UIApplicationDidEnterBackgroundNotification object:nil];
+
+    XCTAssertEqualObjects([self.coordinator memoryUsage], (@{@"heights": @500, @"players": @500}));
+}
+
+@end
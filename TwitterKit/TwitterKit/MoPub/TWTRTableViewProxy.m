@@ -22,24 +22,52 @@ static NSString *const TWTRMoPubCategoryMethodsPrefix = @"mp_";
 @interface TWTRTableViewProxy ()
 
 @property (nonatomic, readonly) UITableView *tableView;
-@property (nonatomic, copy, readonly) NSArray<NSString *> *selectorsToProxy;
-@property (nonatomic, readonly) BOOL isEnabled;
 
 @end
 
-@implementation TWTRTableViewProxy
+@implementation TWTRTableViewProxy {
+    // Maps each registered `UITableView` selector to its MoPub category counterpart. Only holds
+    // selectors the table view can perform the MoPub version of, resolved once at init.
+    CFMutableDictionaryRef _mopubSelectors;
+}
 
 - (instancetype)initWithTableView:(UITableView *)tableView selectorsToProxy:(NSArray<NSString *> *)selectorsToProxy
 {
     _tableView = tableView;
-    _selectorsToProxy = [selectorsToProxy copy];
-    _isEnabled = NO;
+    _enabled = NO;
+
+    // Selectors are unique, immortal pointers so they can be used as keys and values directly
+    _mopubSelectors = CFDictionaryCreateMutable(kCFAllocatorDefault, (CFIndex)[selectorsToProxy count], NULL, NULL);
+    for (NSString *selectorString in selectorsToProxy) {
+        SEL mopubSelector = NSSelectorFromString([TWTRMoPubCategoryMethodsPrefix stringByAppendingString:selectorString]);
+        if ([tableView respondsToSelector:mopubSelector]) {
+            CFDictionarySetValue(_mopubSelectors, NSSelectorFromString(selectorString), mopubSelector);
+        }
+    }
 
     return self;
 }
 
+- (void)dealloc
+{
+    if (_mopubSelectors) {
+        CFRelease(_mopubSelectors);
+    }
+}
+
+- (SEL)mopubSelectorForSelector:(SEL)selector
+{
+    return _enabled ? (SEL)CFDictionaryGetValue(_mopubSelectors, selector) : NULL;
+}
+
 #pragma mark - NSProxy
 
+- (id)forwardingTargetForSelector:(SEL)selector
+{
+    // Messages that are not rerouted go straight to the table view without building an invocation
+    return [self mopubSelectorForSelector:selector] ? nil : self.tableView;
+}
+
 - (NSMethodSignature *)methodSignatureForSelector:(SEL)selector
 {
     return [self.tableView methodSignatureForSelector:selector];
@@ -47,17 +75,9 @@ static NSString *const TWTRMoPubCategoryMethodsPrefix = @"mp_";
 
 - (void)forwardInvocation:(NSInvocation *)invocation
 {
-    if (self.isEnabled) {
-        NSString *selectorString = NSStringFromSelector(invocation.selector);
-        NSString *mopubSelectorString = [NSString stringWithFormat:@"%@%@", TWTRMoPubCategoryMethodsPrefix, NSStringFromSelector(invocation.selector)];
-        SEL mopubSelector = NSSelectorFromString(mopubSelectorString);
-        const BOOL selectorIsRegistered = [self.selectorsToProxy containsObject:selectorString];
-        const BOOL canInvokeMopubMethods = [self.tableView respondsToSelector:mopubSelector];
-        const BOOL shouldProxySelector = selectorIsRegistered && canInvokeMopubMethods;
-
-        if (shouldProxySelector) {
-            invocation.selector = mopubSelector;
-        }
+    SEL mopubSelector = [self mopubSelectorForSelector:invocation.selector];
+    if (mopubSelector) {
+        invocation.selector = mopubSelector;
     }
     [invocation invokeWithTarget:self.tableView];
 }
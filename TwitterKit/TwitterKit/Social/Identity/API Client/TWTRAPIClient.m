@@ -61,6 +61,7 @@ static NSString *const TWTRAPIConstantsAPIConfigurationPath = @"/1.1/help/config
 static NSString *const TWTRAPIConstantsCreateCardPath = @"/v2/cards/create.json";
 
 static NSString *const TWTRMediaIDStringKey = @"media_id_string";
+static NSString *const TWTRAPIClientRequestPriorityKey = @"TWTRAPIClientRequestPriority";
 
 static id<TWTRSessionStore_Private> TWTRSharedSessionStore = nil;
 
@@ -553,18 +554,22 @@ static id<TWTRSessionStore_Private> TWTRSharedSessionStore = nil;
     TWTRParameterAssertOrReturn(path);
     TWTRParameterAssertOrReturn(tweetID);
 
-    [self postToAPIPath:path
-             parameters:@{@"id": tweetID}
-             completion:^(NSURLResponse *response, NSDictionary *responseDict, NSError *error) {
-                 TWTRTweet *tweet = nil;
+    TWTRJSONRequestCompletion requestCompletion = ^(NSURLResponse *response, NSDictionary *responseDict, NSError *error) {
+        TWTRTweet *tweet = nil;
 
-                 if (responseDict) {
-                     TWTRTweet *newTweet = [[TWTRTweet alloc] initWithJSONDictionary:responseDict];
-                     tweet = [newTweet tweetWithPerspectivalUserID:self.userID];
-                 }
+        if (responseDict) {
+            TWTRTweet *newTweet = [[TWTRTweet alloc] initWithJSONDictionary:responseDict];
+            tweet = [newTweet tweetWithPerspectivalUserID:self.userID];
+        }
 
-                 [self callGenericResponseBlock:completion withObject:tweet error:error];
-             }];
+        [self callGenericResponseBlock:completion withObject:tweet error:error];
+    };
+
+    // Tweet actions are always a response to the user tapping a button
+    [[self class] performWithRequestPriority:TWTRNetworkingPipelinePriorityInteractive
+                                       block:^{
+                                           [self postToAPIPath:path parameters:@{@"id": tweetID} completion:requestCompletion];
+                                       }];
 }
 
 - (void)requestEmailForCurrentUser:(TWTRRequestEmailCompletion)completion;
@@ -790,10 +795,34 @@ static id<TWTRSessionStore_Private> TWTRSharedSessionStore = nil;
 }
 
 - (NSProgress *)sendTwitterRequest:(NSURLRequest *)request queue:(dispatch_queue_t)queue completion:(TWTRNetworkCompletion)completion
+{
+    return [self sendTwitterRequest:request queue:queue priority:[[self class] currentRequestPriority] completion:completion];
+}
+
++ (void)performWithRequestPriority:(TWTRNetworkingPipelinePriority)priority block:(void (^)(void))block
+{
+    TWTRParameterAssertOrReturn(block);
+
+    NSMutableDictionary *threadDictionary = [NSThread currentThread].threadDictionary;
+    id previousPriority = threadDictionary[TWTRAPIClientRequestPriorityKey];
+
+    threadDictionary[TWTRAPIClientRequestPriorityKey] = @(priority);
+    block();
+    threadDictionary[TWTRAPIClientRequestPriorityKey] = previousPriority;
+}
+
++ (TWTRNetworkingPipelinePriority)currentRequestPriority
+{
+    NSNumber *priority = [NSThread currentThread].threadDictionary[TWTRAPIClientRequestPriorityKey];
+    return priority ? priority.integerValue : TWTRNetworkingPipelinePriorityDefault;
+}
+
+- (NSProgress *)sendTwitterRequest:(NSURLRequest *)request queue:(dispatch_queue_t)queue priority:(TWTRNetworkingPipelinePriority)priority completion:(TWTRNetworkCompletion)completion
 {
     return [[[self class] networkingPipeline] enqueueRequest:request
                                                 sessionStore:self.sessionStore
                                               requestingUser:self.userID
+                                                    priority:priority
                                                   completion:^(NSData *data, NSURLResponse *response, NSError *error) {
                                                       dispatch_async(queue, ^{
                                                           // The networking pipeline matches Apple API's by having the completion be (data, response, error) but the public TWTRNetworkCompletion is (response, data, error) so we add this wrapper to swap the values.
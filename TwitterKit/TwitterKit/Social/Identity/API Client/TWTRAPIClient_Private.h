@@ -19,12 +19,12 @@
  This header is private to the Twitter Kit SDK and not exposed for public SDK consumption
  */
 
+#import <TwitterCore/TWTRNetworkingPipeline.h>
 #import "TWTRAPIClient.h"
 #import "TWTRTimelineDataSource.h"
 
 @class TWTRNetworking;
 @class TWTRCardConfiguration;
-@class TWTRNetworkingPipeline;
 @class TWTRTimelineCursor;
 @class TWTRTimelineFilterManager;
 @class TWTRTwitterAPIConfiguration;
@@ -123,6 +123,33 @@ typedef NSArray *_Nonnull (^TWTRTimelineParsedResponseHandler)(id parsedResponse
  */
 - (NSProgress *)sendTwitterRequest:(NSURLRequest *)request queue:(dispatch_queue_t)queue completion:(TWTRNetworkCompletion)completion;
 
+/**
+ *  Sends a Twitter request with the given networking pipeline priority.
+ *
+ *  @param request    The request that will be sent asynchronously.
+ *  @param queue      The queue to dispatch response to.
+ *  @param priority   The priority of the request, background requests may be held back or shed when the rate limit budget runs low.
+ *  @param completion Completion block to be called on response in the specified queue.
+ */
+- (NSProgress *)sendTwitterRequest:(NSURLRequest *)request queue:(dispatch_queue_t)queue priority:(TWTRNetworkingPipelinePriority)priority completion:(TWTRNetworkCompletion)completion;
+
+/**
+ *  Runs `block`, sending the requests it makes through `sendTwitterRequest:queue:completion:` with
+ *  `priority` instead of the default. Lets callers such as timelines tag the requests their data
+ *  sources make through the public API. Only requests sent from within `block` on the calling
+ *  thread are affected.
+ *
+ *  @param priority The priority of the requests sent from `block`.
+ *  @param block    Sends one or more requests.
+ */
++ (void)performWithRequestPriority:(TWTRNetworkingPipelinePriority)priority block:(void (^)(void))block;
+
+/**
+ *  The priority requests sent from the calling thread are given, `TWTRNetworkingPipelinePriorityDefault`
+ *  outside of `performWithRequestPriority:block:`.
+ */
++ (TWTRNetworkingPipelinePriority)currentRequestPriority;
+
 #pragma mark - API: Timelines
 
 /**
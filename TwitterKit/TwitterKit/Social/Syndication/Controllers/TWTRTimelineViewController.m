@@ -17,7 +17,9 @@
 
 #import "TWTRTimelineViewController.h"
 #import <TwitterCore/TWTRMultiThreadUtil.h>
+#import <TwitterCore/TWTRNetworkingPipeline.h>
 #import <TwitterCore/TWTRSessionStore.h>
+#import "TWTRAPIClient_Private.h"
 #import "TWTRCollectionTimelineDataSource.h"
 #import "TWTRNotificationConstants.h"
 #import "TWTRTableViewAdPlacer.h"
@@ -31,11 +33,20 @@
 #import "TWTRTweet.h"
 #import "TWTRTweetTableViewCell.h"
 #import "TWTRTweetView.h"
+#import "TWTRTweetView_Private.h"
+#import "TWTRTweet_Private.h"
 #import "TWTRTwitter_Private.h"
+#import "TWTRVideoPlaybackConfiguration.h"
+#import "TWTRVideoPlayerOutputView.h"
 
 static NSString *const TWTRCellReuseIdentifier = @"TweetCell";
 static CGFloat const TWTREstimatedRowHeight = 150;
 
+/**
+ * How many rows past a row that comes on screen get their videos prerolled, in the scrolling direction.
+ */
+static NSInteger const TWTRVideoPrerollRowLookahead = 2;
+
 @interface TWTRTimelineViewController ()
 
 @property (nonatomic) BOOL isCurrentlyLoading;
@@ -45,6 +56,7 @@ static CGFloat const TWTREstimatedRowHeight = 150;
 @property (nonatomic, readonly) NSArray *tweetNotificationObservers;
 @property (nonatomic) TWTRTableViewAdPlacer *adPlacer;
 @property (nonatomic) TWTRTimelineMessageView *messageView;
+@property (nonatomic) NSInteger lastDisplayedRow;
 
 /**
  *  Proxy object that isolates logic behind checking for MoPub methods need to be called on the
@@ -221,12 +233,16 @@ static CGFloat const TWTREstimatedRowHeight = 150;
     if ([self indexIsBottomCell:indexPath.row]) {
         [self loadPreviousTweets];
     }
+
+    [self prerollVideosAroundRow:indexPath.row displayedInCell:(TWTRTweetTableViewCell *)cell];
 }
 
 - (void)tableView:(UITableView *)tableView didEndDisplayingCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
 {
     TWTRTweetTableViewCell *tableViewCell = (TWTRTweetTableViewCell *)cell;
     [tableViewCell.tweetView pauseVideo];
+
+    [self cancelVideoPrerollsFromRow:indexPath.row];
 }
 
 #pragma mark - Tweet Updates
@@ -269,6 +285,60 @@ static CGFloat const TWTREstimatedRowHeight = 150;
 
 #pragma mark - Internal Methods
 
+/**
+ *  Every row shows its Tweet in the same style at the same width, so the displayed cell measures the
+ *  videos of the rows around it.
+ */
+- (void)prerollVideosAroundRow:(NSInteger)row displayedInCell:(TWTRTweetTableViewCell *)cell
+{
+    const NSInteger step = (row >= self.lastDisplayedRow) ? 1 : -1;
+    self.lastDisplayedRow = row;
+
+    if (![cell isKindOfClass:[TWTRTweetTableViewCell class]]) {
+        return;
+    }
+
+    // Start with the row the furthest away so the preroll that is needed first is requested last, and starts first.
+    for (NSInteger offset = TWTRVideoPrerollRowLookahead; offset >= 0; offset--) {
+        const NSInteger prerolledRow = row + offset * step;
+        if (prerolledRow < 0 || prerolledRow >= (NSInteger)[self countOfTweets]) {
+            continue;
+        }
+
+        TWTRTweet *tweet = [self tweetAtIndex:prerolledRow];
+        if ([tweet hasPlayableVideo]) {
+            TWTRVideoPlaybackConfiguration *configuration = [TWTRVideoPlaybackConfiguration playbackConfigurationForTweet:tweet];
+            if (configuration) {
+                [TWTRVideoPlayerOutputView prerollVideoWithPlaybackConfiguration:configuration renderedPixelSize:[cell.tweetView inlineVideoPixelSizeForTweet:tweet]];
+            }
+        }
+    }
+}
+
+/**
+ *  The row that scrolled away and the rows behind it are no longer about to be shown, so their prerolls
+ *  give their slots back to the rows ahead.
+ */
+- (void)cancelVideoPrerollsFromRow:(NSInteger)row
+{
+    const NSInteger step = (row >= self.lastDisplayedRow) ? 1 : -1;
+
+    for (NSInteger offset = 0; offset <= TWTRVideoPrerollRowLookahead; offset++) {
+        const NSInteger cancelledRow = row + offset * step;
+        if (cancelledRow < 0 || cancelledRow >= (NSInteger)[self countOfTweets]) {
+            continue;
+        }
+
+        TWTRTweet *tweet = [self tweetAtIndex:cancelledRow];
+        if ([tweet hasPlayableVideo]) {
+            TWTRVideoPlaybackConfiguration *configuration = [TWTRVideoPlaybackConfiguration playbackConfigurationForTweet:tweet];
+            if (configuration) {
+                [TWTRVideoPlayerOutputView cancelPrerollWithPlaybackConfiguration:configuration];
+            }
+        }
+    }
+}
+
 - (BOOL)indexIsBottomCell:(NSUInteger)rowIndex
 {
     return (rowIndex == ([self countOfTweets] - 1));
@@ -299,15 +369,18 @@ static CGFloat const TWTREstimatedRowHeight = 150;
 - (void)loadNewestTweets
 {
     self.currentCursor = nil;
-    [self loadTweetsAndReplaceExisting:YES];
+    [self loadTweetsAndReplaceExisting:YES priority:TWTRNetworkingPipelinePriorityInteractive];
 }
 
+/**
+ *  Loads the next page before the user reaches the end of the timeline, so it yields to requests the user is waiting on.
+ */
 - (void)loadPreviousTweets
 {
-    [self loadTweetsAndReplaceExisting:NO];
+    [self loadTweetsAndReplaceExisting:NO priority:TWTRNetworkingPipelinePriorityBackground];
 }
 
-- (void)loadTweetsAndReplaceExisting:(BOOL)replaceExisting
+- (void)loadTweetsAndReplaceExisting:(BOOL)replaceExisting priority:(TWTRNetworkingPipelinePriority)priority
 {
     if (self.isCurrentlyLoading) {
         return;
@@ -322,40 +395,44 @@ static CGFloat const TWTREstimatedRowHeight = 150;
 
     __weak typeof(self.dataSource) weakDataSource = self.dataSource;
     @weakify(self);
-    [self.dataSource loadPreviousTweetsBeforePosition:self.currentCursor.minPosition
-                                           completion:^(NSArray *tweets, TWTRTimelineCursor *cursor, NSError *error) {
-                                               @strongify(self);
-
-                                               // Notify users and developer
-                                               [self.messageView endLoading];
-                                               if ([self.refreshControl isRefreshing]) {
-                                                   [self.refreshControl endRefreshing];
-                                               }
-                                               if ([self.timelineDelegate respondsToSelector:@selector(timeline:didFinishLoadingTweets:error:)]) {
-                                                   [self.timelineDelegate timeline:self didFinishLoadingTweets:tweets error:error];
-                                               }
-
-                                               const BOOL dataSourceWasChangedWhileRequestInFlight = (weakDataSource != self.dataSource);
-                                               if (dataSourceWasChangedWhileRequestInFlight) {
-                                                   return;
-                                               }
-
-                                               self.isCurrentlyLoading = NO;
-                                               if ([tweets count] > 0) {
-                                                   if (replaceExisting) {
-                                                       self.tweets = [NSMutableArray arrayWithArray:tweets];
-                                                   } else {
-                                                       [self.tweets addObjectsFromArray:tweets];
-                                                   }
-                                                   self.currentCursor = cursor;
-                                                   [self.tableViewProxy reloadData];
-
-                                               } else if (error) {
-                                                   NSLog(@"[TwitterKit] Couldn't load Tweets from TWTRTimelineViewController: %@", error);
-                                               } else if ([self countOfTweets] == 0) {
-                                                   [self.messageView endLoadingWithMessage:TWTRLocalizedString(@"tw__empty_timeline")];
-                                               }
-                                           }];
+    TWTRLoadTimelineCompletion completion = ^(NSArray *tweets, TWTRTimelineCursor *cursor, NSError *error) {
+        @strongify(self);
+
+        // Notify users and developer
+        [self.messageView endLoading];
+        if ([self.refreshControl isRefreshing]) {
+            [self.refreshControl endRefreshing];
+        }
+        if ([self.timelineDelegate respondsToSelector:@selector(timeline:didFinishLoadingTweets:error:)]) {
+            [self.timelineDelegate timeline:self didFinishLoadingTweets:tweets error:error];
+        }
+
+        const BOOL dataSourceWasChangedWhileRequestInFlight = (weakDataSource != self.dataSource);
+        if (dataSourceWasChangedWhileRequestInFlight) {
+            return;
+        }
+
+        self.isCurrentlyLoading = NO;
+        if ([tweets count] > 0) {
+            if (replaceExisting) {
+                self.tweets = [NSMutableArray arrayWithArray:tweets];
+            } else {
+                [self.tweets addObjectsFromArray:tweets];
+            }
+            self.currentCursor = cursor;
+            [self.tableViewProxy reloadData];
+
+        } else if (error) {
+            NSLog(@"[TwitterKit] Couldn't load Tweets from TWTRTimelineViewController: %@", error);
+        } else if ([self countOfTweets] == 0) {
+            [self.messageView endLoadingWithMessage:TWTRLocalizedString(@"tw__empty_timeline")];
+        }
+    };
+
+    [TWTRAPIClient performWithRequestPriority:priority
+                                        block:^{
+                                            [self.dataSource loadPreviousTweetsBeforePosition:self.currentCursor.minPosition completion:completion];
+                                        }];
 }
 
 #pragma mark - MoPub Helpers
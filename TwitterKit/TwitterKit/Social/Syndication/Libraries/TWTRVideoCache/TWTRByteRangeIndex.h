@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ This header is private to the Twitter Kit SDK and not exposed for public SDK consumption
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Records which bytes of a resource have been cached, as a set of byte ranges.
+ * Adjacent and overlapping ranges are merged as they are added.
+ *
+ * Note: This class is NOT thread-safe.
+ */
+@interface TWTRByteRangeIndex : NSObject <NSSecureCoding, NSCopying>
+
+/**
+ * The length of the whole resource, or `NSURLResponseUnknownLength` until a
+ * response has said so.
+ */
+@property (nonatomic) long long contentLength;
+
+/**
+ * The MIME type of the resource, if known.
+ */
+@property (nonatomic, copy, nullable) NSString *contentType;
+
+/**
+ * The number of bytes covered by the index.
+ */
+@property (nonatomic, readonly) unsigned long long cachedByteCount;
+
+/**
+ * Whether every byte of the resource is covered. Always NO while the
+ * content length is unknown.
+ */
+@property (nonatomic, readonly, getter=isComplete) BOOL complete;
+
+/**
+ * The cached ranges in ascending order, as `NSValue` wrapped `NSRange`s.
+ */
+@property (nonatomic, readonly) NSArray<NSValue *> *ranges;
+
+/**
+ * Marks the bytes in `range` as cached.
+ */
+- (void)addRange:(NSRange)range;
+
+/**
+ * Whether every byte in `range` is cached. An empty range is always contained.
+ */
+- (BOOL)containsRange:(NSRange)range;
+
+/**
+ * The number of cached bytes starting at `offset` before the first gap.
+ */
+- (NSUInteger)contiguousLengthFromOffset:(NSUInteger)offset;
+
+/**
+ * The first run of bytes in `range` that is not cached, or `{NSNotFound, 0}`
+ * if all of it is.
+ */
+- (NSRange)firstMissingRangeInRange:(NSRange)range;
+
+/**
+ * Forgets every cached range. The content length and type are kept.
+ */
+- (void)removeAllRanges;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRByteRangeIndex.h"
+
+static NSString *const TWTRByteRangeIndexRangesKey = @"ranges";
+static NSString *const TWTRByteRangeIndexContentLengthKey = @"contentLength";
+static NSString *const TWTRByteRangeIndexContentTypeKey = @"contentType";
+
+@interface TWTRByteRangeIndex ()
+
+@property (nonatomic, readonly) NSMutableIndexSet *cachedIndexes;
+
+@end
+
+@implementation TWTRByteRangeIndex
+
+- (instancetype)init
+{
+    return [self initWithCachedIndexes:[NSMutableIndexSet indexSet] contentLength:NSURLResponseUnknownLength contentType:nil];
+}
+
+- (instancetype)initWithCachedIndexes:(NSMutableIndexSet *)cachedIndexes contentLength:(long long)contentLength contentType:(NSString *)contentType
+{
+    self = [super init];
+    if (self) {
+        _cachedIndexes = cachedIndexes;
+        _contentLength = contentLength;
+        _contentType = [contentType copy];
+    }
+    return self;
+}
+
+#pragma mark - Ranges
+
+- (unsigned long long)cachedByteCount
+{
+    return self.cachedIndexes.count;
+}
+
+- (BOOL)isComplete
+{
+    if (self.contentLength < 0) {
+        return NO;
+    }
+
+    return [self containsRange:NSMakeRange(0, (NSUInteger)self.contentLength)];
+}
+
+- (NSArray<NSValue *> *)ranges
+{
+    NSMutableArray<NSValue *> *ranges = [NSMutableArray array];
+    [self.cachedIndexes enumerateRangesUsingBlock:^(NSRange range, BOOL *stop) {
+        [ranges addObject:[NSValue valueWithRange:range]];
+    }];
+    return ranges;
+}
+
+- (void)addRange:(NSRange)range
+{
+    if (range.length > 0) {
+        [self.cachedIndexes addIndexesInRange:range];
+    }
+}
+
+- (BOOL)containsRange:(NSRange)range
+{
+    return range.length == 0 || [self.cachedIndexes containsIndexesInRange:range];
+}
+
+- (NSUInteger)contiguousLengthFromOffset:(NSUInteger)offset
+{
+    __block NSUInteger length = 0;
+
+    [self.cachedIndexes enumerateRangesUsingBlock:^(NSRange range, BOOL *stop) {
+        if (NSLocationInRange(offset, range)) {
+            length = NSMaxRange(range) - offset;
+        }
+        *stop = (NSMaxRange(range) > offset);
+    }];
+
+    return length;
+}
+
+- (NSRange)firstMissingRangeInRange:(NSRange)range
+{
+    if (range.length == 0) {
+        return NSMakeRange(NSNotFound, 0);
+    }
+
+    const NSUInteger end = NSMaxRange(range);
+    __block NSUInteger cursor = range.location;
+    __block NSRange missingRange = NSMakeRange(NSNotFound, 0);
+
+    [self.cachedIndexes enumerateRangesUsingBlock:^(NSRange cachedRange, BOOL *stop) {
+        if (NSMaxRange(cachedRange) <= cursor) {
+            return;
+        }
+
+        if (cachedRange.location > cursor) {
+            NSUInteger missingEnd = MIN(cachedRange.location, end);
+            missingRange = NSMakeRange(cursor, missingEnd - cursor);
+            *stop = YES;
+            return;
+        }
+
+        cursor = NSMaxRange(cachedRange);
+        *stop = (cursor >= end);
+    }];
+
+    if (missingRange.location == NSNotFound && cursor < end) {
+        missingRange = NSMakeRange(cursor, end - cursor);
+    }
+
+    return missingRange;
+}
+
+- (void)removeAllRanges
+{
+    [self.cachedIndexes removeAllIndexes];
+}
+
+#pragma mark - NSCopying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    return [[[self class] allocWithZone:zone] initWithCachedIndexes:[self.cachedIndexes mutableCopy] contentLength:self.contentLength contentType:self.contentType];
+}
+
+#pragma mark - NSSecureCoding
+
++ (BOOL)supportsSecureCoding
+{
+    return YES;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)decoder
+{
+    NSIndexSet *cachedIndexes = [decoder decodeObjectOfClass:[NSIndexSet class] forKey:TWTRByteRangeIndexRangesKey];
+    NSString *contentType = [decoder decodeObjectOfClass:[NSString class] forKey:TWTRByteRangeIndexContentTypeKey];
+
+    if (!cachedIndexes || ![decoder containsValueForKey:TWTRByteRangeIndexContentLengthKey]) {
+        return nil;
+    }
+
+    return [self initWithCachedIndexes:[cachedIndexes mutableCopy] contentLength:[decoder decodeInt64ForKey:TWTRByteRangeIndexContentLengthKey] contentType:contentType];
+}
+
+- (void)encodeWithCoder:(NSCoder *)encoder
+{
+    [encoder encodeObject:self.cachedIndexes forKey:TWTRByteRangeIndexRangesKey];
+    [encoder encodeInt64:self.contentLength forKey:TWTRByteRangeIndexContentLengthKey];
+    [encoder encodeObject:self.contentType forKey:TWTRByteRangeIndexContentTypeKey];
+}
+
+@end
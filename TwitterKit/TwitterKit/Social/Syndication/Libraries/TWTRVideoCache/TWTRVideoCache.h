@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ This header is private to the Twitter Kit SDK and not exposed for public SDK consumption
+ */
+
+#import <Foundation/Foundation.h>
+
+@class TWTRByteRangeIndex;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Persistent disk cache for partially downloaded resources such as video files. Each
+ resource is kept in a sparse file written at the offsets its bytes came from, next
+ to a `TWTRByteRangeIndex` of which bytes have been written. Least recently used
+ resources are evicted to stay within `maxSize`, except those currently in use.
+
+ The on disk index is only written by `synchronizeKey:` and `endUsingKey:`. It can
+ lag behind the data but never claims bytes that were not written.
+
+ This class is thread-safe but blocking.
+ */
+@interface TWTRVideoCache : NSObject
+
+/**
+ * The quota for the cached data, in bytes. Lowering it evicts right away.
+ */
+@property (nonatomic) unsigned long long maxSize;
+
+/**
+ * The number of cached bytes across all resources.
+ */
+@property (nonatomic, readonly) unsigned long long totalSize;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ *  Initializes a cache stored in the given directory.
+ *
+ *  @param path     directory where cached resources are stored
+ *  @param maxSize  quota for the cached data, in bytes
+ *
+ *  @return new instance, or nil if the directory cannot be created
+ */
+- (nullable instancetype)initWithPath:(NSString *)path maxSize:(unsigned long long)maxSize;
+
+/**
+ * The key used to store the resource at `URL`.
+ */
++ (NSString *)keyForURL:(NSURL *)URL;
+
+/**
+ * A copy of the index for `key`. Empty, with an unknown content length, if
+ * nothing is cached for it.
+ */
+- (TWTRByteRangeIndex *)indexForKey:(NSString *)key;
+
+/**
+ * Records the length and type of the resource. If the length changed, the
+ * resource has changed and everything cached for it is dropped.
+ */
+- (void)setContentLength:(long long)contentLength contentType:(nullable NSString *)contentType forKey:(NSString *)key;
+
+/**
+ * Writes `data` at `offset` in the resource for `key`.
+ *
+ * @return whether the data was written
+ */
+- (BOOL)storeData:(NSData *)data forKey:(NSString *)key offset:(unsigned long long)offset;
+
+/**
+ * The bytes in `range` of the resource for `key`, or nil unless all of them are cached.
+ */
+- (nullable NSData *)dataForKey:(NSString *)key range:(NSRange)range;
+
+/**
+ * Protects the resource for `key` from eviction until a matching `endUsingKey:`.
+ * Calls may be nested.
+ */
+- (void)beginUsingKey:(NSString *)key;
+- (void)endUsingKey:(NSString *)key;
+
+/**
+ * Writes the index for `key` to disk if it has changed.
+ */
+- (void)synchronizeKey:(NSString *)key;
+
+/**
+ * Removes every cached resource that is not in use.
+ */
+- (void)removeAllData;
+
+@end
+
+NS_ASSUME_NONNULL_END
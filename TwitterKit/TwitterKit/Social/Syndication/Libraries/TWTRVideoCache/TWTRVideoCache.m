@@ -0,0 +1,380 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRVideoCache.h"
+#import <CommonCrypto/CommonDigest.h>
+#import "TWTRByteRangeIndex.h"
+#import "TWTRVideoCacheEvictionPolicy.h"
+
+static NSString *const TWTRVideoCacheDataExtension = @"data";
+static NSString *const TWTRVideoCacheIndexExtension = @"index";
+
+@interface TWTRVideoCache ()
+
+@property (nonatomic, copy, readonly) NSString *path;
+@property (nonatomic, readonly) TWTRVideoCacheEvictionPolicy *evictionPolicy;
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, TWTRByteRangeIndex *> *indexes;
+@property (nonatomic, readonly) NSMutableSet<NSString *> *unsynchronizedKeys;
+
+/**
+ * Keys whose data turned out to be damaged while they were in use. Their files are removed once
+ * the last user is done with them rather than out from under an active playback.
+ */
+@property (nonatomic, readonly) NSMutableSet<NSString *> *damagedKeys;
+@property (nonatomic) BOOL didLoadStoredIndexes;
+
+@end
+
+@implementation TWTRVideoCache
+
+- (instancetype)initWithPath:(NSString *)path maxSize:(unsigned long long)maxSize
+{
+    if (!path) {
+        return nil;
+    }
+
+    if (![[NSFileManager defaultManager] createDirectoryAtPath:path withIntermediateDirectories:YES attributes:nil error:NULL]) {
+        return nil;
+    }
+
+    self = [super init];
+    if (self) {
+        _path = [path copy];
+        _evictionPolicy = [[TWTRVideoCacheEvictionPolicy alloc] initWithMaxSize:maxSize];
+        _indexes = [NSMutableDictionary dictionary];
+        _unsynchronizedKeys = [NSMutableSet set];
+        _damagedKeys = [NSMutableSet set];
+    }
+
+    return self;
+}
+
++ (NSString *)keyForURL:(NSURL *)URL
+{
+    NSData *URLData = [URL.absoluteString dataUsingEncoding:NSUTF8StringEncoding];
+    unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+    CC_SHA1(URLData.bytes, (CC_LONG)URLData.length, digest);
+
+    NSMutableString *key = [NSMutableString stringWithCapacity:CC_SHA1_DIGEST_LENGTH * 2];
+    for (NSUInteger i = 0; i < CC_SHA1_DIGEST_LENGTH; i++) {
+        [key appendFormat:@"%02x", digest[i]];
+    }
+    return key;
+}
+
+#pragma mark - Quota
+
+- (unsigned long long)maxSize
+{
+    @synchronized(self)
+    {
+        return self.evictionPolicy.maxSize;
+    }
+}
+
+- (void)setMaxSize:(unsigned long long)maxSize
+{
+    @synchronized(self)
+    {
+        [self loadStoredIndexesIfNeeded];
+        self.evictionPolicy.maxSize = maxSize;
+        [self evictIfNeeded];
+    }
+}
+
+- (unsigned long long)totalSize
+{
+    @synchronized(self)
+    {
+        [self loadStoredIndexesIfNeeded];
+        return self.evictionPolicy.totalSize;
+    }
+}
+
+#pragma mark - Reading and Writing
+
+- (TWTRByteRangeIndex *)indexForKey:(NSString *)key
+{
+    @synchronized(self)
+    {
+        [self loadStoredIndexesIfNeeded];
+        return [self.indexes[key] copy] ?: [[TWTRByteRangeIndex alloc] init];
+    }
+}
+
+- (void)setContentLength:(long long)contentLength contentType:(NSString *)contentType forKey:(NSString *)key
+{
+    @synchronized(self)
+    {
+        TWTRByteRangeIndex *index = [self mutableIndexForKey:key];
+        if (index.contentLength >= 0 && index.contentLength != contentLength) {
+            [index removeAllRanges];
+            [[NSFileManager defaultManager] removeItemAtPath:[self dataPathForKey:key] error:NULL];
+            [self.evictionPolicy setSize:0 forKey:key];
+        }
+
+        index.contentLength = contentLength;
+        index.contentType = contentType;
+        [self.unsynchronizedKeys addObject:key];
+    }
+}
+
+- (BOOL)storeData:(NSData *)data forKey:(NSString *)key offset:(unsigned long long)offset
+{
+    if (data.length == 0) {
+        return YES;
+    }
+
+    @synchronized(self)
+    {
+        TWTRByteRangeIndex *index = [self mutableIndexForKey:key];
+        NSString *dataPath = [self dataPathForKey:key];
+
+        if (![[NSFileManager defaultManager] fileExistsAtPath:dataPath] && ![[NSFileManager defaultManager] createFileAtPath:dataPath contents:nil attributes:nil]) {
+            NSLog(@"[%@] Could not create file.", [self class]);
+            return NO;
+        }
+
+        // NSFileHandle raises instead of returning errors, e.g. when the disk is full.
+        NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingAtPath:dataPath];
+        @try {
+            [fileHandle seekToFileOffset:offset];
+            [fileHandle writeData:data];
+        } @catch (NSException *exception) {
+            NSLog(@"[%@] Could not write to file: %@", [self class], exception.reason);
+            return NO;
+        } @finally {
+            [fileHandle closeFile];
+        }
+
+        [index addRange:NSMakeRange((NSUInteger)offset, data.length)];
+        [self.evictionPolicy setSize:index.cachedByteCount forKey:key];
+        [self.unsynchronizedKeys addObject:key];
+        [self evictIfNeeded];
+
+        return YES;
+    }
+}
+
+- (NSData *)dataForKey:(NSString *)key range:(NSRange)range
+{
+    @synchronized(self)
+    {
+        [self loadStoredIndexesIfNeeded];
+        TWTRByteRangeIndex *index = self.indexes[key];
+        if (!index || ![index containsRange:range]) {
+            return nil;
+        }
+
+        NSFileHandle *fileHandle = [NSFileHandle fileHandleForReadingAtPath:[self dataPathForKey:key]];
+        NSData *data;
+        @try {
+            [fileHandle seekToFileOffset:range.location];
+            data = [fileHandle readDataOfLength:range.length];
+        } @catch (NSException *exception) {
+            data = nil;
+        } @finally {
+            [fileHandle closeFile];
+        }
+
+        if (data.length != range.length) {
+            if ([self.evictionPolicy isKeyPinned:key]) {
+                [self.damagedKeys addObject:key];
+            } else {
+                [self removeDataForKey:key];
+            }
+            return nil;
+        }
+
+        [self.evictionPolicy touchKey:key];
+        return data;
+    }
+}
+
+#pragma mark - Usage
+
+- (void)beginUsingKey:(NSString *)key
+{
+    @synchronized(self)
+    {
+        [self.evictionPolicy pinKey:key];
+    }
+}
+
+- (void)endUsingKey:(NSString *)key
+{
+    @synchronized(self)
+    {
+        [self.evictionPolicy unpinKey:key];
+
+        if ([self.damagedKeys containsObject:key]) {
+            if (![self.evictionPolicy isKeyPinned:key]) {
+                [self removeDataForKey:key];
+            }
+            return;
+        }
+
+        [self synchronizeKey:key];
+
+        // The modification date doubles as the last access date when the cache is reloaded.
+        [[NSFileManager defaultManager] setAttributes:@{NSFileModificationDate: [NSDate date]} ofItemAtPath:[self dataPathForKey:key] error:NULL];
+        [self evictIfNeeded];
+    }
+}
+
+- (void)synchronizeKey:(NSString *)key
+{
+    @synchronized(self)
+    {
+        TWTRByteRangeIndex *index = self.indexes[key];
+        if (!index || ![self.unsynchronizedKeys containsObject:key]) {
+            return;
+        }
+
+        NSData *indexData = [NSKeyedArchiver archivedDataWithRootObject:index];
+        if ([indexData writeToFile:[self indexPathForKey:key] atomically:YES]) {
+            [self.unsynchronizedKeys removeObject:key];
+        }
+    }
+}
+
+- (void)removeAllData
+{
+    @synchronized(self)
+    {
+        [self loadStoredIndexesIfNeeded];
+
+        unsigned long long maxSize = self.evictionPolicy.maxSize;
+        self.evictionPolicy.maxSize = 0;
+        [self evictIfNeeded];
+        self.evictionPolicy.maxSize = maxSize;
+    }
+}
+
+#pragma mark - Helpers
+
+/**
+ * Must be called while synchronized on self.
+ */
+- (TWTRByteRangeIndex *)mutableIndexForKey:(NSString *)key
+{
+    [self loadStoredIndexesIfNeeded];
+
+    TWTRByteRangeIndex *index = self.indexes[key];
+    if (!index) {
+        index = [[TWTRByteRangeIndex alloc] init];
+        self.indexes[key] = index;
+        [self.evictionPolicy setSize:0 forKey:key];
+    }
+    return index;
+}
+
+/**
+ * Must be called while synchronized on self.
+ */
+- (void)evictIfNeeded
+{
+    for (NSString *key in [self.evictionPolicy keysToEvict]) {
+        [self removeDataForKey:key];
+    }
+}
+
+/**
+ * Must be called while synchronized on self.
+ */
+- (void)removeDataForKey:(NSString *)key
+{
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    [fileManager removeItemAtPath:[self dataPathForKey:key] error:NULL];
+    [fileManager removeItemAtPath:[self indexPathForKey:key] error:NULL];
+
+    [self.indexes removeObjectForKey:key];
+    [self.unsynchronizedKeys removeObject:key];
+    [self.damagedKeys removeObject:key];
+    [self.evictionPolicy removeKey:key];
+}
+
+/**
+ * Reads the stored indexes the first time the cache is used rather than when it is
+ * created, so creating it does no disk work. Must be called while synchronized on self.
+ */
+- (void)loadStoredIndexesIfNeeded
+{
+    if (self.didLoadStoredIndexes) {
+        return;
+    }
+    self.didLoadStoredIndexes = YES;
+
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSArray<NSString *> *fileNames = [fileManager contentsOfDirectoryAtPath:self.path error:NULL];
+    NSMutableArray<NSString *> *keys = [NSMutableArray array];
+    NSMutableDictionary<NSString *, NSDate *> *accessDates = [NSMutableDictionary dictionary];
+
+    for (NSString *fileName in fileNames) {
+        if (![fileName.pathExtension isEqualToString:TWTRVideoCacheIndexExtension]) {
+            continue;
+        }
+
+        NSString *key = fileName.stringByDeletingPathExtension;
+        TWTRByteRangeIndex *index;
+        @try {
+            index = [NSKeyedUnarchiver unarchiveObjectWithFile:[self indexPathForKey:key]];
+        } @catch (NSException *exception) {
+            index = nil;
+        }
+        NSDate *accessDate = [fileManager attributesOfItemAtPath:[self dataPathForKey:key] error:NULL].fileModificationDate;
+
+        if (![index isKindOfClass:[TWTRByteRangeIndex class]] || !accessDate) {
+            [fileManager removeItemAtPath:[self dataPathForKey:key] error:NULL];
+            [fileManager removeItemAtPath:[self indexPathForKey:key] error:NULL];
+            continue;
+        }
+
+        self.indexes[key] = index;
+        accessDates[key] = accessDate;
+        [keys addObject:key];
+    }
+
+    // Data whose index was never written cannot be trusted.
+    for (NSString *fileName in fileNames) {
+        NSString *key = fileName.stringByDeletingPathExtension;
+        if ([fileName.pathExtension isEqualToString:TWTRVideoCacheDataExtension] && !self.indexes[key]) {
+            [fileManager removeItemAtPath:[self dataPathForKey:key] error:NULL];
+        }
+    }
+
+    [keys sortUsingComparator:^NSComparisonResult(NSString *key1, NSString *key2) {
+        return [accessDates[key1] compare:accessDates[key2]];
+    }];
+    for (NSString *key in keys) {
+        [self.evictionPolicy setSize:self.indexes[key].cachedByteCount forKey:key];
+    }
+
+    [self evictIfNeeded];
+}
+
+- (NSString *)dataPathForKey:(NSString *)key
+{
+    return [[self.path stringByAppendingPathComponent:key] stringByAppendingPathExtension:TWTRVideoCacheDataExtension];
+}
+
+- (NSString *)indexPathForKey:(NSString *)key
+{
+    return [[self.path stringByAppendingPathComponent:key] stringByAppendingPathExtension:TWTRVideoCacheIndexExtension];
+}
+
+@end
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ This header is private to the Twitter Kit SDK and not exposed for public SDK consumption
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Decides which cache entries to evict to stay within a size quota, least
+ * recently used first. Entries that are pinned are never evicted.
+ *
+ * This only does the bookkeeping; removing the evicted data is up to the caller.
+ *
+ * Note: This class is NOT thread-safe.
+ */
+@interface TWTRVideoCacheEvictionPolicy : NSObject
+
+/**
+ * The quota, in bytes.
+ */
+@property (nonatomic) unsigned long long maxSize;
+
+/**
+ * The sum of the sizes of all entries.
+ */
+@property (nonatomic, readonly) unsigned long long totalSize;
+
+/**
+ * All keys, least recently used first.
+ */
+@property (nonatomic, readonly) NSArray<NSString *> *keys;
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithMaxSize:(unsigned long long)maxSize NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Records the size of the entry for `key`, adding it if needed, and marks it as
+ * the most recently used.
+ */
+- (void)setSize:(unsigned long long)size forKey:(NSString *)key;
+
+/**
+ * Marks the entry for `key` as the most recently used. Does nothing for unknown keys.
+ */
+- (void)touchKey:(NSString *)key;
+
+/**
+ * Forgets the entry for `key`.
+ */
+- (void)removeKey:(NSString *)key;
+
+/**
+ * Protects the entry for `key` from eviction until a matching `unpinKey:`.
+ * Calls may be nested.
+ */
+- (void)pinKey:(NSString *)key;
+- (void)unpinKey:(NSString *)key;
+
+/**
+ * Whether the entry for `key` has more `pinKey:` calls than `unpinKey:` calls.
+ */
+- (BOOL)isKeyPinned:(NSString *)key;
+
+/**
+ * The keys to evict, in order, to bring the total size within the quota.
+ * Pinned entries are skipped, so the total may still be over the quota.
+ * The keys are not removed.
+ */
+- (NSArray<NSString *> *)keysToEvict;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRVideoCacheEvictionPolicy.h"
+
+@interface TWTRVideoCacheEvictionPolicy ()
+
+/**
+ * Keys ordered from least to most recently used.
+ */
+@property (nonatomic, readonly) NSMutableOrderedSet<NSString *> *usageOrder;
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, NSNumber *> *sizes;
+@property (nonatomic, readonly) NSCountedSet<NSString *> *pinnedKeys;
+@property (nonatomic) unsigned long long totalSize;
+
+@end
+
+@implementation TWTRVideoCacheEvictionPolicy
+
+- (instancetype)initWithMaxSize:(unsigned long long)maxSize
+{
+    self = [super init];
+    if (self) {
+        _maxSize = maxSize;
+        _usageOrder = [NSMutableOrderedSet orderedSet];
+        _sizes = [NSMutableDictionary dictionary];
+        _pinnedKeys = [NSCountedSet set];
+    }
+    return self;
+}
+
+- (NSArray<NSString *> *)keys
+{
+    return self.usageOrder.array;
+}
+
+- (void)setSize:(unsigned long long)size forKey:(NSString *)key
+{
+    self.totalSize = self.totalSize - [self.sizes[key] unsignedLongLongValue] + size;
+    self.sizes[key] = @(size);
+
+    [self.usageOrder removeObject:key];
+    [self.usageOrder addObject:key];
+}
+
+- (void)touchKey:(NSString *)key
+{
+    if ([self.usageOrder containsObject:key]) {
+        [self.usageOrder removeObject:key];
+        [self.usageOrder addObject:key];
+    }
+}
+
+- (void)removeKey:(NSString *)key
+{
+    self.totalSize -= [self.sizes[key] unsignedLongLongValue];
+    [self.sizes removeObjectForKey:key];
+    [self.usageOrder removeObject:key];
+}
+
+- (void)pinKey:(NSString *)key
+{
+    [self.pinnedKeys addObject:key];
+}
+
+- (void)unpinKey:(NSString *)key
+{
+    [self.pinnedKeys removeObject:key];
+}
+
+- (BOOL)isKeyPinned:(NSString *)key
+{
+    return [self.pinnedKeys containsObject:key];
+}
+
+- (NSArray<NSString *> *)keysToEvict
+{
+    NSMutableArray<NSString *> *keys = [NSMutableArray array];
+    unsigned long long remainingSize = self.totalSize;
+
+    for (NSString *key in self.usageOrder) {
+        if (remainingSize <= self.maxSize) {
+            break;
+        }
+        if ([self isKeyPinned:key]) {
+            continue;
+        }
+
+        [keys addObject:key];
+        remainingSize -= [self.sizes[key] unsignedLongLongValue];
+    }
+
+    return keys;
+}
+
+@end
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ This header is private to the Twitter Kit SDK and not exposed for public SDK consumption
+ */
+
+#import <AVFoundation/AVFoundation.h>
+
+@class TWTRVideoCache;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Serves progressive video files to AVFoundation through a `TWTRVideoCache`.
+ *
+ * Assets from `assetWithURL:` use a custom URL scheme, so AVFoundation hands every
+ * byte range it wants to this loader. Cached bytes are served from disk and the
+ * rest is downloaded with HTTP range requests and written to the cache as it arrives.
+ * When several requests for the same file are waiting on the same bytes, they share
+ * one download.
+ */
+@interface TWTRVideoResourceLoader : NSObject <AVAssetResourceLoaderDelegate>
+
+/**
+ * The cache the loader reads from and writes to. When it is nil, e.g. because the
+ * cache directory could not be created, assets load directly from the network.
+ */
+@property (nonatomic, readonly, nullable) TWTRVideoCache *cache;
+
+/**
+ * The loader used by the Twitter Kit video players, with a 50 MB cache.
+ */
++ (instancetype)sharedLoader;
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithCache:(nullable TWTRVideoCache *)cache sessionConfiguration:(NSURLSessionConfiguration *)sessionConfiguration;
+
+/**
+ * Whether the resource at `URL` can be served through the cache. Only
+ * progressive mp4 files over HTTP are, since a playlist is not a single file.
+ */
++ (BOOL)canCacheURL:(NSURL *)URL;
+
+/**
+ * Returns an asset for `URL` that loads through the cache, or a plain asset
+ * if the URL cannot be cached or there is no cache.
+ */
+- (AVURLAsset *)assetWithURL:(NSURL *)URL;
+
+@end
+
+NS_ASSUME_NONNULL_END
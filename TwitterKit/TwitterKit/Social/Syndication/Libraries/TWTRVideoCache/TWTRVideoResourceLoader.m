@@ -0,0 +1,487 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRVideoResourceLoader.h"
+#import <MobileCoreServices/MobileCoreServices.h>
+#import <TwitterCore/TWTRNetworkThroughputEstimator.h>
+#import "TWTRAssetURLSessionConfig.h"
+#import "TWTRByteRangeIndex.h"
+#import "TWTRVideoCache.h"
+
+static NSString *const TWTRVideoResourceLoaderSchemePrefix = @"twtrvideocache-";
+static NSString *const TWTRVideoCachePath = @"cache/videos";
+static const unsigned long long TWTRVideoCacheMaxSize = 50 * 1024 * 1024;
+
+/**
+ * The most bytes read from the cache and handed to AVFoundation at once.
+ */
+static const NSUInteger TWTRVideoCacheReadChunkLength = 512 * 1024;
+
+/**
+ * One HTTP range request and the loading requests waiting on its bytes.
+ */
+@interface TWTRVideoCacheDownload : NSObject
+
+@property (nonatomic, readonly) NSURLSessionDataTask *task;
+@property (nonatomic, copy, readonly) NSString *key;
+@property (nonatomic, readonly) NSMutableArray<AVAssetResourceLoadingRequest *> *loadingRequests;
+
+/**
+ * The offset of the next byte to arrive.
+ */
+@property (nonatomic) unsigned long long currentOffset;
+@property (nonatomic) long long contentLength;
+@property (nonatomic) BOOL didReceiveData;
+@property (nonatomic, nullable) NSError *error;
+
+@end
+
+@implementation TWTRVideoCacheDownload
+
+- (instancetype)initWithTask:(NSURLSessionDataTask *)task key:(NSString *)key offset:(unsigned long long)offset
+{
+    self = [super init];
+    if (self) {
+        _task = task;
+        _key = [key copy];
+        _loadingRequests = [NSMutableArray array];
+        _currentOffset = offset;
+        _contentLength = NSURLResponseUnknownLength;
+    }
+    return self;
+}
+
+@end
+
+@interface TWTRVideoResourceLoader () <NSURLSessionDataDelegate>
+
+/**
+ * All loading requests and session callbacks are handled on this queue.
+ */
+@property (nonatomic, readonly) dispatch_queue_t queue;
+@property (nonatomic, readonly) NSURLSession *session;
+@property (nonatomic, readonly) NSMutableDictionary<NSNumber *, TWTRVideoCacheDownload *> *downloads;
+@property (nonatomic, readonly) NSMutableArray<AVAssetResourceLoadingRequest *> *loadingRequests;
+
+@end
+
+@implementation TWTRVideoResourceLoader
+
++ (instancetype)sharedLoader
+{
+    static TWTRVideoResourceLoader *sharedLoader;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *cacheDir = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+        TWTRVideoCache *cache = [[TWTRVideoCache alloc] initWithPath:[cacheDir stringByAppendingPathComponent:TWTRVideoCachePath] maxSize:TWTRVideoCacheMaxSize];
+        sharedLoader = [[self alloc] initWithCache:cache sessionConfiguration:[self defaultSessionConfiguration]];
+    });
+    return sharedLoader;
+}
+
++ (NSURLSessionConfiguration *)defaultSessionConfiguration
+{
+    NSURLSessionConfiguration *configuration = [TWTRAssetURLSessionConfig defaultConfiguration];
+    NSMutableDictionary *additionalHTTPHeaders = [configuration.HTTPAdditionalHeaders mutableCopy];
+    additionalHTTPHeaders[@"Accept"] = @"video/*";
+    configuration.HTTPAdditionalHeaders = additionalHTTPHeaders;
+
+    // The loader caches responses itself.
+    configuration.URLCache = nil;
+    configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+    return configuration;
+}
+
+- (instancetype)initWithCache:(TWTRVideoCache *)cache sessionConfiguration:(NSURLSessionConfiguration *)sessionConfiguration
+{
+    self = [super init];
+    if (self) {
+        _cache = cache;
+        _queue = dispatch_queue_create("com.twitterkit.video-resource-loader", DISPATCH_QUEUE_SERIAL);
+        _downloads = [NSMutableDictionary dictionary];
+        _loadingRequests = [NSMutableArray array];
+
+        NSOperationQueue *delegateQueue = [[NSOperationQueue alloc] init];
+        delegateQueue.maxConcurrentOperationCount = 1;
+        delegateQueue.underlyingQueue = _queue;
+        _session = [NSURLSession sessionWithConfiguration:sessionConfiguration delegate:self delegateQueue:delegateQueue];
+    }
+    return self;
+}
+
+#pragma mark - Assets
+
++ (BOOL)canCacheURL:(NSURL *)URL
+{
+    NSString *scheme = URL.scheme.lowercaseString;
+    BOOL isHTTP = [scheme isEqualToString:@"https"] || [scheme isEqualToString:@"http"];
+
+    return isHTTP && [URL.pathExtension.lowercaseString isEqualToString:@"mp4"];
+}
+
+- (AVURLAsset *)assetWithURL:(NSURL *)URL
+{
+    if (!self.cache || ![[self class] canCacheURL:URL]) {
+        return [AVURLAsset URLAssetWithURL:URL options:nil];
+    }
+
+    AVURLAsset *asset = [AVURLAsset URLAssetWithURL:[[self class] loaderURLForURL:URL] options:nil];
+    [asset.resourceLoader setDelegate:self queue:self.queue];
+    return asset;
+}
+
+/**
+ * AVFoundation only asks the delegate for URLs it cannot load itself, so the
+ * scheme is prefixed to hide it.
+ */
++ (NSURL *)loaderURLForURL:(NSURL *)URL
+{
+    NSURLComponents *components = [NSURLComponents componentsWithURL:URL resolvingAgainstBaseURL:NO];
+    components.scheme = [TWTRVideoResourceLoaderSchemePrefix stringByAppendingString:components.scheme];
+    return components.URL;
+}
+
++ (nullable NSURL *)originalURLForLoaderURL:(NSURL *)URL
+{
+    NSURLComponents *components = [NSURLComponents componentsWithURL:URL resolvingAgainstBaseURL:NO];
+    if (![components.scheme hasPrefix:TWTRVideoResourceLoaderSchemePrefix]) {
+        return nil;
+    }
+
+    components.scheme = [components.scheme substringFromIndex:TWTRVideoResourceLoaderSchemePrefix.length];
+    return components.URL;
+}
+
++ (NSString *)cacheKeyForLoadingRequest:(AVAssetResourceLoadingRequest *)loadingRequest
+{
+    return [TWTRVideoCache keyForURL:[self originalURLForLoaderURL:loadingRequest.request.URL]];
+}
+
+#pragma mark - AVAssetResourceLoaderDelegate
+
+- (BOOL)resourceLoader:(AVAssetResourceLoader *)resourceLoader shouldWaitForLoadingOfRequestedResource:(AVAssetResourceLoadingRequest *)loadingRequest
+{
+    if (![[self class] originalURLForLoaderURL:loadingRequest.request.URL]) {
+        return NO;
+    }
+
+    [self.loadingRequests addObject:loadingRequest];
+    [self.cache beginUsingKey:[[self class] cacheKeyForLoadingRequest:loadingRequest]];
+    [self processLoadingRequest:loadingRequest];
+    return YES;
+}
+
+- (void)resourceLoader:(AVAssetResourceLoader *)resourceLoader didCancelLoadingRequest:(AVAssetResourceLoadingRequest *)loadingRequest
+{
+    [self endLoadingRequest:loadingRequest];
+}
+
+#pragma mark - Loading Requests
+
+/**
+ * Serves as much of the request as possible from the cache, then finishes it
+ * or waits for the next missing bytes to be downloaded.
+ */
+- (void)processLoadingRequest:(AVAssetResourceLoadingRequest *)loadingRequest
+{
+    NSString *key = [[self class] cacheKeyForLoadingRequest:loadingRequest];
+    TWTRByteRangeIndex *index = [self.cache indexForKey:key];
+
+    if (index.contentLength != NSURLResponseUnknownLength) {
+        [self fillContentInformationRequest:loadingRequest.contentInformationRequest withIndex:index];
+        [self respondToDataRequest:loadingRequest.dataRequest fromCacheForKey:key index:index];
+
+        if ([self isLoadingRequestSatisfied:loadingRequest contentLength:index.contentLength]) {
+            [self finishLoadingRequest:loadingRequest error:nil];
+            return;
+        }
+    }
+
+    [self waitForDownloadOfLoadingRequest:loadingRequest key:key];
+}
+
+- (void)respondToDataRequest:(AVAssetResourceLoadingDataRequest *)dataRequest fromCacheForKey:(NSString *)key index:(TWTRByteRangeIndex *)index
+{
+    if (!dataRequest) {
+        return;
+    }
+
+    const long long endOffset = [self endOffsetOfDataRequest:dataRequest contentLength:index.contentLength];
+
+    while (dataRequest.currentOffset < endOffset) {
+        NSUInteger offset = (NSUInteger)dataRequest.currentOffset;
+        NSUInteger length = MIN([index contiguousLengthFromOffset:offset], MIN(TWTRVideoCacheReadChunkLength, (NSUInteger)(endOffset - offset)));
+        NSData *data = (length > 0) ? [self.cache dataForKey:key range:NSMakeRange(offset, length)] : nil;
+
+        if (!data) {
+            break;
+        }
+        [dataRequest respondWithData:data];
+    }
+}
+
+/**
+ * Attaches the request to a download that is about to deliver the byte it needs
+ * next, or starts one for the bytes up to the next cached byte.
+ */
+- (void)waitForDownloadOfLoadingRequest:(AVAssetResourceLoadingRequest *)loadingRequest key:(NSString *)key
+{
+    AVAssetResourceLoadingDataRequest *dataRequest = loadingRequest.dataRequest;
+    const unsigned long long offset = dataRequest ? (unsigned long long)dataRequest.currentOffset : 0;
+
+    for (TWTRVideoCacheDownload *download in self.downloads.objectEnumerator) {
+        if ([download.key isEqualToString:key] && download.currentOffset == offset) {
+            [download.loadingRequests addObject:loadingRequest];
+            return;
+        }
+    }
+
+    TWTRByteRangeIndex *index = [self.cache indexForKey:key];
+    // A request for content information alone only needs the response headers.
+    const long long endOffset = dataRequest ? [self endOffsetOfDataRequest:dataRequest contentLength:index.contentLength] : (long long)offset + 2;
+
+    NSString *rangeValue;
+    if (endOffset == LLONG_MAX) {
+        rangeValue = [NSString stringWithFormat:@"bytes=%llu-", offset];
+    } else {
+        NSRange missingRange = [index firstMissingRangeInRange:NSMakeRange((NSUInteger)offset, (NSUInteger)(endOffset - offset))];
+        unsigned long long missingEndOffset = (missingRange.location == offset) ? NSMaxRange(missingRange) : (unsigned long long)endOffset;
+        rangeValue = [NSString stringWithFormat:@"bytes=%llu-%llu", offset, missingEndOffset - 1];
+    }
+
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[[self class] originalURLForLoaderURL:loadingRequest.request.URL]];
+    [request setValue:rangeValue forHTTPHeaderField:@"Range"];
+
+    NSURLSessionDataTask *task = [self.session dataTaskWithRequest:request];
+    TWTRVideoCacheDownload *download = [[TWTRVideoCacheDownload alloc] initWithTask:task key:key offset:offset];
+    [download.loadingRequests addObject:loadingRequest];
+    self.downloads[@(task.taskIdentifier)] = download;
+
+    [task resume];
+}
+
+- (void)fillContentInformationRequest:(AVAssetResourceLoadingContentInformationRequest *)contentInformationRequest withIndex:(TWTRByteRangeIndex *)index
+{
+    if (!contentInformationRequest || index.contentLength == NSURLResponseUnknownLength) {
+        return;
+    }
+
+    contentInformationRequest.contentType = [[self class] uniformTypeIdentifierForMIMEType:index.contentType];
+    contentInformationRequest.contentLength = index.contentLength;
+    contentInformationRequest.byteRangeAccessSupported = YES;
+}
+
+- (long long)endOffsetOfDataRequest:(AVAssetResourceLoadingDataRequest *)dataRequest contentLength:(long long)contentLength
+{
+    long long endOffset = dataRequest.requestsAllDataToEndOfResource ? LLONG_MAX : dataRequest.requestedOffset + dataRequest.requestedLength;
+    return (contentLength >= 0) ? MIN(endOffset, contentLength) : endOffset;
+}
+
+- (BOOL)isLoadingRequestSatisfied:(AVAssetResourceLoadingRequest *)loadingRequest contentLength:(long long)contentLength
+{
+    AVAssetResourceLoadingDataRequest *dataRequest = loadingRequest.dataRequest;
+    return !dataRequest || dataRequest.currentOffset >= [self endOffsetOfDataRequest:dataRequest contentLength:contentLength];
+}
+
+- (void)finishLoadingRequest:(AVAssetResourceLoadingRequest *)loadingRequest error:(nullable NSError *)error
+{
+    if (![self endLoadingRequest:loadingRequest]) {
+        return;
+    }
+
+    if (error) {
+        [loadingRequest finishLoadingWithError:error];
+    } else {
+        [loadingRequest finishLoading];
+    }
+}
+
+/**
+ * Stops tracking the request and cancels downloads nobody is waiting on any more.
+ *
+ * @return whether the request was still being tracked
+ */
+- (BOOL)endLoadingRequest:(AVAssetResourceLoadingRequest *)loadingRequest
+{
+    NSUInteger index = [self.loadingRequests indexOfObjectIdenticalTo:loadingRequest];
+    if (index == NSNotFound) {
+        return NO;
+    }
+    [self.loadingRequests removeObjectAtIndex:index];
+
+    for (TWTRVideoCacheDownload *download in self.downloads.allValues) {
+        [download.loadingRequests removeObjectIdenticalTo:loadingRequest];
+        if (download.loadingRequests.count == 0) {
+            [self.downloads removeObjectForKey:@(download.task.taskIdentifier)];
+            [download.task cancel];
+            [self.cache synchronizeKey:download.key];
+        }
+    }
+
+    [self.cache endUsingKey:[[self class] cacheKeyForLoadingRequest:loadingRequest]];
+    return YES;
+}
+
++ (NSString *)uniformTypeIdentifierForMIMEType:(nullable NSString *)MIMEType
+{
+    NSString *identifier;
+    if (MIMEType) {
+        identifier = CFBridgingRelease(UTTypeCreatePreferredIdentifierForTag(kUTTagClassMIMEType, (__bridge CFStringRef)MIMEType, NULL));
+    }
+
+    // Unknown MIME types get a dynamic identifier AVFoundation cannot use.
+    return (identifier && ![identifier hasPrefix:@"dyn."]) ? identifier : AVFileTypeMPEG4;
+}
+
+#pragma mark - NSURLSessionDataDelegate
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveResponse:(NSURLResponse *)response completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler
+{
+    TWTRVideoCacheDownload *download = self.downloads[@(dataTask.taskIdentifier)];
+    if (!download) {
+        completionHandler(NSURLSessionResponseCancel);
+        return;
+    }
+
+    unsigned long long startOffset;
+    long long contentLength;
+    if (![[self class] parseResponse:response startOffset:&startOffset contentLength:&contentLength]) {
+        download.error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorBadServerResponse userInfo:@{NSURLErrorFailingURLErrorKey: dataTask.originalRequest.URL}];
+        completionHandler(NSURLSessionResponseCancel);
+        return;
+    }
+
+    download.currentOffset = startOffset;
+    download.contentLength = contentLength;
+    [self.cache setContentLength:contentLength contentType:response.MIMEType forKey:download.key];
+
+    TWTRByteRangeIndex *index = [self.cache indexForKey:download.key];
+    for (AVAssetResourceLoadingRequest *loadingRequest in [download.loadingRequests copy]) {
+        [self fillContentInformationRequest:loadingRequest.contentInformationRequest withIndex:index];
+        if (!loadingRequest.dataRequest) {
+            [self finishLoadingRequest:loadingRequest error:nil];
+        }
+    }
+
+    completionHandler(NSURLSessionResponseAllow);
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data
+{
+    TWTRVideoCacheDownload *download = self.downloads[@(dataTask.taskIdentifier)];
+    if (!download) {
+        return;
+    }
+
+    const unsigned long long offset = download.currentOffset;
+    [self.cache storeData:data forKey:download.key offset:offset];
+    download.currentOffset = offset + data.length;
+    download.didReceiveData = YES;
+
+    for (AVAssetResourceLoadingRequest *loadingRequest in [download.loadingRequests copy]) {
+        AVAssetResourceLoadingDataRequest *dataRequest = loadingRequest.dataRequest;
+        const long long requestOffset = dataRequest.currentOffset;
+        const long long endOffset = MIN([self endOffsetOfDataRequest:dataRequest contentLength:download.contentLength], (long long)download.currentOffset);
+
+        if (requestOffset >= (long long)offset && requestOffset < endOffset) {
+            [dataRequest respondWithData:[data subdataWithRange:NSMakeRange((NSUInteger)(requestOffset - offset), (NSUInteger)(endOffset - requestOffset))]];
+        }
+
+        if ([self isLoadingRequestSatisfied:loadingRequest contentLength:download.contentLength]) {
+            [self finishLoadingRequest:loadingRequest error:nil];
+        }
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(nullable NSError *)error
+{
+    TWTRVideoCacheDownload *download = self.downloads[@(task.taskIdentifier)];
+    if (!download) {
+        return;
+    }
+
+    [self.downloads removeObjectForKey:@(task.taskIdentifier)];
+    [self.cache synchronizeKey:download.key];
+
+    NSError *failure = download.error ?: error;
+    if (!failure && !download.didReceiveData) {
+        failure = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorZeroByteResource userInfo:@{NSURLErrorFailingURLErrorKey: task.originalRequest.URL}];
+    }
+
+    for (AVAssetResourceLoadingRequest *loadingRequest in [download.loadingRequests copy]) {
+        if (failure) {
+            [self finishLoadingRequest:loadingRequest error:failure];
+        } else {
+            // The download stopped at the next cached byte, or short of what was asked for.
+            [self processLoadingRequest:loadingRequest];
+        }
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics API_AVAILABLE(ios(10.0), tvos(10.0))
+{
+    [[TWTRNetworkThroughputEstimator sharedEstimator] recordTaskMetrics:metrics forTask:task];
+}
+
+#pragma mark - Responses
+
+/**
+ * Reads where the response body starts in the resource and how long the whole
+ * resource is. A 200 response means the server ignored the range.
+ */
++ (BOOL)parseResponse:(NSURLResponse *)response startOffset:(unsigned long long *)startOffset contentLength:(long long *)contentLength
+{
+    NSHTTPURLResponse *HTTPResponse = [response isKindOfClass:[NSHTTPURLResponse class]] ? (NSHTTPURLResponse *)response : nil;
+
+    if (HTTPResponse.statusCode == 200) {
+        *startOffset = 0;
+        *contentLength = HTTPResponse.expectedContentLength;
+        return *contentLength >= 0;
+    }
+
+    if (HTTPResponse.statusCode != 206) {
+        return NO;
+    }
+
+    // e.g. "bytes 0-1023/146515"
+    NSString *contentRange = [self valueForHeaderField:@"Content-Range" inResponse:HTTPResponse];
+    NSScanner *scanner = [NSScanner scannerWithString:contentRange ?: @""];
+    long long firstByte;
+    long long lastByte;
+    long long totalLength;
+
+    BOOL parsed = [scanner scanString:@"bytes" intoString:NULL] && [scanner scanLongLong:&firstByte] && [scanner scanString:@"-" intoString:NULL] && [scanner scanLongLong:&lastByte] && [scanner scanString:@"/" intoString:NULL] && [scanner scanLongLong:&totalLength];
+    if (!parsed || firstByte < 0 || lastByte < firstByte || totalLength <= lastByte) {
+        return NO;
+    }
+
+    *startOffset = (unsigned long long)firstByte;
+    *contentLength = totalLength;
+    return YES;
+}
+
++ (nullable NSString *)valueForHeaderField:(NSString *)field inResponse:(NSHTTPURLResponse *)response
+{
+    for (NSString *key in response.allHeaderFields) {
+        if ([key caseInsensitiveCompare:field] == NSOrderedSame) {
+            return response.allHeaderFields[key];
+        }
+    }
+    return nil;
+}
+
+@end
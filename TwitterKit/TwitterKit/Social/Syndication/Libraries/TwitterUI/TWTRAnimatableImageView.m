@@ -79,6 +79,8 @@
 - (void)startAnimatingWithFrameSheet:(TWTRFrameSheet *)frameSheet duration:(NSTimeInterval)duration repeatCount:(NSUInteger)repeatCount completion:(void (^)(BOOL))completion
 {
     _frameSheet = frameSheet;
+    // These are the frame sheet's own frames, already counted and trimmed as part of the shared frame sheets,
+    // and are only held while the animation is on screen, so the view does not register them separately.
     self.animationImages = frameSheet.frameArray;
     [self startAnimatingWithDuration:duration repeatCount:repeatCount completion:completion];
 }
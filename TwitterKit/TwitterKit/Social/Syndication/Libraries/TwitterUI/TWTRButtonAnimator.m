@@ -60,7 +60,9 @@
 + (void)_performImageSequenceOnButton:(UIButton *)button forImageSequenceConfiguration:(TWTRImageSequenceConfiguration *)imageSequenceConfiguration completion:(dispatch_block_t)completion
 {
     if ([button.imageView isKindOfClass:[TWTRAnimatableImageView class]]) {
-        TWTRFrameSheet *frameSheet = [[TWTRFrameSheet alloc] initWithImage:imageSequenceConfiguration.imageSheet rows:imageSequenceConfiguration.rows columns:imageSequenceConfiguration.columns frameCount:imageSequenceConfiguration.frameCount imageWidth:imageSequenceConfiguration.imageSize.width imageHeight:imageSequenceConfiguration.imageSize.height];
+        // Reuse the frames sliced for earlier taps rather than slicing the sheet again
+        CGFloat scale = button.window.screen.scale ?: [UIScreen mainScreen].scale;
+        TWTRFrameSheet *frameSheet = [TWTRFrameSheet sharedFrameSheetForImageSequenceConfiguration:imageSequenceConfiguration scale:scale];
 
         TWTRAnimatableImageView *imageView = (TWTRAnimatableImageView *)button.imageView;
         @weakify(imageView);
@@ -22,6 +22,7 @@
 #import <Foundation/Foundation.h>
 #import <UIKit/UIKit.h>
 
+@class TWTRImageSequenceConfiguration;
 @class UIImage;
 
 @interface TWTRFrameSheet : NSObject
@@ -29,7 +30,34 @@
 @property (nonatomic, readonly) NSUInteger imageWidth;
 @property (nonatomic, readonly) NSUInteger imageHeight;
 
+/**
+ Returns the frame sheet for an image sequence, shared across the process. Its frames are decoded and
+ sliced the first time they are asked for and then reused by every animation of the sequence at this
+ scale until memory runs low and the memory pressure coordinator trims them.
+
+ @param configuration The image sequence to animate.
+ @param scale The scale of the screen the animation is shown on.
+ */
++ (instancetype)sharedFrameSheetForImageSequenceConfiguration:(TWTRImageSequenceConfiguration *)configuration scale:(CGFloat)scale;
+
+/**
+ Drops every shared frame sheet. Animations in flight keep their frames.
+
+ Shared frame sheets are registered with the memory pressure coordinator, which trims them when memory
+ runs low.
+ */
++ (void)removeAllSharedFrameSheets;
+
 - (instancetype)initWithImage:(UIImage *)image rows:(NSUInteger)rows columns:(NSUInteger)columns frameCount:(NSUInteger)frameCount imageWidth:(NSUInteger)imageWidth imageHeight:(NSUInteger)imageHeight;
+
+/**
+ The frames of the sheet, in order. Sliced on first access and kept for the lifetime of the sheet.
+ */
 - (NSArray<UIImage *> *)frameArray;
 
+/**
+ The approximate number of bytes held by the decoded frames, 0 until they are sliced.
+ */
+- (NSUInteger)memoryCost;
+
 @end
@@ -19,6 +19,32 @@
 // into an array.
 
 #import "TWTRFrameSheet.h"
+#import <TwitterCore/TWTRMemoryPressureCoordinator.h>
+#import "TWTRImageSequenceConfiguration.h"
+
+/**
+ Draws the image into a bitmap so its pixels are decoded once, up front, instead of every time a frame
+ sliced from it is displayed. Frames sliced from the result share its pixel data.
+ */
+static CGImageRef TWTRFrameSheetCreateDecodedImage(CGImageRef image)
+{
+    size_t width = CGImageGetWidth(image);
+    size_t height = CGImageGetHeight(image);
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace, kCGBitmapByteOrder32Host | kCGImageAlphaPremultipliedFirst);
+    CGColorSpaceRelease(colorSpace);
+
+    if (!context) {
+        return CGImageRetain(image);
+    }
+
+    CGContextDrawImage(context, CGRectMake(0, 0, width, height), image);
+    CGImageRef decodedImage = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+
+    return decodedImage ?: CGImageRetain(image);
+}
 
 @interface TWTRFrameSheet ()
 @property (nonatomic, readonly) NSUInteger rows;
@@ -27,7 +53,93 @@
 @property (nonatomic, readonly) UIImage *frameSheet;
 @end
 
-@implementation TWTRFrameSheet
+@implementation TWTRFrameSheet {
+    NSArray<UIImage *> *_frameArray;
+    NSUInteger _memoryCost;
+}
+
+/**
+ Must be accessed while synchronized on the class.
+ */
++ (NSMutableDictionary<NSArray *, TWTRFrameSheet *> *)sharedFrameSheets
+{
+    static NSMutableDictionary<NSArray *, TWTRFrameSheet *> *sharedFrameSheets;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedFrameSheets = [NSMutableDictionary dictionary];
+
+        // Decoded frames are expensive to rebuild mid-animation, but nowhere near as expensive as players
+        TWTRMemoryCostBlock cost = ^NSUInteger {
+            return [TWTRFrameSheet sharedFrameSheetsMemoryCost];
+        };
+        TWTRMemoryTrimBlock trim = ^(NSUInteger targetCost) {
+            [TWTRFrameSheet trimSharedFrameSheetsToMemoryCost:targetCost];
+        };
+        [[TWTRMemoryPressureCoordinator sharedCoordinator] registerCacheNamed:@"TWTRFrameSheet.sharedFrameSheets" priority:TWTRMemoryPurgePriorityDefault cost:cost trim:trim];
+    });
+
+    return sharedFrameSheets;
+}
+
++ (instancetype)sharedFrameSheetForImageSequenceConfiguration:(TWTRImageSequenceConfiguration *)configuration scale:(CGFloat)scale
+{
+    // Sequence configurations are shared instances, so they key by identity
+    NSArray *key = @[configuration, @(scale)];
+
+    @synchronized(self)
+    {
+        NSMutableDictionary<NSArray *, TWTRFrameSheet *> *sharedFrameSheets = [self sharedFrameSheets];
+
+        TWTRFrameSheet *frameSheet = sharedFrameSheets[key];
+        if (!frameSheet) {
+            frameSheet = [[self alloc] initWithImage:configuration.imageSheet rows:configuration.rows columns:configuration.columns frameCount:configuration.frameCount imageWidth:(NSUInteger)configuration.imageSize.width imageHeight:(NSUInteger)configuration.imageSize.height];
+            sharedFrameSheets[key] = frameSheet;
+        }
+
+        return frameSheet;
+    }
+}
+
++ (void)removeAllSharedFrameSheets
+{
+    @synchronized(self)
+    {
+        [[self sharedFrameSheets] removeAllObjects];
+    }
+}
+
++ (NSUInteger)sharedFrameSheetsMemoryCost
+{
+    @synchronized(self)
+    {
+        NSUInteger cost = 0;
+        for (TWTRFrameSheet *frameSheet in [self sharedFrameSheets].allValues) {
+            cost += frameSheet.memoryCost;
+        }
+        return cost;
+    }
+}
+
++ (void)trimSharedFrameSheetsToMemoryCost:(NSUInteger)memoryCost
+{
+    @synchronized(self)
+    {
+        NSMutableDictionary<NSArray *, TWTRFrameSheet *> *sharedFrameSheets = [self sharedFrameSheets];
+        NSUInteger cost = [self sharedFrameSheetsMemoryCost];
+
+        // Drop the largest sheets first so the fewest animations have to decode again
+        NSArray<NSArray *> *keysByCost = [sharedFrameSheets keysSortedByValueUsingComparator:^NSComparisonResult(TWTRFrameSheet *lhs, TWTRFrameSheet *rhs) {
+            return [@(rhs.memoryCost) compare:@(lhs.memoryCost)];
+        }];
+        for (NSArray *key in keysByCost) {
+            if (cost <= memoryCost) {
+                break;
+            }
+            cost -= sharedFrameSheets[key].memoryCost;
+            [sharedFrameSheets removeObjectForKey:key];
+        }
+    }
+}
 
 - (instancetype)initWithImage:(UIImage *)image rows:(NSUInteger)rows columns:(NSUInteger)columns frameCount:(NSUInteger)frameCount imageWidth:(NSUInteger)imageWidth imageHeight:(NSUInteger)imageHeight
 {
@@ -42,11 +154,37 @@
     return self;
 }
 
+- (NSUInteger)memoryCost
+{
+    @synchronized(self)
+    {
+        return _memoryCost;
+    }
+}
+
 - (NSArray *)frameArray
+{
+    @synchronized(self)
+    {
+        if (!_frameArray) {
+            _frameArray = [self sliceFrames];
+        }
+        return _frameArray;
+    }
+}
+
+- (NSArray *)sliceFrames
 {
     // Parses a frame sheet of (rectangular) images into an array of images of equal size. Total count
     // specified by frameCount.
     NSMutableArray *frameArray = [[NSMutableArray alloc] initWithCapacity:_frameCount];
+    CGImageRef sheetImage = [_frameSheet CGImage];
+    if (!sheetImage) {
+        return frameArray;
+    }
+
+    CGImageRef decodedSheetImage = TWTRFrameSheetCreateDecodedImage(sheetImage);
+    _memoryCost = CGImageGetBytesPerRow(decodedSheetImage) * CGImageGetHeight(decodedSheetImage);
 
     for (NSUInteger i = 0; i < _rows; i++) {
         for (NSUInteger j = 0; j < _columns; j++) {
@@ -54,12 +192,14 @@
                 break;
             }
             CGRect frame = CGRectMake(_imageWidth * j * _frameSheet.scale, _imageHeight * i * _frameSheet.scale, _imageWidth * _frameSheet.scale, _imageHeight * _frameSheet.scale);
-            CGImageRef imageRef = CGImageCreateWithImageInRect([_frameSheet CGImage], frame);
-            [frameArray addObject:[[UIImage imageWithCGImage:imageRef] copy]];
+            CGImageRef imageRef = CGImageCreateWithImageInRect(decodedSheetImage, frame);
+            [frameArray addObject:[UIImage imageWithCGImage:imageRef]];
             CGImageRelease(imageRef);
         }
     }
-    return frameArray;
+
+    CGImageRelease(decodedSheetImage);
+    return [frameArray copy];
 }
 
 @end
@@ -56,6 +56,15 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (instancetype)initWithMediaEntity:(TWTRTweetMediaEntity *)mediaEntity targetWidth:(CGFloat)targetWidth;
 
+/**
+ * Returns the display configuration for the media entity at the given width. Widths that choose
+ * the same image size share one configuration, which is created once and kept with the entity.
+ *
+ * @param mediaEntity the TWTRTweetMediaEntity object
+ * @param targetWidth the width that the view will target.
+ */
++ (instancetype)displayConfigurationWithMediaEntity:(TWTRTweetMediaEntity *)mediaEntity targetWidth:(CGFloat)targetWidth;
+
 /**
  * Initializes the receiver with the given card entity or nil if the card has no associated media.
  */
@@ -19,12 +19,14 @@
 #import "TWTRCardEntity.h"
 #import "TWTRImages.h"
 #import "TWTRMediaEntitySize.h"
+#import "TWTRMediaEntitySizeTable.h"
 #import "TWTRMediaType.h"
 #import "TWTRPlayerCardEntity.h"
 #import "TWTRStringUtil.h"
 #import "TWTRTweetMediaEntity.h"
 #import "TWTRVideoMetaData.h"
 #import "TWTRViewUtil.h"
+#import <objc/runtime.h>
 
 static NSString *const TWTRPillGIFText = @"GIF";
 
@@ -33,9 +35,43 @@ static NSString *const TWTRPillGIFText = @"GIF";
 - (instancetype)initWithMediaEntity:(TWTRTweetMediaEntity *)mediaEntity targetWidth:(CGFloat)targetWidth
 {
     TWTRMediaEntitySize *entitySize = [TWTRViewUtil bestMatchSizeFromMediaEntity:mediaEntity fittingWidth:targetWidth];
+    return [self initWithMediaEntity:mediaEntity entitySize:entitySize];
+}
+
++ (instancetype)displayConfigurationWithMediaEntity:(TWTRTweetMediaEntity *)mediaEntity targetWidth:(CGFloat)targetWidth
+{
+    TWTRMediaEntitySizeTable *sizeTable = [TWTRViewUtil sizeTableForMediaEntity:mediaEntity];
+    NSUInteger sizeIndex = [sizeTable indexOfSizeFittingWidth:[TWTRViewUtil mediaFittingWidthForTargetWidth:targetWidth]];
+    if (sizeIndex == NSNotFound) {
+        return [[self alloc] initWithMediaEntity:mediaEntity targetWidth:targetWidth];
+    }
+
+    // One slot per size in the table, filled the first time a width chooses that size
+    @synchronized(mediaEntity)
+    {
+        NSMutableArray *configurations = objc_getAssociatedObject(mediaEntity, @selector(displayConfigurationWithMediaEntity:targetWidth:));
+        if (!configurations) {
+            configurations = [NSMutableArray arrayWithCapacity:sizeTable.count];
+            for (NSUInteger i = 0; i < sizeTable.count; i++) {
+                [configurations addObject:[NSNull null]];
+            }
+            objc_setAssociatedObject(mediaEntity, @selector(displayConfigurationWithMediaEntity:targetWidth:), configurations, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        }
+
+        id configuration = configurations[sizeIndex];
+        if (configuration == [NSNull null]) {
+            configuration = [[self alloc] initWithMediaEntity:mediaEntity entitySize:[sizeTable sizeAtIndex:sizeIndex]];
+            configurations[sizeIndex] = configuration;
+        }
+        return configuration;
+    }
+}
+
+- (instancetype)initWithMediaEntity:(TWTRTweetMediaEntity *)mediaEntity entitySize:(TWTRMediaEntitySize *)entitySize
+{
     NSString *pillText = [[self class] labelTextForMediaEntity:mediaEntity];
+    NSString *path = [[self class] imagePathForMediaEntity:mediaEntity sizeKey:entitySize.name];
 
-    NSString *path = [[[self class] imagePathForMediaEntity:mediaEntity sizeKey:entitySize.name] copy];
     return [self initWithImagePath:path imageSize:entitySize.size pillText:pillText pillImage:nil];
 }
 
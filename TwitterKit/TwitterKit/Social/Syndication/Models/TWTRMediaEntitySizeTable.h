@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ This header is private to the Twitter Kit SDK and not exposed for public SDK consumption
+ */
+
+#import <UIKit/UIKit.h>
+
+@class TWTRMediaEntitySize;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * The sizes of a media entity sorted by width, for choosing the size to load for a given width.
+ * Immutable once created, so it can be built once per media entity and queried from any thread.
+ */
+@interface TWTRMediaEntitySizeTable : NSObject
+
+/**
+ * The number of sizes the table chooses between.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Creates a table of the 'fit' sizes at least `minimumWidth` wide. If there are none, every size is
+ * used instead.
+ *
+ * @param sizes The sizes of a media entity keyed by name.
+ * @param minimumWidth The narrowest size worth loading.
+ */
+- (instancetype)initWithSizes:(NSDictionary<NSString *, TWTRMediaEntitySize *> *)sizes minimumWidth:(CGFloat)minimumWidth NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Returns the index of the size whose width is closest to `width`, preferring the narrower size
+ * on ties, or `NSNotFound` if the table is empty.
+ */
+- (NSUInteger)indexOfSizeFittingWidth:(CGFloat)width;
+
+/**
+ * Returns the size at an index returned by `indexOfSizeFittingWidth:`.
+ */
+- (TWTRMediaEntitySize *)sizeAtIndex:(NSUInteger)index;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRMediaEntitySizeTable.h"
+#import "TWTRMediaEntitySize.h"
+
+@implementation TWTRMediaEntitySizeTable {
+    NSArray<TWTRMediaEntitySize *> *_sizes;
+
+    // Widths of `_sizes`, in the same ascending order, so lookups don't message the sizes
+    CGFloat *_widths;
+}
+
+- (instancetype)initWithSizes:(NSDictionary<NSString *, TWTRMediaEntitySize *> *)sizes minimumWidth:(CGFloat)minimumWidth
+{
+    self = [super init];
+    if (self) {
+        NSMutableArray<TWTRMediaEntitySize *> *validSizes = [NSMutableArray arrayWithCapacity:sizes.count];
+        for (TWTRMediaEntitySize *size in [sizes objectEnumerator]) {
+            if (size.size.width >= minimumWidth && size.resizingMode == TWTRMediaEntitySizeResizingModeFit) {
+                [validSizes addObject:size];
+            }
+        }
+
+        // If that stripped out *all* sizes as invalid, choose between all of them
+        NSArray<TWTRMediaEntitySize *> *candidateSizes = (validSizes.count > 0) ? validSizes : [sizes allValues];
+
+        _sizes = [candidateSizes sortedArrayUsingComparator:^NSComparisonResult(TWTRMediaEntitySize *size1, TWTRMediaEntitySize *size2) {
+            if (size1.size.width != size2.size.width) {
+                return size1.size.width < size2.size.width ? NSOrderedAscending : NSOrderedDescending;
+            }
+            // Keep ties in a stable order between launches
+            return [size1.name compare:size2.name];
+        }];
+
+        _widths = calloc(MAX(_sizes.count, 1), sizeof(CGFloat));
+        [_sizes enumerateObjectsUsingBlock:^(TWTRMediaEntitySize *size, NSUInteger idx, BOOL *stop) {
+            self->_widths[idx] = size.size.width;
+        }];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_widths);
+}
+
+- (NSUInteger)count
+{
+    return _sizes.count;
+}
+
+- (NSUInteger)indexOfSizeFittingWidth:(CGFloat)width
+{
+    NSUInteger count = _sizes.count;
+    if (count == 0) {
+        return NSNotFound;
+    }
+
+    // Find the first size at least as wide as the target; the closest size is it or the one before it
+    NSUInteger low = 0;
+    NSUInteger high = count;
+    while (low < high) {
+        NSUInteger mid = low + (high - low) / 2;
+        if (_widths[mid] < width) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low == count) {
+        return count - 1;
+    }
+    if (low == 0) {
+        return 0;
+    }
+
+    return (width - _widths[low - 1] <= _widths[low] - width) ? low - 1 : low;
+}
+
+- (TWTRMediaEntitySize *)sizeAtIndex:(NSUInteger)index
+{
+    return _sizes[index];
+}
+
+@end
@@ -37,7 +37,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  *  Subscribe to changes for a single object (Tweet, User, Collection, etc).
- *  This runs asynchronously on an internal serial queue.
+ *  The subscriber is held weakly and its subscription is dropped once it
+ *  has been deallocated.
  *
  *  @param subscriber  The object desiring updates upon changes.
  *  @param objectClass The class of the object to observe.
@@ -49,7 +50,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  *  Unsubscribe from notifications. The subscription object will not longer
- *  be retained. This runs asynchronously on an internal serial queue.
+ *  be retained.
  *
  *  @param subscriber  The object previously registered for updates.
  *  @param objectClass The class of the object previously registered.
@@ -67,8 +68,9 @@ NS_ASSUME_NONNULL_BEGIN
  *  have registered to receive updates when that particular object
  *  class and objectID have changed.
  *
- *  This runs asynchronously on an internal serial queue, but calls out to
- *  subscribers on the main thread.
+ *  Notifications are coalesced: every change posted during the current
+ *  run loop turn is delivered once per object, with the most recent
+ *  version of that object, on a later turn of the main run loop.
  *
  *  Note: Ideally, this logic will happen internally when this class handles
  *  dispatching actions and storing state as well.
@@ -76,10 +78,17 @@ NS_ASSUME_NONNULL_BEGIN
  *  @param object   The object itself that has changed.
  *  @param objectID The object ID.
  *
- *  @note This method must be called from the main thread.
+ *  @note This method may be called from any thread, subscribers are always called on the main thread.
  */
 - (void)notifySubscribersOfChangesToObject:(id)object withID:(NSString *)objectID;
 
+/**
+ *  Immediately delivers any coalesced notifications that have not been sent yet.
+ *
+ *  @note This method must be called from the main thread.
+ */
+- (void)deliverPendingNotifications;
+
 @end
 
 NS_ASSUME_NONNULL_END
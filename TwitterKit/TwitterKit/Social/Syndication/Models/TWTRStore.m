@@ -21,24 +21,50 @@
 //  If an object tries to subscribe to a new object, it should usubscribe
 //  from the previous object first.
 //
-//  e.g.   {@"TWTRTweet":
-//                  {@"34890723", [tweetSubscriber9, tweetSubscriber3],
-//                   @"19872398", [tweetSubscriber5],
-//                   @"871629437",[tweetSubs1, tweetSubs89, tweetSubs3},
-//          @"TWTRUser":
-//                  {@"8732", [userSubscriber32, userSubscriber8],
-//                   @"312", [userSubscriber2]}
+//  Subscriptions are indexed by their token, and the tokens are grouped
+//  by the object they observe so both lookups are constant time.
+//
+//  e.g.   subscriptionsByToken:
+//              {@"0x7f9c.../TWTRTweet/34890723", <TWTRSubscription tweetSubscriber9>,
+//               @"0x7f8d.../TWTRTweet/34890723", <TWTRSubscription tweetSubscriber3>,
+//               @"0x7f8d.../TWTRUser/8732", <TWTRSubscription userSubscriber32>}
+//
+//         tokensByObjectKey:
+//              {@"TWTRTweet/34890723", {@"0x7f9c.../TWTRTweet/34890723", @"0x7f8d.../TWTRTweet/34890723"},
+//               @"TWTRUser/8732", {@"0x7f8d.../TWTRUser/8732"}}
 //
 
 #import "TWTRStore.h"
+#import <TwitterCore/TWTRMemoryPressureCoordinator.h>
 #import <TwitterCore/TWTRMultiThreadUtil.h>
 #import "TWTRSubscriber.h"
 #import "TWTRSubscription.h"
 #import "TWTRTweet.h"
 
+// A subscription, its token and its slot in the object key's token set.
+static const NSUInteger TWTRStoreEstimatedSubscriptionCost = 256;
+
+static void TWTRStorePerformSyncOnMainThread(dispatch_block_t block)
+{
+    if ([NSThread isMainThread]) {
+        block();
+    } else {
+        dispatch_sync(dispatch_get_main_queue(), block);
+    }
+}
+
 @interface TWTRStore ()
 
-@property (nonatomic) NSMutableDictionary<NSString *, NSMutableDictionary<NSString *, NSMutableArray<TWTRSubscription *> *> *> *subscriptions;
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, TWTRSubscription *> *subscriptionsByToken;
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, NSMutableSet<NSString *> *> *tokensByObjectKey;
+
+/**
+ *  Latest version of each changed object waiting to be delivered, keyed by object key.
+ *  Guarded by `pendingNotificationsLock` since notifications can be posted from any thread.
+ */
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, id> *pendingObjectsByObjectKey;
+@property (nonatomic, readonly) NSObject *pendingNotificationsLock;
+@property (nonatomic) BOOL isDeliveryScheduled;
 
 @end
 
@@ -50,6 +76,22 @@
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
         store = [[TWTRStore alloc] init];
+
+        // Live subscriptions cannot be dropped, so trimming only prunes the ones whose subscriber has gone away.
+        // The tables are only touched on the main thread, so pressure signalled elsewhere hops over to it.
+        TWTRMemoryCostBlock cost = ^NSUInteger {
+            __block NSUInteger subscriptionsCost = 0;
+            TWTRStorePerformSyncOnMainThread(^{
+                subscriptionsCost = store.subscriptionsByToken.count * TWTRStoreEstimatedSubscriptionCost;
+            });
+            return subscriptionsCost;
+        };
+        TWTRMemoryTrimBlock trim = ^(NSUInteger targetCost) {
+            TWTRStorePerformSyncOnMainThread(^{
+                [store unsafeRemoveDeallocatedSubscriptions];
+            });
+        };
+        [[TWTRMemoryPressureCoordinator sharedCoordinator] registerCacheNamed:@"TWTRStore.subscriptions" priority:TWTRMemoryPurgePriorityHigh cost:cost trim:trim];
     });
     return store;
 }
@@ -57,7 +99,10 @@
 - (instancetype)init
 {
     if (self = [super init]) {
-        _subscriptions = [NSMutableDictionary dictionary];
+        _subscriptionsByToken = [NSMutableDictionary dictionary];
+        _tokensByObjectKey = [NSMutableDictionary dictionary];
+        _pendingObjectsByObjectKey = [NSMutableDictionary dictionary];
+        _pendingNotificationsLock = [[NSObject alloc] init];
     }
     return self;
 }
@@ -86,70 +131,119 @@
     [self unsafeUnsubscribeSubscriber:subscriber className:NSStringFromClass(objectClass) objectID:objectID];
 }
 
+#pragma mark - Notification
+
 - (void)notifySubscribersOfChangesToObject:(id)object withID:(NSString *)objectID
 {
-    [TWTRMultiThreadUtil assertMainThread];
+    if (object == nil || objectID == nil) {
+        return;
+    }
 
-    NSString *className = NSStringFromClass([object class]);
+    NSString *objectKey = [TWTRSubscription objectKeyForClassName:NSStringFromClass([object class]) key:objectID];
+    BOOL shouldScheduleDelivery = NO;
 
-    NSArray<TWTRSubscription *> *subscriptions = [self subscriptionsForClassName:className objectID:objectID];
-    [subscriptions enumerateObjectsUsingBlock:^(TWTRSubscription *subscription, NSUInteger idx, BOOL *stop) {
-        BOOL keyMatches = [subscription.key isEqualToString:objectID];
-        BOOL classMatches = [subscription.className isEqual:className];
-        if (keyMatches && classMatches) {
-            [subscription.subscriber objectUpdated:object];
+    @synchronized(self.pendingNotificationsLock)
+    {
+        self.pendingObjectsByObjectKey[objectKey] = object;
+
+        if (!self.isDeliveryScheduled) {
+            self.isDeliveryScheduled = YES;
+            shouldScheduleDelivery = YES;
         }
+    }
+
+    if (shouldScheduleDelivery) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self deliverPendingNotifications];
+        });
+    }
+}
+
+- (void)deliverPendingNotifications
+{
+    [TWTRMultiThreadUtil assertMainThread];
+
+    NSDictionary<NSString *, id> *pendingObjects;
+
+    @synchronized(self.pendingNotificationsLock)
+    {
+        pendingObjects = [self.pendingObjectsByObjectKey copy];
+        [self.pendingObjectsByObjectKey removeAllObjects];
+        self.isDeliveryScheduled = NO;
+    }
+
+    [pendingObjects enumerateKeysAndObjectsUsingBlock:^(NSString *objectKey, id object, BOOL *stop) {
+        [self unsafeDeliverObject:object toSubscribersOfObjectKey:objectKey];
     }];
 }
 
-#pragma mark - Unsafe Mutating Methods
+#pragma mark - Unsafe Mutating Methods (Main Thread Only)
 
 - (void)unsafeAddSubscriber:(id<TWTRSubscriber>)subscriber className:(NSString *)className key:(NSString *)key
 {
     TWTRSubscription *subscription = [[TWTRSubscription alloc] initWithSubscriber:subscriber className:className key:key];
-    NSMutableArray *subscriptions = [self subscriptionsForClassName:className objectID:key];
-    [subscriptions addObject:subscription];
+
+    NSMutableSet<NSString *> *tokens = self.tokensByObjectKey[subscription.objectKey];
+    if (tokens == nil) {
+        tokens = [NSMutableSet set];
+        self.tokensByObjectKey[subscription.objectKey] = tokens;
+    }
+
+    [tokens addObject:subscription.token];
+    self.subscriptionsByToken[subscription.token] = subscription;
 }
 
 - (void)unsafeUnsubscribeSubscriber:(id<TWTRSubscriber>)subscriber className:(NSString *)className objectID:(NSString *)objectID
 {
-    NSMutableArray *subscriptions = [self subscriptionsForClassName:className objectID:objectID];
-    NSIndexSet *indexes = [subscriptions indexesOfObjectsPassingTest:^BOOL(TWTRSubscription *subscription, NSUInteger idx, BOOL *stop) {
-        return [subscription.subscriber isEqual:subscriber];
-    }];
-    [subscriptions removeObjectsAtIndexes:indexes];
+    NSString *token = [TWTRSubscription tokenForSubscriber:subscriber className:className key:objectID];
+    TWTRSubscription *subscription = self.subscriptionsByToken[token];
+
+    // Subscribers unsubscribe from -dealloc, when their weak reference already reads nil. The token encodes the
+    // address, class and ID, so a nil subscriber is ours. Only a live subscription of another object that reused
+    // the address is left alone.
+    if (subscription && (subscription.subscriber == subscriber || subscription.subscriber == nil)) {
+        [self unsafeRemoveSubscription:subscription];
+    }
 }
 
-#pragma mark - Helpers
-
-/**
- *  Return an array of all the subscriptions that exist for this class/objectID pair
- *
- *  e.g. [subscriber1, subscriber2]
- */
-- (NSMutableArray<TWTRSubscription *> *)subscriptionsForClassName:(NSString *)className objectID:(nonnull NSString *)objectID
+- (void)unsafeRemoveSubscription:(TWTRSubscription *)subscription
 {
-    if ([self subscriptionsForClassName:className][objectID] == nil) {
-        self.subscriptions[className][objectID] = [NSMutableArray array];
-    }
+    [self.subscriptionsByToken removeObjectForKey:subscription.token];
+
+    NSMutableSet<NSString *> *tokens = self.tokensByObjectKey[subscription.objectKey];
+    [tokens removeObject:subscription.token];
 
-    return self.subscriptions[className][objectID];
+    if (tokens.count == 0) {
+        [self.tokensByObjectKey removeObjectForKey:subscription.objectKey];
+    }
 }
 
-/**
- *  Return the dictionary of subscribers.
- *
- *  e.g.   {@"34890723", [subscriber1, subscriber2],
- *          @"19872398", [subscriber2, subscriber3]}
- */
-- (NSMutableDictionary<NSString *, NSMutableArray<TWTRSubscription *> *> *)subscriptionsForClassName:(NSString *)className
+- (void)unsafeRemoveDeallocatedSubscriptions
 {
-    if (self.subscriptions[className] == nil) {
-        NSMutableDictionary<NSString *, NSMutableArray<TWTRSubscription *> *> *subscriptionsByObjectID = [NSMutableDictionary dictionary];
-        self.subscriptions[className] = subscriptionsByObjectID;
+    for (TWTRSubscription *subscription in [self.subscriptionsByToken allValues]) {
+        if (subscription.subscriber == nil) {
+            [self unsafeRemoveSubscription:subscription];
+        }
     }
+}
 
-    return self.subscriptions[className];
+- (void)unsafeDeliverObject:(id)object toSubscribersOfObjectKey:(NSString *)objectKey
+{
+    // Subscribers commonly re-subscribe while handling an update, so iterate over a copy.
+    NSArray<NSString *> *tokens = [self.tokensByObjectKey[objectKey] allObjects];
+
+    for (NSString *token in tokens) {
+        TWTRSubscription *subscription = self.subscriptionsByToken[token];
+        id<TWTRSubscriber> subscriber = subscription.subscriber;
+
+        if (subscription == nil) {
+            continue;
+        } else if (subscriber == nil) {
+            [self unsafeRemoveSubscription:subscription];
+        } else {
+            [subscriber objectUpdated:object];
+        }
+    }
 }
 
 @end
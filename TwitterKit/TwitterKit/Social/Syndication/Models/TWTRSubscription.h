@@ -45,6 +45,20 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, copy, readonly) NSString *key;
 
+/**
+ *  Uniquely identifies this subscriber/class/key combination. Subscribing the same
+ *  subscriber twice to the same object produces the same token.
+ */
+@property (nonatomic, copy, readonly) NSString *token;
+
+/**
+ *  Identifies the observed object, shared by every subscription to it.
+ */
+@property (nonatomic, copy, readonly) NSString *objectKey;
+
++ (NSString *)tokenForSubscriber:(id<TWTRSubscriber>)subscriber className:(NSString *)className key:(NSString *)key;
++ (NSString *)objectKeyForClassName:(NSString *)className key:(NSString *)key;
+
 /**
  *  Initialize with an object desiring to be notified when a particular object
  *  changes.
@@ -26,9 +26,21 @@
         _subscriber = subscriber;
         _className = [className copy];
         _key = [key copy];
+        _objectKey = [[self class] objectKeyForClassName:className key:key];
+        _token = [[self class] tokenForSubscriber:subscriber className:className key:key];
     }
 
     return self;
 }
 
++ (NSString *)tokenForSubscriber:(id<TWTRSubscriber>)subscriber className:(NSString *)className key:(NSString *)key
+{
+    return [NSString stringWithFormat:@"%p/%@", subscriber, [self objectKeyForClassName:className key:key]];
+}
+
++ (NSString *)objectKeyForClassName:(NSString *)className key:(NSString *)key
+{
+    return [NSString stringWithFormat:@"%@/%@", className, key];
+}
+
 @end
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ This header is private to the Twitter Kit SDK and not exposed for public SDK consumption
+ */
+
+#import <Foundation/Foundation.h>
+
+@class TWTRAPIClient;
+@class TWTRTweet;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Called once per lookup with the Tweets that were found. Tweets the API did not return are
+ *  simply missing from the array. If the lookup failed `tweets` is nil and `error` is set.
+ */
+typedef void (^TWTRTweetLookupBatcherCompletion)(NSArray<TWTRTweet *> *_Nullable tweets, NSError *_Nullable error);
+
+/**
+ *  Called once for every `statuses/lookup` response with the Tweets it contained and the
+ *  ID of the user the Tweets were loaded for.
+ */
+typedef void (^TWTRTweetLookupBatcherFetchHandler)(NSArray<TWTRTweet *> *tweets, NSString *_Nullable perspective);
+
+/**
+ *  Coalesces Tweet lookups from any number of callers into as few `statuses/lookup` requests
+ *  as possible. IDs requested within `batchingInterval` of each other are sent together, up to
+ *  `maximumBatchSize` IDs per request, and IDs that are already being looked up are not requested
+ *  again. Lookups are only batched with others made for the same user and parameters.
+ */
+@interface TWTRTweetLookupBatcher : NSObject
+
+/**
+ *  How long to wait for more IDs before sending a request.
+ */
+@property (nonatomic, readonly) NSTimeInterval batchingInterval;
+
+/**
+ *  The most IDs sent in a single request.
+ */
+@property (nonatomic, readonly) NSUInteger maximumBatchSize;
+
+/**
+ *  Creates a batcher with the default interval and the `statuses/lookup` limit of 100 IDs.
+ *
+ *  @param fetchHandler Invoked on a private queue with every batch of Tweets loaded from the network.
+ */
+- (instancetype)initWithFetchHandler:(nullable TWTRTweetLookupBatcherFetchHandler)fetchHandler;
+
+- (instancetype)initWithBatchingInterval:(NSTimeInterval)batchingInterval maximumBatchSize:(NSUInteger)maximumBatchSize fetchHandler:(nullable TWTRTweetLookupBatcherFetchHandler)fetchHandler NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ *  Looks up Tweets from the network, sharing requests with other callers where possible.
+ *
+ *  @param tweetIDs   The IDs of the Tweets to load.
+ *  @param client     The API client to send the request with.
+ *  @param parameters Additional parameters to append to the request.
+ *  @param completion Called on a private queue once every ID has been resolved.
+ */
+- (void)loadTweetsWithIDs:(NSArray<NSString *> *)tweetIDs APIClient:(TWTRAPIClient *)client additionalParameters:(nullable NSDictionary *)parameters completion:(TWTRTweetLookupBatcherCompletion)completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRTweetLookupBatcher.h"
+#import <TwitterCore/TWTRAPIConstants.h>
+#import <TwitterCore/TWTRAPIServiceConfig.h>
+#import <TwitterCore/TWTRAPIServiceConfigRegistry.h>
+#import <TwitterCore/TWTRAssertionMacros.h>
+#import "TWTRAPIClient.h"
+#import "TWTRAPIClient_Private.h"
+#import "TWTRAPIConstantsStatus.h"
+#import "TWTRTweet.h"
+
+static NSTimeInterval const TWTRTweetLookupDefaultBatchingInterval = 0.005;
+static NSUInteger const TWTRTweetLookupMaximumIDsPerRequest = 100;
+
+/**
+ *  A single call to -[TWTRTweetLookupBatcher loadTweetsWithIDs:...] waiting for its IDs to resolve.
+ */
+@interface TWTRTweetLookupWaiter : NSObject
+
+@property (nonatomic, readonly) NSMutableSet<NSString *> *outstandingTweetIDs;
+@property (nonatomic, readonly) NSMutableArray<TWTRTweet *> *tweets;
+@property (nonatomic, copy, nullable) TWTRTweetLookupBatcherCompletion completion;
+
+@end
+
+@implementation TWTRTweetLookupWaiter
+
+- (instancetype)initWithCompletion:(TWTRTweetLookupBatcherCompletion)completion
+{
+    self = [super init];
+    if (self) {
+        _outstandingTweetIDs = [NSMutableSet set];
+        _tweets = [NSMutableArray array];
+        _completion = [completion copy];
+    }
+    return self;
+}
+
+- (void)resolveTweetID:(NSString *)tweetID withTweet:(TWTRTweet *)tweet error:(NSError *)error
+{
+    if (!self.completion) {
+        return;
+    }
+
+    if (error) {
+        [self finishWithTweets:nil error:error];
+        return;
+    }
+
+    if (tweet) {
+        [self.tweets addObject:tweet];
+    }
+    [self.outstandingTweetIDs removeObject:tweetID];
+
+    if (self.outstandingTweetIDs.count == 0) {
+        [self finishWithTweets:[self.tweets copy] error:nil];
+    }
+}
+
+- (void)finishWithTweets:(NSArray *)tweets error:(NSError *)error
+{
+    TWTRTweetLookupBatcherCompletion completion = self.completion;
+    self.completion = nil;
+    completion(tweets, error);
+}
+
+@end
+
+/**
+ *  The IDs waiting to be sent or in flight for one user and set of parameters.
+ */
+@interface TWTRTweetLookupBatch : NSObject
+
+@property (nonatomic) TWTRAPIClient *client;
+@property (nonatomic, copy, readonly, nullable) NSDictionary *parameters;
+@property (nonatomic, readonly) NSMutableOrderedSet<NSString *> *pendingTweetIDs;
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, NSMutableArray<TWTRTweetLookupWaiter *> *> *waitersByTweetID;
+@property (nonatomic, getter=isFlushScheduled) BOOL flushScheduled;
+
+@end
+
+@implementation TWTRTweetLookupBatch
+
+- (instancetype)initWithParameters:(NSDictionary *)parameters
+{
+    self = [super init];
+    if (self) {
+        _parameters = [parameters copy];
+        _pendingTweetIDs = [NSMutableOrderedSet orderedSet];
+        _waitersByTweetID = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+@end
+
+@interface TWTRTweetLookupBatcher ()
+
+@property (nonatomic, copy, readonly, nullable) TWTRTweetLookupBatcherFetchHandler fetchHandler;
+
+/**
+ *  Serializes all access to the batches. Network responses are also delivered on this queue.
+ */
+@property (nonatomic, readonly) dispatch_queue_t batchingQueue;
+
+/**
+ *  Batches keyed by the user ID and parameters they are sent with.
+ */
+@property (nonatomic, readonly) NSMutableDictionary<NSArray *, TWTRTweetLookupBatch *> *batches;
+
+@end
+
+@implementation TWTRTweetLookupBatcher
+
+- (instancetype)initWithFetchHandler:(TWTRTweetLookupBatcherFetchHandler)fetchHandler
+{
+    return [self initWithBatchingInterval:TWTRTweetLookupDefaultBatchingInterval maximumBatchSize:TWTRTweetLookupMaximumIDsPerRequest fetchHandler:fetchHandler];
+}
+
+- (instancetype)initWithBatchingInterval:(NSTimeInterval)batchingInterval maximumBatchSize:(NSUInteger)maximumBatchSize fetchHandler:(TWTRTweetLookupBatcherFetchHandler)fetchHandler
+{
+    TWTRParameterAssertOrReturnValue(maximumBatchSize > 0, nil);
+
+    self = [super init];
+    if (self) {
+        _batchingInterval = batchingInterval;
+        _maximumBatchSize = MIN(maximumBatchSize, TWTRTweetLookupMaximumIDsPerRequest);
+        _fetchHandler = [fetchHandler copy];
+        _batchingQueue = dispatch_queue_create("com.twitterkit.tweet-lookup-batcher.batching-queue", DISPATCH_QUEUE_SERIAL);
+        _batches = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)loadTweetsWithIDs:(NSArray<NSString *> *)tweetIDs APIClient:(TWTRAPIClient *)client additionalParameters:(NSDictionary *)parameters completion:(TWTRTweetLookupBatcherCompletion)completion
+{
+    TWTRParameterAssertOrReturn(client);
+    TWTRParameterAssertOrReturn(completion);
+
+    NSArray *uniqueTweetIDs = [[NSOrderedSet orderedSetWithArray:tweetIDs] array];
+    if (uniqueTweetIDs.count == 0) {
+        completion(@[], nil);
+        return;
+    }
+
+    dispatch_async(self.batchingQueue, ^{
+        TWTRTweetLookupBatch *batch = [self batchForClient:client parameters:parameters];
+        TWTRTweetLookupWaiter *waiter = [[TWTRTweetLookupWaiter alloc] initWithCompletion:completion];
+
+        for (NSString *tweetID in uniqueTweetIDs) {
+            [waiter.outstandingTweetIDs addObject:tweetID];
+
+            NSMutableArray *waiters = batch.waitersByTweetID[tweetID];
+            if (!waiters) {
+                // Not pending or in flight yet, so it needs to go out with the next request.
+                waiters = [NSMutableArray array];
+                batch.waitersByTweetID[tweetID] = waiters;
+                [batch.pendingTweetIDs addObject:tweetID];
+            }
+            [waiters addObject:waiter];
+        }
+
+        if (batch.pendingTweetIDs.count >= self.maximumBatchSize) {
+            [self flushBatch:batch];
+        } else if (!batch.isFlushScheduled && batch.pendingTweetIDs.count > 0) {
+            batch.flushScheduled = YES;
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.batchingInterval * NSEC_PER_SEC)), self.batchingQueue, ^{
+                [self flushBatch:batch];
+            });
+        }
+    });
+}
+
+#pragma mark - Batching
+
+- (TWTRTweetLookupBatch *)batchForClient:(TWTRAPIClient *)client parameters:(NSDictionary *)parameters
+{
+    NSArray *key = @[client.userID ?: @"", parameters ?: @{}];
+    TWTRTweetLookupBatch *batch = self.batches[key];
+    if (!batch) {
+        batch = [[TWTRTweetLookupBatch alloc] initWithParameters:parameters];
+        self.batches[key] = batch;
+    }
+
+    // Any client for the same user signs requests the same way, use the latest one.
+    batch.client = client;
+    return batch;
+}
+
+- (void)removeBatchIfFinished:(TWTRTweetLookupBatch *)batch
+{
+    if (batch.waitersByTweetID.count > 0 || batch.isFlushScheduled) {
+        return;
+    }
+
+    for (NSArray *key in [self.batches allKeysForObject:batch]) {
+        [self.batches removeObjectForKey:key];
+    }
+}
+
+- (void)flushBatch:(TWTRTweetLookupBatch *)batch
+{
+    batch.flushScheduled = NO;
+
+    while (batch.pendingTweetIDs.count > 0) {
+        NSRange range = NSMakeRange(0, MIN(batch.pendingTweetIDs.count, self.maximumBatchSize));
+        NSArray *tweetIDs = [[batch.pendingTweetIDs array] subarrayWithRange:range];
+        [batch.pendingTweetIDs removeObjectsInRange:range];
+
+        [self sendLookupForTweetIDs:tweetIDs batch:batch];
+    }
+
+    [self removeBatchIfFinished:batch];
+}
+
+- (void)sendLookupForTweetIDs:(NSArray *)tweetIDs batch:(TWTRTweetLookupBatch *)batch
+{
+    NSError *requestError;
+    TWTRAPIClient *client = batch.client;
+    NSURLRequest *request = [[self class] lookupRequestForTweetIDs:tweetIDs APIClient:client additionalParameters:batch.parameters error:&requestError];
+    if (!request) {
+        [self resolveTweetIDs:tweetIDs inBatch:batch withTweets:nil error:requestError];
+        return;
+    }
+
+    // The response is delivered on the batching queue.
+    [client sendTwitterRequest:request
+                         queue:self.batchingQueue
+                    completion:^(NSURLResponse *response, NSData *data, NSError *connectionError) {
+                        NSArray *tweets = nil;
+                        NSError *error = connectionError;
+
+                        if (data && !connectionError) {
+                            NSError *jsonSerializationErr;
+                            NSArray *tweetListDicts = [NSJSONSerialization JSONObjectWithData:data options:0 error:&jsonSerializationErr];
+                            if (jsonSerializationErr) {
+                                error = jsonSerializationErr;
+                            } else {
+                                tweets = [TWTRTweet tweetsWithJSONArray:tweetListDicts];
+                            }
+                        }
+
+                        if (tweets && self.fetchHandler) {
+                            self.fetchHandler(tweets, client.userID);
+                        }
+
+                        [self resolveTweetIDs:tweetIDs inBatch:batch withTweets:tweets error:error];
+                        [self removeBatchIfFinished:batch];
+                    }];
+}
+
+- (void)resolveTweetIDs:(NSArray *)tweetIDs inBatch:(TWTRTweetLookupBatch *)batch withTweets:(NSArray<TWTRTweet *> *)tweets error:(NSError *)error
+{
+    NSMutableDictionary<NSString *, TWTRTweet *> *tweetsByID = [NSMutableDictionary dictionaryWithCapacity:tweets.count];
+    for (TWTRTweet *tweet in tweets) {
+        tweetsByID[tweet.tweetID] = tweet;
+    }
+
+    for (NSString *tweetID in tweetIDs) {
+        NSArray *waiters = batch.waitersByTweetID[tweetID];
+        [batch.waitersByTweetID removeObjectForKey:tweetID];
+
+        for (TWTRTweetLookupWaiter *waiter in waiters) {
+            [waiter resolveTweetID:tweetID withTweet:tweetsByID[tweetID] error:error];
+        }
+    }
+}
+
+#pragma mark - Request Builders
+
++ (NSURLRequest *)lookupRequestForTweetIDs:(NSArray *)tweetIDsStrings APIClient:(TWTRAPIClient *)client additionalParameters:(nullable NSDictionary *)additionalParams error:(NSError **)error
+{
+    id<TWTRAPIServiceConfig> config = [[TWTRAPIServiceConfigRegistry defaultRegistry] configForType:TWTRAPIServiceConfigTypeDefault];
+    NSURL *URL = TWTRAPIURLWithPath(config, TWTRAPIConstantsStatusLookUpURL);
+
+    NSString *tweetIDParamString = [tweetIDsStrings componentsJoinedByString:@","];
+
+    NSMutableDictionary *params = additionalParams ? [additionalParams mutableCopy] : [NSMutableDictionary dictionary];
+    params[TWTRAPIConstantsParamID] = tweetIDParamString;
+
+    return [client URLRequestWithMethod:@"GET" URLString:URL.absoluteString parameters:params error:error];
+}
+
+@end
@@ -16,19 +16,16 @@
  */
 
 #import "TWTRTweetRepository.h"
-#import <TwitterCore/TWTRAPIConstants.h>
-#import <TwitterCore/TWTRAPIServiceConfig.h>
-#import <TwitterCore/TWTRAPIServiceConfigRegistry.h>
 #import <TwitterCore/TWTRAssertionMacros.h>
 #import <TwitterCore/TWTRConstants.h>
 #import <TwitterCore/TWTRSessionStore.h>
 #import "TWTRAPIClient.h"
-#import "TWTRAPIConstantsStatus.h"
 #import "TWTRStore.h"
 #import "TWTRSubscriber.h"
 #import "TWTRSubscription.h"
 #import "TWTRTweet.h"
 #import "TWTRTweetCache.h"
+#import "TWTRTweetLookupBatcher.h"
 #import "TWTRTwitter.h"
 #import "TWTRUser.h"
 
@@ -41,6 +38,11 @@ static const NSUInteger TWTRTweetCacheMaxSize = 5 * MB;
 
 @property (nonatomic, strong) id<TWTRTweetCache> cache;
 
+/**
+ *  Coalesces cache misses from concurrent loads into shared `statuses/lookup` requests.
+ */
+@property (nonatomic, readonly) TWTRTweetLookupBatcher *lookupBatcher;
+
 @end
 
 @implementation TWTRTweetRepository
@@ -68,6 +70,22 @@ static const NSUInteger TWTRTweetCacheMaxSize = 5 * MB;
 
     if (self) {
         _cache = cache;
+
+        @weakify(self);
+        _lookupBatcher = [[TWTRTweetLookupBatcher alloc] initWithFetchHandler:^(NSArray<TWTRTweet *> *tweets, NSString *perspective) {
+            @strongify(self);
+            // Fetched Tweets arrive on the batcher's queue. They are cached right away so the lookups they
+            // complete can hit the cache, but subscribers are only notified on the main thread.
+            for (TWTRTweet *tweet in tweets) {
+                [self.cache storeTweet:tweet perspective:perspective];
+            }
+
+            dispatch_async(dispatch_get_main_queue(), ^{
+                for (TWTRTweet *tweet in tweets) {
+                    [[TWTRStore sharedInstance] notifySubscribersOfChangesToObject:tweet withID:tweet.tweetID];
+                }
+            });
+        }];
     }
 
     return self;
@@ -90,58 +108,38 @@ static const NSUInteger TWTRTweetCacheMaxSize = 5 * MB;
                        completion:^(NSArray *cachedTweets, NSArray *cacheMissTweetIDs) {
                            // Fire off network request if there's any Tweets we need to backfill
                            if ([cacheMissTweetIDs count] > 0) {
-                               // Set up the completion block to backfill the cache
-                               TWTRNetworkCompletion networkRespCompletion = ^(NSURLResponse *resp, NSData *data, NSError *error) {
-                                   if (!data || error) {
-                                       completion(nil, error);
-                                       return;
-                                   }
-
-                                   NSError *jsonSerializationErr;
-                                   NSArray *tweetListDicts = [NSJSONSerialization JSONObjectWithData:data options:0 error:&jsonSerializationErr];
-
-                                   if (jsonSerializationErr) {
-                                       completion(nil, jsonSerializationErr);
-                                       return;
-                                   }
-
-                                   NSArray *networkTweets = [TWTRTweet tweetsWithJSONArray:tweetListDicts];
-
-                                   for (TWTRTweet *tweet in networkTweets) {
-                                       [self cacheTweet:tweet perspective:userIDString];
-                                       [[TWTRStore sharedInstance] notifySubscribersOfChangesToObject:tweet withID:tweet.tweetID];
-                                   }
-
-                                   NSArray *combinedTweets = [networkTweets arrayByAddingObjectsFromArray:cachedTweets];
-                                   NSArray *sortedTweets = [TWTRTweetRepository sortedArrayWithArray:combinedTweets withIDsArray:tweetIDStrings];
-
-                                   // The api will return 200 and just drop the tweets which have invalid ids. We want
-                                   // to return successfully loaded tweets and an error that includes a list of IDs that
-                                   // failed to load.
-                                   NSError *invalidTweetIDError;
-                                   if ([networkTweets count] < [cacheMissTweetIDs count]) {
-                                       NSMutableArray *failedTweetIDs = [tweetIDStrings mutableCopy];
-                                       for (TWTRTweet *tweet in sortedTweets) {
-                                           [failedTweetIDs removeObject:tweet.tweetID];
-                                       }
-
-                                       NSString *errorMessage = [NSString stringWithFormat:@"Failed to fetch one or more of the following tweet IDs: %@.", [failedTweetIDs componentsJoinedByString:@", "]];
-                                       invalidTweetIDError = [NSError errorWithDomain:TWTRErrorDomain code:TWTRErrorCodeInvalidResourceID userInfo:@{NSLocalizedDescriptionKey: errorMessage, TWTRTweetsNotLoadedKey: [failedTweetIDs copy]}];
-                                   }
-
-                                   dispatch_async(dispatch_get_main_queue(), ^{
-                                       completion(sortedTweets, invalidTweetIDError);
-                                   });
-                               };
-
-                               // Get the request for cache miss Tweets
-                               NSError *requestError;
-                               NSURLRequest *request = [self lookupRequestForTweetIDs:cacheMissTweetIDs APIClient:client additionalParameters:parameters error:&requestError];
-                               if (requestError) {
-                                   completion(nil, requestError);
-                                   return;
-                               }
-                               [client sendTwitterRequest:request completion:networkRespCompletion];
+                               [self.lookupBatcher loadTweetsWithIDs:cacheMissTweetIDs
+                                                           APIClient:client
+                                                additionalParameters:parameters
+                                                          completion:^(NSArray<TWTRTweet *> *networkTweets, NSError *error) {
+                                                              if (!networkTweets) {
+                                                                  dispatch_async(dispatch_get_main_queue(), ^{
+                                                                      completion(nil, error);
+                                                                  });
+                                                                  return;
+                                                              }
+
+                                                              NSArray *combinedTweets = [networkTweets arrayByAddingObjectsFromArray:cachedTweets];
+                                                              NSArray *sortedTweets = [TWTRTweetRepository sortedArrayWithArray:combinedTweets withIDsArray:tweetIDStrings];
+
+                                                              // The api will return 200 and just drop the tweets which have invalid ids. We want
+                                                              // to return successfully loaded tweets and an error that includes a list of IDs that
+                                                              // failed to load.
+                                                              NSError *invalidTweetIDError;
+                                                              if ([networkTweets count] < [cacheMissTweetIDs count]) {
+                                                                  NSMutableArray *failedTweetIDs = [tweetIDStrings mutableCopy];
+                                                                  for (TWTRTweet *tweet in sortedTweets) {
+                                                                      [failedTweetIDs removeObject:tweet.tweetID];
+                                                                  }
+
+                                                                  NSString *errorMessage = [NSString stringWithFormat:@"Failed to fetch one or more of the following tweet IDs: %@.", [failedTweetIDs componentsJoinedByString:@", "]];
+                                                                  invalidTweetIDError = [NSError errorWithDomain:TWTRErrorDomain code:TWTRErrorCodeInvalidResourceID userInfo:@{NSLocalizedDescriptionKey: errorMessage, TWTRTweetsNotLoadedKey: [failedTweetIDs copy]}];
+                                                              }
+
+                                                              dispatch_async(dispatch_get_main_queue(), ^{
+                                                                  completion(sortedTweets, invalidTweetIDError);
+                                                              });
+                                                          }];
                            } else {
                                completion(cachedTweets, nil);
                            }
@@ -223,19 +221,4 @@ static const NSUInteger TWTRTweetCacheMaxSize = 5 * MB;
     return tweetCacheFullPath;
 }
 
-#pragma mark - Request Builders
-
-- (NSURLRequest *)lookupRequestForTweetIDs:(NSArray *)tweetIDsStrings APIClient:(TWTRAPIClient *)client additionalParameters:(nullable NSDictionary *)additionalParams error:(NSError **)error
-{
-    id<TWTRAPIServiceConfig> config = [[TWTRAPIServiceConfigRegistry defaultRegistry] configForType:TWTRAPIServiceConfigTypeDefault];
-    NSURL *URL = TWTRAPIURLWithPath(config, TWTRAPIConstantsStatusLookUpURL);
-
-    NSString *tweetIDParamString = [tweetIDsStrings componentsJoinedByString:@","];
-
-    NSMutableDictionary *params = additionalParams ? [additionalParams mutableCopy] : [NSMutableDictionary dictionary];
-    params[TWTRAPIConstantsParamID] = tweetIDParamString;
-
-    return [client URLRequestWithMethod:@"GET" URLString:URL.absoluteString parameters:params error:error];
-}
-
 @end
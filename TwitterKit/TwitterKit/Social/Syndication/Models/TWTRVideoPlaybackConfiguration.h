@@ -23,9 +23,11 @@
 #import "TWTRMediaType.h"
 
 @class TWTRCardEntity;
+@class TWTRTweet;
 @class TWTRTweetMediaEntity;
 @class TWTRTweetUrlEntity;
 @class TWTRVideoDeeplinkConfiguration;
+@class TWTRVideoMetaDataVariant;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -62,14 +64,33 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, readonly, nullable) TWTRVideoDeeplinkConfiguration *deeplinkConfiguration;
 
+/**
+ * All the encodings of this video. Empty when only `videoURL` is known.
+ */
+@property (nonatomic, copy, readonly) NSArray<TWTRVideoMetaDataVariant *> *videoVariants;
+
 /**
  * Initializes the receiver with the given values.
  */
 - (instancetype)initWithVideoURL:(NSURL *)URL aspectRatio:(CGFloat)aspectRatio duration:(NSTimeInterval)duration mediaType:(TWTRMediaType)mediaType mediaID:(NSString *)mediaID deeplinkConfiguration:(nullable TWTRVideoDeeplinkConfiguration *)deeplinkConfiguration;
+- (instancetype)initWithVideoURL:(NSURL *)URL aspectRatio:(CGFloat)aspectRatio duration:(NSTimeInterval)duration mediaType:(TWTRMediaType)mediaType mediaID:(NSString *)mediaID deeplinkConfiguration:(nullable TWTRVideoDeeplinkConfiguration *)deeplinkConfiguration videoVariants:(NSArray<TWTRVideoMetaDataVariant *> *)videoVariants;
+
+/**
+ * Returns the variant to play in a view of the given size, in pixels, taking the
+ * current network throughput and the data saver preference into account.
+ * Returns nil when there are no variants to choose from.
+ */
+- (nullable TWTRVideoMetaDataVariant *)videoVariantForRenderedPixelSize:(CGSize)renderedPixelSize;
+
+/**
+ * The URL of `videoVariantForRenderedPixelSize:`, falling back to `videoURL`.
+ */
+- (NSURL *)videoURLForRenderedPixelSize:(CGSize)renderedPixelSize;
 
 /**
  * Returns a playback configuration object for the given meta data object.
  */
++ (nullable instancetype)playbackConfigurationForTweet:(TWTRTweet *)tweet;
 + (nullable instancetype)playbackConfigurationForTweetMediaEntity:(TWTRTweetMediaEntity *)mediaEntity;
 + (nullable instancetype)playbackConfigurationForCardEntity:(TWTRCardEntity *)cardEntity URLEntities:(NSArray<TWTRTweetUrlEntity *> *)URLEntities;
 
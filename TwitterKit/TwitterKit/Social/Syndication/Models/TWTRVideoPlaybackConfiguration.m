@@ -16,18 +16,28 @@
  */
 
 #import "TWTRVideoPlaybackConfiguration.h"
+#import <TwitterCore/TWTRNetworkThroughputEstimator.h>
 #import "TWTRCardEntity.h"
 #import "TWTRPlayerCardEntity.h"
 #import "TWTRTranslationsUtil.h"
+#import "TWTRTweet.h"
 #import "TWTRTweetMediaEntity.h"
 #import "TWTRTweetUrlEntity.h"
+#import "TWTRTweet_Private.h"
+#import "TWTRTwitter.h"
 #import "TWTRVideoDeeplinkConfiguration.h"
 #import "TWTRVideoMetaData.h"
+#import "TWTRVideoVariantSelector.h"
 #import "TWTRViewUtil.h"
 
 @implementation TWTRVideoPlaybackConfiguration
 
 - (instancetype)initWithVideoURL:(NSURL *)URL aspectRatio:(CGFloat)aspectRatio duration:(NSTimeInterval)duration mediaType:(TWTRMediaType)mediaType mediaID:(NSString *)mediaID deeplinkConfiguration:(nullable TWTRVideoDeeplinkConfiguration *)deeplinkConfiguration
+{
+    return [self initWithVideoURL:URL aspectRatio:aspectRatio duration:duration mediaType:mediaType mediaID:mediaID deeplinkConfiguration:deeplinkConfiguration videoVariants:@[]];
+}
+
+- (instancetype)initWithVideoURL:(NSURL *)URL aspectRatio:(CGFloat)aspectRatio duration:(NSTimeInterval)duration mediaType:(TWTRMediaType)mediaType mediaID:(NSString *)mediaID deeplinkConfiguration:(nullable TWTRVideoDeeplinkConfiguration *)deeplinkConfiguration videoVariants:(NSArray<TWTRVideoMetaDataVariant *> *)videoVariants
 {
     self = [super init];
     if (self) {
@@ -37,10 +47,38 @@
         _mediaID = [mediaID copy];
         _aspectRatio = aspectRatio;
         _deeplinkConfiguration = deeplinkConfiguration;
+        _videoVariants = [videoVariants copy] ?: @[];
     }
     return self;
 }
 
+- (nullable TWTRVideoMetaDataVariant *)videoVariantForRenderedPixelSize:(CGSize)renderedPixelSize
+{
+    if (self.videoVariants.count == 0) {
+        return nil;
+    }
+
+    double throughput = [TWTRNetworkThroughputEstimator sharedEstimator].estimatedBitsPerSecond;
+    BOOL prefersReducedDataUsage = [TWTRTwitter sharedInstance].prefersReducedVideoDataUsage;
+
+    return [TWTRVideoVariantSelector variantFromVariants:self.videoVariants renderedPixelSize:renderedPixelSize throughput:throughput prefersReducedDataUsage:prefersReducedDataUsage];
+}
+
+- (NSURL *)videoURLForRenderedPixelSize:(CGSize)renderedPixelSize
+{
+    return [self videoVariantForRenderedPixelSize:renderedPixelSize].URL ?: self.videoURL;
+}
+
++ (nullable instancetype)playbackConfigurationForTweet:(TWTRTweet *)tweet
+{
+    TWTRTweetMediaEntity *mediaEntity = tweet.media.firstObject;
+    if (mediaEntity) {
+        return [self playbackConfigurationForTweetMediaEntity:mediaEntity];
+    } else {
+        return [self playbackConfigurationForCardEntity:tweet.cardEntity URLEntities:tweet.urls];
+    }
+}
+
 + (nullable instancetype)playbackConfigurationForTweetMediaEntity:(TWTRTweetMediaEntity *)mediaEntity
 {
     TWTRVideoMetaData *videoMetaData = mediaEntity.videoMetaData;
@@ -51,7 +89,7 @@
     TWTRVideoMetaDataVariant *variant = [[self class] bestVariantFromMetaData:videoMetaData];
     NSURL *URL = variant.URL;
 
-    return [[TWTRVideoPlaybackConfiguration alloc] initWithVideoURL:URL aspectRatio:videoMetaData.aspectRatio duration:videoMetaData.duration mediaType:mediaEntity.mediaType mediaID:mediaEntity.mediaID deeplinkConfiguration:nil];
+    return [[TWTRVideoPlaybackConfiguration alloc] initWithVideoURL:URL aspectRatio:videoMetaData.aspectRatio duration:videoMetaData.duration mediaType:mediaEntity.mediaType mediaID:mediaEntity.mediaID deeplinkConfiguration:nil videoVariants:videoMetaData.variants];
 }
 
 + (TWTRVideoMetaDataVariant *)bestVariantFromMetaData:(TWTRVideoMetaData *)videoMetaData
@@ -70,13 +108,7 @@
 
 + (TWTRVideoMetaDataVariant *)lowestBitrateVariant:(TWTRVideoMetaData *)videoMetaData
 {
-    NSIndexSet *mp4Indexes = [[videoMetaData variants] indexesOfObjectsPassingTest:^BOOL(TWTRVideoMetaDataVariant *obj, NSUInteger idx, BOOL *stop) {
-        return [TWTRMediaTypeMP4 isEqualToString:obj.contentType];
-    }];
-
-    return [[[[videoMetaData variants] objectsAtIndexes:mp4Indexes] sortedArrayUsingComparator:^NSComparisonResult(TWTRVideoMetaDataVariant *obj1, TWTRVideoMetaDataVariant *obj2) {
-        return [@(obj1.bitrate) compare:@(obj2.bitrate)];
-    }] firstObject];
+    return [TWTRVideoVariantSelector lowestBitrateVariantFromVariants:[videoMetaData variants]];
 }
 
 #pragma mark - Card Entity
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ This header is private to the Twitter Kit SDK and not exposed for public SDK consumption
+ */
+
+#import <UIKit/UIKit.h>
+
+@class TWTRVideoMetaDataVariant;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Chooses which variant of a video to play. This only looks at the variant metadata
+ * and the values passed in, so the same inputs always give the same variant.
+ */
+@interface TWTRVideoVariantSelector : NSObject
+
+/**
+ * Returns the variant to play in a view of the given size, in pixels.
+ *
+ * Progressive mp4 variants are preferred. The HLS playlist is only used when there
+ * are no mp4 variants. Within the bitrates the connection can sustain, this picks the
+ * smallest variant whose resolution covers `renderedPixelSize` when drawn aspect fit.
+ * If none do, it picks the largest sustainable variant. When nothing is sustainable,
+ * or data usage should be reduced, it picks the lowest bitrate.
+ *
+ * @param variants The variants to choose from.
+ * @param renderedPixelSize The size the video is drawn at, or `CGSizeZero` if unknown.
+ * @param bitsPerSecond The estimated throughput, or 0 if unknown.
+ * @param prefersReducedDataUsage Whether the lowest bitrate should always be used.
+ */
++ (nullable TWTRVideoMetaDataVariant *)variantFromVariants:(NSArray<TWTRVideoMetaDataVariant *> *)variants renderedPixelSize:(CGSize)renderedPixelSize throughput:(double)bitsPerSecond prefersReducedDataUsage:(BOOL)prefersReducedDataUsage;
+
+/**
+ * Returns the mp4 variant with the lowest bitrate, or nil if there is none.
+ */
++ (nullable TWTRVideoMetaDataVariant *)lowestBitrateVariantFromVariants:(NSArray<TWTRVideoMetaDataVariant *> *)variants;
+
+/**
+ * Returns the resolution encoded in the variant's URL, e.g. `/vid/640x360/`, or
+ * `CGSizeZero` if the URL does not have one.
+ */
++ (CGSize)pixelSizeOfVariant:(TWTRVideoMetaDataVariant *)variant;
+
+@end
+
+NS_ASSUME_NONNULL_END
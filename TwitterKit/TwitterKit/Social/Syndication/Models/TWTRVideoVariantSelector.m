@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRVideoVariantSelector.h"
+#import "TWTRVideoMetaData.h"
+
+/**
+ * The share of the estimated throughput a variant may use. The rest is headroom
+ * for the estimate being optimistic and for other traffic.
+ */
+static const double TWTRVideoVariantSustainableThroughputFraction = 0.75;
+
+@implementation TWTRVideoVariantSelector
+
++ (nullable TWTRVideoMetaDataVariant *)variantFromVariants:(NSArray<TWTRVideoMetaDataVariant *> *)variants renderedPixelSize:(CGSize)renderedPixelSize throughput:(double)bitsPerSecond prefersReducedDataUsage:(BOOL)prefersReducedDataUsage
+{
+    NSArray<TWTRVideoMetaDataVariant *> *progressiveVariants = [self progressiveVariantsSortedByBitrate:variants];
+    if (progressiveVariants.count == 0) {
+        return [self streamingVariantFromVariants:variants];
+    }
+
+    TWTRVideoMetaDataVariant *lowestVariant = progressiveVariants.firstObject;
+    if (prefersReducedDataUsage) {
+        return lowestVariant;
+    }
+
+    double sustainableBitrate = (bitsPerSecond > 0) ? bitsPerSecond * TWTRVideoVariantSustainableThroughputFraction : DBL_MAX;
+    TWTRVideoMetaDataVariant *largestSustainableVariant;
+
+    for (TWTRVideoMetaDataVariant *variant in progressiveVariants) {
+        if (variant.bitrate > sustainableBitrate) {
+            break;
+        }
+
+        CGSize pixelSize = [self pixelSizeOfVariant:variant];
+        if (pixelSize.width <= 0 || pixelSize.height <= 0) {
+            continue;
+        }
+
+        if ([self pixelSize:pixelSize coversRenderedPixelSize:renderedPixelSize]) {
+            return variant;
+        }
+        largestSustainableVariant = variant;
+    }
+
+    return largestSustainableVariant ?: lowestVariant;
+}
+
++ (nullable TWTRVideoMetaDataVariant *)lowestBitrateVariantFromVariants:(NSArray<TWTRVideoMetaDataVariant *> *)variants
+{
+    TWTRVideoMetaDataVariant *lowestVariant;
+
+    for (TWTRVideoMetaDataVariant *variant in variants) {
+        if ([TWTRMediaTypeMP4 isEqualToString:variant.contentType] && (!lowestVariant || variant.bitrate < lowestVariant.bitrate)) {
+            lowestVariant = variant;
+        }
+    }
+
+    return lowestVariant;
+}
+
++ (CGSize)pixelSizeOfVariant:(TWTRVideoMetaDataVariant *)variant
+{
+    for (NSString *component in variant.URL.pathComponents) {
+        NSScanner *scanner = [NSScanner scannerWithString:component];
+        NSInteger width;
+        NSInteger height;
+
+        if ([scanner scanInteger:&width] && [scanner scanString:@"x" intoString:NULL] && [scanner scanInteger:&height] && scanner.isAtEnd && width > 0 && height > 0) {
+            return CGSizeMake(width, height);
+        }
+    }
+
+    return CGSizeZero;
+}
+
+#pragma mark - Helpers
+
++ (NSArray<TWTRVideoMetaDataVariant *> *)progressiveVariantsSortedByBitrate:(NSArray<TWTRVideoMetaDataVariant *> *)variants
+{
+    NSIndexSet *mp4Indexes = [variants indexesOfObjectsPassingTest:^BOOL(TWTRVideoMetaDataVariant *obj, NSUInteger idx, BOOL *stop) {
+        return [TWTRMediaTypeMP4 isEqualToString:obj.contentType];
+    }];
+
+    return [[variants objectsAtIndexes:mp4Indexes] sortedArrayWithOptions:NSSortStable usingComparator:^NSComparisonResult(TWTRVideoMetaDataVariant *obj1, TWTRVideoMetaDataVariant *obj2) {
+        if (obj1.bitrate < obj2.bitrate) {
+            return NSOrderedAscending;
+        } else if (obj1.bitrate > obj2.bitrate) {
+            return NSOrderedDescending;
+        }
+        return NSOrderedSame;
+    }];
+}
+
++ (nullable TWTRVideoMetaDataVariant *)streamingVariantFromVariants:(NSArray<TWTRVideoMetaDataVariant *> *)variants
+{
+    for (TWTRVideoMetaDataVariant *variant in variants) {
+        if ([TWTRMediaTypeM3u8 isEqualToString:variant.contentType]) {
+            return variant;
+        }
+    }
+    return nil;
+}
+
+/**
+ * Whether a video of `pixelSize` drawn aspect fit into `renderedPixelSize` is shown at
+ * its native resolution or smaller. A zero rendered size is covered by anything.
+ */
++ (BOOL)pixelSize:(CGSize)pixelSize coversRenderedPixelSize:(CGSize)renderedPixelSize
+{
+    return pixelSize.width >= renderedPixelSize.width || pixelSize.height >= renderedPixelSize.height;
+}
+
+@end
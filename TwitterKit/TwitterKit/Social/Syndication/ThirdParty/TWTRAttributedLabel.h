@@ -215,6 +215,13 @@ extern NSString *const kTWTRBackgroundCornerRadiusAttributeName;
  */
 @property (nonatomic, assign) TWTRAttributedLabelVerticalAlignment verticalAlignment;
 
+/**
+ Whether the label renders its text into a bitmap on a background queue instead of drawing it in `drawRect:`. Rendering falls back to drawing synchronously while the label adjusts its font size to fit. `NO` by default.
+
+ @discussion The rendered bitmap replaces the previous one once it is ready, and renders of text or bounds the label no longer shows are discarded, so this is suited to labels in scrolling cells. Highlighted labels also render asynchronously, and the active link is drawn by an overlay layer above the bitmap without rendering the text again.
+ */
+@property (nonatomic, assign) BOOL displaysAsynchronously;
+
 ///--------------------------------------------
 /// @name Accessing Truncation Token Appearance
 ///--------------------------------------------
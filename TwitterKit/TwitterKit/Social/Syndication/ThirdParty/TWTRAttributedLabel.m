@@ -21,12 +21,14 @@
 // THE SOFTWARE.
 
 #import "TWTRAttributedLabel.h"
+#import "TWTRAttributedLabelRenderer.h"
 #import "TWTRTweetCashtagEntity.h"
 #import "TWTRTweetEntity.h"
 #import "TWTRTweetHashtagEntity.h"
 #import "TWTRTweetPresenter.h"  // For TWTRTweetEntityRange
 #import "TWTRTweetUrlEntity.h"
 #import "TWTRTweetUserMentionEntity.h"
+#import "TWTRTypesetterCache.h"
 
 #import <Availability.h>
 #import <QuartzCore/QuartzCore.h>
@@ -111,28 +113,6 @@ static inline CGFLOAT_TYPE CGFloat_floor(CGFLOAT_TYPE cgfloat)
 #endif
 }
 
-static inline CGFLOAT_TYPE CGFloat_round(CGFLOAT_TYPE cgfloat)
-{
-#if CGFLOAT_IS_DOUBLE
-    return round(cgfloat);
-#else
-    return roundf(cgfloat);
-#endif
-}
-
-static inline CGFloat TWTRFlushFactorForTextAlignment(NSTextAlignment textAlignment)
-{
-    switch (textAlignment) {
-        case TWTRTextAlignmentCenter:
-            return 0.5f;
-        case TWTRTextAlignmentRight:
-            return 1.0f;
-        case TWTRTextAlignmentLeft:
-        default:
-            return 0.0f;
-    }
-}
-
 static inline NSDictionary *NSAttributedStringAttributesFromLabel(TWTRAttributedLabel *label)
 {
     NSMutableDictionary *mutableAttributes = [NSMutableDictionary dictionary];
@@ -271,40 +251,64 @@ static inline NSAttributedString *NSAttributedStringByKeepingPreviousColorAndFon
     return mutableAttributedString;
 }
 
-static inline CGSize CTFramesetterSuggestFrameSizeForAttributedStringWithConstraints(CTFramesetterRef framesetter, NSAttributedString *attributedString, CGSize size, NSUInteger numberOfLines)
+/**
+ Geometry of a visible line in the laid out frame, in Core Text coordinates relative to the text rect.
+ */
+typedef struct {
+    CGPoint origin;
+    CGFloat penOffset;
+    CGFloat width;
+    CGFloat minY;
+    CGFloat maxY;
+    CFRange stringRange;
+} TWTRAttributedLabelLine;
+
+/**
+ An entry of the entity index. Entries are sorted by `location`, and `maxEnd` is the largest
+ range end of this and every preceding entry so that lookups can stop as soon as no earlier
+ range can still contain the index.
+ */
+typedef struct {
+    NSUInteger location;
+    NSUInteger end;
+    NSUInteger maxEnd;
+    NSUInteger entityIndex;
+} TWTRAttributedLabelEntityIndexEntry;
+
+static int TWTRAttributedLabelCompareEntityIndexEntries(const void *a, const void *b)
 {
-    CFRange rangeToSize = CFRangeMake(0, (CFIndex)[attributedString length]);
-    CGSize constraints = CGSizeMake(size.width, TWTRFLOAT_MAX);
-
-    if (numberOfLines == 1) {
-        // If there is one line, the size that fits is the full width of the line
-        constraints = CGSizeMake(TWTRFLOAT_MAX, TWTRFLOAT_MAX);
-    } else if (numberOfLines > 0) {
-        // If the line count of the label more than 1, limit the range to size to the number of lines that have been set
-        CGMutablePathRef path = CGPathCreateMutable();
-        CGPathAddRect(path, NULL, CGRectMake(0.0f, 0.0f, constraints.width, TWTRFLOAT_MAX));
-        CTFrameRef frame = CTFramesetterCreateFrame(framesetter, CFRangeMake(0, 0), path, NULL);
-        CFArrayRef lines = CTFrameGetLines(frame);
-
-        if (CFArrayGetCount(lines) > 0) {
-            NSInteger lastVisibleLineIndex = MIN((CFIndex)numberOfLines, CFArrayGetCount(lines)) - 1;
-            CTLineRef lastVisibleLine = CFArrayGetValueAtIndex(lines, lastVisibleLineIndex);
+    const TWTRAttributedLabelEntityIndexEntry *lhs = a;
+    const TWTRAttributedLabelEntityIndexEntry *rhs = b;
 
-            CFRange rangeToLayout = CTLineGetStringRange(lastVisibleLine);
-            rangeToSize = CFRangeMake(0, rangeToLayout.location + rangeToLayout.length);
-        }
-
-        CFRelease(frame);
-        CFRelease(path);
+    if (lhs->location != rhs->location) {
+        return lhs->location < rhs->location ? -1 : 1;
     }
+    if (lhs->entityIndex != rhs->entityIndex) {
+        return lhs->entityIndex < rhs->entityIndex ? -1 : 1;
+    }
+    return 0;
+}
 
-    CGSize suggestedSize = CTFramesetterSuggestFrameSizeWithConstraints(framesetter, rangeToSize, NULL, constraints, NULL);
+/**
+ Draws the highlight of the active link over the label's text, reusing the frame the text was laid out in.
+ */
+@interface TWTRAttributedLabelHighlightLayer : CALayer
+@property (nonatomic, strong) TWTRAttributedLabelRenderer *renderer;
+@property (nonatomic, strong) id textFrame;
+@property (nonatomic, assign) NSRange highlightRange;
+@property (nonatomic, copy) NSDictionary *highlightAttributes;
+@end
+
+@implementation TWTRAttributedLabelHighlightLayer
 
-    return CGSizeMake(CGFloat_ceil(suggestedSize.width), CGFloat_ceil(suggestedSize.height));
+- (void)drawInContext:(CGContextRef)c
+{
+    [self.renderer drawHighlightOfRange:self.highlightRange withAttributes:self.highlightAttributes frame:(__bridge CTFrameRef)self.textFrame inContext:c];
 }
 
+@end
+
 @interface TWTRAttributedLabel ()
-@property (readwrite, nonatomic, copy) NSAttributedString *inactiveAttributedText;
 @property (readwrite, nonatomic, copy) NSAttributedString *renderedAttributedText;
 @property (readwrite, nonatomic, strong) NSArray<TWTRTweetEntityRange *> *entities;
 @property (readwrite, nonatomic, strong) TWTRTweetEntityRange *activeLink;
@@ -313,9 +317,25 @@ static inline CGSize CTFramesetterSuggestFrameSizeForAttributedStringWithConstra
 
 @implementation TWTRAttributedLabel {
    @private
-    BOOL _needsFramesetter;
-    CTFramesetterRef _framesetter;
-    CTFramesetterRef _highlightFramesetter;
+    // The frame from the last layout pass and the state it was laid out for
+    CTFrameRef _layoutFrame;
+    NSData *_layoutLines;
+    CGRect _layoutBounds;
+    CGRect _layoutTextRect;
+    NSInteger _layoutNumberOfLines;
+    NSTextAlignment _layoutTextAlignment;
+    UIEdgeInsets _layoutTextInsets;
+    TWTRAttributedLabelVerticalAlignment _layoutVerticalAlignment;
+
+    // Asynchronous display state, only touched on the main thread
+    NSUInteger _displayGeneration;
+    NSOperation *_displayOperation;
+    CALayer *_asynchronousContentLayer;
+
+    TWTRAttributedLabelHighlightLayer *_highlightLayer;
+
+    NSData *_entityIndex;
+    NSArray<NSValue *> *_entityFrames;
 }
 
 @dynamic text;
@@ -372,13 +392,11 @@ static inline CGSize CTFramesetterSuggestFrameSizeForAttributedStringWithConstra
 
 - (void)dealloc
 {
-    if (_framesetter) {
-        CFRelease(_framesetter);
+    if (_layoutFrame) {
+        CFRelease(_layoutFrame);
     }
 
-    if (_highlightFramesetter) {
-        CFRelease(_highlightFramesetter);
-    }
+    [_displayOperation cancel];
 }
 
 #pragma mark -
@@ -389,13 +407,7 @@ static inline CGSize CTFramesetterSuggestFrameSizeForAttributedStringWithConstra
         return CGSizeZero;
     }
 
-    CTFramesetterRef framesetter = CTFramesetterCreateWithAttributedString((__bridge CFAttributedStringRef)attributedString);
-
-    CGSize calculatedSize = CTFramesetterSuggestFrameSizeForAttributedStringWithConstraints(framesetter, attributedString, size, numberOfLines);
-
-    CFRelease(framesetter);
-
-    return calculatedSize;
+    return [[TWTRTypesetterCache sharedCache] layoutForAttributedString:attributedString width:size.width numberOfLines:numberOfLines].suggestedSize;
 }
 
 #pragma mark -
@@ -427,66 +439,136 @@ static inline CGSize CTFramesetterSuggestFrameSizeForAttributedStringWithConstra
 - (void)setEntities:(NSArray<TWTRTweetEntityRange *> *)entities
 {
     _entities = entities;
+    _entityIndex = [[self class] entityIndexForEntities:entities];
+    _entityFrames = nil;
 
     self.accessibilityElements = nil;
 }
 
++ (NSData *)entityIndexForEntities:(NSArray<TWTRTweetEntityRange *> *)entities
+{
+    NSUInteger count = [entities count];
+    if (count == 0) {
+        return nil;
+    }
+
+    NSMutableData *data = [NSMutableData dataWithLength:count * sizeof(TWTRAttributedLabelEntityIndexEntry)];
+    TWTRAttributedLabelEntityIndexEntry *entries = data.mutableBytes;
+
+    [entities enumerateObjectsUsingBlock:^(TWTRTweetEntityRange *entityRange, NSUInteger idx, BOOL *stop) {
+        NSRange range = entityRange.textRange;
+        entries[idx] = (TWTRAttributedLabelEntityIndexEntry){.location = range.location, .end = NSMaxRange(range), .entityIndex = idx};
+    }];
+
+    qsort(entries, count, sizeof(TWTRAttributedLabelEntityIndexEntry), TWTRAttributedLabelCompareEntityIndexEntries);
+
+    NSUInteger maxEnd = 0;
+    for (NSUInteger i = 0; i < count; i++) {
+        maxEnd = MAX(maxEnd, entries[i].end);
+        entries[i].maxEnd = maxEnd;
+    }
+
+    return data;
+}
+
 - (void)setNeedsFramesetter
 {
     // Reset the rendered attributed text so it has a chance to regenerate
     self.renderedAttributedText = nil;
 
-    _needsFramesetter = YES;
+    [self invalidateLayoutFrame];
+    [self hideHighlight];
 }
 
-- (CTFramesetterRef)framesetter
-{
-    if (_needsFramesetter) {
-        @synchronized(self)
-        {
-            CTFramesetterRef framesetter = CTFramesetterCreateWithAttributedString((__bridge CFAttributedStringRef)self.renderedAttributedText);
-            [self setFramesetter:framesetter];
-            [self setHighlightFramesetter:nil];
-            _needsFramesetter = NO;
+#pragma mark - Layout Frame
 
-            if (framesetter) {
-                CFRelease(framesetter);
-            }
-        }
+- (void)invalidateLayoutFrame
+{
+    if (_layoutFrame) {
+        CFRelease(_layoutFrame);
+        _layoutFrame = NULL;
     }
 
-    return _framesetter;
+    _layoutLines = nil;
+    _entityFrames = nil;
+}
+
+- (BOOL)isLayoutFrameValidForBounds:(CGRect)bounds
+{
+    return _layoutFrame && CGRectEqualToRect(_layoutBounds, bounds) && _layoutNumberOfLines == self.numberOfLines && _layoutTextAlignment == self.textAlignment && UIEdgeInsetsEqualToEdgeInsets(_layoutTextInsets, self.textInsets) && _layoutVerticalAlignment == self.verticalAlignment;
 }
 
-- (void)setFramesetter:(CTFramesetterRef)framesetter
+/**
+ Returns the frame laid out for the given bounds, reusing the frame from the last layout pass when
+ nothing affecting it has changed since. The geometry of its visible lines is cached alongside it so
+ that hit testing does not need to go back to Core Text.
+ */
+- (CTFrameRef)layoutFrameForBounds:(CGRect)bounds
 {
-    if (framesetter) {
-        CFRetain(framesetter);
+    if ([self isLayoutFrameValidForBounds:bounds]) {
+        return _layoutFrame;
     }
 
-    if (_framesetter) {
-        CFRelease(_framesetter);
+    [self invalidateLayoutFrame];
+
+    NSAttributedString *renderedAttributedText = self.renderedAttributedText;
+    if (!renderedAttributedText) {
+        return NULL;
     }
 
-    _framesetter = framesetter;
-}
+    CGRect textRect = [self textRectForBounds:bounds limitedToNumberOfLines:self.numberOfLines];
 
-- (CTFramesetterRef)highlightFramesetter
-{
-    return _highlightFramesetter;
-}
+    // Labels showing the same text share a framesetter with each other and with sizing
+    CGMutablePathRef path = CGPathCreateMutable();
+    CGPathAddRect(path, NULL, textRect);
+    CTFrameRef frame = [[TWTRTypesetterCache sharedCache] copyFrameForAttributedString:renderedAttributedText path:path];
+    CFRelease(path);
 
-- (void)setHighlightFramesetter:(CTFramesetterRef)highlightFramesetter
-{
-    if (highlightFramesetter) {
-        CFRetain(highlightFramesetter);
+    if (frame == NULL) {
+        return NULL;
     }
 
-    if (_highlightFramesetter) {
-        CFRelease(_highlightFramesetter);
+    CFArrayRef lines = CTFrameGetLines(frame);
+    NSInteger numberOfLines = self.numberOfLines > 0 ? MIN(self.numberOfLines, CFArrayGetCount(lines)) : CFArrayGetCount(lines);
+
+    NSMutableData *lineData = [NSMutableData dataWithLength:(NSUInteger)numberOfLines * sizeof(TWTRAttributedLabelLine)];
+    TWTRAttributedLabelLine *lineGeometry = lineData.mutableBytes;
+
+    if (numberOfLines > 0) {
+        CGPoint lineOrigins[numberOfLines];
+        CTFrameGetLineOrigins(frame, CFRangeMake(0, numberOfLines), lineOrigins);
+
+        // Adjust pen offset for flush depending on text alignment
+        CGFloat flushFactor = TWTRAttributedLabelFlushFactorForTextAlignment(self.textAlignment);
+
+        for (CFIndex lineIndex = 0; lineIndex < numberOfLines; lineIndex++) {
+            CTLineRef line = CFArrayGetValueAtIndex(lines, lineIndex);
+            CGPoint lineOrigin = lineOrigins[lineIndex];
+
+            CGFloat ascent = 0.0f, descent = 0.0f, leading = 0.0f;
+            CGFloat width = (CGFloat)CTLineGetTypographicBounds(line, &ascent, &descent, &leading);
+
+            lineGeometry[lineIndex] = (TWTRAttributedLabelLine){
+                .origin = lineOrigin,
+                .penOffset = (CGFloat)CTLineGetPenOffsetForFlush(line, flushFactor, textRect.size.width),
+                .width = width,
+                .minY = (CGFloat)floor(lineOrigin.y - descent),
+                .maxY = (CGFloat)ceil(lineOrigin.y + ascent),
+                .stringRange = CTLineGetStringRange(line),
+            };
+        }
     }
 
-    _highlightFramesetter = highlightFramesetter;
+    _layoutFrame = frame;
+    _layoutLines = lineData;
+    _layoutBounds = bounds;
+    _layoutTextRect = textRect;
+    _layoutNumberOfLines = self.numberOfLines;
+    _layoutTextAlignment = self.textAlignment;
+    _layoutTextInsets = self.textInsets;
+    _layoutVerticalAlignment = self.verticalAlignment;
+
+    return _layoutFrame;
 }
 
 - (CGFloat)leading
@@ -527,15 +609,37 @@ static inline CGSize CTFramesetterSuggestFrameSizeForAttributedStringWithConstra
 
 - (TWTRTweetEntityRange *)entityAtCharacterIndex:(CFIndex)idx
 {
-    NSEnumerator *enumerator = [self.entities reverseObjectEnumerator];
-    TWTRTweetEntityRange *result = nil;
-    while ((result = [enumerator nextObject])) {
-        if (NSLocationInRange((NSUInteger)idx, result.textRange)) {
-            return result;
+    if (idx == NSNotFound || idx < 0 || !_entityIndex) {
+        return nil;
+    }
+
+    const TWTRAttributedLabelEntityIndexEntry *entries = _entityIndex.bytes;
+    NSUInteger count = _entityIndex.length / sizeof(TWTRAttributedLabelEntityIndexEntry);
+    NSUInteger location = (NSUInteger)idx;
+
+    // Find the number of entries starting at or before the index
+    NSUInteger low = 0;
+    NSUInteger high = count;
+    while (low < high) {
+        NSUInteger mid = low + (high - low) / 2;
+        if (entries[mid].location <= location) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
     }
 
-    return nil;
+    // Walk back while an earlier range could still contain the index. When entities overlap the
+    // most recently added one wins, matching the order links were added in.
+    NSUInteger bestEntityIndex = NSNotFound;
+    for (NSUInteger i = low; i > 0 && entries[i - 1].maxEnd > location; i--) {
+        const TWTRAttributedLabelEntityIndexEntry *entry = &entries[i - 1];
+        if (location < entry->end && (bestEntityIndex == NSNotFound || entry->entityIndex > bestEntityIndex)) {
+            bestEntityIndex = entry->entityIndex;
+        }
+    }
+
+    return bestEntityIndex != NSNotFound ? self.entities[bestEntityIndex] : nil;
 }
 
 - (TWTRTweetEntityRange *)entityAtPoint:(CGPoint)p
@@ -551,378 +655,117 @@ static inline CGSize CTFramesetterSuggestFrameSizeForAttributedStringWithConstra
         return NSNotFound;
     }
 
-    CGRect textRect = [self textRectForBounds:self.bounds limitedToNumberOfLines:self.numberOfLines];
+    CTFrameRef frame = [self layoutFrameForBounds:self.bounds];
+    if (frame == NULL) {
+        return NSNotFound;
+    }
+
+    CGRect textRect = _layoutTextRect;
     if (!CGRectContainsPoint(textRect, p)) {
         return NSNotFound;
     }
 
-    // Adjust pen offset for flush depending on text alignment
-    CGFloat flushFactor = TWTRFlushFactorForTextAlignment(self.textAlignment);
+    const TWTRAttributedLabelLine *lineGeometry = _layoutLines.bytes;
+    NSUInteger numberOfLines = _layoutLines.length / sizeof(TWTRAttributedLabelLine);
+    if (numberOfLines == 0) {
+        return NSNotFound;
+    }
 
     // Offset tap coordinates by textRect origin to make them relative to the origin of frame
     p = CGPointMake(p.x - textRect.origin.x, p.y - textRect.origin.y);
     // Convert tap coordinates (start at top left) to CT coordinates (start at bottom left)
     p = CGPointMake(p.x, textRect.size.height - p.y);
 
-    CGMutablePathRef path = CGPathCreateMutable();
-    CGPathAddRect(path, NULL, textRect);
-    CTFrameRef frame = CTFramesetterCreateFrame([self framesetter], CFRangeMake(0, (CFIndex)[self.attributedText length]), path, NULL);
-    if (frame == NULL) {
-        CFRelease(path);
-        return NSNotFound;
+    // Lines run top to bottom, so find the first line whose bottom is at or below the point
+    NSUInteger low = 0;
+    NSUInteger high = numberOfLines;
+    while (low < high) {
+        NSUInteger mid = low + (high - low) / 2;
+        if (lineGeometry[mid].minY > p.y) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
     }
 
-    CFArrayRef lines = CTFrameGetLines(frame);
-    NSInteger numberOfLines = self.numberOfLines > 0 ? MIN(self.numberOfLines, CFArrayGetCount(lines)) : CFArrayGetCount(lines);
-    if (numberOfLines == 0) {
-        CFRelease(frame);
-        CFRelease(path);
+    if (low == numberOfLines) {
         return NSNotFound;
     }
 
-    CFIndex idx = NSNotFound;
-
-    CGPoint lineOrigins[numberOfLines];
-    CTFrameGetLineOrigins(frame, CFRangeMake(0, numberOfLines), lineOrigins);
+    const TWTRAttributedLabelLine *lineInfo = &lineGeometry[low];
 
-    for (CFIndex lineIndex = 0; lineIndex < numberOfLines; lineIndex++) {
-        CGPoint lineOrigin = lineOrigins[lineIndex];
-        CTLineRef line = CFArrayGetValueAtIndex(lines, lineIndex);
-        CGFloat penOffset = (CGFloat)CTLineGetPenOffsetForFlush(line, flushFactor, textRect.size.width);
-
-        // Get bounding information of line
-        CGFloat ascent = 0.0f, descent = 0.0f, leading = 0.0f;
-        CGFloat width = (CGFloat)CTLineGetTypographicBounds(line, &ascent, &descent, &leading);
-        CGFloat yMin = (CGFloat)floor(lineOrigin.y - descent);
-        CGFloat yMax = (CGFloat)ceil(lineOrigin.y + ascent);
-
-        // Check if we've already passed the line
-        if (p.y > yMax) {
-            break;
-        }
-        // Check if the point is within this line vertically
-        if (p.y >= yMin) {
-            // Check if the point is within this line horizontally
-            if (p.x >= penOffset && p.x <= penOffset + width) {
-                // Convert CT coordinates to line-relative coordinates
-                CGPoint relativePoint = CGPointMake(p.x - penOffset, p.y - lineOrigin.y);
-                idx = CTLineGetStringIndexForPosition(line, relativePoint);
-                break;
-            }
-        }
+    // The point is either between lines or beside the text
+    if (p.y > lineInfo->maxY || p.x < lineInfo->penOffset || p.x > lineInfo->penOffset + lineInfo->width) {
+        return NSNotFound;
     }
 
-    CFRelease(frame);
-    CFRelease(path);
-
-    return idx;
-}
-
-- (CGRect)boundingRectForCharacterRange:(NSRange)range
-{
-    NSMutableAttributedString *mutableAttributedString = [self.attributedText mutableCopy];
-
-    NSTextStorage *textStorage = [[NSTextStorage alloc] initWithAttributedString:mutableAttributedString];
-
-    NSLayoutManager *layoutManager = [[NSLayoutManager alloc] init];
-    [textStorage addLayoutManager:layoutManager];
-
-    NSTextContainer *textContainer = [[NSTextContainer alloc] initWithSize:self.bounds.size];
-    [layoutManager addTextContainer:textContainer];
+    // Convert CT coordinates to line-relative coordinates
+    CTLineRef line = CFArrayGetValueAtIndex(CTFrameGetLines(frame), (CFIndex)low);
+    CGPoint relativePoint = CGPointMake(p.x - lineInfo->penOffset, p.y - lineInfo->origin.y);
 
-    NSRange glyphRange;
-    [layoutManager characterRangeForGlyphRange:range actualGlyphRange:&glyphRange];
-
-    return [layoutManager boundingRectForGlyphRange:glyphRange inTextContainer:textContainer];
+    return CTLineGetStringIndexForPosition(line, relativePoint);
 }
 
-- (void)drawFramesetter:(CTFramesetterRef)framesetter attributedString:(NSAttributedString *)attributedString textRange:(CFRange)textRange inRect:(CGRect)rect context:(CGContextRef)c
+/**
+ Returns the bounding rect of each entity in the label's coordinate space, in the same order as
+ `entities`. Rects are derived from the laid out lines in a single pass and cached until the
+ layout or the entities change. Entities that are not visible get `CGRectZero`.
+ */
+- (NSArray<NSValue *> *)entityFrames
 {
-    CGMutablePathRef path = CGPathCreateMutable();
-    CGPathAddRect(path, NULL, rect);
-    CTFrameRef frame = CTFramesetterCreateFrame(framesetter, textRange, path, NULL);
-
-    [self drawBackground:frame inRect:rect context:c];
-
-    CFArrayRef lines = CTFrameGetLines(frame);
-    NSInteger numberOfLines = self.numberOfLines > 0 ? MIN(self.numberOfLines, CFArrayGetCount(lines)) : CFArrayGetCount(lines);
-    BOOL truncateLastLine = (self.lineBreakMode == TWTRLineBreakByTruncatingHead || self.lineBreakMode == TWTRLineBreakByTruncatingMiddle || self.lineBreakMode == TWTRLineBreakByTruncatingTail);
-
-    CGPoint lineOrigins[numberOfLines];
-    CTFrameGetLineOrigins(frame, CFRangeMake(0, numberOfLines), lineOrigins);
-
-    for (CFIndex lineIndex = 0; lineIndex < numberOfLines; lineIndex++) {
-        CGPoint lineOrigin = lineOrigins[lineIndex];
-        lineOrigin = CGPointMake(CGFloat_ceil(lineOrigin.x), CGFloat_ceil(lineOrigin.y));
-
-        CGContextSetTextPosition(c, lineOrigin.x, lineOrigin.y);
-        CTLineRef line = CFArrayGetValueAtIndex(lines, lineIndex);
-
-        CGFloat descent = 0.0f;
-        CTLineGetTypographicBounds((CTLineRef)line, NULL, &descent, NULL);
-
-        // Adjust pen offset for flush depending on text alignment
-        CGFloat flushFactor = TWTRFlushFactorForTextAlignment(self.textAlignment);
-
-        if (lineIndex == numberOfLines - 1 && truncateLastLine) {
-            // Check if the range of text in the last line reaches the end of the full attributed string
-            CFRange lastLineRange = CTLineGetStringRange(line);
-
-            if (!(lastLineRange.length == 0 && lastLineRange.location == 0) && lastLineRange.location + lastLineRange.length < textRange.location + textRange.length) {
-                // Get correct truncationType and attribute position
-                CTLineTruncationType truncationType;
-                CFIndex truncationAttributePosition = lastLineRange.location;
-                TWTRLineBreakMode lineBreakMode = self.lineBreakMode;
-
-                // Multiple lines, only use UILineBreakModeTailTruncation
-                if (numberOfLines != 1) {
-                    lineBreakMode = TWTRLineBreakByTruncatingTail;
-                }
-
-                switch (lineBreakMode) {
-                    case TWTRLineBreakByTruncatingHead:
-                        truncationType = kCTLineTruncationStart;
-                        break;
-                    case TWTRLineBreakByTruncatingMiddle:
-                        truncationType = kCTLineTruncationMiddle;
-                        truncationAttributePosition += (lastLineRange.length / 2);
-                        break;
-                    case TWTRLineBreakByTruncatingTail:
-                    default:
-                        truncationType = kCTLineTruncationEnd;
-                        truncationAttributePosition += (lastLineRange.length - 1);
-                        break;
-                }
-
-                NSString *truncationTokenString = self.truncationTokenString;
-                if (!truncationTokenString) {
-                    truncationTokenString = @"\u2026";  // Unicode Character 'HORIZONTAL ELLIPSIS' (U+2026)
-                }
-
-                NSDictionary *truncationTokenStringAttributes = self.truncationTokenStringAttributes;
-                if (!truncationTokenStringAttributes) {
-                    truncationTokenStringAttributes = [attributedString attributesAtIndex:(NSUInteger)truncationAttributePosition effectiveRange:NULL];
-                }
-
-                NSAttributedString *attributedTokenString = [[NSAttributedString alloc] initWithString:truncationTokenString attributes:truncationTokenStringAttributes];
-                CTLineRef truncationToken = CTLineCreateWithAttributedString((__bridge CFAttributedStringRef)attributedTokenString);
-
-                // Append truncationToken to the string
-                // because if string isn't too long, CT wont add the truncationToken on it's own
-                // There is no change of a double truncationToken because CT only add the token if it removes characters (and the one we add will go first)
-                NSMutableAttributedString *truncationString = [[attributedString attributedSubstringFromRange:NSMakeRange((NSUInteger)lastLineRange.location, (NSUInteger)lastLineRange.length)] mutableCopy];
-                if (lastLineRange.length > 0) {
-                    // Remove any newline at the end (we don't want newline space between the text and the truncation token). There can only be one, because the second would be on the next line.
-                    unichar lastCharacter = [[truncationString string] characterAtIndex:(NSUInteger)(lastLineRange.length - 1)];
-                    if ([[NSCharacterSet newlineCharacterSet] characterIsMember:lastCharacter]) {
-                        [truncationString deleteCharactersInRange:NSMakeRange((NSUInteger)(lastLineRange.length - 1), 1)];
-                    }
-                }
-                [truncationString appendAttributedString:attributedTokenString];
-                CTLineRef truncationLine = CTLineCreateWithAttributedString((__bridge CFAttributedStringRef)truncationString);
-
-                // Truncate the line in case it is too long.
-                CTLineRef truncatedLine = CTLineCreateTruncatedLine(truncationLine, rect.size.width, truncationType, truncationToken);
-                if (!truncatedLine) {
-                    // If the line is not as wide as the truncationToken, truncatedLine is NULL
-                    truncatedLine = CFRetain(truncationToken);
-                }
-
-                CGFloat penOffset = (CGFloat)CTLineGetPenOffsetForFlush(truncatedLine, flushFactor, rect.size.width);
-                CGContextSetTextPosition(c, penOffset, lineOrigin.y - descent - self.font.descender);
-
-                CTLineDraw(truncatedLine, c);
-
-                CFRelease(truncatedLine);
-                CFRelease(truncationLine);
-                CFRelease(truncationToken);
+    CTFrameRef frame = [self layoutFrameForBounds:self.bounds];
+    if (_entityFrames) {
+        return _entityFrames;
+    }
+
+    NSMutableArray<NSValue *> *entityFrames = [NSMutableArray arrayWithCapacity:[self.entities count]];
+
+    const TWTRAttributedLabelLine *lineGeometry = _layoutLines.bytes;
+    NSUInteger numberOfLines = _layoutLines.length / sizeof(TWTRAttributedLabelLine);
+    CFArrayRef lines = frame ? CTFrameGetLines(frame) : NULL;
+    CGRect textRect = _layoutTextRect;
+
+    for (TWTRTweetEntityRange *entityRange in self.entities) {
+        CFIndex entityStart = (CFIndex)entityRange.textRange.location;
+        CFIndex entityEnd = (CFIndex)NSMaxRange(entityRange.textRange);
+
+        // Find the first line that ends after the entity starts
+        NSUInteger low = 0;
+        NSUInteger high = numberOfLines;
+        while (low < high) {
+            NSUInteger mid = low + (high - low) / 2;
+            CFRange lineRange = lineGeometry[mid].stringRange;
+            if (lineRange.location + lineRange.length <= entityStart) {
+                low = mid + 1;
             } else {
-                CGFloat penOffset = (CGFloat)CTLineGetPenOffsetForFlush(line, flushFactor, rect.size.width);
-                CGContextSetTextPosition(c, penOffset, lineOrigin.y - descent - self.font.descender);
-                CTLineDraw(line, c);
+                high = mid;
             }
-        } else {
-            CGFloat penOffset = (CGFloat)CTLineGetPenOffsetForFlush(line, flushFactor, rect.size.width);
-            CGContextSetTextPosition(c, penOffset, lineOrigin.y - descent - self.font.descender);
-            CTLineDraw(line, c);
         }
-    }
-
-    [self drawStrike:frame inRect:rect context:c];
-
-    CFRelease(frame);
-    CFRelease(path);
-}
-
-- (void)drawBackground:(CTFrameRef)frame inRect:(CGRect)rect context:(CGContextRef)c
-{
-    NSArray *lines = (__bridge NSArray *)CTFrameGetLines(frame);
-    CGPoint origins[[lines count]];
-    CTFrameGetLineOrigins(frame, CFRangeMake(0, 0), origins);
-
-    // Adjust pen offset for flush depending on text alignment
-    CGFloat flushFactor = TWTRFlushFactorForTextAlignment(self.textAlignment);
-
-    // Compensate for y-offset of text rect from vertical positioning
-    CGFloat yOffset = self.textInsets.top - [self textRectForBounds:self.bounds limitedToNumberOfLines:self.numberOfLines].origin.y;
-
-    CFIndex lineIndex = 0;
-    for (id line in lines) {
-        CGFloat ascent = 0.0f, descent = 0.0f, leading = 0.0f;
-        CGFloat width = (CGFloat)CTLineGetTypographicBounds((__bridge CTLineRef)line, &ascent, &descent, &leading);
-        CGRect lineBounds = CGRectMake(rect.origin.x, rect.origin.y, width, ascent + descent + leading);
-
-        CGFloat penOffset = (CGFloat)CTLineGetPenOffsetForFlush((__bridge CTLineRef)line, flushFactor, rect.size.width);
 
-        lineBounds.origin.x += origins[lineIndex].x;
-        lineBounds.origin.y += origins[lineIndex].y;
-
-        for (id glyphRun in (__bridge NSArray *)CTLineGetGlyphRuns((__bridge CTLineRef)line)) {
-            NSDictionary *attributes = (__bridge NSDictionary *)CTRunGetAttributes((__bridge CTRunRef)glyphRun);
-            UIColor *strokeColor = [attributes objectForKey:kTWTRBackgroundStrokeColorAttributeName];
-            UIColor *fillColor = [attributes objectForKey:kTWTRBackgroundFillColorAttributeName];
-            UIEdgeInsets fillPadding = [[attributes objectForKey:kTWTRBackgroundFillPaddingAttributeName] UIEdgeInsetsValue];
-            CGFloat cornerRadius = [[attributes objectForKey:kTWTRBackgroundCornerRadiusAttributeName] floatValue];
-            CGFloat lineWidth = [[attributes objectForKey:kTWTRBackgroundLineWidthAttributeName] floatValue];
-
-            if (strokeColor || fillColor) {
-                CGRect runBounds = CGRectZero;
-                CGFloat runAscent = 0.0f;
-                CGFloat runDescent = 0.0f;
-
-                runBounds.size.width = (CGFloat)CTRunGetTypographicBounds((__bridge CTRunRef)glyphRun, CFRangeMake(0, 0), &runAscent, &runDescent, NULL) + fillPadding.left + fillPadding.right;
-                runBounds.size.height = runAscent + runDescent + fillPadding.top + fillPadding.bottom;
-
-                CGFloat xOffset = 0.0f;
-                CFRange glyphRange = CTRunGetStringRange((__bridge CTRunRef)glyphRun);
-                switch (CTRunGetStatus((__bridge CTRunRef)glyphRun)) {
-                    case kCTRunStatusRightToLeft:
-                        xOffset = CTLineGetOffsetForStringIndex((__bridge CTLineRef)line, glyphRange.location + glyphRange.length, NULL);
-                        break;
-                    default:
-                        xOffset = CTLineGetOffsetForStringIndex((__bridge CTLineRef)line, glyphRange.location, NULL);
-                        break;
-                }
-
-                runBounds.origin.x = penOffset + rect.origin.x + xOffset - fillPadding.left - rect.origin.x;
-                runBounds.origin.y = origins[lineIndex].y + rect.origin.y + yOffset - fillPadding.bottom - rect.origin.y;
-                runBounds.origin.y -= runDescent;
-
-                // Don't draw higlightedLinkBackground too far to the right
-                if (CGRectGetWidth(runBounds) > CGRectGetWidth(lineBounds)) {
-                    runBounds.size.width = CGRectGetWidth(lineBounds);
-                }
-
-                CGPathRef path = [[UIBezierPath bezierPathWithRoundedRect:CGRectInset(CGRectInset(runBounds, -1.0f, 0.0f), lineWidth, lineWidth) cornerRadius:cornerRadius] CGPath];
-
-                CGContextSetLineJoin(c, kCGLineJoinRound);
+        CGRect entityFrame = CGRectNull;
+        for (NSUInteger lineIndex = low; lineIndex < numberOfLines; lineIndex++) {
+            const TWTRAttributedLabelLine *lineInfo = &lineGeometry[lineIndex];
+            if (lineInfo->stringRange.location >= entityEnd) {
+                break;
+            }
 
-                if (fillColor) {
-                    CGContextSetFillColorWithColor(c, fillColor.CGColor);
-                    CGContextAddPath(c, path);
-                    CGContextFillPath(c);
-                }
+            CTLineRef line = CFArrayGetValueAtIndex(lines, (CFIndex)lineIndex);
+            CFIndex start = MAX(entityStart, lineInfo->stringRange.location);
+            CFIndex end = MIN(entityEnd, lineInfo->stringRange.location + lineInfo->stringRange.length);
+            CGFloat startOffset = (CGFloat)CTLineGetOffsetForStringIndex(line, start, NULL);
+            CGFloat endOffset = (CGFloat)CTLineGetOffsetForStringIndex(line, end, NULL);
 
-                if (strokeColor) {
-                    CGContextSetStrokeColorWithColor(c, strokeColor.CGColor);
-                    CGContextAddPath(c, path);
-                    CGContextStrokePath(c);
-                }
-            }
+            // Convert CT coordinates (start at bottom left) back to view coordinates
+            CGRect lineFrame = CGRectMake(textRect.origin.x + lineInfo->penOffset + MIN(startOffset, endOffset), textRect.origin.y + textRect.size.height - lineInfo->maxY, (CGFloat)fabs(endOffset - startOffset), lineInfo->maxY - lineInfo->minY);
+            entityFrame = CGRectUnion(entityFrame, lineFrame);
         }
 
-        lineIndex++;
+        [entityFrames addObject:[NSValue valueWithCGRect:CGRectIsNull(entityFrame) ? CGRectZero : entityFrame]];
     }
-}
 
-- (void)drawStrike:(CTFrameRef)frame inRect:(__unused CGRect)rect context:(CGContextRef)c
-{
-    NSArray *lines = (__bridge NSArray *)CTFrameGetLines(frame);
-    CGPoint origins[[lines count]];
-    CTFrameGetLineOrigins(frame, CFRangeMake(0, 0), origins);
-
-    // Adjust pen offset for flush depending on text alignment
-    CGFloat flushFactor = TWTRFlushFactorForTextAlignment(self.textAlignment);
-
-    CFIndex lineIndex = 0;
-    for (id line in lines) {
-        CGFloat ascent = 0.0f, descent = 0.0f, leading = 0.0f;
-        CGFloat width = (CGFloat)CTLineGetTypographicBounds((__bridge CTLineRef)line, &ascent, &descent, &leading);
-        CGRect lineBounds = CGRectMake(0.0f, 0.0f, width, ascent + descent + leading);
-        lineBounds.origin.x = origins[lineIndex].x;
-        lineBounds.origin.y = origins[lineIndex].y;
-
-        CGFloat penOffset = (CGFloat)CTLineGetPenOffsetForFlush((__bridge CTLineRef)line, flushFactor, rect.size.width);
-
-        for (id glyphRun in (__bridge NSArray *)CTLineGetGlyphRuns((__bridge CTLineRef)line)) {
-            NSDictionary *attributes = (__bridge NSDictionary *)CTRunGetAttributes((__bridge CTRunRef)glyphRun);
-            BOOL strikeOut = [[attributes objectForKey:kTWTRStrikeOutAttributeName] boolValue];
-            NSInteger superscriptStyle = [[attributes objectForKey:(id)kCTSuperscriptAttributeName] integerValue];
-
-            if (strikeOut) {
-                CGRect runBounds = CGRectZero;
-                CGFloat runAscent = 0.0f;
-                CGFloat runDescent = 0.0f;
-
-                runBounds.size.width = (CGFloat)CTRunGetTypographicBounds((__bridge CTRunRef)glyphRun, CFRangeMake(0, 0), &runAscent, &runDescent, NULL);
-                runBounds.size.height = runAscent + runDescent;
-
-                CGFloat xOffset = 0.0f;
-                CFRange glyphRange = CTRunGetStringRange((__bridge CTRunRef)glyphRun);
-                switch (CTRunGetStatus((__bridge CTRunRef)glyphRun)) {
-                    case kCTRunStatusRightToLeft:
-                        xOffset = CTLineGetOffsetForStringIndex((__bridge CTLineRef)line, glyphRange.location + glyphRange.length, NULL);
-                        break;
-                    default:
-                        xOffset = CTLineGetOffsetForStringIndex((__bridge CTLineRef)line, glyphRange.location, NULL);
-                        break;
-                }
-                runBounds.origin.x = penOffset + xOffset;
-                runBounds.origin.y = origins[lineIndex].y;
-                runBounds.origin.y -= runDescent;
-
-                // Don't draw strikeout too far to the right
-                if (CGRectGetWidth(runBounds) > CGRectGetWidth(lineBounds)) {
-                    runBounds.size.width = CGRectGetWidth(lineBounds);
-                }
-
-                switch (superscriptStyle) {
-                    case 1:
-                        runBounds.origin.y -= runAscent * 0.47f;
-                        break;
-                    case -1:
-                        runBounds.origin.y += runAscent * 0.25f;
-                        break;
-                    default:
-                        break;
-                }
-
-                // Use text color, or default to black
-                id color = [attributes objectForKey:(id)kCTForegroundColorAttributeName];
-                if (color) {
-                    if ([color isKindOfClass:[UIColor class]]) {
-                        CGContextSetStrokeColorWithColor(c, [color CGColor]);
-                    } else {
-                        CGContextSetStrokeColorWithColor(c, (__bridge CGColorRef)color);
-                    }
-                } else {
-                    CGContextSetGrayStrokeColor(c, 0.0f, 1.0);
-                }
+    _entityFrames = [entityFrames copy];
 
-                CTFontRef font = CTFontCreateWithName((__bridge CFStringRef)self.font.fontName, self.font.pointSize, NULL);
-                CGContextSetLineWidth(c, CTFontGetUnderlineThickness(font));
-                CFRelease(font);
-
-                CGFloat y = CGFloat_round(runBounds.origin.y + runBounds.size.height / 2.0f);
-                CGContextMoveToPoint(c, runBounds.origin.x, y);
-                CGContextAddLineToPoint(c, runBounds.origin.x + runBounds.size.width, y);
-
-                CGContextStrokePath(c);
-            }
-        }
-
-        lineIndex++;
-    }
+    return _entityFrames;
 }
 
 #pragma mark - TWTRAttributedLabel
@@ -939,6 +782,9 @@ static inline CGSize CTFramesetterSuggestFrameSizeForAttributedStringWithConstra
     self.attributedText = text;
     self.activeLink = nil;
 
+    // Don't show the previous text while the new one renders, e.g. in a reused cell
+    [self clearAsynchronousContents];
+
     self.entities = [NSArray array];
 
     [super setText:[self.attributedText string]];
@@ -965,26 +811,57 @@ static inline CGSize CTFramesetterSuggestFrameSizeForAttributedStringWithConstra
 {
     _activeLink = activeLink;
 
-    if (_activeLink && [self.activeLinkAttributes count] > 0) {
-        if (!self.inactiveAttributedText) {
-            self.inactiveAttributedText = [self.attributedText copy];
-        }
-
-        NSMutableAttributedString *mutableAttributedString = [self.inactiveAttributedText mutableCopy];
-        if (self.activeLink.textRange.length > 0 && NSLocationInRange(NSMaxRange(self.activeLink.textRange) - 1, NSMakeRange(0, [self.inactiveAttributedText length]))) {
-            [mutableAttributedString addAttributes:self.activeLinkAttributes range:self.activeLink.textRange];
-        }
+    NSRange range = activeLink.textRange;
+    BOOL isValidRange = range.length > 0 && NSMaxRange(range) <= [self.attributedText length];
 
-        self.attributedText = mutableAttributedString;
-        [self setNeedsDisplay];
+    if (_activeLink && [self.activeLinkAttributes count] > 0 && isValidRange) {
+        // Draw the highlight over the text already on screen instead of typesetting a restyled copy of it
+        [self showHighlightOfRange:range];
 
         [CATransaction flush];
-    } else if (self.inactiveAttributedText) {
-        self.attributedText = self.inactiveAttributedText;
-        self.inactiveAttributedText = nil;
+    } else {
+        [self hideHighlight];
+    }
+}
 
-        [self setNeedsDisplay];
+- (void)showHighlightOfRange:(NSRange)range
+{
+    CTFrameRef frame = [self layoutFrameForBounds:self.bounds];
+    if (!frame) {
+        return;
+    }
+
+    if (!_highlightLayer) {
+        _highlightLayer = [TWTRAttributedLabelHighlightLayer layer];
+        [self.layer addSublayer:_highlightLayer];
+    }
+
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    _highlightLayer.renderer = [[TWTRAttributedLabelRenderer alloc] initWithLabel:self attributedString:self.renderedAttributedText bounds:self.bounds];
+    _highlightLayer.textFrame = (__bridge id)frame;
+    _highlightLayer.highlightRange = range;
+    _highlightLayer.highlightAttributes = self.activeLinkAttributes;
+    _highlightLayer.frame = self.bounds;
+    _highlightLayer.contentsScale = self.contentScaleFactor;
+    _highlightLayer.hidden = NO;
+    [_highlightLayer setNeedsDisplay];
+    [CATransaction commit];
+}
+
+- (void)hideHighlight
+{
+    if (!_highlightLayer || _highlightLayer.hidden) {
+        return;
     }
+
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    _highlightLayer.hidden = YES;
+    _highlightLayer.renderer = nil;
+    _highlightLayer.textFrame = nil;
+    _highlightLayer.contents = nil;
+    [CATransaction commit];
 }
 
 #pragma mark - UILabel
@@ -1025,39 +902,14 @@ static inline CGSize CTFramesetterSuggestFrameSizeForAttributedStringWithConstra
         return [super textRectForBounds:bounds limitedToNumberOfLines:numberOfLines];
     }
 
-    CGRect textRect = bounds;
-
-    // Calculate height with a minimum of double the font pointSize, to ensure that CTFramesetterSuggestFrameSizeWithConstraints doesn't return CGSizeZero, as it would if textRect height is insufficient.
-    textRect.size.height = MAX(self.font.pointSize * 2.0f, bounds.size.height);
-
-    // Adjust the text to be in the center vertically, if the text size is smaller than bounds
-    CGSize textSize = CTFramesetterSuggestFrameSizeWithConstraints([self framesetter], CFRangeMake(0, (CFIndex)[self.attributedText length]), NULL, textRect.size, NULL);
-    textSize = CGSizeMake(CGFloat_ceil(textSize.width), CGFloat_ceil(textSize.height));  // Fix for iOS 4, CTFramesetterSuggestFrameSizeWithConstraints sometimes returns fractional sizes
-
-    if (textSize.height < textRect.size.height) {
-        CGFloat yOffset = 0.0f;
-        switch (self.verticalAlignment) {
-            case TWTRAttributedLabelVerticalAlignmentCenter:
-                yOffset = CGFloat_floor((bounds.size.height - textSize.height) / 2.0f);
-                break;
-            case TWTRAttributedLabelVerticalAlignmentBottom:
-                yOffset = bounds.size.height - textSize.height;
-                break;
-            case TWTRAttributedLabelVerticalAlignmentTop:
-            default:
-                break;
-        }
-
-        textRect.origin.y += yOffset;
-    }
-
-    return textRect;
+    return [TWTRAttributedLabelRenderer textRectForAttributedString:self.renderedAttributedText insetBounds:bounds font:self.font verticalAlignment:self.verticalAlignment];
 }
 
 - (void)drawTextInRect:(CGRect)rect
 {
     CGRect insetRect = UIEdgeInsetsInsetRect(rect, self.textInsets);
     if (!self.attributedText) {
+        [self clearAsynchronousContents];
         [super drawTextInRect:insetRect];
         return;
     }
@@ -1087,53 +939,123 @@ static inline CGSize CTFramesetterSuggestFrameSizeForAttributedStringWithConstra
         }
     }
 
-    CGContextRef c = UIGraphicsGetCurrentContext();
-    CGContextSaveGState(c);
-    {
-        CGContextSetTextMatrix(c, CGAffineTransformIdentity);
+    if ([self canDisplayAsynchronously]) {
+        [self displayAsynchronouslyInRect:rect];
+    } else {
+        [self clearAsynchronousContents];
+
+        // The renderer recolors the glyphs itself when the label is highlighted, so the same frame serves both states
+        TWTRAttributedLabelRenderer *renderer = [[TWTRAttributedLabelRenderer alloc] initWithLabel:self attributedString:self.renderedAttributedText bounds:rect];
+
+        // Laying out here keeps the frame around for hit testing until the text or bounds change
+        [renderer drawFrame:[self layoutFrameForBounds:rect] inContext:UIGraphicsGetCurrentContext()];
+    }
 
-        // Inverts the CTM to match iOS coordinates (otherwise text draws upside-down; Mac OS's system is different)
-        CGContextTranslateCTM(c, 0.0f, insetRect.size.height);
-        CGContextScaleCTM(c, 1.0f, -1.0f);
+    // If we adjusted the font size, set it back to its original size
+    if (originalAttributedText) {
+        // Use ivar directly to avoid clearing out framesetter and renderedAttributedText
+        _attributedText = originalAttributedText;
+    }
+}
 
-        CFRange textRange = CFRangeMake(0, (CFIndex)[self.attributedText length]);
+#pragma mark - Asynchronous Display
 
-        // First, get the text rect (which takes vertical centering into account)
-        CGRect textRect = [self textRectForBounds:rect limitedToNumberOfLines:self.numberOfLines];
++ (NSOperationQueue *)asynchronousDisplayQueue
+{
+    static NSOperationQueue *queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = [[NSOperationQueue alloc] init];
+        queue.name = @"com.twitterkit.attributed-label.display-queue";
+        queue.maxConcurrentOperationCount = 2;
+        queue.qualityOfService = NSQualityOfServiceUserInitiated;
+    });
+
+    return queue;
+}
 
-        // CoreText draws it's text aligned to the bottom, so we move the CTM here to take our vertical offsets into account
-        CGContextTranslateCTM(c, insetRect.origin.x, insetRect.size.height - textRect.origin.y - textRect.size.height);
+- (BOOL)canDisplayAsynchronously
+{
+    // Scaling the font to fit mutates the text while drawing, so it draws synchronously
+    BOOL adjustsFontSize = self.adjustsFontSizeToFitWidth && self.numberOfLines > 0;
 
-        // Second, trace the shadow before the actual text, if we have one
-        if (self.shadowColor && !self.highlighted) {
-            CGContextSetShadowWithColor(c, self.shadowOffset, self.shadowRadius, [self.shadowColor CGColor]);
-        } else if (self.highlightedShadowColor) {
-            CGContextSetShadowWithColor(c, self.highlightedShadowOffset, self.highlightedShadowRadius, [self.highlightedShadowColor CGColor]);
-        }
+    return self.displaysAsynchronously && self.attributedText && !adjustsFontSize;
+}
 
-        // Finally, draw the text or highlighted text itself (on top of the shadow, if there is one)
-        if (self.highlightedTextColor && self.highlighted) {
-            NSMutableAttributedString *highlightAttributedString = [self.renderedAttributedText mutableCopy];
-            [highlightAttributedString addAttribute:(__bridge NSString *)kCTForegroundColorAttributeName value:(id)[self.highlightedTextColor CGColor] range:NSMakeRange(0, highlightAttributedString.length)];
+- (void)displayAsynchronouslyInRect:(CGRect)rect
+{
+    TWTRAttributedLabelRenderer *renderer = [[TWTRAttributedLabelRenderer alloc] initWithLabel:self attributedString:self.renderedAttributedText bounds:rect];
+    CGFloat scale = self.contentScaleFactor;
+    NSUInteger generation = ++_displayGeneration;
+
+    // A newer render supersedes any that has not started yet
+    [_displayOperation cancel];
+
+    @weakify(self);
+    _displayOperation = [NSBlockOperation blockOperationWithBlock:^{
+        CGImageRef image = [renderer newImageWithScale:scale];
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            @strongify(self);
+            [self finishAsynchronousDisplayWithImage:image scale:scale generation:generation];
 
-            if (![self highlightFramesetter]) {
-                CTFramesetterRef highlightFramesetter = CTFramesetterCreateWithAttributedString((__bridge CFAttributedStringRef)highlightAttributedString);
-                [self setHighlightFramesetter:highlightFramesetter];
-                CFRelease(highlightFramesetter);
+            if (image) {
+                CGImageRelease(image);
             }
+        });
+    }];
 
-            [self drawFramesetter:[self highlightFramesetter] attributedString:highlightAttributedString textRange:textRange inRect:textRect context:c];
-        } else {
-            [self drawFramesetter:[self framesetter] attributedString:self.renderedAttributedText textRange:textRange inRect:textRect context:c];
-        }
+    [[[self class] asynchronousDisplayQueue] addOperation:_displayOperation];
+}
 
-        // If we adjusted the font size, set it back to its original size
-        if (originalAttributedText) {
-            // Use ivar directly to avoid clearing out framesetter and renderedAttributedText
-            _attributedText = originalAttributedText;
-        }
+- (void)finishAsynchronousDisplayWithImage:(CGImageRef)image scale:(CGFloat)scale generation:(NSUInteger)generation
+{
+    // Drop renders of text or bounds the label has since moved on from, e.g. after cell reuse
+    if (generation != _displayGeneration) {
+        return;
+    }
+
+    _displayOperation = nil;
+
+    if (!_asynchronousContentLayer) {
+        _asynchronousContentLayer = [CALayer layer];
+
+        // Keep the text below the link highlight
+        [self.layer insertSublayer:_asynchronousContentLayer atIndex:0];
+    }
+
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    _asynchronousContentLayer.frame = self.bounds;
+    _asynchronousContentLayer.contentsScale = scale;
+    _asynchronousContentLayer.contents = (__bridge id)image;
+    [CATransaction commit];
+}
+
+- (void)clearAsynchronousContents
+{
+    if (!_displayOperation && !_asynchronousContentLayer.contents) {
+        return;
+    }
+
+    _displayGeneration++;
+    [_displayOperation cancel];
+    _displayOperation = nil;
+
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    _asynchronousContentLayer.contents = nil;
+    [CATransaction commit];
+}
+
+- (void)setDisplaysAsynchronously:(BOOL)displaysAsynchronously
+{
+    if (_displaysAsynchronously == displaysAsynchronously) {
+        return;
     }
-    CGContextRestoreGState(c);
+
+    _displaysAsynchronously = displaysAsynchronously;
+    [self setNeedsDisplay];
 }
 
 #pragma mark - UIAccessibilityElement
@@ -1160,12 +1082,19 @@ static inline CGSize CTFramesetterSuggestFrameSizeForAttributedStringWithConstra
 
 - (NSArray *)accessibilityElements
 {
+    // Link frames come from the layout, so rebuild them once the layout no longer matches the label
+    if (_accessibilityElements && ![self isLayoutFrameValidForBounds:self.bounds]) {
+        _accessibilityElements = nil;
+    }
+
     if (!_accessibilityElements) {
         @synchronized(self)
         {
             NSMutableArray *mutableAccessibilityItems = [NSMutableArray array];
+            NSArray<NSValue *> *entityFrames = [self entityFrames];
 
-            for (TWTRTweetEntityRange *result in self.entities) {
+            for (NSUInteger entityIndex = 0; entityIndex < [self.entities count]; entityIndex++) {
+                TWTRTweetEntityRange *result = self.entities[entityIndex];
                 NSString *sourceText = [self.text isKindOfClass:[NSString class]] ? self.text : [(NSAttributedString *)self.text string];
 
                 NSString *accessibilityLabel = [sourceText substringWithRange:result.textRange];
@@ -1174,7 +1103,7 @@ static inline CGSize CTFramesetterSuggestFrameSizeForAttributedStringWithConstra
                 if (accessibilityLabel) {
                     UIAccessibilityElement *linkElement = [[UIAccessibilityElement alloc] initWithAccessibilityContainer:self];
                     linkElement.accessibilityTraits = UIAccessibilityTraitLink;
-                    linkElement.accessibilityFrame = [self convertRect:[self boundingRectForCharacterRange:result.textRange] toView:self.window];
+                    linkElement.accessibilityFrame = [self convertRect:[entityFrames[entityIndex] CGRectValue] toView:self.window];
                     linkElement.accessibilityLabel = accessibilityLabel;
 
                     if (![accessibilityLabel isEqualToString:accessibilityValue]) {
@@ -1208,7 +1137,7 @@ static inline CGSize CTFramesetterSuggestFrameSizeForAttributedStringWithConstra
     if (!self.attributedText) {
         return [super sizeThatFits:size];
     } else {
-        size = CTFramesetterSuggestFrameSizeForAttributedStringWithConstraints([self framesetter], self.attributedText, size, (NSUInteger)self.numberOfLines);
+        size = [[TWTRTypesetterCache sharedCache] layoutForAttributedString:self.renderedAttributedText width:size.width numberOfLines:(NSUInteger)self.numberOfLines].suggestedSize;
         size.width += self.textInsets.left + self.textInsets.right;
         size.height += self.textInsets.top + self.textInsets.bottom;
 
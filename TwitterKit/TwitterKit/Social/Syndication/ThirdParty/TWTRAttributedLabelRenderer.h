@@ -0,0 +1,126 @@
+// TWTRAttributedLabelRenderer.h
+//
+// Copyright (c) 2011 Mattt Thompson (http://mattt.me)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+/**
+ This header is private to the Twitter Kit SDK and not exposed for public SDK consumption
+ */
+
+#import <CoreText/CoreText.h>
+#import <UIKit/UIKit.h>
+#import "TWTRAttributedLabel.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Returns the flush factor used to offset the pen of a line for the given text alignment.
+ */
+FOUNDATION_EXTERN CGFloat TWTRAttributedLabelFlushFactorForTextAlignment(NSTextAlignment textAlignment);
+
+/**
+ `TWTRAttributedLabelRenderer` draws the text of a `TWTRAttributedLabel` from an immutable snapshot of the label's text and styling. Drawing uses Core Text and Core Graphics, along with the `UIColor` and `UIFont` values of the snapshot and UIKit's geometry functions. Colors and fonts are immutable, and UIKit documents them as safe to use from multiple threads, so once created on the main thread the renderer can draw on any thread.
+ */
+@interface TWTRAttributedLabelRenderer : NSObject
+
+/**
+ The attributed string to draw.
+ */
+@property (nonatomic, copy, readonly) NSAttributedString *attributedString;
+
+/**
+ The bounds of the label at the time of the snapshot.
+ */
+@property (nonatomic, readonly) CGRect bounds;
+
+@property (nonatomic, readonly) UIEdgeInsets textInsets;
+@property (nonatomic, readonly) NSInteger numberOfLines;
+@property (nonatomic, readonly) NSTextAlignment textAlignment;
+@property (nonatomic, readonly) NSLineBreakMode lineBreakMode;
+@property (nonatomic, readonly) TWTRAttributedLabelVerticalAlignment verticalAlignment;
+@property (nonatomic, readonly) UIFont *font;
+@property (nonatomic, copy, readonly, nullable) NSString *truncationTokenString;
+@property (nonatomic, copy, readonly, nullable) NSDictionary *truncationTokenStringAttributes;
+
+/**
+ The color to draw all of the text in while the label is highlighted, or `nil` to use the colors of the attributed string.
+ */
+@property (nonatomic, readonly, nullable) UIColor *highlightedTextColor;
+
+/**
+ The shadow to draw the text with, resolved for the label's highlighted state. `nil` for no shadow.
+ */
+@property (nonatomic, readonly, nullable) UIColor *shadowColor;
+@property (nonatomic, readonly) CGSize shadowOffset;
+@property (nonatomic, readonly) CGFloat shadowRadius;
+
+/**
+ The rect the text is laid out in, which takes the insets and vertical alignment into account.
+ */
+@property (nonatomic, readonly) CGRect textRect;
+
+/**
+ Returns the rect to lay out an attributed string in within bounds that are already inset.
+
+ @param attributedString The attributed string to lay out.
+ @param bounds The bounds of the label, inset by its text insets.
+ @param font The font of the label.
+ @param verticalAlignment The vertical alignment of the text within the bounds.
+ */
++ (CGRect)textRectForAttributedString:(NSAttributedString *)attributedString insetBounds:(CGRect)bounds font:(UIFont *)font verticalAlignment:(TWTRAttributedLabelVerticalAlignment)verticalAlignment;
+
+/**
+ Snapshots the label's styling. Must be called on the main thread.
+
+ @param label The label to snapshot.
+ @param attributedString The string to draw, which differs from the label's text while it is highlighted.
+ @param bounds The rect to draw the label in.
+ */
+- (instancetype)initWithLabel:(TWTRAttributedLabel *)label attributedString:(NSAttributedString *)attributedString bounds:(CGRect)bounds;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Draws the text into a context using UIKit's coordinate system.
+
+ @param frame A frame of `attributedString` laid out in `textRect`, or `NULL` to lay out a new one.
+ @param context The context to draw into.
+ */
+- (void)drawFrame:(nullable CTFrameRef)frame inContext:(CGContextRef)context;
+
+/**
+ Draws the highlight of a range of the text on top of text drawn by `drawFrame:inContext:`, without laying out the text again. The background of the range is drawn using the `kTWTRBackground...` attributes and its glyphs are redrawn in the foreground color of the attributes.
+
+ @param range The range of the text to highlight.
+ @param attributes The attributes of the highlight, e.g. the label's `activeLinkAttributes`.
+ @param frame The frame the text was drawn from.
+ @param context The context to draw into, using UIKit's coordinate system.
+ */
+- (void)drawHighlightOfRange:(NSRange)range withAttributes:(NSDictionary *)attributes frame:(CTFrameRef)frame inContext:(CGContextRef)context;
+
+/**
+ Renders the text into a new transparent bitmap of the bounds size at the given scale. The caller owns the returned image.
+ */
+- (nullable CGImageRef)newImageWithScale:(CGFloat)scale CF_RETURNS_RETAINED;
+
+@end
+
+NS_ASSUME_NONNULL_END
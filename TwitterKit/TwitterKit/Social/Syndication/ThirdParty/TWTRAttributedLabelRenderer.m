@@ -0,0 +1,672 @@
+// TWTRAttributedLabelRenderer.m
+//
+// Copyright (c) 2011 Mattt Thompson (http://mattt.me)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#import "TWTRAttributedLabelRenderer.h"
+#import "TWTRTypesetterCache.h"
+
+static inline CGFLOAT_TYPE CGFloat_ceil(CGFLOAT_TYPE cgfloat)
+{
+#if CGFLOAT_IS_DOUBLE
+    return ceil(cgfloat);
+#else
+    return ceilf(cgfloat);
+#endif
+}
+
+static inline CGFLOAT_TYPE CGFloat_floor(CGFLOAT_TYPE cgfloat)
+{
+#if CGFLOAT_IS_DOUBLE
+    return floor(cgfloat);
+#else
+    return floorf(cgfloat);
+#endif
+}
+
+static inline CGFLOAT_TYPE CGFloat_round(CGFLOAT_TYPE cgfloat)
+{
+#if CGFLOAT_IS_DOUBLE
+    return round(cgfloat);
+#else
+    return roundf(cgfloat);
+#endif
+}
+
+CGFloat TWTRAttributedLabelFlushFactorForTextAlignment(NSTextAlignment textAlignment)
+{
+    switch (textAlignment) {
+        case NSTextAlignmentCenter:
+            return 0.5f;
+        case NSTextAlignmentRight:
+            return 1.0f;
+        case NSTextAlignmentLeft:
+        default:
+            return 0.0f;
+    }
+}
+
+/**
+ Draws the glyphs of a line that fall in a string range filled with the given color, ignoring the colors of the runs. The line is drawn at the current text position. A range with a length of 0 draws the whole line.
+ */
+static void TWTRAttributedLabelDrawGlyphsOfLine(CTLineRef line, CFRange range, CGColorRef color, CGContextRef c)
+{
+    CGPoint textPosition = CGContextGetTextPosition(c);
+    CGContextSetFillColorWithColor(c, color);
+
+    for (id glyphRun in (__bridge NSArray *)CTLineGetGlyphRuns(line)) {
+        CTRunRef run = (__bridge CTRunRef)glyphRun;
+        CFRange runRange = CTRunGetStringRange(run);
+        if (range.length > 0 && (runRange.location >= range.location + range.length || runRange.location + runRange.length <= range.location)) {
+            continue;
+        }
+
+        CTFontRef font = CFDictionaryGetValue(CTRunGetAttributes(run), kCTFontAttributeName);
+        CFIndex glyphCount = CTRunGetGlyphCount(run);
+        if (!font || glyphCount == 0) {
+            continue;
+        }
+
+        CGGlyph glyphs[glyphCount];
+        CGPoint positions[glyphCount];
+        CFIndex stringIndices[glyphCount];
+        CTRunGetGlyphs(run, CFRangeMake(0, 0), glyphs);
+        CTRunGetPositions(run, CFRangeMake(0, 0), positions);
+        CTRunGetStringIndices(run, CFRangeMake(0, 0), stringIndices);
+
+        // Keep the glyphs in range, moving them from line to user space
+        size_t drawnGlyphCount = 0;
+        for (CFIndex glyphIndex = 0; glyphIndex < glyphCount; glyphIndex++) {
+            CFIndex stringIndex = stringIndices[glyphIndex];
+            if (range.length > 0 && (stringIndex < range.location || stringIndex >= range.location + range.length)) {
+                continue;
+            }
+
+            glyphs[drawnGlyphCount] = glyphs[glyphIndex];
+            positions[drawnGlyphCount] = CGPointMake(positions[glyphIndex].x + textPosition.x, positions[glyphIndex].y + textPosition.y);
+            drawnGlyphCount++;
+        }
+
+        CTFontDrawGlyphs(font, glyphs, positions, drawnGlyphCount, c);
+    }
+}
+
+/**
+ Equivalent of `+[UIBezierPath bezierPathWithRoundedRect:cornerRadius:]`, which is not safe to use off the main thread. The radius is clamped the same way.
+ */
+static CGPathRef TWTRAttributedLabelCreateRoundedRectPath(CGRect rect, CGFloat cornerRadius)
+{
+    if (CGRectIsNull(rect)) {
+        return CGPathCreateMutable();
+    }
+
+    rect = CGRectStandardize(rect);
+    CGFloat radius = MAX(0.0f, MIN(cornerRadius, MIN(CGRectGetWidth(rect), CGRectGetHeight(rect)) / 2.0f));
+
+    return CGPathCreateWithRoundedRect(rect, radius, radius, NULL);
+}
+
+static CGColorRef TWTRAttributedLabelColorFromAttributes(NSDictionary *attributes)
+{
+    id color = attributes[NSForegroundColorAttributeName] ?: attributes[(id)kCTForegroundColorAttributeName];
+    if ([color isKindOfClass:[UIColor class]]) {
+        return [color CGColor];
+    }
+    return (__bridge CGColorRef)color;
+}
+
+@implementation TWTRAttributedLabelRenderer {
+    CGRect _textRect;
+    BOOL _hasTextRect;
+}
+
+- (instancetype)initWithLabel:(TWTRAttributedLabel *)label attributedString:(NSAttributedString *)attributedString bounds:(CGRect)bounds
+{
+    self = [super init];
+    if (self) {
+        _attributedString = [attributedString copy];
+        _bounds = bounds;
+        _textInsets = label.textInsets;
+        _numberOfLines = label.numberOfLines;
+        _textAlignment = label.textAlignment;
+        _lineBreakMode = label.lineBreakMode;
+        _verticalAlignment = label.verticalAlignment;
+        _font = label.font;
+        _truncationTokenString = [label.truncationTokenString copy];
+        _truncationTokenStringAttributes = [label.truncationTokenStringAttributes copy];
+        _highlightedTextColor = label.highlighted ? label.highlightedTextColor : nil;
+
+        if (label.shadowColor && !label.highlighted) {
+            _shadowColor = label.shadowColor;
+            _shadowOffset = label.shadowOffset;
+            _shadowRadius = label.shadowRadius;
+        } else if (label.highlightedShadowColor) {
+            _shadowColor = label.highlightedShadowColor;
+            _shadowOffset = label.highlightedShadowOffset;
+            _shadowRadius = label.highlightedShadowRadius;
+        }
+    }
+    return self;
+}
+
++ (CGRect)textRectForAttributedString:(NSAttributedString *)attributedString insetBounds:(CGRect)bounds font:(UIFont *)font verticalAlignment:(TWTRAttributedLabelVerticalAlignment)verticalAlignment
+{
+    CGRect textRect = bounds;
+
+    // Calculate height with a minimum of double the font pointSize, to ensure that CTFramesetterSuggestFrameSizeWithConstraints doesn't return CGSizeZero, as it would if textRect height is insufficient.
+    textRect.size.height = MAX(font.pointSize * 2.0f, bounds.size.height);
+
+    // Adjust the text to be in the center vertically, if the text size is smaller than bounds
+    CGSize textSize = [[TWTRTypesetterCache sharedCache] suggestFrameSizeForAttributedString:attributedString constraints:textRect.size];
+    textSize = CGSizeMake(CGFloat_ceil(textSize.width), CGFloat_ceil(textSize.height));  // Fix for iOS 4, CTFramesetterSuggestFrameSizeWithConstraints sometimes returns fractional sizes
+
+    if (textSize.height < textRect.size.height) {
+        CGFloat yOffset = 0.0f;
+        switch (verticalAlignment) {
+            case TWTRAttributedLabelVerticalAlignmentCenter:
+                yOffset = CGFloat_floor((bounds.size.height - textSize.height) / 2.0f);
+                break;
+            case TWTRAttributedLabelVerticalAlignmentBottom:
+                yOffset = bounds.size.height - textSize.height;
+                break;
+            case TWTRAttributedLabelVerticalAlignmentTop:
+            default:
+                break;
+        }
+
+        textRect.origin.y += yOffset;
+    }
+
+    return textRect;
+}
+
+- (CGRect)textRect
+{
+    if (!_hasTextRect) {
+        _textRect = [[self class] textRectForAttributedString:self.attributedString insetBounds:UIEdgeInsetsInsetRect(self.bounds, self.textInsets) font:self.font verticalAlignment:self.verticalAlignment];
+        _hasTextRect = YES;
+    }
+
+    return _textRect;
+}
+
+#pragma mark - Drawing
+
+- (CGImageRef)newImageWithScale:(CGFloat)scale
+{
+    size_t width = (size_t)ceil(CGRectGetWidth(self.bounds) * scale);
+    size_t height = (size_t)ceil(CGRectGetHeight(self.bounds) * scale);
+    if (width == 0 || height == 0) {
+        return NULL;
+    }
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace, kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Little);
+    CGColorSpaceRelease(colorSpace);
+
+    if (!context) {
+        return NULL;
+    }
+
+    // Match the coordinate system of a UIKit image context
+    CGContextTranslateCTM(context, 0.0f, height);
+    CGContextScaleCTM(context, scale, -scale);
+    CGContextTranslateCTM(context, -CGRectGetMinX(self.bounds), -CGRectGetMinY(self.bounds));
+
+    [self drawFrame:NULL inContext:context];
+
+    CGImageRef image = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+
+    return image;
+}
+
+/**
+ Moves the origin of the context to the bottom left corner of the text rect and flips it to match Core Text.
+ */
+- (void)prepareContextForDrawingText:(CGContextRef)c
+{
+    CGRect insetRect = UIEdgeInsetsInsetRect(self.bounds, self.textInsets);
+    CGRect textRect = self.textRect;
+
+    CGContextSetTextMatrix(c, CGAffineTransformIdentity);
+
+    // Inverts the CTM to match iOS coordinates (otherwise text draws upside-down; Mac OS's system is different)
+    CGContextTranslateCTM(c, 0.0f, insetRect.size.height);
+    CGContextScaleCTM(c, 1.0f, -1.0f);
+
+    // CoreText draws it's text aligned to the bottom, so we move the CTM here to take our vertical offsets into account
+    CGContextTranslateCTM(c, insetRect.origin.x, insetRect.size.height - textRect.origin.y - textRect.size.height);
+}
+
+- (void)drawFrame:(CTFrameRef)frame inContext:(CGContextRef)c
+{
+    CGRect textRect = self.textRect;
+
+    CTFrameRef ownedFrame = NULL;
+    if (!frame) {
+        CGMutablePathRef path = CGPathCreateMutable();
+        CGPathAddRect(path, NULL, textRect);
+        ownedFrame = [[TWTRTypesetterCache sharedCache] copyFrameForAttributedString:self.attributedString path:path];
+        CFRelease(path);
+
+        frame = ownedFrame;
+    }
+
+    if (!frame) {
+        return;
+    }
+
+    CGContextSaveGState(c);
+    {
+        [self prepareContextForDrawingText:c];
+
+        // Trace the shadow before the actual text, if we have one
+        if (self.shadowColor) {
+            CGContextSetShadowWithColor(c, self.shadowOffset, self.shadowRadius, [self.shadowColor CGColor]);
+        }
+
+        [self drawLinesOfFrame:frame inRect:textRect context:c];
+    }
+    CGContextRestoreGState(c);
+
+    if (ownedFrame) {
+        CFRelease(ownedFrame);
+    }
+}
+
+- (void)drawLinesOfFrame:(CTFrameRef)frame inRect:(CGRect)rect context:(CGContextRef)c
+{
+    NSAttributedString *attributedString = self.attributedString;
+    CFRange textRange = CFRangeMake(0, (CFIndex)[attributedString length]);
+
+    [self drawBackground:frame inRect:rect context:c];
+
+    CFArrayRef lines = CTFrameGetLines(frame);
+    NSInteger numberOfLines = self.numberOfLines > 0 ? MIN(self.numberOfLines, CFArrayGetCount(lines)) : CFArrayGetCount(lines);
+    BOOL truncateLastLine = (self.lineBreakMode == NSLineBreakByTruncatingHead || self.lineBreakMode == NSLineBreakByTruncatingMiddle || self.lineBreakMode == NSLineBreakByTruncatingTail);
+
+    CGPoint lineOrigins[numberOfLines];
+    CTFrameGetLineOrigins(frame, CFRangeMake(0, numberOfLines), lineOrigins);
+
+    for (CFIndex lineIndex = 0; lineIndex < numberOfLines; lineIndex++) {
+        CGPoint lineOrigin = lineOrigins[lineIndex];
+        lineOrigin = CGPointMake(CGFloat_ceil(lineOrigin.x), CGFloat_ceil(lineOrigin.y));
+
+        CGContextSetTextPosition(c, lineOrigin.x, lineOrigin.y);
+        CTLineRef line = CFArrayGetValueAtIndex(lines, lineIndex);
+
+        CGFloat descent = 0.0f;
+        CTLineGetTypographicBounds((CTLineRef)line, NULL, &descent, NULL);
+
+        // Adjust pen offset for flush depending on text alignment
+        CGFloat flushFactor = TWTRAttributedLabelFlushFactorForTextAlignment(self.textAlignment);
+
+        if (lineIndex == numberOfLines - 1 && truncateLastLine) {
+            // Check if the range of text in the last line reaches the end of the full attributed string
+            CFRange lastLineRange = CTLineGetStringRange(line);
+
+            if (!(lastLineRange.length == 0 && lastLineRange.location == 0) && lastLineRange.location + lastLineRange.length < textRange.location + textRange.length) {
+                // Get correct truncationType and attribute position
+                CTLineTruncationType truncationType;
+                CFIndex truncationAttributePosition = lastLineRange.location;
+                NSLineBreakMode lineBreakMode = self.lineBreakMode;
+
+                // Multiple lines, only use UILineBreakModeTailTruncation
+                if (numberOfLines != 1) {
+                    lineBreakMode = NSLineBreakByTruncatingTail;
+                }
+
+                switch (lineBreakMode) {
+                    case NSLineBreakByTruncatingHead:
+                        truncationType = kCTLineTruncationStart;
+                        break;
+                    case NSLineBreakByTruncatingMiddle:
+                        truncationType = kCTLineTruncationMiddle;
+                        truncationAttributePosition += (lastLineRange.length / 2);
+                        break;
+                    case NSLineBreakByTruncatingTail:
+                    default:
+                        truncationType = kCTLineTruncationEnd;
+                        truncationAttributePosition += (lastLineRange.length - 1);
+                        break;
+                }
+
+                NSString *truncationTokenString = self.truncationTokenString;
+                if (!truncationTokenString) {
+                    truncationTokenString = @"\u2026";  // Unicode Character 'HORIZONTAL ELLIPSIS' (U+2026)
+                }
+
+                NSDictionary *truncationTokenStringAttributes = self.truncationTokenStringAttributes;
+                if (!truncationTokenStringAttributes) {
+                    truncationTokenStringAttributes = [attributedString attributesAtIndex:(NSUInteger)truncationAttributePosition effectiveRange:NULL];
+                }
+
+                NSAttributedString *attributedTokenString = [[NSAttributedString alloc] initWithString:truncationTokenString attributes:truncationTokenStringAttributes];
+                CTLineRef truncationToken = CTLineCreateWithAttributedString((__bridge CFAttributedStringRef)attributedTokenString);
+
+                // Append truncationToken to the string
+                // because if string isn't too long, CT wont add the truncationToken on it's own
+                // There is no change of a double truncationToken because CT only add the token if it removes characters (and the one we add will go first)
+                NSMutableAttributedString *truncationString = [[attributedString attributedSubstringFromRange:NSMakeRange((NSUInteger)lastLineRange.location, (NSUInteger)lastLineRange.length)] mutableCopy];
+                if (lastLineRange.length > 0) {
+                    // Remove any newline at the end (we don't want newline space between the text and the truncation token). There can only be one, because the second would be on the next line.
+                    unichar lastCharacter = [[truncationString string] characterAtIndex:(NSUInteger)(lastLineRange.length - 1)];
+                    if ([[NSCharacterSet newlineCharacterSet] characterIsMember:lastCharacter]) {
+                        [truncationString deleteCharactersInRange:NSMakeRange((NSUInteger)(lastLineRange.length - 1), 1)];
+                    }
+                }
+                [truncationString appendAttributedString:attributedTokenString];
+                CTLineRef truncationLine = CTLineCreateWithAttributedString((__bridge CFAttributedStringRef)truncationString);
+
+                // Truncate the line in case it is too long.
+                CTLineRef truncatedLine = CTLineCreateTruncatedLine(truncationLine, rect.size.width, truncationType, truncationToken);
+                if (!truncatedLine) {
+                    // If the line is not as wide as the truncationToken, truncatedLine is NULL
+                    truncatedLine = CFRetain(truncationToken);
+                }
+
+                CGFloat penOffset = (CGFloat)CTLineGetPenOffsetForFlush(truncatedLine, flushFactor, rect.size.width);
+                CGContextSetTextPosition(c, penOffset, lineOrigin.y - descent - self.font.descender);
+
+                [self drawLine:truncatedLine context:c];
+
+                CFRelease(truncatedLine);
+                CFRelease(truncationLine);
+                CFRelease(truncationToken);
+            } else {
+                CGFloat penOffset = (CGFloat)CTLineGetPenOffsetForFlush(line, flushFactor, rect.size.width);
+                CGContextSetTextPosition(c, penOffset, lineOrigin.y - descent - self.font.descender);
+                [self drawLine:line context:c];
+            }
+        } else {
+            CGFloat penOffset = (CGFloat)CTLineGetPenOffsetForFlush(line, flushFactor, rect.size.width);
+            CGContextSetTextPosition(c, penOffset, lineOrigin.y - descent - self.font.descender);
+            [self drawLine:line context:c];
+        }
+    }
+
+    [self drawStrike:frame inRect:rect context:c];
+}
+
+- (void)drawLine:(CTLineRef)line context:(CGContextRef)c
+{
+    if (self.highlightedTextColor) {
+        TWTRAttributedLabelDrawGlyphsOfLine(line, CFRangeMake(0, 0), [self.highlightedTextColor CGColor], c);
+    } else {
+        CTLineDraw(line, c);
+    }
+}
+
+- (void)drawHighlightOfRange:(NSRange)range withAttributes:(NSDictionary *)attributes frame:(CTFrameRef)frame inContext:(CGContextRef)c
+{
+    if (!frame || range.length == 0) {
+        return;
+    }
+
+    UIColor *fillColor = attributes[kTWTRBackgroundFillColorAttributeName];
+    UIColor *strokeColor = attributes[kTWTRBackgroundStrokeColorAttributeName];
+    UIEdgeInsets fillPadding = [attributes[kTWTRBackgroundFillPaddingAttributeName] UIEdgeInsetsValue];
+    CGFloat cornerRadius = [attributes[kTWTRBackgroundCornerRadiusAttributeName] floatValue];
+    CGFloat lineWidth = [attributes[kTWTRBackgroundLineWidthAttributeName] floatValue];
+    CGColorRef textColor = TWTRAttributedLabelColorFromAttributes(attributes);
+
+    CFArrayRef lines = CTFrameGetLines(frame);
+    NSInteger numberOfLines = self.numberOfLines > 0 ? MIN(self.numberOfLines, CFArrayGetCount(lines)) : CFArrayGetCount(lines);
+    BOOL truncateLastLine = (self.lineBreakMode == NSLineBreakByTruncatingHead || self.lineBreakMode == NSLineBreakByTruncatingMiddle || self.lineBreakMode == NSLineBreakByTruncatingTail);
+    CGFloat flushFactor = TWTRAttributedLabelFlushFactorForTextAlignment(self.textAlignment);
+    CFIndex rangeStart = (CFIndex)range.location;
+    CFIndex rangeEnd = (CFIndex)NSMaxRange(range);
+
+    CGContextSaveGState(c);
+    [self prepareContextForDrawingText:c];
+
+    for (CFIndex lineIndex = 0; lineIndex < numberOfLines; lineIndex++) {
+        CTLineRef line = CFArrayGetValueAtIndex(lines, lineIndex);
+        CFRange lineRange = CTLineGetStringRange(line);
+        if (lineRange.location >= rangeEnd) {
+            break;
+        }
+        if (lineRange.location + lineRange.length <= rangeStart) {
+            continue;
+        }
+
+        CGPoint lineOrigin;
+        CTFrameGetLineOrigins(frame, CFRangeMake(lineIndex, 1), &lineOrigin);
+
+        CGFloat ascent = 0.0f, descent = 0.0f;
+        CTLineGetTypographicBounds(line, &ascent, &descent, NULL);
+
+        // Position the line exactly where drawLinesOfFrame:inRect:context: drew it
+        CGFloat penOffset = (CGFloat)CTLineGetPenOffsetForFlush(line, flushFactor, self.textRect.size.width);
+        CGPoint textPosition = CGPointMake(penOffset, CGFloat_ceil(lineOrigin.y) - descent - self.font.descender);
+
+        CFIndex start = MAX(rangeStart, lineRange.location);
+        CFIndex end = MIN(rangeEnd, lineRange.location + lineRange.length);
+        CGFloat startOffset = (CGFloat)CTLineGetOffsetForStringIndex(line, start, NULL);
+        CGFloat endOffset = (CGFloat)CTLineGetOffsetForStringIndex(line, end, NULL);
+
+        if (fillColor || strokeColor) {
+            CGRect highlightBounds = CGRectMake(textPosition.x + MIN(startOffset, endOffset) - fillPadding.left, textPosition.y - descent - fillPadding.bottom, (CGFloat)fabs(endOffset - startOffset) + fillPadding.left + fillPadding.right, ascent + descent + fillPadding.top + fillPadding.bottom);
+            CGPathRef path = TWTRAttributedLabelCreateRoundedRectPath(CGRectInset(CGRectInset(highlightBounds, -1.0f, 0.0f), lineWidth, lineWidth), cornerRadius);
+
+            CGContextSetLineJoin(c, kCGLineJoinRound);
+
+            if (fillColor) {
+                CGContextSetFillColorWithColor(c, fillColor.CGColor);
+                CGContextAddPath(c, path);
+                CGContextFillPath(c);
+            }
+
+            if (strokeColor) {
+                CGContextSetStrokeColorWithColor(c, strokeColor.CGColor);
+                CGContextAddPath(c, path);
+                CGContextStrokePath(c);
+            }
+
+            CGPathRelease(path);
+        }
+
+        // A truncated last line was drawn from a different line, so its glyphs can't be redrawn in place
+        BOOL isTruncated = lineIndex == numberOfLines - 1 && truncateLastLine && lineRange.location + lineRange.length < (CFIndex)[self.attributedString length];
+        if (textColor && !isTruncated) {
+            CGContextSetTextPosition(c, textPosition.x, textPosition.y);
+            TWTRAttributedLabelDrawGlyphsOfLine(line, CFRangeMake(start, end - start), textColor, c);
+        }
+    }
+
+    CGContextRestoreGState(c);
+}
+
+- (void)drawBackground:(CTFrameRef)frame inRect:(CGRect)rect context:(CGContextRef)c
+{
+    NSArray *lines = (__bridge NSArray *)CTFrameGetLines(frame);
+    CGPoint origins[[lines count]];
+    CTFrameGetLineOrigins(frame, CFRangeMake(0, 0), origins);
+
+    // Adjust pen offset for flush depending on text alignment
+    CGFloat flushFactor = TWTRAttributedLabelFlushFactorForTextAlignment(self.textAlignment);
+
+    // Compensate for y-offset of text rect from vertical positioning
+    CGFloat yOffset = self.textInsets.top - self.textRect.origin.y;
+
+    CFIndex lineIndex = 0;
+    for (id line in lines) {
+        CGFloat ascent = 0.0f, descent = 0.0f, leading = 0.0f;
+        CGFloat width = (CGFloat)CTLineGetTypographicBounds((__bridge CTLineRef)line, &ascent, &descent, &leading);
+        CGRect lineBounds = CGRectMake(rect.origin.x, rect.origin.y, width, ascent + descent + leading);
+
+        CGFloat penOffset = (CGFloat)CTLineGetPenOffsetForFlush((__bridge CTLineRef)line, flushFactor, rect.size.width);
+
+        lineBounds.origin.x += origins[lineIndex].x;
+        lineBounds.origin.y += origins[lineIndex].y;
+
+        for (id glyphRun in (__bridge NSArray *)CTLineGetGlyphRuns((__bridge CTLineRef)line)) {
+            NSDictionary *attributes = (__bridge NSDictionary *)CTRunGetAttributes((__bridge CTRunRef)glyphRun);
+            UIColor *strokeColor = [attributes objectForKey:kTWTRBackgroundStrokeColorAttributeName];
+            UIColor *fillColor = [attributes objectForKey:kTWTRBackgroundFillColorAttributeName];
+            UIEdgeInsets fillPadding = [[attributes objectForKey:kTWTRBackgroundFillPaddingAttributeName] UIEdgeInsetsValue];
+            CGFloat cornerRadius = [[attributes objectForKey:kTWTRBackgroundCornerRadiusAttributeName] floatValue];
+            CGFloat lineWidth = [[attributes objectForKey:kTWTRBackgroundLineWidthAttributeName] floatValue];
+
+            if (strokeColor || fillColor) {
+                CGRect runBounds = CGRectZero;
+                CGFloat runAscent = 0.0f;
+                CGFloat runDescent = 0.0f;
+
+                runBounds.size.width = (CGFloat)CTRunGetTypographicBounds((__bridge CTRunRef)glyphRun, CFRangeMake(0, 0), &runAscent, &runDescent, NULL) + fillPadding.left + fillPadding.right;
+                runBounds.size.height = runAscent + runDescent + fillPadding.top + fillPadding.bottom;
+
+                CGFloat xOffset = 0.0f;
+                CFRange glyphRange = CTRunGetStringRange((__bridge CTRunRef)glyphRun);
+                switch (CTRunGetStatus((__bridge CTRunRef)glyphRun)) {
+                    case kCTRunStatusRightToLeft:
+                        xOffset = CTLineGetOffsetForStringIndex((__bridge CTLineRef)line, glyphRange.location + glyphRange.length, NULL);
+                        break;
+                    default:
+                        xOffset = CTLineGetOffsetForStringIndex((__bridge CTLineRef)line, glyphRange.location, NULL);
+                        break;
+                }
+
+                runBounds.origin.x = penOffset + rect.origin.x + xOffset - fillPadding.left - rect.origin.x;
+                runBounds.origin.y = origins[lineIndex].y + rect.origin.y + yOffset - fillPadding.bottom - rect.origin.y;
+                runBounds.origin.y -= runDescent;
+
+                // Don't draw higlightedLinkBackground too far to the right
+                if (CGRectGetWidth(runBounds) > CGRectGetWidth(lineBounds)) {
+                    runBounds.size.width = CGRectGetWidth(lineBounds);
+                }
+
+                CGPathRef path = TWTRAttributedLabelCreateRoundedRectPath(CGRectInset(CGRectInset(runBounds, -1.0f, 0.0f), lineWidth, lineWidth), cornerRadius);
+
+                CGContextSetLineJoin(c, kCGLineJoinRound);
+
+                if (fillColor) {
+                    CGContextSetFillColorWithColor(c, fillColor.CGColor);
+                    CGContextAddPath(c, path);
+                    CGContextFillPath(c);
+                }
+
+                if (strokeColor) {
+                    CGContextSetStrokeColorWithColor(c, strokeColor.CGColor);
+                    CGContextAddPath(c, path);
+                    CGContextStrokePath(c);
+                }
+
+                CGPathRelease(path);
+            }
+        }
+
+        lineIndex++;
+    }
+}
+
+- (void)drawStrike:(CTFrameRef)frame inRect:(__unused CGRect)rect context:(CGContextRef)c
+{
+    NSArray *lines = (__bridge NSArray *)CTFrameGetLines(frame);
+    CGPoint origins[[lines count]];
+    CTFrameGetLineOrigins(frame, CFRangeMake(0, 0), origins);
+
+    // Adjust pen offset for flush depending on text alignment
+    CGFloat flushFactor = TWTRAttributedLabelFlushFactorForTextAlignment(self.textAlignment);
+
+    CFIndex lineIndex = 0;
+    for (id line in lines) {
+        CGFloat ascent = 0.0f, descent = 0.0f, leading = 0.0f;
+        CGFloat width = (CGFloat)CTLineGetTypographicBounds((__bridge CTLineRef)line, &ascent, &descent, &leading);
+        CGRect lineBounds = CGRectMake(0.0f, 0.0f, width, ascent + descent + leading);
+        lineBounds.origin.x = origins[lineIndex].x;
+        lineBounds.origin.y = origins[lineIndex].y;
+
+        CGFloat penOffset = (CGFloat)CTLineGetPenOffsetForFlush((__bridge CTLineRef)line, flushFactor, rect.size.width);
+
+        for (id glyphRun in (__bridge NSArray *)CTLineGetGlyphRuns((__bridge CTLineRef)line)) {
+            NSDictionary *attributes = (__bridge NSDictionary *)CTRunGetAttributes((__bridge CTRunRef)glyphRun);
+            BOOL strikeOut = [[attributes objectForKey:kTWTRStrikeOutAttributeName] boolValue];
+            NSInteger superscriptStyle = [[attributes objectForKey:(id)kCTSuperscriptAttributeName] integerValue];
+
+            if (strikeOut) {
+                CGRect runBounds = CGRectZero;
+                CGFloat runAscent = 0.0f;
+                CGFloat runDescent = 0.0f;
+
+                runBounds.size.width = (CGFloat)CTRunGetTypographicBounds((__bridge CTRunRef)glyphRun, CFRangeMake(0, 0), &runAscent, &runDescent, NULL);
+                runBounds.size.height = runAscent + runDescent;
+
+                CGFloat xOffset = 0.0f;
+                CFRange glyphRange = CTRunGetStringRange((__bridge CTRunRef)glyphRun);
+                switch (CTRunGetStatus((__bridge CTRunRef)glyphRun)) {
+                    case kCTRunStatusRightToLeft:
+                        xOffset = CTLineGetOffsetForStringIndex((__bridge CTLineRef)line, glyphRange.location + glyphRange.length, NULL);
+                        break;
+                    default:
+                        xOffset = CTLineGetOffsetForStringIndex((__bridge CTLineRef)line, glyphRange.location, NULL);
+                        break;
+                }
+                runBounds.origin.x = penOffset + xOffset;
+                runBounds.origin.y = origins[lineIndex].y;
+                runBounds.origin.y -= runDescent;
+
+                // Don't draw strikeout too far to the right
+                if (CGRectGetWidth(runBounds) > CGRectGetWidth(lineBounds)) {
+                    runBounds.size.width = CGRectGetWidth(lineBounds);
+                }
+
+                switch (superscriptStyle) {
+                    case 1:
+                        runBounds.origin.y -= runAscent * 0.47f;
+                        break;
+                    case -1:
+                        runBounds.origin.y += runAscent * 0.25f;
+                        break;
+                    default:
+                        break;
+                }
+
+                // Use text color, or default to black
+                id color = [attributes objectForKey:(id)kCTForegroundColorAttributeName];
+                if (color) {
+                    if ([color isKindOfClass:[UIColor class]]) {
+                        CGContextSetStrokeColorWithColor(c, [color CGColor]);
+                    } else {
+                        CGContextSetStrokeColorWithColor(c, (__bridge CGColorRef)color);
+                    }
+                } else {
+                    CGContextSetGrayStrokeColor(c, 0.0f, 1.0);
+                }
+
+                CTFontRef font = CTFontCreateWithName((__bridge CFStringRef)self.font.fontName, self.font.pointSize, NULL);
+                CGContextSetLineWidth(c, CTFontGetUnderlineThickness(font));
+                CFRelease(font);
+
+                CGFloat y = CGFloat_round(runBounds.origin.y + runBounds.size.height / 2.0f);
+                CGContextMoveToPoint(c, runBounds.origin.x, y);
+                CGContextAddLineToPoint(c, runBounds.origin.x + runBounds.size.width, y);
+
+                CGContextStrokePath(c);
+            }
+        }
+
+        lineIndex++;
+    }
+}
+
+@end
@@ -37,6 +37,27 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (void)layoutViews:(NSArray<UIView *> *)views;
 
+/**
+ *  Frames of each cell of the grid used by `layoutViews:` for a given
+ *  number of views, computed directly rather than through Auto Layout.
+ *
+ *  @param count  Number of views, 1-4.
+ *  @param bounds Bounds of the parent view.
+ *
+ *  @return NSArray of `count` CGRect values, or an empty array if `count` is out of range.
+ */
++ (NSArray<NSValue *> *)framesForViewCount:(NSUInteger)count inBounds:(CGRect)bounds;
+
+/**
+ *  Assign frames to a set of views so they lay out in the same grid as
+ *  `layoutViews:` without adding any constraints. Suited to views that
+ *  are reused and laid out repeatedly.
+ *
+ *  @param views  NSArray of 1-4 views using autoresizing masks.
+ *  @param bounds Bounds of the parent view.
+ */
++ (void)setFramesForViews:(NSArray<UIView *> *)views inBounds:(CGRect)bounds;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -46,6 +46,8 @@
 
 @end
 
+static const CGFloat TWTRMultiPhotoLayoutSpacing = 0.5;
+
 @implementation TWTRMultiPhotoLayout
 
 + (void)layoutViews:(NSArray<UIView *> *)views
@@ -126,4 +128,42 @@
     [TWTRViewUtil addVisualConstraints:@"V:|[view2(==view4)]-0.5-[view4]-0@900-|" views:views];
 }
 
+#pragma mark - Frame Layout
+
++ (NSArray<NSValue *> *)framesForViewCount:(NSUInteger)count inBounds:(CGRect)bounds
+{
+    const CGFloat width = CGRectGetWidth(bounds);
+    const CGFloat height = CGRectGetHeight(bounds);
+    const CGFloat halfWidth = MAX(0, (width - TWTRMultiPhotoLayoutSpacing) / 2.0);
+    const CGFloat halfHeight = MAX(0, (height - TWTRMultiPhotoLayoutSpacing) / 2.0);
+    const CGFloat rightX = CGRectGetMinX(bounds) + halfWidth + TWTRMultiPhotoLayoutSpacing;
+    const CGFloat bottomY = CGRectGetMinY(bounds) + halfHeight + TWTRMultiPhotoLayoutSpacing;
+    const CGFloat leftX = CGRectGetMinX(bounds);
+    const CGFloat topY = CGRectGetMinY(bounds);
+
+    switch (count) {
+        case 1:
+            return @[[NSValue valueWithCGRect:bounds]];
+        case 2:
+            return @[[NSValue valueWithCGRect:CGRectMake(leftX, topY, halfWidth, height)], [NSValue valueWithCGRect:CGRectMake(rightX, topY, halfWidth, height)]];
+        case 3:
+            return @[[NSValue valueWithCGRect:CGRectMake(leftX, topY, halfWidth, height)], [NSValue valueWithCGRect:CGRectMake(rightX, topY, halfWidth, halfHeight)], [NSValue valueWithCGRect:CGRectMake(rightX, bottomY, halfWidth, halfHeight)]];
+        case 4:
+            return @[[NSValue valueWithCGRect:CGRectMake(leftX, topY, halfWidth, halfHeight)], [NSValue valueWithCGRect:CGRectMake(rightX, topY, halfWidth, halfHeight)], [NSValue valueWithCGRect:CGRectMake(leftX, bottomY, halfWidth, halfHeight)], [NSValue valueWithCGRect:CGRectMake(rightX, bottomY, halfWidth, halfHeight)]];
+        default:
+            return @[];
+    }
+}
+
++ (void)setFramesForViews:(NSArray<UIView *> *)views inBounds:(CGRect)bounds
+{
+    TWTRParameterAssertOrReturn(views.count > 0);
+    TWTRParameterAssertOrReturn(views.count <= 4);
+
+    NSArray<NSValue *> *frames = [self framesForViewCount:views.count inBounds:bounds];
+    [views enumerateObjectsUsingBlock:^(UIView *view, NSUInteger idx, BOOL *stop) {
+        view.frame = [frames[idx] CGRectValue];
+    }];
+}
+
 @end
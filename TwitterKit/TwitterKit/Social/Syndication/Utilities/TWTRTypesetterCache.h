@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ This header is private to the Twitter Kit SDK and not exposed for public SDK consumption
+ */
+
+#import <CoreText/CoreText.h>
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * The result of typesetting an attributed string at a given width and line limit.
+ */
+@interface TWTRTypesetterLayout : NSObject
+
+/**
+ * The width the string was laid out at. Single line layouts are laid out at an unconstrained width.
+ */
+@property (nonatomic, readonly) CGFloat width;
+
+/**
+ * The maximum number of lines of the layout, 0 meaning no limit.
+ */
+@property (nonatomic, readonly) NSUInteger numberOfLines;
+
+/**
+ * The size that fits the visible lines, rounded up to whole points.
+ */
+@property (nonatomic, readonly) CGSize suggestedSize;
+
+/**
+ * The range of the string in each visible line, as `NSRange` values.
+ */
+@property (nonatomic, copy, readonly) NSArray<NSValue *> *lineRanges;
+
+@end
+
+/**
+ * A bounded, least recently used cache of typesetting results shared by every label in the
+ * process. Attributed strings with equal contents share one framesetter, so measuring a string
+ * and later drawing it reuse the same typesetting pass.
+ *
+ * This class is thread-safe. Framesetters are not, so work on a shared framesetter should go
+ * through the cache, which serializes it per string.
+ */
+@interface TWTRTypesetterCache : NSObject
+
+/**
+ * The maximum number of attributed strings kept in the cache.
+ */
+@property (nonatomic, readonly) NSUInteger countLimit;
+
+/**
+ * The number of attributed strings currently in the cache.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ * The cache shared by all labels.
+ */
++ (instancetype)sharedCache;
+
+- (instancetype)initWithCountLimit:(NSUInteger)countLimit NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Returns a framesetter for the attributed string, creating one if none is cached. The caller
+ * owns the returned reference and must release it.
+ */
+- (nullable CTFramesetterRef)copyFramesetterForAttributedString:(NSAttributedString *)attributedString CF_RETURNS_RETAINED;
+
+/**
+ * Returns the layout of the attributed string constrained to the given width and number of lines.
+ *
+ * @param attributedString The string to lay out.
+ * @param width The maximum width of the layout. Ignored when `numberOfLines` is 1.
+ * @param numberOfLines The maximum number of lines, 0 meaning no limit.
+ */
+- (TWTRTypesetterLayout *)layoutForAttributedString:(NSAttributedString *)attributedString width:(CGFloat)width numberOfLines:(NSUInteger)numberOfLines;
+
+/**
+ * Returns the size that fits the attributed string within the given constraints.
+ */
+- (CGSize)suggestFrameSizeForAttributedString:(NSAttributedString *)attributedString constraints:(CGSize)constraints;
+
+/**
+ * Lays out the whole attributed string in the given path. The caller owns the returned frame
+ * and may use it on any thread.
+ */
+- (nullable CTFrameRef)copyFrameForAttributedString:(NSAttributedString *)attributedString path:(CGPathRef)path CF_RETURNS_RETAINED;
+
+/**
+ * The approximate number of bytes held by the cached framesetters and layouts.
+ */
+- (NSUInteger)memoryCost;
+
+/**
+ * Evicts the least recently used strings until the cache holds no more than `memoryCost` bytes.
+ */
+- (void)trimToMemoryCost:(NSUInteger)memoryCost;
+
+/**
+ * Empties the cache.
+ */
+- (void)removeAllObjects;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRTypesetterCache.h"
+#import <TwitterCore/TWTRAssertionMacros.h>
+#import <TwitterCore/TWTRMemoryPressureCoordinator.h>
+
+static NSUInteger const TWTRTypesetterCacheDefaultCountLimit = 100;
+
+/**
+ * Layouts kept per string. A string is rarely laid out at more than a couple of widths, e.g. the
+ * portrait and landscape width of a timeline.
+ */
+static NSUInteger const TWTRTypesetterCacheMaxLayoutsPerString = 4;
+
+static CGFloat const TWTRTypesetterCacheMaxDimension = 100000;
+
+/**
+ * Rough footprint of a framesetter: a fixed overhead plus its glyph runs, which grow with the
+ * length of the string.
+ */
+static NSUInteger const TWTRTypesetterCacheEstimatedEntryCost = 2048;
+static NSUInteger const TWTRTypesetterCacheEstimatedCostPerCharacter = 64;
+
+@interface TWTRTypesetterLayout ()
+
+- (instancetype)initWithWidth:(CGFloat)width numberOfLines:(NSUInteger)numberOfLines suggestedSize:(CGSize)suggestedSize lineRanges:(NSArray<NSValue *> *)lineRanges;
+
+@end
+
+@implementation TWTRTypesetterLayout
+
+- (instancetype)initWithWidth:(CGFloat)width numberOfLines:(NSUInteger)numberOfLines suggestedSize:(CGSize)suggestedSize lineRanges:(NSArray<NSValue *> *)lineRanges
+{
+    self = [super init];
+    if (self) {
+        _width = width;
+        _numberOfLines = numberOfLines;
+        _suggestedSize = suggestedSize;
+        _lineRanges = [lineRanges copy];
+    }
+    return self;
+}
+
+@end
+
+/**
+ * The framesetter of a cached string along with the layouts computed from it, most recent last.
+ */
+@interface TWTRTypesetterCacheEntry : NSObject
+
+@property (nonatomic, readonly) CTFramesetterRef framesetter;
+@property (nonatomic, readonly) NSUInteger length;
+@property (nonatomic, readonly) NSMutableArray<TWTRTypesetterLayout *> *layouts;
+
+- (instancetype)initWithAttributedString:(NSAttributedString *)attributedString;
+- (TWTRTypesetterLayout *)layoutWithWidth:(CGFloat)width numberOfLines:(NSUInteger)numberOfLines;
+- (NSUInteger)memoryCost;
+
+@end
+
+@implementation TWTRTypesetterCacheEntry
+
+- (instancetype)initWithAttributedString:(NSAttributedString *)attributedString
+{
+    self = [super init];
+    if (self) {
+        _framesetter = CTFramesetterCreateWithAttributedString((__bridge CFAttributedStringRef)attributedString);
+        _length = [attributedString length];
+        _layouts = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_framesetter) {
+        CFRelease(_framesetter);
+    }
+}
+
+- (NSUInteger)memoryCost
+{
+    return TWTRTypesetterCacheEstimatedEntryCost + self.length * TWTRTypesetterCacheEstimatedCostPerCharacter;
+}
+
+- (TWTRTypesetterLayout *)layoutWithWidth:(CGFloat)width numberOfLines:(NSUInteger)numberOfLines
+{
+    for (TWTRTypesetterLayout *layout in self.layouts) {
+        if (layout.width == width && layout.numberOfLines == numberOfLines) {
+            return layout;
+        }
+    }
+
+    TWTRTypesetterLayout *layout = [self newLayoutWithWidth:width numberOfLines:numberOfLines];
+
+    if ([self.layouts count] >= TWTRTypesetterCacheMaxLayoutsPerString) {
+        [self.layouts removeObjectAtIndex:0];
+    }
+    [self.layouts addObject:layout];
+
+    return layout;
+}
+
+- (TWTRTypesetterLayout *)newLayoutWithWidth:(CGFloat)width numberOfLines:(NSUInteger)numberOfLines
+{
+    NSMutableArray<NSValue *> *lineRanges = [NSMutableArray array];
+    CFRange rangeToSize = CFRangeMake(0, (CFIndex)self.length);
+    CGSize constraints = CGSizeMake(width, TWTRTypesetterCacheMaxDimension);
+
+    if (self.framesetter) {
+        CGMutablePathRef path = CGPathCreateMutable();
+        CGPathAddRect(path, NULL, CGRectMake(0.0f, 0.0f, constraints.width, TWTRTypesetterCacheMaxDimension));
+        CTFrameRef frame = CTFramesetterCreateFrame(self.framesetter, CFRangeMake(0, 0), path, NULL);
+        CFRelease(path);
+
+        if (frame) {
+            CFArrayRef lines = CTFrameGetLines(frame);
+            CFIndex lineCount = CFArrayGetCount(lines);
+            CFIndex visibleLineCount = numberOfLines > 0 ? MIN((CFIndex)numberOfLines, lineCount) : lineCount;
+
+            for (CFIndex lineIndex = 0; lineIndex < visibleLineCount; lineIndex++) {
+                CFRange lineRange = CTLineGetStringRange(CFArrayGetValueAtIndex(lines, lineIndex));
+                [lineRanges addObject:[NSValue valueWithRange:NSMakeRange((NSUInteger)lineRange.location, (NSUInteger)lineRange.length)]];
+            }
+
+            // If the line count is limited to more than 1, limit the range to size to the lines that are visible
+            if (numberOfLines > 1 && visibleLineCount > 0) {
+                rangeToSize = CFRangeMake(0, (CFIndex)NSMaxRange([[lineRanges lastObject] rangeValue]));
+            }
+
+            CFRelease(frame);
+        }
+    }
+
+    CGSize suggestedSize = CGSizeZero;
+    if (self.framesetter) {
+        suggestedSize = CTFramesetterSuggestFrameSizeWithConstraints(self.framesetter, rangeToSize, NULL, constraints, NULL);
+    }
+    suggestedSize = CGSizeMake(ceil(suggestedSize.width), ceil(suggestedSize.height));
+
+    return [[TWTRTypesetterLayout alloc] initWithWidth:width numberOfLines:numberOfLines suggestedSize:suggestedSize lineRanges:lineRanges];
+}
+
+@end
+
+@interface TWTRTypesetterCache ()
+
+@property (nonatomic, readonly) NSMutableDictionary<NSAttributedString *, TWTRTypesetterCacheEntry *> *entries;
+
+/**
+ * Cached strings ordered from least to most recently used.
+ */
+@property (nonatomic, readonly) NSMutableOrderedSet<NSAttributedString *> *usageOrder;
+
+@end
+
+@implementation TWTRTypesetterCache
+
++ (instancetype)sharedCache
+{
+    static TWTRTypesetterCache *sharedCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [[TWTRTypesetterCache alloc] initWithCountLimit:TWTRTypesetterCacheDefaultCountLimit];
+
+        TWTRMemoryCostBlock cost = ^NSUInteger {
+            return [sharedCache memoryCost];
+        };
+        TWTRMemoryTrimBlock trim = ^(NSUInteger targetCost) {
+            [sharedCache trimToMemoryCost:targetCost];
+        };
+        [[TWTRMemoryPressureCoordinator sharedCoordinator] registerCacheNamed:@"TWTRTypesetterCache" priority:TWTRMemoryPurgePriorityDefault cost:cost trim:trim];
+    });
+
+    return sharedCache;
+}
+
+- (instancetype)initWithCountLimit:(NSUInteger)countLimit
+{
+    TWTRParameterAssertOrReturnValue(countLimit > 0, nil);
+
+    self = [super init];
+    if (self) {
+        _countLimit = countLimit;
+        _entries = [NSMutableDictionary dictionary];
+        _usageOrder = [NSMutableOrderedSet orderedSet];
+    }
+    return self;
+}
+
+- (NSUInteger)count
+{
+    @synchronized(self)
+    {
+        return [self.entries count];
+    }
+}
+
+- (CTFramesetterRef)copyFramesetterForAttributedString:(NSAttributedString *)attributedString
+{
+    TWTRParameterAssertOrReturnValue(attributedString, NULL);
+
+    @synchronized(self)
+    {
+        CTFramesetterRef framesetter = [self entryForAttributedString:attributedString].framesetter;
+        if (framesetter) {
+            CFRetain(framesetter);
+        }
+        return framesetter;
+    }
+}
+
+- (TWTRTypesetterLayout *)layoutForAttributedString:(NSAttributedString *)attributedString width:(CGFloat)width numberOfLines:(NSUInteger)numberOfLines
+{
+    // If there is one line, the size that fits is the full width of the line
+    if (numberOfLines == 1) {
+        width = TWTRTypesetterCacheMaxDimension;
+    }
+
+    if (!attributedString) {
+        return [[TWTRTypesetterLayout alloc] initWithWidth:width numberOfLines:numberOfLines suggestedSize:CGSizeZero lineRanges:@[]];
+    }
+
+    // Typesetting locks the entry rather than the cache so that different strings can be laid out concurrently
+    TWTRTypesetterCacheEntry *entry = [self lockedEntryForAttributedString:attributedString];
+    @synchronized(entry)
+    {
+        return [entry layoutWithWidth:width numberOfLines:numberOfLines];
+    }
+}
+
+- (CGSize)suggestFrameSizeForAttributedString:(NSAttributedString *)attributedString constraints:(CGSize)constraints
+{
+    TWTRParameterAssertOrReturnValue(attributedString, CGSizeZero);
+
+    TWTRTypesetterCacheEntry *entry = [self lockedEntryForAttributedString:attributedString];
+    @synchronized(entry)
+    {
+        if (!entry.framesetter) {
+            return CGSizeZero;
+        }
+        return CTFramesetterSuggestFrameSizeWithConstraints(entry.framesetter, CFRangeMake(0, (CFIndex)entry.length), NULL, constraints, NULL);
+    }
+}
+
+- (CTFrameRef)copyFrameForAttributedString:(NSAttributedString *)attributedString path:(CGPathRef)path
+{
+    TWTRParameterAssertOrReturnValue(attributedString, NULL);
+    TWTRParameterAssertOrReturnValue(path, NULL);
+
+    TWTRTypesetterCacheEntry *entry = [self lockedEntryForAttributedString:attributedString];
+    @synchronized(entry)
+    {
+        if (!entry.framesetter) {
+            return NULL;
+        }
+        return CTFramesetterCreateFrame(entry.framesetter, CFRangeMake(0, (CFIndex)entry.length), path, NULL);
+    }
+}
+
+- (NSUInteger)memoryCost
+{
+    @synchronized(self)
+    {
+        NSUInteger cost = 0;
+        for (TWTRTypesetterCacheEntry *entry in self.entries.allValues) {
+            cost += [entry memoryCost];
+        }
+        return cost;
+    }
+}
+
+- (void)trimToMemoryCost:(NSUInteger)memoryCost
+{
+    @synchronized(self)
+    {
+        NSUInteger cost = [self memoryCost];
+        while (cost > memoryCost && [self.usageOrder count] > 0) {
+            NSAttributedString *leastRecentlyUsed = self.usageOrder.firstObject;
+            cost -= [self.entries[leastRecentlyUsed] memoryCost];
+            [self.entries removeObjectForKey:leastRecentlyUsed];
+            [self.usageOrder removeObjectAtIndex:0];
+        }
+    }
+}
+
+- (void)removeAllObjects
+{
+    @synchronized(self)
+    {
+        [self.entries removeAllObjects];
+        [self.usageOrder removeAllObjects];
+    }
+}
+
+- (TWTRTypesetterCacheEntry *)lockedEntryForAttributedString:(NSAttributedString *)attributedString
+{
+    @synchronized(self)
+    {
+        return [self entryForAttributedString:attributedString];
+    }
+}
+
+/**
+ * Must be called while synchronized on self.
+ */
+- (TWTRTypesetterCacheEntry *)entryForAttributedString:(NSAttributedString *)attributedString
+{
+    TWTRTypesetterCacheEntry *entry = self.entries[attributedString];
+
+    if (entry) {
+        [self.usageOrder removeObject:attributedString];
+        [self.usageOrder addObject:attributedString];
+        return entry;
+    }
+
+    NSAttributedString *key = [attributedString copy];
+    entry = [[TWTRTypesetterCacheEntry alloc] initWithAttributedString:key];
+    self.entries[key] = entry;
+    [self.usageOrder addObject:key];
+
+    while ([self.usageOrder count] > self.countLimit) {
+        NSAttributedString *leastRecentlyUsed = self.usageOrder.firstObject;
+        [self.entries removeObjectForKey:leastRecentlyUsed];
+        [self.usageOrder removeObjectAtIndex:0];
+    }
+
+    return entry;
+}
+
+@end
@@ -22,6 +22,7 @@
 #import <UIKit/UIKit.h>
 
 @class TWTRMediaEntitySize;
+@class TWTRMediaEntitySizeTable;
 @class TWTRTweetMediaEntity;
 
 NS_ASSUME_NONNULL_BEGIN
@@ -47,6 +48,19 @@ CGFloat TWTRRoundHalfInteger(CGFloat);
  */
 + (TWTRMediaEntitySize *)bestMatchSizeFromMediaEntity:(TWTRTweetMediaEntity *)mediaEntity fittingWidth:(CGFloat)fittingWidth;
 
+/*
+ * Returns the sizes of the media entity that `bestMatchSizeFromMediaEntity:fittingWidth:` chooses
+ * between. Built on first use and kept for the lifetime of the entity.
+ *
+ * @param mediaEntity (required) the media entity object.
+ */
++ (TWTRMediaEntitySizeTable *)sizeTableForMediaEntity:(TWTRTweetMediaEntity *)mediaEntity;
+
+/*
+ * Returns the target width clamped to the narrowest width media is laid out for.
+ */
++ (CGFloat)mediaFittingWidthForTargetWidth:(CGFloat)targetWidth;
+
 /**
  * Returns an average of the aspect ratios in the given media
  * entity size dictionary.
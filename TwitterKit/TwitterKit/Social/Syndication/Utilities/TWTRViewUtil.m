@@ -20,7 +20,9 @@
 #import <TwitterCore/TWTRDictUtil.h>
 #import "TWTRAPIConstantsStatus.h"
 #import "TWTRMediaEntitySize.h"
+#import "TWTRMediaEntitySizeTable.h"
 #import "TWTRTweetMediaEntity.h"
+#import <objc/runtime.h>
 
 static CGFloat const TWTRTweetMediaViewDefaultWidthHint = 300.0;
 
@@ -50,41 +52,36 @@ CGRect TWTRRectPixelIntegral(CGRect rect)
 + (TWTRMediaEntitySize *)bestMatchSizeFromMediaEntity:(TWTRTweetMediaEntity *)mediaEntity fittingWidth:(CGFloat)fittingWidth
 {
     NSParameterAssert(mediaEntity);
-    fittingWidth = MAX(fittingWidth, TWTRTweetMediaViewDefaultWidthHint);
-    if (mediaEntity.sizes.count == 0) {
+    TWTRMediaEntitySizeTable *sizeTable = [self sizeTableForMediaEntity:mediaEntity];
+
+    // Choose the size that fills the most pixels (scales least) while minimizing bandwidth
+    NSUInteger index = [sizeTable indexOfSizeFittingWidth:[self mediaFittingWidthForTargetWidth:fittingWidth]];
+    if (index == NSNotFound) {
         return nil;
     }
 
-    // Strip out sizes that are too small
-    NSMutableDictionary<NSString *, TWTRMediaEntitySize *> *validSizes = [NSMutableDictionary dictionary];
-    [mediaEntity.sizes enumerateKeysAndObjectsUsingBlock:^(NSString *sizeName, TWTRMediaEntitySize *sizeDetails, BOOL *stop) {
-        BOOL validSize = sizeDetails.size.width >= TWTRTweetMediaViewDefaultWidthHint;
-        BOOL validResizeMode = sizeDetails.resizingMode == TWTRMediaEntitySizeResizingModeFit;
-
-        if (validSize && validResizeMode) {
-            validSizes[sizeName] = sizeDetails;
-        }
-    }];
-
-    // If we just stripped out *all* images as invalid, use the original dict
-    NSDictionary<NSString *, TWTRMediaEntitySize *> *sizesToCompare = (validSizes.count > 0) ? validSizes : mediaEntity.sizes;
+    return [sizeTable sizeAtIndex:index];
+}
 
-    // Sort sizes by the difference in width to determine the size that
-    // fills the most pixels (scales least) while minimizing bandwidth
-    NSArray *sortedSizes = [sizesToCompare keysSortedByValueUsingComparator:^NSComparisonResult(TWTRMediaEntitySize *size1, TWTRMediaEntitySize *size2) {
-        CGFloat width1 = size1.size.width;
-        CGFloat width2 = size2.size.width;
++ (TWTRMediaEntitySizeTable *)sizeTableForMediaEntity:(TWTRTweetMediaEntity *)mediaEntity
+{
+    NSParameterAssert(mediaEntity);
 
-        if (fabs(width1 - fittingWidth) < fabs(width2 - fittingWidth)) {
-            return (NSComparisonResult)NSOrderedAscending;
-        } else {
-            return (NSComparisonResult)NSOrderedDescending;
+    // Media entities are immutable, so the table is built once and rides along with the entity
+    @synchronized(mediaEntity)
+    {
+        TWTRMediaEntitySizeTable *sizeTable = objc_getAssociatedObject(mediaEntity, @selector(sizeTableForMediaEntity:));
+        if (!sizeTable) {
+            sizeTable = [[TWTRMediaEntitySizeTable alloc] initWithSizes:mediaEntity.sizes ?: @{} minimumWidth:TWTRTweetMediaViewDefaultWidthHint];
+            objc_setAssociatedObject(mediaEntity, @selector(sizeTableForMediaEntity:), sizeTable, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
         }
-    }];
-    NSString *chosenKey = [sortedSizes firstObject];
-    TWTRMediaEntitySize *entitySize = sizesToCompare[chosenKey];
+        return sizeTable;
+    }
+}
 
-    return entitySize;
++ (CGFloat)mediaFittingWidthForTargetWidth:(CGFloat)targetWidth
+{
+    return MAX(targetWidth, TWTRTweetMediaViewDefaultWidthHint);
 }
 
 + (CGFloat)averageAspectRatioForMediaEntity:(TWTRTweetMediaEntity *)mediaEntity
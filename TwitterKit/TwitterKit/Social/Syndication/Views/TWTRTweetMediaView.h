@@ -105,6 +105,11 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (CGSize)sizeThatFits:(CGSize)size;
 
+/**
+ * The size media shown at `aspectRatio` takes up in a media view `width` points wide.
+ */
++ (CGSize)sizeForWidth:(CGFloat)width aspectRatio:(CGFloat)aspectRatio;
+
 - (void)playVideo;
 - (void)pauseVideo;
 
@@ -45,6 +45,14 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, readonly, nullable) TWTRTweet *tweet;
 @property (nonatomic) NSMutableArray<TWTRTweetImageView *> *imageViews;
+
+/**
+ *  Every image view created so far, indexed by the media slot they fill. These
+ *  are reconfigured in place when the view is reused; slots not needed by the
+ *  current Tweet are hidden.
+ */
+@property (nonatomic, readonly) NSMutableArray<TWTRTweetImageView *> *reusableImageViews;
+@property (nonatomic, readonly) TWTRPlayIcon *playIcon;
 @property (nonatomic, nullable) TWTRVideoPlayerView *inlinePlayerView;
 @property (nonatomic, readonly) NSLayoutConstraint *aspectRatioConstraint;
 
@@ -67,6 +75,7 @@ static const CGFloat TWTRImageCornerRadius = 4.0;
         self.clipsToBounds = YES;
         self.presenterViewController = [TWTRUtils topViewController];
         self.imageViews = [NSMutableArray array];
+        _reusableImageViews = [NSMutableArray array];
 
         _tapGestureRecognizer = [[UITapGestureRecognizer alloc] initWithTarget:self action:@selector(presentDetailedMediaForGesture:)];
         [self addGestureRecognizer:_tapGestureRecognizer];
@@ -76,25 +85,46 @@ static const CGFloat TWTRImageCornerRadius = 4.0;
 
 - (void)prepareImageViewsForTweet:(TWTRTweet *)tweet
 {
-    // Inefficiently remove image views
-    for (UIImageView *imageView in self.imageViews) {
-        [imageView removeFromSuperview];
-    }
-
-    NSMutableArray *imageViews = [NSMutableArray array];
+    NSArray<TWTRMediaEntityDisplayConfiguration *> *configurations = [self mediaDisplayConfigurations];
+    NSMutableArray<TWTRTweetImageView *> *imageViews = [NSMutableArray arrayWithCapacity:configurations.count];
 
-    for (TWTRMediaEntityDisplayConfiguration *config in [self mediaDisplayConfigurations]) {
-        TWTRTweetImageView *imageView = [[TWTRTweetImageView alloc] init];
+    [configurations enumerateObjectsUsingBlock:^(TWTRMediaEntityDisplayConfiguration *config, NSUInteger idx, BOOL *stop) {
+        TWTRTweetImageView *imageView = [self reusableImageViewAtIndex:idx];
         [imageView configureWithMediaEntityConfiguration:config style:self.style];
-        [self addSubview:imageView];
         [imageViews addObject:imageView];
-    }
+    }];
 
-    if (imageViews.count > 0) {
-        [TWTRMultiPhotoLayout layoutViews:imageViews];
+    // Clearing the configuration hides the view and drops any in-flight image load
+    for (NSUInteger idx = configurations.count; idx < self.reusableImageViews.count; idx++) {
+        [self.reusableImageViews[idx] configureWithMediaEntityConfiguration:nil style:self.style];
     }
 
     self.imageViews = imageViews;
+    [self setNeedsLayout];
+}
+
+- (TWTRTweetImageView *)reusableImageViewAtIndex:(NSUInteger)idx
+{
+    if (idx < self.reusableImageViews.count) {
+        return self.reusableImageViews[idx];
+    }
+
+    // Image views are laid out with frames in -layoutSubviews rather than constraints
+    TWTRTweetImageView *imageView = [[TWTRTweetImageView alloc] init];
+    imageView.translatesAutoresizingMaskIntoConstraints = YES;
+    [self addSubview:imageView];
+    [self.reusableImageViews addObject:imageView];
+
+    return imageView;
+}
+
+- (void)layoutSubviews
+{
+    [super layoutSubviews];
+
+    if (self.imageViews.count > 0) {
+        [TWTRMultiPhotoLayout setFramesForViews:self.imageViews inBounds:self.bounds];
+    }
 }
 
 - (void)prepareInlinePlayerForTweet:(nullable TWTRTweet *)tweet
@@ -131,7 +161,7 @@ static const CGFloat TWTRImageCornerRadius = 4.0;
         [mediaConfigurations addObject:[TWTRMediaEntityDisplayConfiguration mediaEntityDisplayConfigurationWithCardEntity:self.tweet.cardEntity]];
     } else if ([self.tweet hasMedia]) {
         for (TWTRTweetMediaEntity *entity in self.tweet.media) {
-            [mediaConfigurations addObject:[[TWTRMediaEntityDisplayConfiguration alloc] initWithMediaEntity:entity targetWidth:[self desiredWidth]]];
+            [mediaConfigurations addObject:[TWTRMediaEntityDisplayConfiguration displayConfigurationWithMediaEntity:entity targetWidth:[self desiredWidth]]];
         }
     }
 
@@ -160,7 +190,12 @@ static const CGFloat TWTRImageCornerRadius = 4.0;
 
 - (CGSize)sizeThatFits:(CGSize)size
 {
-    return CGSizeMake(size.width, (self.tweet.hasMedia) ? floor(size.width / self.aspectRatio) : 0.0);
+    return (self.tweet.hasMedia) ? [[self class] sizeForWidth:size.width aspectRatio:self.aspectRatio] : CGSizeMake(size.width, 0.0);
+}
+
++ (CGSize)sizeForWidth:(CGFloat)width aspectRatio:(CGFloat)aspectRatio
+{
+    return CGSizeMake(width, (aspectRatio > 0.0) ? floor(width / aspectRatio) : 0.0);
 }
 
 #pragma mark - constraints
@@ -217,9 +252,16 @@ static const CGFloat TWTRImageCornerRadius = 4.0;
 - (void)addPlayIconIfNeeded
 {
     if ([self shouldShowPlayButtonForEmbeddableVideo] || [self isShowingVideoThumbnail]) {
-        TWTRPlayIcon *playIcon = [[TWTRPlayIcon alloc] init];
-        [self.videoThumbnail addSubview:playIcon];
-        [TWTRViewUtil centerViewInSuperview:playIcon];
+        if (self.playIcon == nil) {
+            _playIcon = [[TWTRPlayIcon alloc] init];
+        }
+
+        if (self.playIcon.superview != self.videoThumbnail) {
+            [self.videoThumbnail addSubview:self.playIcon];
+            [TWTRViewUtil centerViewInSuperview:self.playIcon];
+        }
+    } else {
+        [self.playIcon removeFromSuperview];
     }
 }
 
@@ -432,12 +474,7 @@ static const CGFloat TWTRImageCornerRadius = 4.0;
 
 - (TWTRVideoPlaybackConfiguration *)videoPlaybackConfiguration
 {
-    TWTRTweetMediaEntity *mediaEntity = self.firstMediaEntity;
-    if (mediaEntity) {
-        return [TWTRVideoPlaybackConfiguration playbackConfigurationForTweetMediaEntity:mediaEntity];
-    } else {
-        return [TWTRVideoPlaybackConfiguration playbackConfigurationForCardEntity:self.tweet.cardEntity URLEntities:self.tweet.urls];
-    }
+    return [TWTRVideoPlaybackConfiguration playbackConfigurationForTweet:self.tweet];
 }
 
 - (void)updateBackgroundWithComputedColor:(UIColor *)backgroundColor
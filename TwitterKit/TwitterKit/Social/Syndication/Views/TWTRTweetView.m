@@ -66,6 +66,13 @@
 @property (nonatomic, readonly) NSLayoutConstraint *attachmentTopMarginConstraint;
 @property (nonatomic, readonly) NSLayoutConstraint *attachmentBottomMarginConstraint;
 
+/**
+ * Quote Tweet content view kept around between configurations so that it, its
+ * constraints and its tap gesture are only built once per Tweet view.
+ */
+@property (nonatomic, nullable) TWTRTweetContentView *reusableQuoteContentView;
+@property (nonatomic, copy, nullable) NSArray<NSLayoutConstraint *> *reusableQuoteContentViewEdgeConstraints;
+
 /**
  * Represents an area at the bottom of the view which can hold an action bar.
  */
@@ -449,23 +456,10 @@ static TWTRTweetViewTheme const TWTRTweetViewDefaultTheme = TWTRTweetViewThemeLi
 
 - (void)updateAttachmentViewWithTweet:(TWTRTweet *)tweet
 {
-    for (UIView *subview in self.attachmentContainer.subviews) {
-        [subview removeFromSuperview];
-    }
-
     // Currently only show a quote tweet as an attachment
     // If content view already has media, does not show a quote tweet attachment
     if (tweet.isQuoteTweet && !tweet.hasMedia) {
-        id<TWTRTweetContentViewLayout> layout = [TWTRTweetContentViewLayoutFactory quoteTweetViewLayoutWithMetrics:self.metrics];
-        TWTRTweetContentView *contentView = [[TWTRTweetContentView alloc] initWithLayout:layout];
-        [self.attachmentContainer addSubview:contentView];
-
-        contentView.mediaViewDelegate = self;
-        contentView.tweetLabelDelegate = self;
-
-        contentView.translatesAutoresizingMaskIntoConstraints = NO;
-        [TWTRViewUtil addVisualConstraints:@"H:|[contentView]|" views:NSDictionaryOfVariableBindings(contentView)];
-        [TWTRViewUtil addVisualConstraints:@"V:|[contentView]|" views:NSDictionaryOfVariableBindings(contentView)];
+        TWTRTweetContentView *contentView = [self dequeueQuoteContentView];
 
         contentView.primaryTextColor = self.primaryTextColor;
         [self updateComputedColorsForContentView:contentView];
@@ -479,19 +473,52 @@ static TWTRTweetViewTheme const TWTRTweetViewDefaultTheme = TWTRTweetViewThemeLi
         self.attachmentTopMarginConstraint.constant = self.metrics.marginTop;
         self.attachmentBottomMarginConstraint.constant = self.metrics.marginBottom;
 
-        // Add a tap gesture
-        UITapGestureRecognizer *tapGesture = [[UITapGestureRecognizer alloc] initWithTarget:self action:@selector(quoteTweetTapped)];
-        tapGesture.delegate = self;
-        [contentView addGestureRecognizer:tapGesture];
-
         self.attachmentContentView = contentView;
     } else {
+        [self.attachmentContentView removeFromSuperview];
         self.attachmentContentView = nil;
         self.attachmentTopMarginConstraint.constant = 0;
         self.attachmentBottomMarginConstraint.constant = 0;
     }
 }
 
+/**
+ * Returns the quote Tweet content view installed in the attachment container,
+ * creating it the first time a quote Tweet is shown.
+ */
+- (TWTRTweetContentView *)dequeueQuoteContentView
+{
+    TWTRTweetContentView *contentView = self.reusableQuoteContentView;
+
+    if (contentView == nil) {
+        id<TWTRTweetContentViewLayout> layout = [TWTRTweetContentViewLayoutFactory quoteTweetViewLayoutWithMetrics:self.metrics];
+        contentView = [[TWTRTweetContentView alloc] initWithLayout:layout];
+        contentView.mediaViewDelegate = self;
+        contentView.tweetLabelDelegate = self;
+        contentView.translatesAutoresizingMaskIntoConstraints = NO;
+
+        // Add a tap gesture
+        UITapGestureRecognizer *tapGesture = [[UITapGestureRecognizer alloc] initWithTarget:self action:@selector(quoteTweetTapped)];
+        tapGesture.delegate = self;
+        [contentView addGestureRecognizer:tapGesture];
+
+        NSDictionary *views = NSDictionaryOfVariableBindings(contentView);
+        NSArray<NSLayoutConstraint *> *horizontalConstraints = [TWTRViewUtil constraintsWithFormat:@"H:|[contentView]|" metrics:@{} views:views];
+        NSArray<NSLayoutConstraint *> *verticalConstraints = [TWTRViewUtil constraintsWithFormat:@"V:|[contentView]|" metrics:@{} views:views];
+
+        self.reusableQuoteContentView = contentView;
+        self.reusableQuoteContentViewEdgeConstraints = [horizontalConstraints arrayByAddingObjectsFromArray:verticalConstraints];
+    }
+
+    if (contentView.superview != self.attachmentContainer) {
+        // Removing the view from the container deactivates its edge constraints, so (re)activate them here.
+        [self.attachmentContainer addSubview:contentView];
+        [TWTRViewUtil setConstraints:self.reusableQuoteContentViewEdgeConstraints active:YES];
+    }
+
+    return contentView;
+}
+
 #pragma mark - Auto Layout
 - (void)setupConstraints
 {
@@ -566,6 +593,18 @@ static TWTRTweetViewTheme const TWTRTweetViewDefaultTheme = TWTRTweetViewThemeLi
     }
 }
 
+- (CGSize)inlineVideoPixelSizeForTweet:(TWTRTweet *)tweet
+{
+    TWTRTweetMediaView *mediaView = self.contentView.mediaView;
+    if (CGRectGetWidth(mediaView.bounds) == 0.0) {
+        [self layoutIfNeeded];
+    }
+
+    CGSize size = [TWTRTweetMediaView sizeForWidth:CGRectGetWidth(mediaView.bounds) aspectRatio:[self.tweetPresenter mediaAspectRatioForTweet:tweet]];
+    CGFloat scale = self.window.screen.scale ?: [UIScreen mainScreen].scale;
+    return CGSizeMake(size.width * scale, size.height * scale);
+}
+
 - (void)pauseVideo
 {
     if ([self.tweet isQuoteTweet] && [self.tweet.quotedTweet hasPlayableVideo]) {
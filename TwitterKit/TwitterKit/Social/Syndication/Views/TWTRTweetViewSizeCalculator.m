@@ -16,6 +16,7 @@
  */
 
 #import "TWTRTweetViewSizeCalculator.h"
+#import <TwitterCore/TWTRMemoryPressureCoordinator.h>
 #import "TWTRTweet.h"
 #import "TWTRTweetView.h"
 #import "TWTRTweetView_Private.h"
@@ -29,6 +30,9 @@
 
 static NSString *TWTRCalculatorLockSentinel = @"TWTRTweetViewSizeCalculator";
 
+// Key string, boxed height and dictionary slot per cached height.
+static NSUInteger const TWTRHeightCacheEstimatedEntryCost = 128;
+
 @implementation TWTRTweetViewSizeCalculator
 
 + (TWTRTweetView *)cachedTweetViewForStyle:(TWTRTweetViewStyle)style
@@ -73,6 +77,23 @@ static NSString *TWTRCalculatorLockSentinel = @"TWTRTweetViewSizeCalculator";
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
         heights = [NSMutableDictionary dictionary];
+
+        // Heights are cheap to recalculate compared to what the rest of the kit holds, so they go first
+        TWTRMemoryCostBlock cost = ^NSUInteger {
+            @synchronized(TWTRCalculatorLockSentinel)
+            {
+                return heights.count * TWTRHeightCacheEstimatedEntryCost;
+            }
+        };
+        TWTRMemoryTrimBlock trim = ^(NSUInteger targetCost) {
+            @synchronized(TWTRCalculatorLockSentinel)
+            {
+                if (heights.count * TWTRHeightCacheEstimatedEntryCost > targetCost) {
+                    [heights removeAllObjects];
+                }
+            }
+        };
+        [[TWTRMemoryPressureCoordinator sharedCoordinator] registerCacheNamed:@"TWTRTweetViewSizeCalculator.heights" priority:TWTRMemoryPurgePriorityHigh cost:cost trim:trim];
     });
 
     return heights;
@@ -56,4 +56,11 @@
 - (void)playVideo;
 - (void)pauseVideo;
 
+/**
+ *  The size, in pixels, the inline player draws a video of `tweet` at when the receiver shows it at its
+ *  current width. The inline player measures the same media view once laid out, so a video prerolled
+ *  at this size gets the variant the player would pick.
+ */
+- (CGSize)inlineVideoPixelSizeForTweet:(TWTRTweet *)tweet;
+
 @end
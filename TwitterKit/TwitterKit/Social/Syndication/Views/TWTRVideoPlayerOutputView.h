@@ -87,6 +87,21 @@ typedef NS_ENUM(NSUInteger, TWTRVideoPlayerAspectRatio) {
  */
 @property (nonatomic, readonly) CGRect videoRect;
 
+/**
+ * Starts loading the video ahead of time into the shared player pool, so a player view created for it
+ * shortly afterwards shows its first frame sooner. Does nothing for videos the pool does not handle.
+ *
+ * `renderedPixelSize` is the size the player view is expected to have, in pixels. It picks the same
+ * variant the player view will pick, so it should be close to the final size.
+ */
++ (void)prerollVideoWithPlaybackConfiguration:(TWTRVideoPlaybackConfiguration *)configuration renderedPixelSize:(CGSize)renderedPixelSize;
+
+/**
+ * Stops a preroll started by `prerollVideoWithPlaybackConfiguration:renderedPixelSize:` for a video that is
+ * no longer about to be shown. An already prerolled player stays ready.
+ */
++ (void)cancelPrerollWithPlaybackConfiguration:(TWTRVideoPlaybackConfiguration *)configuration;
+
 /**
  * Initializes the receiver with a given video.
  *
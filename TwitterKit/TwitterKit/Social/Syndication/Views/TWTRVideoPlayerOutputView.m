@@ -19,9 +19,13 @@
 #import <AVFoundation/AVFoundation.h>
 #import <CoreMedia/CoreMedia.h>
 #import <TwitterCore/TWTRAssertionMacros.h>
+#import <TwitterCore/TWTRNetworkThroughputEstimator.h>
 #import "TWTRImages.h"
 #import "TWTRNotificationConstants.h"
+#import "TWTRVideoMetaData.h"
 #import "TWTRVideoPlaybackConfiguration.h"
+#import "TWTRVideoPlayerPool.h"
+#import "TWTRVideoResourceLoader.h"
 #import "TWTRViewUtil.h"
 
 NS_ASSUME_NONNULL_BEGIN
@@ -88,6 +92,12 @@ NSString *videoGravityForAspectRatio(TWTRVideoPlayerAspectRatio aspectRatio)
 
 @property (nonatomic, readonly) TWTRVideoPlaybackConfiguration *configuration;
 
+/**
+ * The variant being played, or nil if the configuration has no variants to choose from.
+ */
+@property (nonatomic, readonly, nullable) TWTRVideoMetaDataVariant *videoVariant;
+@property (nonatomic, readonly) NSURL *videoURL;
+
 @property (nonatomic, readonly) UIActivityIndicatorView *loadingView;
 @property (nonatomic, readonly) UIImageView *previewImageView;
 
@@ -96,6 +106,7 @@ NSString *videoGravityForAspectRatio(TWTRVideoPlayerAspectRatio aspectRatio)
 @implementation TWTRVideoPlayerOutputView {
     BOOL _didRegisterForNotifications;
     BOOL _playerHasBecomeReady;
+    BOOL _playerIsFromPool;
 }
 
 - (instancetype)initWithFrame:(CGRect)frame videoPlaybackConfiguration:(TWTRVideoPlaybackConfiguration *)configuration previewImage:(nullable UIImage *)previewImage shouldLoadVideo:(BOOL)shouldLoadVideo
@@ -125,6 +136,11 @@ NSString *videoGravityForAspectRatio(TWTRVideoPlayerAspectRatio aspectRatio)
 - (void)dealloc
 {
     [self unregisterObservers];
+
+    if (_playerIsFromPool) {
+        _playerLayerView.playerLayer.player = nil;
+        [[TWTRVideoPlayerPool sharedPool] checkInPlayer:_player forMediaID:_configuration.mediaID URL:_videoURL];
+    }
 }
 
 - (void)prepareSubviewsWithPreviewImage:(UIImage *)image
@@ -149,25 +165,63 @@ NSString *videoGravityForAspectRatio(TWTRVideoPlayerAspectRatio aspectRatio)
     [self addSubview:_playerLayerView];
 }
 
++ (BOOL)canUsePlayerPoolForConfiguration:(TWTRVideoPlaybackConfiguration *)configuration
+{
+    return configuration.videoURL != nil && configuration.mediaID.length > 0 && configuration.mediaType != TWTRMediaTypeVine;
+}
+
++ (void)prerollVideoWithPlaybackConfiguration:(TWTRVideoPlaybackConfiguration *)configuration renderedPixelSize:(CGSize)renderedPixelSize
+{
+    if ([self canUsePlayerPoolForConfiguration:configuration]) {
+        NSURL *URL = [configuration videoURLForRenderedPixelSize:renderedPixelSize];
+        [[TWTRVideoPlayerPool sharedPool] prerollPlayerForMediaID:configuration.mediaID URL:URL];
+    }
+}
+
++ (void)cancelPrerollWithPlaybackConfiguration:(TWTRVideoPlaybackConfiguration *)configuration
+{
+    if ([self canUsePlayerPoolForConfiguration:configuration]) {
+        [[TWTRVideoPlayerPool sharedPool] cancelPrerollForMediaID:configuration.mediaID];
+    }
+}
+
 - (void)configureVideoPlayer
 {
+    _videoVariant = [self.configuration videoVariantForRenderedPixelSize:[self renderedPixelSize]];
+    _videoURL = self.videoVariant.URL ?: self.configuration.videoURL;
+
+    if ([[self class] canUsePlayerPoolForConfiguration:self.configuration]) {
+        [self configureVideoPlayerFromPool];
+        return;
+    }
+
     dispatch_async(self.serialConfigurationQueue, ^{
         [self configureVideoPlayerInSerialQueue];
     });
 }
 
+- (void)configureVideoPlayerFromPool
+{
+    _player = [[TWTRVideoPlayerPool sharedPool] checkOutPlayerForMediaID:self.configuration.mediaID URL:self.videoURL];
+    _playerItem = self.player.currentItem;
+    _playerIsFromPool = YES;
+
+    self.playerLayerView.playerLayer.player = self.player;
+    [self registerObservers];
+}
+
 - (void)configureVideoPlayerInSerialQueue
 {
-    if (self.configuration.videoURL == nil) {
+    if (self.videoURL == nil) {
         NSLog(@"Attempting to play a video without a videoURL");
         return;
     }
 
     if (self.configuration.mediaType == TWTRMediaTypeVine) {
         // TODO: This is pretty slow, need to make it asynchronous.
-        _playerItem = [[self class] seamlessLoopingVinePlayerItemFromURL:self.configuration.videoURL];
+        _playerItem = [[self class] seamlessLoopingVinePlayerItemFromURL:self.videoURL];
     } else {
-        AVURLAsset *asset = [AVURLAsset URLAssetWithURL:self.configuration.videoURL options:nil];
+        AVURLAsset *asset = [[TWTRVideoResourceLoader sharedLoader] assetWithURL:self.videoURL];
         _playerItem = [AVPlayerItem playerItemWithAsset:asset];
     }
 
@@ -201,6 +255,58 @@ NSString *videoGravityForAspectRatio(TWTRVideoPlayerAspectRatio aspectRatio)
     return self.playerLayerView.playerLayer.videoRect;
 }
 
+#pragma mark - Variants
+
+- (void)layoutSubviews
+{
+    [super layoutSubviews];
+    [self upgradeVideoVariantIfNeeded];
+}
+
+/**
+ * The size the video is drawn at, in pixels. Before the receiver has been laid out
+ * this is the size of the closest ancestor that has been. Inline, the receiver fills
+ * the Tweet's media view, which timelines measure with `inlineVideoPixelSizeForTweet:`
+ * when prerolling.
+ */
+- (CGSize)renderedPixelSize
+{
+    UIView *view = self;
+    while (view && CGRectIsEmpty(view.bounds)) {
+        view = view.superview;
+    }
+
+    CGFloat scale = self.window.screen.scale ?: [UIScreen mainScreen].scale;
+    return CGSizeMake(CGRectGetWidth(view.bounds) * scale, CGRectGetHeight(view.bounds) * scale);
+}
+
+/**
+ * Switches to a higher bitrate variant when the receiver has grown, e.g. when going
+ * fullscreen. Playback carries on from the same position. The variant is never
+ * downgraded, since the higher one is already buffered.
+ */
+- (void)upgradeVideoVariantIfNeeded
+{
+    if (!_playerHasBecomeReady || !self.videoVariant) {
+        return;
+    }
+
+    TWTRVideoMetaDataVariant *variant = [self.configuration videoVariantForRenderedPixelSize:[self renderedPixelSize]];
+    if (variant.bitrate <= self.videoVariant.bitrate) {
+        return;
+    }
+
+    CMTime currentTime = self.playerItem.currentTime;
+
+    [self unregisterObservers];
+    _videoVariant = variant;
+    _videoURL = variant.URL;
+    _playerItem = [AVPlayerItem playerItemWithAsset:[[TWTRVideoResourceLoader sharedLoader] assetWithURL:variant.URL]];
+    [self.player replaceCurrentItemWithPlayerItem:self.playerItem];
+    [self.player seekToTime:currentTime];
+    [self registerObservers];
+}
+
 #pragma mark - KVO
 
 - (void)registerObservers
@@ -209,8 +315,10 @@ NSString *videoGravityForAspectRatio(TWTRVideoPlayerAspectRatio aspectRatio)
         return;
     }
 
-    [self.playerItem addObserver:self forKeyPath:@"status" options:0 context:&TWTRVideoPlayerStatusKVOContext];
+    // A pooled player may already be ready, in which case no change would ever be observed.
+    [self.playerItem addObserver:self forKeyPath:@"status" options:NSKeyValueObservingOptionInitial context:&TWTRVideoPlayerStatusKVOContext];
     [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(handlePlayerDidReachEndNotification:) name:AVPlayerItemDidPlayToEndTimeNotification object:self.playerItem];
+    [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(handleNewAccessLogEntryNotification:) name:AVPlayerItemNewAccessLogEntryNotification object:self.playerItem];
 
     _didRegisterForNotifications = YES;
 }
@@ -223,6 +331,7 @@ NSString *videoGravityForAspectRatio(TWTRVideoPlayerAspectRatio aspectRatio)
 
     [self.playerItem removeObserver:self forKeyPath:@"status" context:TWTRVideoPlayerStatusKVOContext];
     [[NSNotificationCenter defaultCenter] removeObserver:self name:AVPlayerItemDidPlayToEndTimeNotification object:self.playerItem];
+    [[NSNotificationCenter defaultCenter] removeObserver:self name:AVPlayerItemNewAccessLogEntryNotification object:self.playerItem];
 
     _didRegisterForNotifications = NO;
 }
@@ -239,6 +348,10 @@ NSString *videoGravityForAspectRatio(TWTRVideoPlayerAspectRatio aspectRatio)
 - (void)handlePlayerStatusChange:(NSDictionary *)change
 {
     [self performOnMain:^{
+        if (self.playerItem.status == AVPlayerItemStatusUnknown) {
+            return;
+        }
+
         [self.loadingView removeFromSuperview];
         if (self.player.status == AVPlayerStatusReadyToPlay) {
             [self playerDidBecomeReady];
@@ -255,6 +368,16 @@ NSString *videoGravityForAspectRatio(TWTRVideoPlayerAspectRatio aspectRatio)
     }
 }
 
+- (void)handleNewAccessLogEntryNotification:(NSNotification *)note
+{
+    AVPlayerItem *playerItem = note.object;
+    double observedBitrate = playerItem.accessLog.events.lastObject.observedBitrate;
+
+    if (observedBitrate > 0) {
+        [[TWTRNetworkThroughputEstimator sharedEstimator] recordThroughputSample:observedBitrate];
+    }
+}
+
 - (void)setPlaybackState:(TWTRVideoPlaybackState)playbackState
 {
     if (_playbackState != playbackState) {
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ This header is private to the Twitter Kit SDK and not exposed for public SDK consumption
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Creates and warms up the players kept by a `TWTRVideoPlayerPool`. The pool never looks inside a player,
+ * so its policy can be exercised with any object standing in for one.
+ */
+@protocol TWTRVideoPlayerProviding <NSObject>
+
+/**
+ * Returns a new player for the video at `URL`.
+ */
+- (id)playerWithURL:(NSURL *)URL;
+
+/**
+ * Starts loading what the player needs before it can show its first frame. `completion` must be called
+ * on the main queue, unless the preroll is cancelled first.
+ */
+- (void)prerollPlayer:(id)player completion:(void (^)(void))completion;
+
+/**
+ * Stops a preroll started with `-prerollPlayer:completion:`.
+ */
+- (void)cancelPrerollOfPlayer:(id)player;
+
+/**
+ * Called when a player goes back into the pool, to stop playback and rewind it.
+ */
+- (void)resetPlayer:(id)player;
+
+@end
+
+/**
+ * A small pool of video players keyed by media ID.
+ *
+ * A view checks a player out while it shows a video and checks it back in when it goes away. Idle players
+ * are kept, least recently used first, up to `capacity`, so a cell reused for the same video gets back a
+ * player that has already loaded it. Players for videos about to scroll on screen can be prerolled into
+ * the pool; at most `maximumConcurrentPrerolls` run at once and the most recent requests start first.
+ *
+ * Note: This class must only be used from the main thread.
+ */
+@interface TWTRVideoPlayerPool : NSObject
+
+@property (nonatomic, readonly) NSUInteger capacity;
+@property (nonatomic, readonly) NSUInteger maximumConcurrentPrerolls;
+
+/**
+ * The number of idle players in the pool.
+ */
+@property (nonatomic, readonly) NSUInteger idlePlayerCount;
+
+/**
+ * The pool shared by all video player views, backed by AVFoundation.
+ */
++ (instancetype)sharedPool;
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithPlayerProvider:(id<TWTRVideoPlayerProviding>)playerProvider capacity:(NSUInteger)capacity maximumConcurrentPrerolls:(NSUInteger)maximumConcurrentPrerolls NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Returns the idle player for `mediaID` if it plays `URL`, or a new one otherwise.
+ */
+- (id)checkOutPlayerForMediaID:(NSString *)mediaID URL:(NSURL *)URL;
+
+/**
+ * Resets `player` and keeps it for the next checkout of `mediaID`.
+ */
+- (void)checkInPlayer:(id)player forMediaID:(NSString *)mediaID URL:(NSURL *)URL;
+
+/**
+ * Adds a player for `mediaID` to the pool, if there is none, and schedules it to be prerolled.
+ */
+- (void)prerollPlayerForMediaID:(NSString *)mediaID URL:(NSURL *)URL;
+
+/**
+ * Unschedules or stops the preroll of the player for `mediaID`. The player stays in the pool.
+ */
+- (void)cancelPrerollForMediaID:(NSString *)mediaID;
+
+/**
+ * Drops every idle player, cancelling their prerolls.
+ */
+- (void)removeAllIdlePlayers;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRVideoPlayerPool.h"
+#import <TwitterCore/TWTRAssertionMacros.h>
+#import <TwitterCore/TWTRMemoryPressureCoordinator.h>
+#import "TWTRVideoPlayerProvider.h"
+
+static const NSUInteger TWTRVideoPlayerPoolDefaultCapacity = 3;
+static const NSUInteger TWTRVideoPlayerPoolDefaultMaximumConcurrentPrerolls = 2;
+
+// Decoder state and buffered media of a prerolled player.
+static const NSUInteger TWTRVideoPlayerPoolEstimatedIdlePlayerCost = 4 * 1024 * 1024;
+
+static void TWTRVideoPlayerPoolPerformSyncOnMainThread(dispatch_block_t block)
+{
+    if ([NSThread isMainThread]) {
+        block();
+    } else {
+        dispatch_sync(dispatch_get_main_queue(), block);
+    }
+}
+
+typedef NS_ENUM(NSUInteger, TWTRVideoPlayerPoolEntryState) {
+    TWTRVideoPlayerPoolEntryStateCold,
+    TWTRVideoPlayerPoolEntryStatePendingPreroll,
+    TWTRVideoPlayerPoolEntryStatePrerolling,
+    TWTRVideoPlayerPoolEntryStateWarm,
+};
+
+@interface TWTRVideoPlayerPoolEntry : NSObject
+
+@property (nonatomic, copy) NSString *mediaID;
+@property (nonatomic, copy) NSURL *URL;
+@property (nonatomic) id player;
+@property (nonatomic) TWTRVideoPlayerPoolEntryState state;
+
+@end
+
+@implementation TWTRVideoPlayerPoolEntry
+@end
+
+@interface TWTRVideoPlayerPool ()
+
+@property (nonatomic, readonly) id<TWTRVideoPlayerProviding> playerProvider;
+
+/**
+ * Idle entries by media ID, and their media IDs from least to most recently used.
+ */
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, TWTRVideoPlayerPoolEntry *> *idleEntries;
+@property (nonatomic, readonly) NSMutableArray<NSString *> *idleMediaIDs;
+
+/**
+ * Entries waiting for a preroll slot, oldest request first.
+ */
+@property (nonatomic, readonly) NSMutableArray<TWTRVideoPlayerPoolEntry *> *pendingEntries;
+@property (nonatomic) NSUInteger prerollingCount;
+
+@end
+
+@implementation TWTRVideoPlayerPool
+
++ (instancetype)sharedPool
+{
+    static TWTRVideoPlayerPool *sharedPool;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedPool = [[self alloc] initWithPlayerProvider:[[TWTRVideoPlayerProvider alloc] init] capacity:TWTRVideoPlayerPoolDefaultCapacity maximumConcurrentPrerolls:TWTRVideoPlayerPoolDefaultMaximumConcurrentPrerolls];
+
+        // Prerolled players are the most expensive to rebuild, so they are purged last. The pool lives on the main thread, so pressure signalled elsewhere hops over to it.
+        TWTRMemoryCostBlock cost = ^NSUInteger {
+            __block NSUInteger idleCost = 0;
+            TWTRVideoPlayerPoolPerformSyncOnMainThread(^{
+                idleCost = sharedPool.idlePlayerCount * TWTRVideoPlayerPoolEstimatedIdlePlayerCost;
+            });
+            return idleCost;
+        };
+        TWTRMemoryTrimBlock trim = ^(NSUInteger targetCost) {
+            TWTRVideoPlayerPoolPerformSyncOnMainThread(^{
+                if (sharedPool.idlePlayerCount * TWTRVideoPlayerPoolEstimatedIdlePlayerCost > targetCost) {
+                    [sharedPool removeAllIdlePlayers];
+                }
+            });
+        };
+        [[TWTRMemoryPressureCoordinator sharedCoordinator] registerCacheNamed:@"TWTRVideoPlayerPool.idlePlayers" priority:TWTRMemoryPurgePriorityLow cost:cost trim:trim];
+    });
+
+    return sharedPool;
+}
+
+- (instancetype)initWithPlayerProvider:(id<TWTRVideoPlayerProviding>)playerProvider capacity:(NSUInteger)capacity maximumConcurrentPrerolls:(NSUInteger)maximumConcurrentPrerolls
+{
+    TWTRParameterAssertOrReturnValue(playerProvider, nil);
+    TWTRParameterAssertOrReturnValue(capacity > 0, nil);
+
+    self = [super init];
+    if (self) {
+        _playerProvider = playerProvider;
+        _capacity = capacity;
+        _maximumConcurrentPrerolls = maximumConcurrentPrerolls;
+        _idleEntries = [NSMutableDictionary dictionary];
+        _idleMediaIDs = [NSMutableArray array];
+        _pendingEntries = [NSMutableArray array];
+    }
+
+    return self;
+}
+
+- (NSUInteger)idlePlayerCount
+{
+    return self.idleEntries.count;
+}
+
+#pragma mark - Checkout
+
+- (id)checkOutPlayerForMediaID:(NSString *)mediaID URL:(NSURL *)URL
+{
+    TWTRVideoPlayerPoolEntry *entry = self.idleEntries[mediaID];
+
+    if (entry && [entry.URL isEqual:URL]) {
+        [self removeIdleEntry:entry];
+        return entry.player;
+    } else if (entry) {
+        [self evictIdleEntry:entry];
+    }
+
+    return [self.playerProvider playerWithURL:URL];
+}
+
+- (void)checkInPlayer:(id)player forMediaID:(NSString *)mediaID URL:(NSURL *)URL
+{
+    TWTRParameterAssertOrReturn(player);
+
+    [self.playerProvider resetPlayer:player];
+
+    TWTRVideoPlayerPoolEntry *existingEntry = self.idleEntries[mediaID];
+    if (existingEntry) {
+        // Another view showing the same video already returned its player.
+        [self evictIdleEntry:existingEntry];
+    }
+
+    TWTRVideoPlayerPoolEntry *entry = [self addIdleEntryForMediaID:mediaID URL:URL player:player];
+    entry.state = TWTRVideoPlayerPoolEntryStateWarm;
+}
+
+#pragma mark - Preroll
+
+- (void)prerollPlayerForMediaID:(NSString *)mediaID URL:(NSURL *)URL
+{
+    TWTRVideoPlayerPoolEntry *entry = self.idleEntries[mediaID];
+
+    if (entry && ![entry.URL isEqual:URL]) {
+        [self evictIdleEntry:entry];
+        entry = nil;
+    }
+
+    if (entry) {
+        [self touchIdleEntry:entry];
+    } else {
+        entry = [self addIdleEntryForMediaID:mediaID URL:URL player:[self.playerProvider playerWithURL:URL]];
+    }
+
+    switch (entry.state) {
+        case TWTRVideoPlayerPoolEntryStateCold:
+            entry.state = TWTRVideoPlayerPoolEntryStatePendingPreroll;
+            [self.pendingEntries addObject:entry];
+            break;
+        case TWTRVideoPlayerPoolEntryStatePendingPreroll:
+            // Newer requests are closer to the screen, so move it to the front of the line.
+            [self.pendingEntries removeObjectIdenticalTo:entry];
+            [self.pendingEntries addObject:entry];
+            break;
+        case TWTRVideoPlayerPoolEntryStatePrerolling:
+        case TWTRVideoPlayerPoolEntryStateWarm:
+            break;
+    }
+
+    [self startPendingPrerolls];
+}
+
+- (void)cancelPrerollForMediaID:(NSString *)mediaID
+{
+    TWTRVideoPlayerPoolEntry *entry = self.idleEntries[mediaID];
+    if (entry) {
+        [self cancelPrerollOfEntry:entry];
+    }
+}
+
+- (void)startPendingPrerolls
+{
+    while (self.prerollingCount < self.maximumConcurrentPrerolls && self.pendingEntries.count > 0) {
+        TWTRVideoPlayerPoolEntry *entry = self.pendingEntries.lastObject;
+        [self.pendingEntries removeLastObject];
+
+        entry.state = TWTRVideoPlayerPoolEntryStatePrerolling;
+        self.prerollingCount++;
+
+        @weakify(self);
+        [self.playerProvider prerollPlayer:entry.player
+                                completion:^{
+                                    @strongify(self);
+                                    [self prerollDidFinishForEntry:entry];
+                                }];
+    }
+}
+
+- (void)prerollDidFinishForEntry:(TWTRVideoPlayerPoolEntry *)entry
+{
+    if (entry.state != TWTRVideoPlayerPoolEntryStatePrerolling) {
+        // Cancelled or evicted while the preroll was finishing.
+        return;
+    }
+
+    entry.state = TWTRVideoPlayerPoolEntryStateWarm;
+    self.prerollingCount--;
+    [self startPendingPrerolls];
+}
+
+- (void)cancelPrerollOfEntry:(TWTRVideoPlayerPoolEntry *)entry
+{
+    switch (entry.state) {
+        case TWTRVideoPlayerPoolEntryStatePendingPreroll:
+            [self.pendingEntries removeObjectIdenticalTo:entry];
+            entry.state = TWTRVideoPlayerPoolEntryStateCold;
+            break;
+        case TWTRVideoPlayerPoolEntryStatePrerolling:
+            [self.playerProvider cancelPrerollOfPlayer:entry.player];
+            entry.state = TWTRVideoPlayerPoolEntryStateCold;
+            self.prerollingCount--;
+            [self startPendingPrerolls];
+            break;
+        case TWTRVideoPlayerPoolEntryStateCold:
+        case TWTRVideoPlayerPoolEntryStateWarm:
+            break;
+    }
+}
+
+#pragma mark - Idle Entries
+
+- (TWTRVideoPlayerPoolEntry *)addIdleEntryForMediaID:(NSString *)mediaID URL:(NSURL *)URL player:(id)player
+{
+    TWTRVideoPlayerPoolEntry *entry = [[TWTRVideoPlayerPoolEntry alloc] init];
+    entry.mediaID = mediaID;
+    entry.URL = URL;
+    entry.player = player;
+    entry.state = TWTRVideoPlayerPoolEntryStateCold;
+
+    self.idleEntries[mediaID] = entry;
+    [self.idleMediaIDs addObject:mediaID];
+
+    while (self.idleMediaIDs.count > self.capacity) {
+        [self evictIdleEntry:self.idleEntries[self.idleMediaIDs.firstObject]];
+    }
+
+    return entry;
+}
+
+- (void)touchIdleEntry:(TWTRVideoPlayerPoolEntry *)entry
+{
+    [self.idleMediaIDs removeObject:entry.mediaID];
+    [self.idleMediaIDs addObject:entry.mediaID];
+}
+
+/**
+ * Takes a checked out entry out of the pool. A running preroll keeps warming the player that is about to be
+ * used, but gives its slot back.
+ */
+- (void)removeIdleEntry:(TWTRVideoPlayerPoolEntry *)entry
+{
+    if (entry.state == TWTRVideoPlayerPoolEntryStatePendingPreroll) {
+        [self cancelPrerollOfEntry:entry];
+    } else if (entry.state == TWTRVideoPlayerPoolEntryStatePrerolling) {
+        entry.state = TWTRVideoPlayerPoolEntryStateCold;
+        self.prerollingCount--;
+    }
+
+    [self.idleEntries removeObjectForKey:entry.mediaID];
+    [self.idleMediaIDs removeObject:entry.mediaID];
+    [self startPendingPrerolls];
+}
+
+/**
+ * Drops the entry and its player.
+ */
+- (void)evictIdleEntry:(TWTRVideoPlayerPoolEntry *)entry
+{
+    [self cancelPrerollOfEntry:entry];
+    [self removeIdleEntry:entry];
+}
+
+- (void)removeAllIdlePlayers
+{
+    for (TWTRVideoPlayerPoolEntry *entry in self.pendingEntries) {
+        entry.state = TWTRVideoPlayerPoolEntryStateCold;
+    }
+    [self.pendingEntries removeAllObjects];
+
+    for (TWTRVideoPlayerPoolEntry *entry in self.idleEntries.allValues) {
+        [self cancelPrerollOfEntry:entry];
+    }
+
+    [self.idleEntries removeAllObjects];
+    [self.idleMediaIDs removeAllObjects];
+}
+
+@end
@@ -16,15 +16,20 @@
  */
 
 /**
- This header is private to the Twitter Core SDK and not exposed for public SDK consumption
+ This header is private to the Twitter Kit SDK and not exposed for public SDK consumption
  */
 
 #import <Foundation/Foundation.h>
+#import "TWTRVideoPlayerPool.h"
 
-@interface TWTRX509Certificate : NSObject
+NS_ASSUME_NONNULL_BEGIN
 
-- (instancetype)initWithCertificate:(SecCertificateRef)certificate;
-- (NSData *)publicKey;
-- (NSString *)fingerprint;
+/**
+ * Provides `AVPlayer`s for a `TWTRVideoPlayerPool`. Prerolling loads the tracks and duration of the
+ * player's `AVURLAsset` so the item can become ready to play without waiting on the network first.
+ */
+@interface TWTRVideoPlayerProvider : NSObject <TWTRVideoPlayerProviding>
 
 @end
+
+NS_ASSUME_NONNULL_END
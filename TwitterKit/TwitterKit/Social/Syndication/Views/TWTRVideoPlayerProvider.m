@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRVideoPlayerProvider.h"
+#import <AVFoundation/AVFoundation.h>
+#import "TWTRVideoResourceLoader.h"
+
+@implementation TWTRVideoPlayerProvider
+
+- (id)playerWithURL:(NSURL *)URL
+{
+    AVURLAsset *asset = [[TWTRVideoResourceLoader sharedLoader] assetWithURL:URL];
+    return [AVPlayer playerWithPlayerItem:[AVPlayerItem playerItemWithAsset:asset]];
+}
+
+- (void)prerollPlayer:(id)player completion:(void (^)(void))completion
+{
+    AVAsset *asset = ((AVPlayer *)player).currentItem.asset;
+
+    [asset loadValuesAsynchronouslyForKeys:@[@"tracks", @"duration", @"playable"]
+                         completionHandler:^{
+                             dispatch_async(dispatch_get_main_queue(), completion);
+                         }];
+}
+
+- (void)cancelPrerollOfPlayer:(id)player
+{
+    [((AVPlayer *)player).currentItem.asset cancelLoading];
+}
+
+- (void)resetPlayer:(id)player
+{
+    AVPlayer *avPlayer = player;
+
+    [avPlayer pause];
+    [avPlayer.currentItem cancelPendingSeeks];
+    [avPlayer seekToTime:kCMTimeZero];
+}
+
+@end
@@ -32,6 +32,16 @@ NS_ASSUME_NONNULL_BEGIN
 
 #endif
 
+/**
+ *  Keys of `-[TWTRTwitter startupPhaseDurations]`.
+ */
+FOUNDATION_EXTERN NSString *const TWTRStartupPhaseConfiguration;      // Runs on the thread that calls start.
+FOUNDATION_EXTERN NSString *const TWTRStartupPhaseResources;          // Locating the TwitterKitResources bundle, also on the thread that calls start.
+FOUNDATION_EXTERN NSString *const TWTRStartupPhaseImageCache;         // Indexing the on-disk image cache.
+FOUNDATION_EXTERN NSString *const TWTRStartupPhaseSessionLoading;     // Reading saved sessions from the keychain.
+FOUNDATION_EXTERN NSString *const TWTRStartupPhaseSessionMigration;   // Migrating sessions saved by older versions.
+FOUNDATION_EXTERN NSString *const TWTRStartupPhaseSessionValidation;  // Purging sessions saved with other credentials.
+
 /**
  *  The central class of the Twitter Kit.
  *  @note This class can only be used from the main thread.
@@ -67,6 +77,17 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)startWithConsumerKey:(NSString *)consumerKey consumerSecret:(NSString *)consumerSecret accessGroup:(nullable NSString *)accessGroup;
 
+/**
+ *  How long each phase of starting the kit took, in seconds, keyed by the `TWTRStartupPhase` constants.
+ *
+ *  Only locating resources and configuration happen on the thread that calls start. The remaining
+ *  phases run on a background queue and appear here as they finish. Network requests are held until
+ *  they have all finished.
+ *  Accessors such as `sessionStore` return immediately; sessions migrated from older versions of the
+ *  kit appear in the store once migration has run.
+ */
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, NSNumber *> *startupPhaseDurations;
+
 /**
  *  The current version of this kit.
  */
@@ -83,6 +104,27 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, readonly) TWTRSessionStore *sessionStore;
 
+/**
+ *  Set to `YES` when the user has asked the app to save data. Inline videos then always play
+ *  their lowest bitrate variant instead of one chosen for the view size and network speed.
+ *  Defaults to `NO`.
+ */
+@property (nonatomic) BOOL prefersReducedVideoDataUsage;
+
+/**
+ *  Approximate bytes held by each of the kits' in-memory caches, such as measured tweet heights,
+ *  typeset text, animated image frames and prerolled video players, keyed by cache name.
+ *  Meant for tuning `cacheMemoryBudget` rather than exact accounting.
+ */
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, NSNumber *> *cacheMemoryUsage;
+
+/**
+ *  The number of bytes the kits' in-memory caches may keep. When the app receives a memory warning
+ *  or enters the background while the caches hold more than this, the caches that are cheapest to
+ *  rebuild are trimmed first until they fit. Defaults to 16 MB.
+ */
+@property (nonatomic) NSUInteger cacheMemoryBudget;
+
 /**
  *  Triggers user authentication with Twitter.
  *
@@ -16,6 +16,7 @@
  */
 
 #import "TWTRTwitter.h"
+#import <QuartzCore/QuartzCore.h>
 #import <TwitterCore/TWTRAPIConstantsUser.h>
 #import <TwitterCore/TWTRAPIServiceConfig.h>
 #import <TwitterCore/TWTRAPIServiceConfigRegistry.h>
@@ -24,7 +25,9 @@
 #import <TwitterCore/TWTRAuthConfigStore.h>
 #import <TwitterCore/TWTRAuthenticationConstants.h>
 #import <TwitterCore/TWTRCoreConstants.h>
+#import <TwitterCore/TWTRMemoryPressureCoordinator.h>
 #import <TwitterCore/TWTRMultiThreadUtil.h>
+#import <TwitterCore/TWTRNetworkThroughputEstimator.h>
 #import <TwitterCore/TWTRNetworkingConstants.h>
 #import <TwitterCore/TWTRNetworkingPipeline.h>
 #import <TwitterCore/TWTRResourcesUtil.h>
@@ -62,16 +65,47 @@ static const NSUInteger AssetCacheMaxSize = 10 * MB;
 
 NSString *const TWTRInvalidInitializationException = @"TWTRInvalidInitializationException";
 
+NSString *const TWTRStartupPhaseConfiguration = @"configuration";
+NSString *const TWTRStartupPhaseResources = @"resources";
+NSString *const TWTRStartupPhaseImageCache = @"image_cache";
+NSString *const TWTRStartupPhaseSessionLoading = @"session_loading";
+NSString *const TWTRStartupPhaseSessionMigration = @"session_migration";
+NSString *const TWTRStartupPhaseSessionValidation = @"session_validation";
+
+// Set in the thread dictionary of the startup queue while it migrates sessions saved by older versions
+static NSString *const TWTRSessionMigrationInProgressKey = @"TWTRSessionMigrationInProgress";
+
+/**
+ *  Session store hooks can fire on the startup queue, e.g. when validation logs out users saved
+ *  with other credentials, but their notifications are observed by UIKit code.
+ */
+static void TWTRPerformOnMainThread(dispatch_block_t block)
+{
+    if ([NSThread isMainThread]) {
+        block();
+    } else {
+        dispatch_async(dispatch_get_main_queue(), block);
+    }
+}
+
 @interface TWTRTwitter ()
 
 @property (nonatomic) TWTRWebAuthenticationFlow *webAuthenticationFlow;
 @property (nonatomic) TWTRMobileSSO *mobileSSO;
 
+/**
+ *  Serial queue running the startup phases that touch the disk or keychain.
+ */
+@property (nonatomic, readonly) dispatch_queue_t startupQueue;
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, NSNumber *> *mutableStartupPhaseDurations;
+@property (nonatomic, readonly) TWTRSessionMigrator *sessionMigrator;
+
 @end
 
 @implementation TWTRTwitter
 @synthesize sessionStore = _sessionStore;
 @synthesize authConfig = _authConfig;
+@synthesize imageLoader = _imageLoader;
 
 #pragma mark - FABKit
 
@@ -146,20 +180,72 @@ static TWTRTwitter *sharedTwitter;
         [NSException raise:TWTRInvalidInitializationException format:@"[%@] %@ called with empty consumer key or secret.", [self class], NSStringFromSelector(_cmd)];
     }
 
+    _mutableStartupPhaseDurations = [NSMutableDictionary dictionary];
+
+    // A single bundle lookup, checked here so a missing bundle raises from the app's call to start
+    CFTimeInterval resourcesStartTime = CACurrentMediaTime();
     [self ensureResourcesBundleExists];
-    [self setupAPIServiceConfigs];
+    [self recordStartupPhase:TWTRStartupPhaseResources startTime:resourcesStartTime];
 
-    self->_authConfig = [[TWTRAuthConfig alloc] initWithConsumerKey:consumerKey consumerSecret:consumerSecret];
+    CFTimeInterval configurationStartTime = CACurrentMediaTime();
+    _startupQueue = dispatch_queue_create("com.twitterkit.startup-queue", DISPATCH_QUEUE_SERIAL);
+
+    // Nothing may be signed until migration and validation have settled which sessions exist
+    [[TWTRAPIClient networkingPipeline] suspend];
 
-    NSString *cacheDir = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+    [self setupAPIServiceConfigs];
 
-    [self setupImageLoaderWithCacheDir:cacheDir];
+    self->_authConfig = [[TWTRAuthConfig alloc] initWithConsumerKey:consumerKey consumerSecret:consumerSecret];
 
+    // The store loads saved sessions asynchronously so it is cheap to create here
     [self setupNetworkingSessionStackWithAccessGroup:accessGroup];
+    _sessionMigrator = [[TWTRSessionMigrator alloc] init];
+    [self setupSessionStoreLogoutHookWithMigrator:_sessionMigrator];
+    [self setupSessionStoreSaveHook];
     [TWTRResourcesUtil setKitVersion:TWTRVersion];
 
     [self kitDidFinishStarting];
     _initialized = YES;
+
+    [self recordStartupPhase:TWTRStartupPhaseConfiguration startTime:configurationStartTime];
+
+    dispatch_async(self.startupQueue, ^{
+        [self runBackgroundStartupPhases];
+    });
+}
+
+/**
+ *  Everything here used to run on the caller of start, usually from application:didFinishLaunching:.
+ */
+- (void)runBackgroundStartupPhases
+{
+    // Created here unless something asked for it first
+    CFTimeInterval startTime = CACurrentMediaTime();
+    [self imageLoader];
+    [self recordStartupPhase:TWTRStartupPhaseImageCache startTime:startTime];
+
+    startTime = CACurrentMediaTime();
+    [_sessionStore existingUserSessions];  // Blocks until the initial keychain load has published
+    [self recordStartupPhase:TWTRStartupPhaseSessionLoading startTime:startTime];
+
+    startTime = CACurrentMediaTime();
+    [self runSessionMigration];
+    [self recordStartupPhase:TWTRStartupPhaseSessionMigration startTime:startTime];
+
+    startTime = CACurrentMediaTime();
+    [self validateSessions];
+    [self recordStartupPhase:TWTRStartupPhaseSessionValidation startTime:startTime];
+
+    [[TWTRAPIClient networkingPipeline] resume];
+}
+
+- (void)recordStartupPhase:(NSString *)phase startTime:(CFTimeInterval)startTime
+{
+    NSNumber *duration = @(CACurrentMediaTime() - startTime);
+    @synchronized(self.mutableStartupPhaseDurations)
+    {
+        self.mutableStartupPhaseDurations[phase] = duration;
+    }
 }
 
 - (void)dealloc
@@ -183,6 +269,10 @@ static TWTRTwitter *sharedTwitter;
 
 #pragma mark - Public
 
+/**
+ *  The store is created when the kit starts and loads saved sessions on its own, so this never
+ *  waits for the startup queue.
+ */
 - (TWTRSessionStore *)sessionStore
 {
     [self assertTwitterKitInitialized];
@@ -195,6 +285,50 @@ static TWTRTwitter *sharedTwitter;
     return _authConfig;
 }
 
+/**
+ *  Created by the startup queue or by the first caller, whichever comes first, rather than making
+ *  the caller wait for every startup phase.
+ */
+- (TWTRImageLoader *)imageLoader
+{
+    @synchronized(self)
+    {
+        if (!_imageLoader) {
+            NSString *cacheDir = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+            [self setupImageLoaderWithCacheDir:cacheDir];
+        }
+        return _imageLoader;
+    }
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)startupPhaseDurations
+{
+    NSMutableDictionary *durations = self.mutableStartupPhaseDurations;
+    if (durations == nil) {
+        return @{};
+    }
+
+    @synchronized(durations)
+    {
+        return [durations copy];
+    }
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)cacheMemoryUsage
+{
+    return [[TWTRMemoryPressureCoordinator sharedCoordinator] memoryUsage];
+}
+
+- (NSUInteger)cacheMemoryBudget
+{
+    return [TWTRMemoryPressureCoordinator sharedCoordinator].memoryBudget;
+}
+
+- (void)setCacheMemoryBudget:(NSUInteger)cacheMemoryBudget
+{
+    [TWTRMemoryPressureCoordinator sharedCoordinator].memoryBudget = cacheMemoryBudget;
+}
+
 #pragma mark - Kit Lifecycle
 
 /**
@@ -266,29 +400,56 @@ static TWTRTwitter *sharedTwitter;
 
     _sessionStore = [[TWTRSessionStore alloc] initWithAuthConfig:_authConfig APIServiceConfig:defaultConfig refreshStrategies:@[guestSessionRefreshStrategy] URLSession:URLSession accessGroup:accessGroup];
 
-    TWTRSessionMigrator *migrator = [[TWTRSessionMigrator alloc] init];
-    [migrator runMigrationWithDestination:_sessionStore removeOnSuccess:NO];
+    [TWTRAPIClient registerSharedSessionStore:_sessionStore];
+}
 
+/**
+ *  Installed when the kit starts so users logged out before startup finishes are still cleaned up.
+ */
+- (void)setupSessionStoreLogoutHookWithMigrator:(TWTRSessionMigrator *)migrator
+{
     _sessionStore.userLogoutHook = ^(NSString *userID) {
         [migrator removeDeprecatedSessions];
 
-        // also clear web view cookies so users will actually be prompted on the next web login
-        [TWTRCookieStorageUtil clearCookiesWithDomainSuffix:@"twitter.com"];
-        [[NSNotificationCenter defaultCenter] postNotificationName:TWTRUserDidLogOutNotification object:nil userInfo:@{TWTRLoggedOutUserIDKey: userID}];
+        TWTRPerformOnMainThread(^{
+            // also clear web view cookies so users will actually be prompted on the next web login
+            [TWTRCookieStorageUtil clearCookiesWithDomainSuffix:@"twitter.com"];
+            [[NSNotificationCenter defaultCenter] postNotificationName:TWTRUserDidLogOutNotification object:nil userInfo:@{TWTRLoggedOutUserIDKey: userID}];
+        });
     };
+}
 
+/**
+ *  Installed when the kit starts so logins that finish before startup does are still announced.
+ */
+- (void)setupSessionStoreSaveHook
+{
     // Only persist session to system account for Twitter user sessions. No callback because
     // we don't care if this succeeds since it will also be persisted into the keychain.
     _sessionStore.userSessionSavedCompletion = ^(id<TWTRAuthSession> savedSession) {
-        if ([savedSession isMemberOfClass:[TWTRSession class]]) {
+        // Migrated sessions are saved synchronously on the startup queue and are not new logins
+        const BOOL isMigratedSession = [[NSThread currentThread].threadDictionary[TWTRSessionMigrationInProgressKey] boolValue];
+
+        if ([savedSession isMemberOfClass:[TWTRSession class]] && !isMigratedSession) {
             TWTRSession *twitterUserSession = savedSession;
             [TWTRSystemAccountSerializer saveToSystemAccountCredentials:[twitterUserSession dictionaryRepresentation] completion:nil];
-            [[NSNotificationCenter defaultCenter] postNotificationName:TWTRUserDidLogInNotification object:nil userInfo:@{TWTRLoggedInUserIDKey: twitterUserSession.userID}];
+            TWTRPerformOnMainThread(^{
+                [[NSNotificationCenter defaultCenter] postNotificationName:TWTRUserDidLogInNotification object:nil userInfo:@{TWTRLoggedInUserIDKey: twitterUserSession.userID}];
+            });
         }
     };
+}
 
-    [TWTRAPIClient registerSharedSessionStore:_sessionStore];
+- (void)runSessionMigration
+{
+    NSMutableDictionary *threadDictionary = [NSThread currentThread].threadDictionary;
+    threadDictionary[TWTRSessionMigrationInProgressKey] = @YES;
+    [self.sessionMigrator runMigrationWithDestination:_sessionStore removeOnSuccess:NO];
+    [threadDictionary removeObjectForKey:TWTRSessionMigrationInProgressKey];
+}
 
+- (void)validateSessions
+{
     TWTRAuthConfigStore *configStore = [[TWTRAuthConfigStore alloc] initWithNameSpace:TWTRBundleID];
     TWTRAuthConfigSessionsValidator *sessionsValidator = [[TWTRAuthConfigSessionsValidator alloc] initWithConfigStore:configStore sessionStore:_sessionStore];
     [sessionsValidator validateSessionStoreContainsValidAuthConfig];
@@ -300,7 +461,7 @@ static TWTRTwitter *sharedTwitter;
     TWTRImageLoaderDiskCache *assetDiskCache = [[TWTRImageLoaderDiskCache alloc] initWithPath:assetCacheFullPath maxSize:AssetCacheMaxSize];
 
     NSURLSessionConfiguration *assetSessionConfig = [TWTRAssetURLSessionConfig defaultConfiguration];
-    NSURLSession *imageSession = [NSURLSession sessionWithConfiguration:assetSessionConfig];
+    NSURLSession *imageSession = [NSURLSession sessionWithConfiguration:assetSessionConfig delegate:[TWTRNetworkThroughputEstimator sharedEstimator] delegateQueue:nil];
     TWTRImageLoaderTaskManager *imageTaskManager = [[TWTRImageLoaderTaskManager alloc] init];
     TWTRImageLoader *imageLoader = [[TWTRImageLoader alloc] initWithSession:imageSession cache:assetDiskCache taskManager:imageTaskManager];
     _imageLoader = imageLoader;
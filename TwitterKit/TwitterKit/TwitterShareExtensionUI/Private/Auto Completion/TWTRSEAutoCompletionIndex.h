@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+@import Foundation;
+
+#import "TWTRSETweet.h"
+
+@protocol TWTRSETwitterUser;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A prefix index of the hashtags and users the composer has seen, so autocompletion can answer on every keystroke
+ without waiting for the host's `TWTRSEAutoCompletion`.
+
+ Entries are kept sorted by their lowercased key (hashtags without the leading #) and a prefix lookup is a binary search
+ followed by a scan of the matching range. Matches are ranked by frecency: every use adds a weight that halves each
+ `halfLife`, and entries that were only seen in remote results rank after used ones, most recently seen first.
+ When an index holds more than `capacity` entries of a kind, the lowest ranked one is evicted.
+
+ The share extension process rarely outlives a single share, so an index with a `fileURL` loads its entries from that
+ file when created and writes them back on a background queue shortly after a use is recorded. Uses recorded in quick
+ succession are written together, and entries that were only seen are written along with the next use.
+
+ Note: This class is NOT thread-safe.
+ */
+@interface TWTRSEAutoCompletionIndex : NSObject
+
+/**
+ The index shared by all composers, saved in the extension's caches directory so completions survive from one
+ share to the next.
+ */
++ (instancetype)sharedIndex;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Creates an index that only lives in memory.
+ */
+- (instancetype)initWithHalfLife:(NSTimeInterval)halfLife capacity:(NSUInteger)capacity;
+
+/**
+ @param fileURL Where the index is loaded from and saved to, or nil to keep it in memory only. A missing or unreadable
+ file starts an empty index.
+ */
+- (instancetype)initWithHalfLife:(NSTimeInterval)halfLife capacity:(NSUInteger)capacity fileURL:(nullable NSURL *)fileURL NS_DESIGNATED_INITIALIZER;
+
+@property (nonatomic, readonly) NSTimeInterval halfLife;
+@property (nonatomic, readonly) NSUInteger capacity;
+@property (nullable, nonatomic, readonly, copy) NSURL *fileURL;
+
+/**
+ Records that the user picked or typed `hashtag` (starting with #) at `date`.
+ */
+- (void)recordUseOfHashtag:(NSString *)hashtag date:(NSDate *)date;
+- (void)recordUseOfUser:(id<TWTRSETwitterUser>)user date:(NSDate *)date;
+
+/**
+ Records a use of every hashtag in `text`, and of every mentioned user the index already holds.
+ */
+- (void)recordUseOfEntitiesInText:(NSString *)text twitterText:(Class<TwitterTextProtocol>)twitterText date:(NSDate *)date;
+
+/**
+ Indexes remote results without counting them as used. Earlier results rank before later ones.
+ */
+- (void)addHashtags:(NSArray<NSString *> *)hashtags;
+- (void)addUsers:(NSArray<id<TWTRSETwitterUser>> *)users;
+
+/**
+ @param prefix The hashtag being typed, with or without the leading #. Matching is case insensitive.
+ @return At most `limit` hashtags, best ranked first.
+ */
+- (NSArray<NSString *> *)hashtagsMatchingPrefix:(NSString *)prefix limit:(NSUInteger)limit;
+
+/**
+ @param prefix The username being typed, without the leading @. Matching is case insensitive.
+ @return At most `limit` users, best ranked first.
+ */
+- (NSArray<id<TWTRSETwitterUser>> *)usersMatchingPrefix:(NSString *)prefix limit:(NSUInteger)limit;
+
+/**
+ Writes any recorded uses that are waiting to be saved, and returns once they are on disk.
+ */
+- (void)flush;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,493 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRSEAutoCompletionIndex.h"
+#import "TWTRSETwitterUser.h"
+
+static const NSTimeInterval TWTRSEAutoCompletionIndexDefaultHalfLife = 3 * 24 * 60 * 60;
+static const NSUInteger TWTRSEAutoCompletionIndexDefaultCapacity = 500;
+static NSString *const TWTRSEAutoCompletionIndexFileName = @"TWTRSEAutoCompletionIndex.plist";
+static const NSTimeInterval TWTRSEAutoCompletionIndexSaveDelay = 1.0;
+
+static NSString *const TWTRSEAutoCompletionIndexHashtagsKey = @"hashtags";
+static NSString *const TWTRSEAutoCompletionIndexUsersKey = @"users";
+static NSString *const TWTRSEAutoCompletionIndexEntryKeyKey = @"key";
+static NSString *const TWTRSEAutoCompletionIndexEntryValueKey = @"value";
+static NSString *const TWTRSEAutoCompletionIndexEntryFrecencyKey = @"frecency";
+static NSString *const TWTRSEAutoCompletionIndexEntrySequenceNumberKey = @"sequenceNumber";
+static NSString *const TWTRSEAutoCompletionIndexUserIDKey = @"userID";
+static NSString *const TWTRSEAutoCompletionIndexUsernameKey = @"username";
+static NSString *const TWTRSEAutoCompletionIndexFullNameKey = @"fullName";
+static NSString *const TWTRSEAutoCompletionIndexAvatarURLKey = @"avatarURL";
+static NSString *const TWTRSEAutoCompletionIndexVerifiedKey = @"verified";
+
+/**
+ Stands in for a user loaded from disk until remote results or a use replace it with the host's own object.
+ */
+@interface TWTRSEAutoCompletionIndexUser : NSObject <TWTRSETwitterUser>
+
+@property (nonatomic) long long userID;
+@property (nonatomic, copy) NSString *username;
+@property (nullable, nonatomic, copy) NSString *fullName;
+@property (nullable, nonatomic, copy) NSURL *avatarURL;
+@property (nonatomic) BOOL verified;
+
+@end
+
+@implementation TWTRSEAutoCompletionIndexUser
+@end
+
+@interface TWTRSEAutoCompletionIndexEntry : NSObject
+
+/**
+ The lowercased string the entry is sorted and matched by.
+ */
+@property (nonatomic, copy) NSString *key;
+@property (nonatomic) id value;
+
+/**
+ log2 of the sum of 2^(t / halfLife) over the times t of every use, or -INFINITY if the entry was never used.
+ Ordering by this value is the same as ordering by the decayed use count at any later time, so it never needs
+ to be refreshed.
+ */
+@property (nonatomic) double frecency;
+
+/**
+ Increases every time the entry is used or seen. Breaks ties in `frecency`.
+ */
+@property (nonatomic) NSUInteger sequenceNumber;
+
+@end
+
+@implementation TWTRSEAutoCompletionIndexEntry
+
+- (NSComparisonResult)compareRank:(TWTRSEAutoCompletionIndexEntry *)otherEntry
+{
+    if (self.frecency != otherEntry.frecency) {
+        return self.frecency > otherEntry.frecency ? NSOrderedAscending : NSOrderedDescending;
+    }
+
+    if (self.sequenceNumber != otherEntry.sequenceNumber) {
+        return self.sequenceNumber > otherEntry.sequenceNumber ? NSOrderedAscending : NSOrderedDescending;
+    }
+
+    return NSOrderedSame;
+}
+
+@end
+
+#pragma mark - Property List Serialization
+
+static NSDictionary *TWTRSEAutoCompletionIndexPropertyListFromUser(id<TWTRSETwitterUser> user)
+{
+    NSMutableDictionary *propertyList = [NSMutableDictionary dictionary];
+    propertyList[TWTRSEAutoCompletionIndexUserIDKey] = @(user.userID);
+    propertyList[TWTRSEAutoCompletionIndexUsernameKey] = user.username;
+    propertyList[TWTRSEAutoCompletionIndexFullNameKey] = user.fullName;
+    propertyList[TWTRSEAutoCompletionIndexAvatarURLKey] = user.avatarURL.absoluteString;
+    propertyList[TWTRSEAutoCompletionIndexVerifiedKey] = @(user.verified);
+
+    return propertyList;
+}
+
+static id<TWTRSETwitterUser> TWTRSEAutoCompletionIndexUserFromPropertyList(NSDictionary *propertyList)
+{
+    if (![propertyList isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+
+    NSString *username = propertyList[TWTRSEAutoCompletionIndexUsernameKey];
+    if (![username isKindOfClass:[NSString class]]) {
+        return nil;
+    }
+
+    NSString *fullName = propertyList[TWTRSEAutoCompletionIndexFullNameKey];
+    NSString *avatarURLString = propertyList[TWTRSEAutoCompletionIndexAvatarURLKey];
+
+    TWTRSEAutoCompletionIndexUser *user = [[TWTRSEAutoCompletionIndexUser alloc] init];
+    user.userID = [propertyList[TWTRSEAutoCompletionIndexUserIDKey] longLongValue];
+    user.username = username;
+    user.fullName = [fullName isKindOfClass:[NSString class]] ? fullName : nil;
+    user.avatarURL = [avatarURLString isKindOfClass:[NSString class]] ? [NSURL URLWithString:avatarURLString] : nil;
+    user.verified = [propertyList[TWTRSEAutoCompletionIndexVerifiedKey] boolValue];
+
+    return user;
+}
+
+@interface TWTRSEAutoCompletionIndex ()
+
+@property (nonatomic, readonly) NSMutableArray<TWTRSEAutoCompletionIndexEntry *> *hashtagEntries;
+@property (nonatomic, readonly) NSMutableArray<TWTRSEAutoCompletionIndexEntry *> *userEntries;
+@property (nonatomic) NSUInteger lastSequenceNumber;
+@property (nonatomic, readonly) dispatch_queue_t saveQueue;
+
+/**
+ The latest snapshot of the entries that has not been written yet. Only accessed on `saveQueue`.
+ */
+@property (nullable, nonatomic) NSDictionary *pendingPropertyList;
+
+@end
+
+@implementation TWTRSEAutoCompletionIndex
+
++ (instancetype)sharedIndex
+{
+    static TWTRSEAutoCompletionIndex *sharedIndex;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSURL *cachesURL = [[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask].firstObject;
+        NSURL *fileURL = [cachesURL URLByAppendingPathComponent:TWTRSEAutoCompletionIndexFileName];
+        sharedIndex = [[self alloc] initWithHalfLife:TWTRSEAutoCompletionIndexDefaultHalfLife capacity:TWTRSEAutoCompletionIndexDefaultCapacity fileURL:fileURL];
+    });
+
+    return sharedIndex;
+}
+
+- (instancetype)initWithHalfLife:(NSTimeInterval)halfLife capacity:(NSUInteger)capacity
+{
+    return [self initWithHalfLife:halfLife capacity:capacity fileURL:nil];
+}
+
+- (instancetype)initWithHalfLife:(NSTimeInterval)halfLife capacity:(NSUInteger)capacity fileURL:(NSURL *)fileURL
+{
+    NSParameterAssert(halfLife > 0);
+    NSParameterAssert(capacity > 0);
+
+    if ((self = [super init])) {
+        _halfLife = halfLife;
+        _capacity = capacity;
+        _fileURL = [fileURL copy];
+        _hashtagEntries = [NSMutableArray array];
+        _userEntries = [NSMutableArray array];
+        _saveQueue = dispatch_queue_create("com.twitter.TWTRSEAutoCompletionIndexSaveQueue", DISPATCH_QUEUE_SERIAL);
+
+        [self load];
+    }
+
+    return self;
+}
+
+#pragma mark - Recording
+
+- (void)recordUseOfHashtag:(NSString *)hashtag date:(NSDate *)date
+{
+    NSParameterAssert(hashtag);
+    NSParameterAssert(date);
+
+    [self recordUseOfValue:hashtag key:[self keyForHashtag:hashtag] inEntries:self.hashtagEntries date:date];
+    [self save];
+}
+
+- (void)recordUseOfUser:(id<TWTRSETwitterUser>)user date:(NSDate *)date
+{
+    NSParameterAssert(user);
+    NSParameterAssert(date);
+
+    [self recordUseOfValue:user key:user.username.lowercaseString inEntries:self.userEntries date:date];
+    [self save];
+}
+
+- (void)recordUseOfEntitiesInText:(NSString *)text twitterText:(Class<TwitterTextProtocol>)twitterText date:(NSDate *)date
+{
+    NSParameterAssert(text);
+    NSParameterAssert(twitterText);
+    NSParameterAssert(date);
+
+    for (TwitterTextEntity *entity in [twitterText hashtagsInText:text checkingURLOverlap:YES]) {
+        NSString *hashtag = [text substringWithRange:[(id)entity range]];
+        [self recordUseOfValue:hashtag key:[self keyForHashtag:hashtag] inEntries:self.hashtagEntries date:date];
+    }
+
+    for (TwitterTextEntity *entity in [twitterText mentionedScreenNamesInText:text]) {
+        // The mention range starts with the @ sign.
+        NSString *key = [text substringWithRange:[(id)entity range]].lowercaseString;
+        key = [key substringFromIndex:MIN(key.length, (NSUInteger)1)];
+
+        const NSUInteger index = [self lowerBoundOfKey:key inEntries:self.userEntries];
+        if (index < self.userEntries.count && [self.userEntries[index].key isEqualToString:key]) {
+            [self recordUseOfValue:self.userEntries[index].value key:key inEntries:self.userEntries date:date];
+        }
+    }
+
+    [self save];
+}
+
+- (void)addHashtags:(NSArray<NSString *> *)hashtags
+{
+    for (NSString *hashtag in hashtags.reverseObjectEnumerator) {
+        [self entryForValue:hashtag key:[self keyForHashtag:hashtag] inEntries:self.hashtagEntries];
+    }
+}
+
+- (void)addUsers:(NSArray<id<TWTRSETwitterUser>> *)users
+{
+    for (id<TWTRSETwitterUser> user in users.reverseObjectEnumerator) {
+        [self entryForValue:user key:user.username.lowercaseString inEntries:self.userEntries];
+    }
+}
+
+- (void)recordUseOfValue:(id)value key:(NSString *)key inEntries:(NSMutableArray<TWTRSEAutoCompletionIndexEntry *> *)entries date:(NSDate *)date
+{
+    TWTRSEAutoCompletionIndexEntry *entry = [self entryForValue:value key:key inEntries:entries];
+    const double weight = date.timeIntervalSinceReferenceDate / self.halfLife;
+
+    if (entry.frecency == -INFINITY) {
+        entry.frecency = weight;
+    } else {
+        const double high = MAX(entry.frecency, weight);
+        const double low = MIN(entry.frecency, weight);
+        entry.frecency = high + log2(1 + exp2(low - high));
+    }
+}
+
+/**
+ Inserts an entry for `key` if there is none, marks it as the most recently seen and stores the latest `value` in it.
+ */
+- (TWTRSEAutoCompletionIndexEntry *)entryForValue:(id)value key:(NSString *)key inEntries:(NSMutableArray<TWTRSEAutoCompletionIndexEntry *> *)entries
+{
+    const NSUInteger index = [self lowerBoundOfKey:key inEntries:entries];
+    TWTRSEAutoCompletionIndexEntry *entry = nil;
+
+    if (index < entries.count && [entries[index].key isEqualToString:key]) {
+        entry = entries[index];
+    } else {
+        entry = [[TWTRSEAutoCompletionIndexEntry alloc] init];
+        entry.key = key;
+        entry.frecency = -INFINITY;
+        [entries insertObject:entry atIndex:index];
+    }
+
+    entry.value = value;
+    entry.sequenceNumber = ++self.lastSequenceNumber;
+
+    if (entries.count > self.capacity) {
+        [self evictLowestRankedEntryExcept:entry inEntries:entries];
+    }
+
+    return entry;
+}
+
+- (void)evictLowestRankedEntryExcept:(TWTRSEAutoCompletionIndexEntry *)keptEntry inEntries:(NSMutableArray<TWTRSEAutoCompletionIndexEntry *> *)entries
+{
+    NSUInteger evictedIndex = NSNotFound;
+
+    for (NSUInteger index = 0; index < entries.count; index++) {
+        if (entries[index] == keptEntry) {
+            continue;
+        }
+
+        if (evictedIndex == NSNotFound || [entries[index] compareRank:entries[evictedIndex]] == NSOrderedDescending) {
+            evictedIndex = index;
+        }
+    }
+
+    if (evictedIndex != NSNotFound) {
+        [entries removeObjectAtIndex:evictedIndex];
+    }
+}
+
+#pragma mark - Lookup
+
+- (NSArray<NSString *> *)hashtagsMatchingPrefix:(NSString *)prefix limit:(NSUInteger)limit
+{
+    return [self valuesMatchingPrefix:[self keyForHashtag:prefix] inEntries:self.hashtagEntries limit:limit];
+}
+
+- (NSArray<id<TWTRSETwitterUser>> *)usersMatchingPrefix:(NSString *)prefix limit:(NSUInteger)limit
+{
+    return [self valuesMatchingPrefix:prefix.lowercaseString inEntries:self.userEntries limit:limit];
+}
+
+- (NSArray *)valuesMatchingPrefix:(NSString *)prefix inEntries:(NSArray<TWTRSEAutoCompletionIndexEntry *> *)entries limit:(NSUInteger)limit
+{
+    const NSUInteger start = [self lowerBoundOfKey:prefix inEntries:entries];
+    NSUInteger end = start;
+
+    while (end < entries.count && [entries[end].key hasPrefix:prefix]) {
+        end++;
+    }
+
+    NSArray<TWTRSEAutoCompletionIndexEntry *> *matches = [[entries subarrayWithRange:NSMakeRange(start, end - start)] sortedArrayUsingSelector:@selector(compareRank:)];
+    NSMutableArray *values = [NSMutableArray arrayWithCapacity:MIN(limit, matches.count)];
+
+    for (TWTRSEAutoCompletionIndexEntry *entry in matches) {
+        if (values.count == limit) {
+            break;
+        }
+        [values addObject:entry.value];
+    }
+
+    return values;
+}
+
+#pragma mark - Persistence
+
+- (void)load
+{
+    if (!self.fileURL) {
+        return;
+    }
+
+    NSDictionary *propertyList = [NSDictionary dictionaryWithContentsOfURL:self.fileURL];
+    [self loadEntriesFromPropertyList:propertyList[TWTRSEAutoCompletionIndexHashtagsKey] intoEntries:self.hashtagEntries valueTransformer:^id(id value) {
+        return [value isKindOfClass:[NSString class]] ? value : nil;
+    }];
+    [self loadEntriesFromPropertyList:propertyList[TWTRSEAutoCompletionIndexUsersKey] intoEntries:self.userEntries valueTransformer:^id(id value) {
+        return TWTRSEAutoCompletionIndexUserFromPropertyList(value);
+    }];
+}
+
+- (void)loadEntriesFromPropertyList:(NSArray *)propertyList intoEntries:(NSMutableArray<TWTRSEAutoCompletionIndexEntry *> *)entries valueTransformer:(id (^)(id value))valueTransformer
+{
+    if (![propertyList isKindOfClass:[NSArray class]]) {
+        return;
+    }
+
+    for (NSDictionary *entryPropertyList in propertyList) {
+        if (![entryPropertyList isKindOfClass:[NSDictionary class]]) {
+            continue;
+        }
+
+        NSString *key = entryPropertyList[TWTRSEAutoCompletionIndexEntryKeyKey];
+        id value = valueTransformer(entryPropertyList[TWTRSEAutoCompletionIndexEntryValueKey]);
+        if (![key isKindOfClass:[NSString class]] || !value) {
+            continue;
+        }
+
+        // Entries are written in key order, but insert at the lower bound anyway in case the file was written differently.
+        const NSUInteger index = [self lowerBoundOfKey:key inEntries:entries];
+        if ((index < entries.count && [entries[index].key isEqualToString:key]) || entries.count >= self.capacity) {
+            continue;
+        }
+
+        // A never used entry has no frecency, since property lists cannot hold infinities.
+        NSNumber *frecency = entryPropertyList[TWTRSEAutoCompletionIndexEntryFrecencyKey];
+
+        TWTRSEAutoCompletionIndexEntry *entry = [[TWTRSEAutoCompletionIndexEntry alloc] init];
+        entry.key = key;
+        entry.value = value;
+        entry.frecency = frecency ? frecency.doubleValue : -INFINITY;
+        entry.sequenceNumber = [entryPropertyList[TWTRSEAutoCompletionIndexEntrySequenceNumberKey] unsignedIntegerValue];
+        [entries insertObject:entry atIndex:index];
+
+        self.lastSequenceNumber = MAX(self.lastSequenceNumber, entry.sequenceNumber);
+    }
+}
+
+/**
+ Snapshots the entries and writes the latest snapshot on `saveQueue` `TWTRSEAutoCompletionIndexSaveDelay` after
+ the first unwritten use, so a burst of uses costs a single write.
+ */
+- (void)save
+{
+    if (!self.fileURL) {
+        return;
+    }
+
+    NSArray *hashtags = [self propertyListFromEntries:self.hashtagEntries valueTransformer:^id(id value) {
+        return value;
+    }];
+    NSArray *users = [self propertyListFromEntries:self.userEntries valueTransformer:^id(id value) {
+        return TWTRSEAutoCompletionIndexPropertyListFromUser(value);
+    }];
+    NSDictionary *propertyList = @{TWTRSEAutoCompletionIndexHashtagsKey: hashtags, TWTRSEAutoCompletionIndexUsersKey: users};
+
+    dispatch_async(self.saveQueue, ^{
+        const BOOL isWriteScheduled = self.pendingPropertyList != nil;
+        self.pendingPropertyList = propertyList;
+
+        if (!isWriteScheduled) {
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(TWTRSEAutoCompletionIndexSaveDelay * NSEC_PER_SEC)), self.saveQueue, ^{
+                [self writePendingPropertyList];
+            });
+        }
+    });
+}
+
+- (void)flush
+{
+    dispatch_sync(self.saveQueue, ^{
+        [self writePendingPropertyList];
+    });
+}
+
+- (void)writePendingPropertyList
+{
+    NSDictionary *propertyList = self.pendingPropertyList;
+    if (!propertyList) {
+        return;
+    }
+    self.pendingPropertyList = nil;
+
+    NSError *error;
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:propertyList format:NSPropertyListBinaryFormat_v1_0 options:0 error:&error];
+    if (!data || ![data writeToURL:self.fileURL options:NSDataWritingAtomic error:&error]) {
+        NSLog(@"Error saving autocompletion index: %@", error);
+    }
+}
+
+- (NSArray *)propertyListFromEntries:(NSArray<TWTRSEAutoCompletionIndexEntry *> *)entries valueTransformer:(id (^)(id value))valueTransformer
+{
+    NSMutableArray *propertyList = [NSMutableArray arrayWithCapacity:entries.count];
+
+    for (TWTRSEAutoCompletionIndexEntry *entry in entries) {
+        NSMutableDictionary *entryPropertyList = [NSMutableDictionary dictionary];
+        entryPropertyList[TWTRSEAutoCompletionIndexEntryKeyKey] = entry.key;
+        entryPropertyList[TWTRSEAutoCompletionIndexEntryValueKey] = valueTransformer(entry.value);
+        entryPropertyList[TWTRSEAutoCompletionIndexEntrySequenceNumberKey] = @(entry.sequenceNumber);
+        if (entry.frecency != -INFINITY) {
+            entryPropertyList[TWTRSEAutoCompletionIndexEntryFrecencyKey] = @(entry.frecency);
+        }
+        [propertyList addObject:entryPropertyList];
+    }
+
+    return propertyList;
+}
+
+#pragma mark - Keys
+
+- (NSString *)keyForHashtag:(NSString *)hashtag
+{
+    if ([hashtag hasPrefix:@"#"] || [hashtag hasPrefix:@"＃"]) {
+        hashtag = [hashtag substringFromIndex:1];
+    }
+
+    return hashtag.lowercaseString;
+}
+
+/**
+ @return The index of the first entry whose key does not sort before `key`. Keys are compared literally, so all the keys
+ starting with a prefix are contiguous from the lower bound of that prefix.
+ */
+- (NSUInteger)lowerBoundOfKey:(NSString *)key inEntries:(NSArray<TWTRSEAutoCompletionIndexEntry *> *)entries
+{
+    NSUInteger low = 0;
+    NSUInteger high = entries.count;
+
+    while (low < high) {
+        const NSUInteger middle = low + (high - low) / 2;
+        if ([entries[middle].key compare:key options:NSLiteralSearch] == NSOrderedAscending) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+@end
@@ -20,6 +20,7 @@
 #import "TWTRSEAccount.h"
 #import "TWTRSEAccountTableViewCell.h"
 #import "TWTRSEAutoCompletion.h"
+#import "TWTRSEAutoCompletionIndex.h"
 #import "TWTRSEAutoCompletionResult.h"
 #import "TWTRSEAutoCompletionViewModel.h"
 #import "TWTRSEColors.h"
@@ -39,15 +40,22 @@ typedef NS_ENUM(NSUInteger, TWTRSEAutoCompletionState) {
 
 static const NSTimeInterval kAutoCompletionTypingThrottleInterval = 0.3;
 
+/**
+ Local results shown per word. When the local index has this many, the remote lookup is skipped.
+ */
+static const NSUInteger kAutoCompletionLocalResultsLimit = 5;
+
 @interface TWTRSEAutoCompletionTableViewController () <UITableViewDelegate, UITableViewDataSource, TWTRSEThrottledPropertyObserver>
 
 @property (nonatomic, nonnull, readonly) id<TWTRSEAutoCompletion> autoCompletion;
 @property (nonatomic, readonly, nonnull) id<TWTRSEImageDownloader> imageDownloader;
 @property (nonatomic, nonnull, readonly) TWTRSEAutoCompletionViewModel *viewModel;
+@property (nonatomic, nonnull, readonly) TWTRSEAutoCompletionIndex *autoCompletionIndex;
 
 @property (nonatomic, nonnull, readonly) TWTRSEThrottledProperty<NSString *> *wordAroundSelectionProperty;
 
 @property (nonatomic, nullable, copy) NSArray<id<TWTRSEAutoCompletionResult>> *latestResults;
+@property (nonatomic, nullable, copy) NSArray<id<TWTRSEAutoCompletionResult>> *localResults;
 
 @property (nonatomic, readonly) UIView *separatorLine;
 
@@ -73,6 +81,7 @@ static const NSTimeInterval kAutoCompletionTypingThrottleInterval = 0.3;
         _delegate = delegate;
 
         _viewModel = [[TWTRSEAutoCompletionViewModel alloc] init];
+        _autoCompletionIndex = [TWTRSEAutoCompletionIndex sharedIndex];
 
         _wordAroundSelectionProperty = [[TWTRSEThrottledProperty alloc] initWithThottleInterval:kAutoCompletionTypingThrottleInterval observer:self];
         _cursor = (NSRange){.location = NSNotFound, .length = 0};
@@ -140,6 +149,11 @@ static const NSTimeInterval kAutoCompletionTypingThrottleInterval = 0.3;
     }
 
     _wordAroundSelection = [wordAroundSelection copy];
+
+    // Any response still in flight is for a superseded word.
+    self.lastRequestedWord = nil;
+    [self showLocalResultsForWordAroundSelection:wordAroundSelection];
+
     self.wordAroundSelectionProperty.lastValue = wordAroundSelection;
 
     [self updateVisibilityWithWordAroundSelection:wordAroundSelection];
@@ -171,14 +185,63 @@ static const NSTimeInterval kAutoCompletionTypingThrottleInterval = 0.3;
     [self.delegate autoCompletionTableViewController:self wantsAutoCompletionResultsVisible:showAutoCompletionResults];
 }
 
+- (void)showLocalResultsForWordAroundSelection:(nullable NSString *)wordAroundSelection
+{
+    NSArray<id<TWTRSEAutoCompletionResult>> *localResults = @[];
+
+    if ([self.viewModel wordIsHashtag:wordAroundSelection]) {
+        NSArray<NSString *> *hashtags = [self.autoCompletionIndex hashtagsMatchingPrefix:wordAroundSelection limit:kAutoCompletionLocalResultsLimit];
+        localResults = tse_map(hashtags, ^TWTRSEAutoCompletionResultHashtag *_Nonnull(NSString *_Nonnull element) {
+            return [[TWTRSEAutoCompletionResultHashtag alloc] initWithHashtag:element];
+        });
+    } else if ([self.viewModel wordIsUsername:wordAroundSelection]) {
+        NSString *strippedWord = [self.viewModel stripUsernameMarkersFromWord:wordAroundSelection];
+        NSArray<id<TWTRSETwitterUser>> *users = [self.autoCompletionIndex usersMatchingPrefix:strippedWord limit:kAutoCompletionLocalResultsLimit];
+        localResults = tse_map(users, ^TWTRSEAutoCompletionResultUser *_Nonnull(id<TWTRSETwitterUser> _Nonnull element) {
+            return [[TWTRSEAutoCompletionResultUser alloc] initWithUser:element];
+        });
+    }
+
+    self.localResults = localResults;
+    self.latestResults = localResults;
+    self.autoCompletionState = TWTRSEAutoCompletionStateWaiting;
+}
+
+/**
+ @return The local results followed by the remote ones that are not already among them.
+ */
+- (NSArray<id<TWTRSEAutoCompletionResult>> *)resultsByAppendingRemoteResults:(NSArray<id<TWTRSEAutoCompletionResult>> *)remoteResults
+{
+    NSMutableSet<NSString *> *localKeys = [NSMutableSet set];
+    for (id<TWTRSEAutoCompletionResult> result in self.localResults) {
+        [localKeys addObject:[self deduplicationKeyForResult:result]];
+    }
+
+    NSArray<id<TWTRSEAutoCompletionResult>> *newResults = tse_filter(remoteResults, ^BOOL(id<TWTRSEAutoCompletionResult> _Nonnull element) {
+        return ![localKeys containsObject:[self deduplicationKeyForResult:element]];
+    });
+
+    return [self.localResults ?: @[] arrayByAddingObjectsFromArray:newResults];
+}
+
+- (NSString *)deduplicationKeyForResult:(id<TWTRSEAutoCompletionResult>)result
+{
+    if ([result isKindOfClass:[TWTRSEAutoCompletionResultHashtag class]]) {
+        return ((TWTRSEAutoCompletionResultHashtag *)result).hashtag.lowercaseString;
+    } else if ([result isKindOfClass:[TWTRSEAutoCompletionResultUser class]]) {
+        return [NSString stringWithFormat:@"%lld", ((TWTRSEAutoCompletionResultUser *)result).user.userID];
+    } else {
+        [self assertUnknownAutoCompletionResultClass:[result class]];
+        return @"";
+    }
+}
+
 #pragma mark - TWTRSEThrottledPropertyObserver
 
 - (void)throttledProperty:(TWTRSEThrottledProperty *)throttledProperty didChangeValue:(nullable NSString *)wordAroundSelection
 {
-    self.latestResults = nil;
-    self.autoCompletionState = TWTRSEAutoCompletionStateWaiting;
-
-    if (wordAroundSelection == nil) {
+    // The local index answered on the keystroke; only ask the host when it did not have enough.
+    if (wordAroundSelection == nil || self.localResults.count >= kAutoCompletionLocalResultsLimit) {
         return;
     }
 
@@ -188,7 +251,9 @@ static const NSTimeInterval kAutoCompletionTypingThrottleInterval = 0.3;
     __weak typeof(self) weakSelf = self;
 
     if ([self.viewModel wordIsHashtag:wordAroundSelection]) {
-        self.autoCompletionState = TWTRSEAutoCompletionStateLoading;
+        if (self.localResults.count == 0) {
+            self.autoCompletionState = TWTRSEAutoCompletionStateLoading;
+        }
         [self.autoCompletion loadAutoCompletionResultsForHashtag:strippedWord
                                                         callback:^(NSArray<NSString *> *_Nullable results, NSError *_Nullable error) {
                                                             dispatch_async(dispatch_get_main_queue(), ^{
@@ -206,16 +271,19 @@ static const NSTimeInterval kAutoCompletionTypingThrottleInterval = 0.3;
                                                                 strongSelf.autoCompletionState = TWTRSEAutoCompletionStateWaiting;
 
                                                                 if (results) {
-                                                                    strongSelf.latestResults = tse_map(results, ^TWTRSEAutoCompletionResultHashtag *_Nonnull(NSString *_Nonnull element) {
-                                                                        return [[TWTRSEAutoCompletionResultHashtag alloc] initWithHashtag:element];
-                                                                    });
-                                                                } else {
+                                                                    [strongSelf.autoCompletionIndex addHashtags:results];
+                                                                    strongSelf.latestResults = [strongSelf resultsByAppendingRemoteResults:tse_map(results, ^TWTRSEAutoCompletionResultHashtag *_Nonnull(NSString *_Nonnull element) {
+                                                                                                               return [[TWTRSEAutoCompletionResultHashtag alloc] initWithHashtag:element];
+                                                                                                           })];
+                                                                } else if (strongSelf.localResults.count == 0) {
                                                                     strongSelf.autoCompletionState = TWTRSEAutoCompletionStateFailed;
                                                                 }
                                                             });
                                                         }];
     } else if ([self.viewModel wordIsUsername:wordAroundSelection]) {
-        self.autoCompletionState = TWTRSEAutoCompletionStateLoading;
+        if (self.localResults.count == 0) {
+            self.autoCompletionState = TWTRSEAutoCompletionStateLoading;
+        }
         [self.autoCompletion loadAutoCompletionResultsForUsername:strippedWord
                                                          callback:^(NSArray<id<TWTRSETwitterUser>> *_Nullable results, NSError *_Nullable error) {
                                                              dispatch_async(dispatch_get_main_queue(), ^{
@@ -233,10 +301,11 @@ static const NSTimeInterval kAutoCompletionTypingThrottleInterval = 0.3;
                                                                  strongSelf.autoCompletionState = TWTRSEAutoCompletionStateWaiting;
 
                                                                  if (results) {
-                                                                     strongSelf.latestResults = tse_map(results, ^TWTRSEAutoCompletionResultUser *_Nonnull(id<TWTRSETwitterUser> _Nonnull element) {
-                                                                         return [[TWTRSEAutoCompletionResultUser alloc] initWithUser:element];
-                                                                     });
-                                                                 } else {
+                                                                     [strongSelf.autoCompletionIndex addUsers:results];
+                                                                     strongSelf.latestResults = [strongSelf resultsByAppendingRemoteResults:tse_map(results, ^TWTRSEAutoCompletionResultUser *_Nonnull(id<TWTRSETwitterUser> _Nonnull element) {
+                                                                                                                return [[TWTRSEAutoCompletionResultUser alloc] initWithUser:element];
+                                                                                                            })];
+                                                                 } else if (strongSelf.localResults.count == 0) {
                                                                      strongSelf.autoCompletionState = TWTRSEAutoCompletionStateFailed;
                                                                  }
                                                              });
@@ -340,10 +409,12 @@ static const NSTimeInterval kAutoCompletionTypingThrottleInterval = 0.3;
         TWTRSEAutoCompletionResultHashtag *hashtagResult = (TWTRSEAutoCompletionResultHashtag *)result;
 
         word = hashtagResult.hashtag;
+        [self.autoCompletionIndex recordUseOfHashtag:hashtagResult.hashtag date:[NSDate date]];
     } else if ([result isKindOfClass:[TWTRSEAutoCompletionResultUser class]]) {
         TWTRSEAutoCompletionResultUser *userResult = (TWTRSEAutoCompletionResultUser *)result;
 
         word = TWTRSEDisplayUsername(userResult.user.username);
+        [self.autoCompletionIndex recordUseOfUser:userResult.user date:[NSDate date]];
     } else {
         [self assertUnknownAutoCompletionResultClass:[result class]];
     }
@@ -17,20 +17,37 @@
 
 #import "TWTRSEAutoCompletionViewModel.h"
 #import "TWTRSEAccount.h"
+#import "TWTRSEEntityTokenIndex.h"
 #import "TWTRSETweet.h"
 #import "TWTRSEWordRangeCalculator.h"
 
 @interface NSString (TWTRSEAutoCompletionViewModel)
 - (BOOL)isSpecialAutoCompleteSymbolAtIndex:(NSUInteger)index;
 - (BOOL)isSpaceOrCarriageReturnAtIndex:(NSUInteger)index;
-- (NSString *)stringForTwitterTextEntityIntersectingRange:(NSRange)range;
 @end
 
 @interface NSString () <TWTRSEWordRangeCalculator>
 @end
 
+@interface TWTRSEAutoCompletionViewModel ()
+
+@property (nonatomic, readonly) TWTRSEEntityTokenIndex *entityTokenIndex;
+
+@end
+
 @implementation TWTRSEAutoCompletionViewModel
 
+@synthesize entityTokenIndex = _entityTokenIndex;
+
+- (TWTRSEEntityTokenIndex *)entityTokenIndex
+{
+    if (!_entityTokenIndex) {
+        _entityTokenIndex = [[TWTRSEEntityTokenIndex alloc] initWithTwitterText:[TWTRSETweet twitterText]];
+    }
+
+    return _entityTokenIndex;
+}
+
 - (BOOL)wordIsHashtag:(NSString *)word
 {
     return [word hasPrefix:@"#"];
@@ -67,7 +84,8 @@
         }
     }
 
-    return [text stringForTwitterTextEntityIntersectingRange:wordRange] ?: [text substringWithRange:wordRange];
+    const NSRange entityRange = [self.entityTokenIndex entityRangeIntersectingRange:wordRange inText:text];
+    return [text substringWithRange:(NSNotFound != entityRange.location) ? entityRange : wordRange];
 }
 
 - (NSString *)insertAutoCompletionWord:(NSString *)word inWordAtLocation:(NSUInteger)wordLocation inText:(NSString<TWTRSEWordRangeCalculator> *)text insertionEndLocation:(NSUInteger *)insertionEndLocation
@@ -127,15 +145,4 @@
     return ' ' == c || 0x000A == c;
 }
 
-- (NSString *)stringForTwitterTextEntityIntersectingRange:(NSRange)range
-{
-    NSArray<TwitterTextEntity *> *entities = [[TWTRSETweet twitterText] entitiesInText:self];
-    for (TwitterTextEntity *entity in entities) {
-        if (0 != NSIntersectionRange([(id)entity range], range).length) {
-            return [self substringWithRange:[(id)entity range]];
-        }
-    }
-    return nil;
-}
-
 @end
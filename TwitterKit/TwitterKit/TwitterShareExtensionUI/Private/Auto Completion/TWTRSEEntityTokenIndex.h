@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+@import Foundation;
+
+#import "TWTRSETweet.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Keeps the ranges of the twitter-text entities (URLs, hashtags, cashtags and mentions) of a composer draft up to date as
+ it is edited.
+
+ No entity spans whitespace, so an edit only re-extracts entities from the whitespace-delimited tokens it touches. The
+ entities before the edit are kept as they are and the ones after it are shifted by the change in length.
+
+ Note: This class is NOT thread-safe.
+ */
+@interface TWTRSEEntityTokenIndex : NSObject
+
+@property (nonatomic, readonly) Class<TwitterTextProtocol> twitterText;
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithTwitterText:(Class<TwitterTextProtocol>)twitterText NS_DESIGNATED_INITIALIZER;
+
+/**
+ @return The range of the first entity in `text` that intersects `range`, or `{NSNotFound, 0}` if there is none.
+ The entities of `text` are extracted incrementally from the ones of the previously queried text.
+ */
+- (NSRange)entityRangeIntersectingRange:(NSRange)range inText:(NSString *)text;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRSEEntityTokenIndex.h"
+#import "TWTRSEStringDiff.h"
+
+/**
+ @return The index of the first range in `ranges` for which `predicate` is true. `predicate` must be false for a prefix
+ of `ranges` and true for the rest of it.
+ */
+static NSUInteger TWTRSEFirstRangeIndexPassingTest(NSArray<NSValue *> *ranges, BOOL (^predicate)(NSRange range))
+{
+    NSUInteger low = 0;
+    NSUInteger high = ranges.count;
+
+    while (low < high) {
+        const NSUInteger middle = low + (high - low) / 2;
+        if (predicate(ranges[middle].rangeValue)) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+
+    return low;
+}
+
+@interface TWTRSEEntityTokenIndex ()
+
+@property (nonatomic, copy) NSString *text;
+
+/**
+ The entity ranges of `text`, sorted by location. Entities never overlap, so they are sorted by their end as well.
+ */
+@property (nonatomic, readonly) NSMutableArray<NSValue *> *entityRanges;
+
+@end
+
+@implementation TWTRSEEntityTokenIndex
+
+- (instancetype)initWithTwitterText:(Class<TwitterTextProtocol>)twitterText
+{
+    NSParameterAssert(twitterText);
+
+    if ((self = [super init])) {
+        _twitterText = twitterText;
+        _text = @"";
+        _entityRanges = [NSMutableArray array];
+    }
+
+    return self;
+}
+
+- (NSRange)entityRangeIntersectingRange:(NSRange)range inText:(NSString *)text
+{
+    text = text ?: @"";
+
+    if (text != self.text && ![text isEqualToString:self.text]) {
+        [self updateWithText:text];
+    }
+
+    if (range.length == 0) {
+        return NSMakeRange(NSNotFound, 0);
+    }
+
+    const NSUInteger index = TWTRSEFirstRangeIndexPassingTest(self.entityRanges, ^BOOL(NSRange entityRange) {
+        return NSMaxRange(entityRange) > range.location;
+    });
+
+    if (index < self.entityRanges.count) {
+        const NSRange entityRange = self.entityRanges[index].rangeValue;
+        if (entityRange.location < NSMaxRange(range)) {
+            return entityRange;
+        }
+    }
+
+    return NSMakeRange(NSNotFound, 0);
+}
+
+#pragma mark - Entities
+
+- (void)updateWithText:(NSString *)text
+{
+    NSString *oldText = self.text;
+    const NSUInteger oldLength = oldText.length;
+    const NSUInteger newLength = text.length;
+    const NSUInteger prefixLength = TWTRSEStringDiffCommonPrefixLength(oldText, text);
+    const NSUInteger suffixLength = TWTRSEStringDiffCommonSuffixLength(oldText, text, MIN(oldLength, newLength) - prefixLength);
+
+    // Widen the edit to the whitespace around it in the new text. The widened ends lie in the unchanged prefix and
+    // suffix, so the same whitespace delimits the replaced tokens in the old text.
+    NSCharacterSet *whitespaceSet = [NSCharacterSet whitespaceAndNewlineCharacterSet];
+    NSUInteger tokensStart = prefixLength;
+    while (tokensStart > 0 && ![whitespaceSet characterIsMember:[text characterAtIndex:tokensStart - 1]]) {
+        tokensStart--;
+    }
+
+    NSUInteger tokensEnd = newLength - suffixLength;
+    while (tokensEnd < newLength && ![whitespaceSet characterIsMember:[text characterAtIndex:tokensEnd]]) {
+        tokensEnd++;
+    }
+
+    const NSUInteger oldTokensEnd = tokensEnd + oldLength - newLength;
+    const NSUInteger firstIndex = TWTRSEFirstRangeIndexPassingTest(self.entityRanges, ^BOOL(NSRange entityRange) {
+        return entityRange.location >= tokensStart;
+    });
+    const NSUInteger endIndex = TWTRSEFirstRangeIndexPassingTest(self.entityRanges, ^BOOL(NSRange entityRange) {
+        return entityRange.location >= oldTokensEnd;
+    });
+
+    NSArray<NSValue *> *updatedRanges = [self entityRangesInText:text range:NSMakeRange(tokensStart, tokensEnd - tokensStart)];
+    [self.entityRanges replaceObjectsInRange:NSMakeRange(firstIndex, endIndex - firstIndex) withObjectsFromArray:updatedRanges];
+
+    if (newLength != oldLength) {
+        for (NSUInteger index = firstIndex + updatedRanges.count; index < self.entityRanges.count; index++) {
+            NSRange entityRange = self.entityRanges[index].rangeValue;
+            entityRange.location = entityRange.location + newLength - oldLength;
+            self.entityRanges[index] = [NSValue valueWithRange:entityRange];
+        }
+    }
+
+    self.text = text;
+}
+
+- (NSArray<NSValue *> *)entityRangesInText:(NSString *)text range:(NSRange)range
+{
+    if (range.length == 0) {
+        return @[];
+    }
+
+    NSArray<TwitterTextEntity *> *entities = [self.twitterText entitiesInText:[text substringWithRange:range]];
+    NSMutableArray<NSValue *> *ranges = [NSMutableArray arrayWithCapacity:entities.count];
+
+    for (TwitterTextEntity *entity in entities) {
+        NSRange entityRange = [(id)entity range];
+        entityRange.location += range.location;
+        [ranges addObject:[NSValue valueWithRange:entityRange]];
+    }
+
+    [ranges sortUsingComparator:^NSComparisonResult(NSValue *range1, NSValue *range2) {
+        const NSUInteger location1 = range1.rangeValue.location;
+        const NSUInteger location2 = range2.rangeValue.location;
+        return location1 < location2 ? NSOrderedAscending : (location1 > location2 ? NSOrderedDescending : NSOrderedSame);
+    }];
+
+    return ranges;
+}
+
+@end
@@ -96,6 +96,7 @@
 #import "TWTRBirdView.h"
 #import "TWTRSEAccount.h"
 #import "TWTRSEAccountSelectionTableViewController.h"
+#import "TWTRSEAutoCompletionIndex.h"
 #import "TWTRSEAutoCompletionTableViewController.h"
 #import "TWTRSEFonts.h"
 #import "TWTRSEFrameworkLazyLoading.h"
@@ -690,8 +691,10 @@ static void *TSETweetTextKVOCOntext = &TSETweetTextKVOCOntext;
     [self.view endEditing:YES];
     self.isSendingTweet = YES;
 
+    TWTRSETweet *tweet = [self.dataSource.composedTweet copy];
+
     __weak typeof(self) weakSelf = self;
-    [_configuration.networking sendTweet:[self.dataSource.composedTweet copy]
+    [_configuration.networking sendTweet:tweet
                              fromAccount:self.selectedAccount
                               completion:^(TWTRSENetworkingResult result) {
                                   dispatch_async(dispatch_get_main_queue(), ^{
@@ -706,6 +709,7 @@ static void *TSETweetTextKVOCOntext = &TSETweetTextKVOCOntext;
                                       switch (result) {
                                           case TWTRSENetworkingResultSuccess:
                                           case TWTRSENetworkingResultWillPostAsynchronously:
+                                              [[TWTRSEAutoCompletionIndex sharedIndex] recordUseOfEntitiesInText:tweet.text twitterText:[TWTRSETweet twitterText] date:[NSDate date]];
                                               [strongSelf.configuration.delegate shareViewControllerDidFinishSendingTweet];
                                               break;
                                           case TWTRSENetworkingResultError:
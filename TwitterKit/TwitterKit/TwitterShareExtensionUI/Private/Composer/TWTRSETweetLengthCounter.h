@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+@import Foundation;
+
+#import "TWTRSETweet.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Keeps the weighted length of a composer draft up to date as it is edited.
+
+ The text is split into segments made of a run of non-whitespace characters followed by its trailing whitespace.
+ URLs never span whitespace, so the segment weights add up to the length of the full text. An edit only re-weights the
+ segments around the changed range; the rest of the draft is not normalized or scanned for URLs again.
+
+ Note: This class is NOT thread-safe.
+ */
+@interface TWTRSETweetLengthCounter : NSObject
+
+@property (nonatomic, readonly) Class<TwitterTextProtocol> twitterText;
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithTwitterText:(Class<TwitterTextProtocol>)twitterText NS_DESIGNATED_INITIALIZER;
+
+/**
+ @return The remaining character count for `text`, as `+[TwitterTextProtocol remainingCharacterCount:]` would.
+ Asking repeatedly about the same text returns the cached result.
+ */
+- (NSInteger)remainingCharacterCountForText:(NSString *)text;
+
+@end
+
+NS_ASSUME_NONNULL_END
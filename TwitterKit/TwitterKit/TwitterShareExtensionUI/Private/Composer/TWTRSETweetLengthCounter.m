@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRSETweetLengthCounter.h"
+#import "TWTRSEStringDiff.h"
+
+@interface TWTRSETweetLengthSegment : NSObject
+
+/**
+ Length of the segment in UTF-16 code units, including its trailing whitespace.
+ */
+@property (nonatomic) NSUInteger length;
+@property (nonatomic) NSInteger weight;
+
+@end
+
+@implementation TWTRSETweetLengthSegment
+@end
+
+@interface TWTRSETweetLengthCounter ()
+
+@property (nonatomic, copy) NSString *text;
+@property (nonatomic, readonly) NSMutableArray<TWTRSETweetLengthSegment *> *segments;
+@property (nonatomic) NSInteger totalWeight;
+
+/**
+ The remaining character count of an empty tweet, i.e. the character limit.
+ */
+@property (nonatomic, readonly) NSInteger characterLimit;
+
+@end
+
+@implementation TWTRSETweetLengthCounter
+
+- (instancetype)initWithTwitterText:(Class<TwitterTextProtocol>)twitterText
+{
+    NSParameterAssert(twitterText);
+
+    if ((self = [super init])) {
+        _twitterText = twitterText;
+        _text = @"";
+        _segments = [NSMutableArray array];
+        _characterLimit = [twitterText remainingCharacterCount:@""];
+    }
+
+    return self;
+}
+
+- (NSInteger)remainingCharacterCountForText:(NSString *)text
+{
+    text = text ?: @"";
+
+    if (text != self.text && ![text isEqualToString:self.text]) {
+        [self updateWithText:text];
+    }
+
+    return self.characterLimit - self.totalWeight;
+}
+
+#pragma mark - Segments
+
+- (void)updateWithText:(NSString *)text
+{
+    NSString *oldText = self.text;
+    const NSUInteger oldLength = oldText.length;
+    const NSUInteger newLength = text.length;
+    const NSUInteger prefixLength = TWTRSEStringDiffCommonPrefixLength(oldText, text);
+    const NSUInteger suffixLength = TWTRSEStringDiffCommonSuffixLength(oldText, text, MIN(oldLength, newLength) - prefixLength);
+
+    // The character before the edit can join a token with inserted text, and so can the first unchanged character after it.
+    const NSUInteger editStart = prefixLength > 0 ? prefixLength - 1 : 0;
+    const NSUInteger editEnd = oldLength - suffixLength;
+
+    NSUInteger firstIndex = NSNotFound;
+    NSUInteger replacedCount = 0;
+    NSUInteger replacedLocation = 0;
+    NSUInteger replacedLength = 0;
+    NSInteger replacedWeight = 0;
+    NSUInteger location = 0;
+
+    for (NSUInteger index = 0; index < self.segments.count; index++) {
+        TWTRSETweetLengthSegment *segment = self.segments[index];
+        const NSUInteger segmentEnd = location + segment.length;
+
+        if (firstIndex == NSNotFound && editStart < segmentEnd) {
+            firstIndex = index;
+            replacedLocation = location;
+        }
+
+        if (firstIndex != NSNotFound) {
+            replacedCount++;
+            replacedLength += segment.length;
+            replacedWeight += segment.weight;
+
+            if (editEnd < segmentEnd) {
+                break;
+            }
+        }
+
+        location = segmentEnd;
+    }
+
+    if (firstIndex == NSNotFound) {
+        firstIndex = self.segments.count;
+        replacedLocation = location;
+    }
+
+    NSRange updatedRange = NSMakeRange(replacedLocation, replacedLength + newLength - oldLength);
+    NSArray<TWTRSETweetLengthSegment *> *updatedSegments = [self segmentsInText:text range:updatedRange];
+
+    NSInteger updatedWeight = 0;
+    for (TWTRSETweetLengthSegment *segment in updatedSegments) {
+        updatedWeight += segment.weight;
+    }
+
+    [self.segments replaceObjectsInRange:NSMakeRange(firstIndex, replacedCount) withObjectsFromArray:updatedSegments];
+    self.totalWeight += updatedWeight - replacedWeight;
+    self.text = text;
+}
+
+- (NSArray<TWTRSETweetLengthSegment *> *)segmentsInText:(NSString *)text range:(NSRange)range
+{
+    NSCharacterSet *whitespaceSet = [NSCharacterSet whitespaceAndNewlineCharacterSet];
+    NSMutableArray<TWTRSETweetLengthSegment *> *segments = [NSMutableArray array];
+    const NSUInteger end = NSMaxRange(range);
+    NSUInteger index = range.location;
+
+    while (index < end) {
+        const NSUInteger tokenStart = index;
+        while (index < end && ![whitespaceSet characterIsMember:[text characterAtIndex:index]]) {
+            index++;
+        }
+
+        const NSUInteger tokenEnd = index;
+        while (index < end && [whitespaceSet characterIsMember:[text characterAtIndex:index]]) {
+            index++;
+        }
+
+        TWTRSETweetLengthSegment *segment = [[TWTRSETweetLengthSegment alloc] init];
+        segment.length = index - tokenStart;
+        segment.weight = [self weightOfToken:[text substringWithRange:NSMakeRange(tokenStart, tokenEnd - tokenStart)]] + (NSInteger)(index - tokenEnd);
+        [segments addObject:segment];
+    }
+
+    return segments;
+}
+
+- (NSInteger)weightOfToken:(NSString *)token
+{
+    if (token.length == 0) {
+        return 0;
+    }
+
+    return self.characterLimit - [self.twitterText remainingCharacterCount:token];
+}
+
+@end
@@ -0,0 +1,29 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ @return The number of leading UTF-16 code units `string` and `otherString` have in common.
+ */
+FOUNDATION_EXTERN NSUInteger TWTRSEStringDiffCommonPrefixLength(NSString *_Nonnull string, NSString *_Nonnull otherString);
+
+/**
+ @return The number of trailing UTF-16 code units `string` and `otherString` have in common, up to `maxLength`.
+ Pass the lengths left over after the common prefix so the prefix and suffix never overlap.
+ */
+FOUNDATION_EXTERN NSUInteger TWTRSEStringDiffCommonSuffixLength(NSString *_Nonnull string, NSString *_Nonnull otherString, NSUInteger maxLength);
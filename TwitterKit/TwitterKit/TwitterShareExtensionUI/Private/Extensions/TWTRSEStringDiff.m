@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRSEStringDiff.h"
+
+NSUInteger TWTRSEStringDiffCommonPrefixLength(NSString *string, NSString *otherString)
+{
+    const NSUInteger maxLength = MIN(string.length, otherString.length);
+    NSUInteger length = 0;
+
+    while (length < maxLength && [string characterAtIndex:length] == [otherString characterAtIndex:length]) {
+        length++;
+    }
+
+    return length;
+}
+
+NSUInteger TWTRSEStringDiffCommonSuffixLength(NSString *string, NSString *otherString, NSUInteger maxLength)
+{
+    const NSUInteger stringLength = string.length;
+    const NSUInteger otherStringLength = otherString.length;
+    NSUInteger length = 0;
+
+    while (length < maxLength && [string characterAtIndex:stringLength - length - 1] == [otherString characterAtIndex:otherStringLength - length - 1]) {
+        length++;
+    }
+
+    return length;
+}
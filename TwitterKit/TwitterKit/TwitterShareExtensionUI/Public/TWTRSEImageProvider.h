@@ -31,6 +31,12 @@ typedef void (^TWTRSEImageFailureBlock)(NSError *);
 
 + (nullable TWTRSEImageProvider *)existingImageProviderForItemProvider:(NSItemProvider *)itemProvider;
 
+/**
+ Loads a preview of the image. When the item provider offers a file URL the image is decoded straight
+ to the size in `NSItemProviderPreferredImageSizeKey` (in points), so the full resolution original is
+ never held in memory. A previously loaded image is reused when it is at least as large as the
+ preferred size.
+ */
 - (void)loadWithOptions:(NSDictionary *)options success:(TWTRSEImageSuccessBlock)successBlock failure:(TWTRSEImageFailureBlock)failureBlock;
 
 + (void)reset;
@@ -18,8 +18,9 @@
 #import "TWTRSEImageProvider.h"
 #import "TWTRSETweetAttachment.h"
 
+@import ImageIO;
 @import MobileCoreServices;
-@import UIKit.UIImage;
+@import UIKit;
 
 typedef NS_ENUM(NSInteger, TWTRSEItemProviderLoadImageMode) {
     TWTRSEItemProviderLoadImageModeLoadImageClass = 0,
@@ -31,6 +32,11 @@ typedef NS_ENUM(NSInteger, TWTRSEItemProviderLoadImageMode) {
 @interface TWTRSEImageProvider ()
 @property (nonatomic) NSItemProvider *itemProvider;
 @property (nullable, nonatomic) UIImage *cachedImage;
+/**
+ The largest size, in pixels, `cachedImage` can be handed out for without being upscaled. Images the item
+ provider decoded itself are at full size and can be handed out for any size.
+ */
+@property (nonatomic) CGFloat cachedImageMaxPixelSize;
 @end
 
 static NSMapTable<NSItemProvider *, TWTRSEImageProvider *> *sProviders;
@@ -39,35 +45,84 @@ static NSMapTable<NSItemProvider *, TWTRSEImageProvider *> *sProviders;
 
 + (instancetype)imageProviderWithItemProvider:(NSItemProvider *)itemProvider
 {
-    TWTRSEImageProvider *imageProvider;
-    if (!sProviders) {
-        sProviders = [NSMapTable<NSItemProvider *, TWTRSEImageProvider *> weakToStrongObjectsMapTable];
-    } else {
-        imageProvider = [self existingImageProviderForItemProvider:itemProvider];
-    }
+    @synchronized(self)
+    {
+        if (!sProviders) {
+            sProviders = [NSMapTable<NSItemProvider *, TWTRSEImageProvider *> weakToStrongObjectsMapTable];
+        }
 
-    if (!imageProvider) {
-        imageProvider = [[self alloc] init];
-        imageProvider.itemProvider = itemProvider;
-        [sProviders setObject:imageProvider forKey:itemProvider];
-    }
+        TWTRSEImageProvider *imageProvider = [sProviders objectForKey:itemProvider];
+        if (!imageProvider) {
+            imageProvider = [[self alloc] init];
+            imageProvider.itemProvider = itemProvider;
+            [sProviders setObject:imageProvider forKey:itemProvider];
+        }
 
-    return imageProvider;
+        return imageProvider;
+    }
 }
 
 + (TWTRSEImageProvider *)existingImageProviderForItemProvider:(NSItemProvider *)itemProvider
 {
-    for (NSItemProvider *existingItemProvider in [sProviders keyEnumerator]) {
-        if ([existingItemProvider isEqual:itemProvider]) {
-            return [sProviders objectForKey:existingItemProvider];
-        }
+    @synchronized(self)
+    {
+        return [sProviders objectForKey:itemProvider];
     }
-    return nil;
 }
 
 + (void)reset
 {
-    [sProviders removeAllObjects];
+    @synchronized(self)
+    {
+        [sProviders removeAllObjects];
+    }
+}
+
+#pragma mark - ImageIO
+
++ (CGFloat)maxPixelSizeForOptions:(NSDictionary *)options
+{
+    NSValue *preferredSizeValue = options[NSItemProviderPreferredImageSizeKey];
+    CGSize preferredSize = [preferredSizeValue isKindOfClass:[NSValue class]] ? [preferredSizeValue CGSizeValue] : [UIScreen mainScreen].bounds.size;
+
+    return ceil(MAX(preferredSize.width, preferredSize.height) * [UIScreen mainScreen].scale);
+}
+
+/**
+ Decodes the image at `url` no larger than `maxPixelSize` on its longest side. ImageIO reads the file
+ incrementally and decodes straight to the target size, so memory use depends on `maxPixelSize` and
+ not on the resolution of the original.
+ */
++ (nullable CGImageRef)createDownsampledImageWithContentsOfURL:(NSURL *)url maxPixelSize:(CGFloat)maxPixelSize CF_RETURNS_RETAINED
+{
+    NSDictionary *sourceOptions = @{(NSString *)kCGImageSourceShouldCache: @NO};
+    CGImageSourceRef source = CGImageSourceCreateWithURL((__bridge CFURLRef)url, (__bridge CFDictionaryRef)sourceOptions);
+    if (!source) {
+        return NULL;
+    }
+
+    NSDictionary *thumbnailOptions = @{
+        (NSString *)kCGImageSourceCreateThumbnailFromImageAlways: @YES,
+        (NSString *)kCGImageSourceCreateThumbnailWithTransform: @YES,
+        (NSString *)kCGImageSourceShouldCacheImmediately: @YES,
+        (NSString *)kCGImageSourceThumbnailMaxPixelSize: @(maxPixelSize)
+    };
+    CGImageRef image = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)thumbnailOptions);
+    CFRelease(source);
+
+    return image;
+}
+
++ (nullable UIImage *)downsampledImageWithContentsOfURL:(NSURL *)url maxPixelSize:(CGFloat)maxPixelSize
+{
+    CGImageRef imageRef = [self createDownsampledImageWithContentsOfURL:url maxPixelSize:maxPixelSize];
+    if (!imageRef) {
+        return nil;
+    }
+
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:[UIScreen mainScreen].scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+    return image;
 }
 
 typedef void (^TWTRSEImageInternalFailureBlock)(NSError *_Nullable);
@@ -75,6 +130,7 @@ typedef void (^TWTRSEImageInternalFailureBlock)(NSError *_Nullable);
 - (void)_tseui_loadWithOptions:(NSDictionary *)options mode:(TWTRSEItemProviderLoadImageMode)mode success:(TWTRSEImageSuccessBlock)successBlock failure:(TWTRSEImageInternalFailureBlock)failureBlock
 {
     __weak typeof(self) weakSelf = self;
+    const CGFloat maxPixelSize = [TWTRSEImageProvider maxPixelSizeForOptions:options];
 
     switch (mode) {
         case TWTRSEItemProviderLoadImageModeLoadImageClass: {
@@ -83,7 +139,7 @@ typedef void (^TWTRSEImageInternalFailureBlock)(NSError *_Nullable);
                     [_itemProvider loadObjectOfClass:[UIImage class]
                                    completionHandler:^(UIImage *itemImage, NSError *error) {
                                        if (itemImage) {
-                                           weakSelf.cachedImage = itemImage;
+                                           [weakSelf cacheImage:itemImage maxPixelSize:CGFLOAT_MAX];
                                            successBlock(itemImage);
                                        } else {
                                            failureBlock(error);
@@ -104,11 +160,8 @@ typedef void (^TWTRSEImageInternalFailureBlock)(NSError *_Nullable);
                                    completionHandler:^(NSURL *url, NSError *error) {
                                        UIImage *imageFromDisk = nil;
                                        if (url.isFileURL) {
-                                           NSData *data = [NSData dataWithContentsOfURL:url];
-                                           if (data) {
-                                               imageFromDisk = [UIImage imageWithData:data];
-                                               weakSelf.cachedImage = imageFromDisk;
-                                           }
+                                           imageFromDisk = [TWTRSEImageProvider downsampledImageWithContentsOfURL:url maxPixelSize:maxPixelSize];
+                                           [weakSelf cacheImage:imageFromDisk maxPixelSize:maxPixelSize];
                                        }
 
                                        if (imageFromDisk) {
@@ -130,7 +183,7 @@ typedef void (^TWTRSEImageInternalFailureBlock)(NSError *_Nullable);
                                              options:options
                                    completionHandler:^(UIImage *itemImage, NSError *error) {
                                        if (itemImage) {
-                                           weakSelf.cachedImage = itemImage;
+                                           [weakSelf cacheImage:itemImage maxPixelSize:CGFLOAT_MAX];
                                            successBlock(itemImage);
                                        } else {
                                            failureBlock(error);
@@ -144,14 +197,11 @@ typedef void (^TWTRSEImageInternalFailureBlock)(NSError *_Nullable);
                                    completionHandler:^(NSURL *url, NSError *error) {
                                        UIImage *imageFromDisk = nil;
                                        if (url.isFileURL) {
-                                           NSData *data = [NSData dataWithContentsOfURL:url];
-                                           if (data) {
-                                               imageFromDisk = [UIImage imageWithData:data];
-                                           }
+                                           imageFromDisk = [TWTRSEImageProvider downsampledImageWithContentsOfURL:url maxPixelSize:maxPixelSize];
                                        }
 
                                        if (imageFromDisk) {
-                                           weakSelf.cachedImage = imageFromDisk;
+                                           [weakSelf cacheImage:imageFromDisk maxPixelSize:maxPixelSize];
                                            successBlock(imageFromDisk);
                                        } else {
                                            failureBlock(error);
@@ -167,26 +217,49 @@ typedef void (^TWTRSEImageInternalFailureBlock)(NSError *_Nullable);
     }
 }
 
+- (void)cacheImage:(UIImage *)image maxPixelSize:(CGFloat)maxPixelSize
+{
+    @synchronized(self)
+    {
+        // Keep whichever image can serve the larger sizes.
+        if (!_cachedImage || maxPixelSize >= _cachedImageMaxPixelSize) {
+            _cachedImage = image;
+            _cachedImageMaxPixelSize = maxPixelSize;
+        }
+    }
+}
+
+- (nullable UIImage *)cachedImageForMaxPixelSize:(CGFloat)maxPixelSize
+{
+    @synchronized(self)
+    {
+        return _cachedImageMaxPixelSize >= maxPixelSize ? _cachedImage : nil;
+    }
+}
+
 - (void)loadWithOptions:(NSDictionary *)options success:(TWTRSEImageSuccessBlock)successBlock failure:(TWTRSEImageFailureBlock)failureBlock
 {
-    if (_cachedImage) {
-        successBlock(_cachedImage);
+    UIImage *cachedImage = [self cachedImageForMaxPixelSize:[TWTRSEImageProvider maxPixelSizeForOptions:options]];
+    if (cachedImage) {
+        successBlock(cachedImage);
         return;
     }
 
+    // File URLs are tried first in each pair because they can be downsampled while decoding,
+    // whereas a UIImage handed over by the item provider has already been decoded at full size.
     void (^loadImageTypeBlock)(NSError *_Nullable) = ^(NSError *_Nullable loadObjectOfClassError) {
         [self _tseui_loadWithOptions:options
-            mode:TWTRSEItemProviderLoadImageModeLoadImageType
-            success:^(UIImage *_Nonnull typeLoadImage) {
-                successBlock(typeLoadImage);
+            mode:TWTRSEItemProviderLoadImageModeLoadFileURLType
+            success:^(UIImage *_Nonnull typeLoadFileURLImage) {
+                successBlock(typeLoadFileURLImage);
             }
-            failure:^(NSError *_Nullable loadImageTypeError) {
+            failure:^(NSError *_Nullable loadFileURLTypeError) {
                 [self _tseui_loadWithOptions:options
-                    mode:TWTRSEItemProviderLoadImageModeLoadFileURLType
-                    success:^(UIImage *_Nonnull typeLoadFileURLImage) {
-                        successBlock(typeLoadFileURLImage);
+                    mode:TWTRSEItemProviderLoadImageModeLoadImageType
+                    success:^(UIImage *_Nonnull typeLoadImage) {
+                        successBlock(typeLoadImage);
                     }
-                    failure:^(NSError *_Nullable loadFileURLTypeError) {
+                    failure:^(NSError *_Nullable loadImageTypeError) {
                         NSError *error = loadObjectOfClassError;
                         if (nil == error) {
                             if (loadImageTypeError && loadFileURLTypeError) {
@@ -208,17 +281,17 @@ typedef void (^TWTRSEImageInternalFailureBlock)(NSError *_Nullable);
 
     if (@available(iOS 11, *)) {
         [self _tseui_loadWithOptions:options
-            mode:TWTRSEItemProviderLoadImageModeLoadImageClass
-            success:^(UIImage *_Nonnull classLoadImage) {
-                successBlock(classLoadImage);
+            mode:TWTRSEItemProviderLoadImageModeLoadFileURLClass
+            success:^(UIImage *_Nonnull classLoadFileURLImage) {
+                successBlock(classLoadFileURLImage);
             }
-            failure:^(NSError *_Nullable loadImageClassError) {
+            failure:^(NSError *_Nullable loadFileURLClassError) {
                 [self _tseui_loadWithOptions:options
-                    mode:TWTRSEItemProviderLoadImageModeLoadFileURLClass
-                    success:^(UIImage *_Nonnull classLoadFileURLImage) {
-                        successBlock(classLoadFileURLImage);
+                    mode:TWTRSEItemProviderLoadImageModeLoadImageClass
+                    success:^(UIImage *_Nonnull classLoadImage) {
+                        successBlock(classLoadImage);
                     }
-                    failure:^(NSError *_Nullable loadFileURLClassError) {
+                    failure:^(NSError *_Nullable loadImageClassError) {
                         NSError *error;
                         if (loadImageClassError && loadFileURLClassError) {
                             NSDictionary *userInfo = @{@"loadImageClassError": [loadImageClassError localizedDescription], @"loadFileURLClassError": [loadFileURLClassError localizedDescription]};
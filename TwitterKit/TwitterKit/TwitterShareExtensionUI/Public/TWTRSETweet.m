@@ -18,9 +18,11 @@
 #import "TWTRSETweet.h"
 #import "TWTRSEAccount.h"
 #import "TWTRSETweetAttachment.h"
+#import "TWTRSETweetLengthCounter.h"
 
 @interface TWTRSETweet ()
 @property (nullable, nonatomic, readonly) NSString *textWithAttachmentURLs;
+@property (nullable, nonatomic) TWTRSETweetLengthCounter *lengthCounter;
 @end
 
 @implementation TWTRSETweet
@@ -80,17 +82,24 @@ static Class<TwitterTextProtocol> sTwitterTextClass;
 
 - (NSInteger)remainingCharacters
 {
-    return [[[self class] twitterText] remainingCharacterCount:self.textWithAttachmentURLs];
+    Class<TwitterTextProtocol> twitterText = [[self class] twitterText];
+
+    // The counter remembers the last text it measured, so the accessors below share one computation per edit.
+    if (self.lengthCounter.twitterText != twitterText) {
+        self.lengthCounter = [[TWTRSETweetLengthCounter alloc] initWithTwitterText:twitterText];
+    }
+
+    return [self.lengthCounter remainingCharacterCountForText:self.textWithAttachmentURLs];
 }
 
 - (BOOL)isWithinCharacterLimit
 {
-    return [[[self class] twitterText] remainingCharacterCount:self.textWithAttachmentURLs] >= 0;
+    return [self remainingCharacters] >= 0;
 }
 
 - (BOOL)isNearOrOverCharacterLimit
 {
-    return [[[self class] twitterText] remainingCharacterCount:self.textWithAttachmentURLs] < 20;
+    return [self remainingCharacters] < 20;
 }
 
 #pragma mark - NSCopying
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ This header is private to the Twitter Kit SDK and not exposed for public SDK consumption
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Environment variables read by the benchmark tests.
+ *
+ *  TWTR_BENCHMARK_OUTPUT     Path the JSON results are written to. The timeline benchmarks are skipped unless it is set.
+ *  TWTR_BENCHMARK_BASELINE   Path of results from an earlier run to compare against. No comparison is made without one.
+ *  TWTR_BENCHMARK_THRESHOLD  Fraction a stage may be slower than the baseline before it counts as a regression. Defaults to 0.2.
+ */
+FOUNDATION_EXTERN NSString *const TWTRBenchmarkOutputEnvironmentKey;
+FOUNDATION_EXTERN NSString *const TWTRBenchmarkBaselineEnvironmentKey;
+FOUNDATION_EXTERN NSString *const TWTRBenchmarkThresholdEnvironmentKey;
+
+/**
+ *  The cost of one benchmarked stage. Times are medians over the measured iterations; memory
+ *  figures are sampled around each iteration.
+ */
+@interface TWTRBenchmarkMeasurement : NSObject
+
+@property (nonatomic, copy, readonly) NSString *name;
+@property (nonatomic, readonly) NSUInteger iterations;
+
+/**
+ *  Median wall clock time of an iteration, in seconds.
+ */
+@property (nonatomic, readonly) NSTimeInterval wallTime;
+
+/**
+ *  Median CPU time of an iteration across every thread of the process, in seconds. Includes
+ *  work done on networking and parsing queues on behalf of the stage.
+ */
+@property (nonatomic, readonly) NSTimeInterval CPUTime;
+
+/**
+ *  Median growth of the malloc heap over an iteration, in allocated blocks and bytes. Memory
+ *  that is allocated and freed within the iteration is not counted.
+ */
+@property (nonatomic, readonly) NSInteger heapBlockGrowth;
+@property (nonatomic, readonly) NSInteger heapByteGrowth;
+
+/**
+ *  Largest physical memory footprint of the process sampled after any iteration, in bytes.
+ */
+@property (nonatomic, readonly) NSUInteger peakFootprint;
+
+- (NSDictionary<NSString *, NSNumber *> *)dictionaryRepresentation;
+
+@end
+
+/**
+ *  Runs benchmark stages and collects their measurements into machine-readable results that can
+ *  be compared against an earlier run.
+ */
+@interface TWTRBenchmarkRecorder : NSObject
+
+/**
+ *  The recorder shared by the benchmark tests of a test run.
+ */
++ (instancetype)sharedRecorder;
+
+/**
+ *  Fraction a stage may be slower than the baseline before it counts as a regression.
+ */
+@property (nonatomic) double regressionThreshold;
+
+/**
+ *  Where the results of this run should be written. Defaults to a file in the temporary directory.
+ */
+@property (nonatomic, copy) NSURL *resultsURL;
+
+/**
+ *  Results of an earlier run, as written by `writeResultsToURL:error:`.
+ */
+@property (nonatomic, copy, nullable) NSDictionary *baseline;
+
+/**
+ *  Every measurement recorded so far, keyed by stage name.
+ */
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, TWTRBenchmarkMeasurement *> *measurements;
+
+/**
+ *  Runs `block` once to warm up caches, then `iterations` more times while measuring it. A stage
+ *  measured again replaces its earlier measurement.
+ *
+ *  @param name       Name of the stage in the results.
+ *  @param iterations Number of measured runs.
+ *  @param block      The work of the stage. Must not return until the work is done.
+ */
+- (TWTRBenchmarkMeasurement *)measureStageNamed:(NSString *)name iterations:(NSUInteger)iterations block:(void (^)(void))block;
+
+/**
+ *  Returns a description of each way the measurement is slower than its baseline by more than
+ *  `regressionThreshold`, or an empty array when there is no baseline for the stage.
+ */
+- (NSArray<NSString *> *)regressionsOfMeasurement:(TWTRBenchmarkMeasurement *)measurement;
+
+/**
+ *  The recorded measurements along with the device they were recorded on.
+ */
+- (NSDictionary *)results;
+
+- (BOOL)writeResultsToURL:(NSURL *)URL error:(NSError **)error;
+
+/**
+ *  Sets the results URL, baseline and regression threshold from the TWTR_BENCHMARK_* environment
+ *  variables that are present.
+ */
+- (void)configureFromEnvironment:(NSDictionary<NSString *, NSString *> *)environment;
+
+@end
+
+NS_ASSUME_NONNULL_END
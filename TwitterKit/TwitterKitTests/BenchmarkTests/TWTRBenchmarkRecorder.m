@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import "TWTRBenchmarkRecorder.h"
+#import <TwitterCore/TWTRAssertionMacros.h>
+#import <UIKit/UIKit.h>
+#import <mach/mach.h>
+#import <malloc/malloc.h>
+#import <sys/resource.h>
+
+NSString *const TWTRBenchmarkOutputEnvironmentKey = @"TWTR_BENCHMARK_OUTPUT";
+NSString *const TWTRBenchmarkBaselineEnvironmentKey = @"TWTR_BENCHMARK_BASELINE";
+NSString *const TWTRBenchmarkThresholdEnvironmentKey = @"TWTR_BENCHMARK_THRESHOLD";
+
+static NSString *const TWTRBenchmarkResultsVersionKey = @"version";
+static NSString *const TWTRBenchmarkResultsDeviceKey = @"device";
+static NSString *const TWTRBenchmarkResultsStagesKey = @"stages";
+static NSInteger const TWTRBenchmarkResultsVersion = 1;
+
+static NSString *const TWTRBenchmarkIterationsKey = @"iterations";
+static NSString *const TWTRBenchmarkWallTimeKey = @"wallTime";
+static NSString *const TWTRBenchmarkCPUTimeKey = @"CPUTime";
+static NSString *const TWTRBenchmarkHeapBlockGrowthKey = @"heapBlockGrowth";
+static NSString *const TWTRBenchmarkHeapByteGrowthKey = @"heapByteGrowth";
+static NSString *const TWTRBenchmarkPeakFootprintKey = @"peakFootprint";
+
+static double const TWTRBenchmarkDefaultRegressionThreshold = 0.2;
+
+/**
+ *  Times below this are dominated by timer resolution and scheduling noise, so they are never
+ *  reported as regressions.
+ */
+static NSTimeInterval const TWTRBenchmarkMinimumComparableTime = 0.0005;
+
+static NSTimeInterval TWTRBenchmarkProcessCPUTime(void)
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+
+    NSTimeInterval userTime = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / (double)USEC_PER_SEC;
+    NSTimeInterval systemTime = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / (double)USEC_PER_SEC;
+    return userTime + systemTime;
+}
+
+static malloc_statistics_t TWTRBenchmarkHeapStatistics(void)
+{
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(NULL, &statistics);
+    return statistics;
+}
+
+static NSUInteger TWTRBenchmarkPhysicalFootprint(void)
+{
+    task_vm_info_data_t info;
+    mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+    if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return (NSUInteger)info.phys_footprint;
+}
+
+static NSNumber *TWTRBenchmarkMedian(NSArray<NSNumber *> *values)
+{
+    NSArray<NSNumber *> *sorted = [values sortedArrayUsingSelector:@selector(compare:)];
+    NSUInteger middle = sorted.count / 2;
+    if (sorted.count % 2 == 1) {
+        return sorted[middle];
+    }
+    return @(([sorted[middle - 1] doubleValue] + [sorted[middle] doubleValue]) / 2);
+}
+
+@interface TWTRBenchmarkMeasurement ()
+
+- (instancetype)initWithName:(NSString *)name iterations:(NSUInteger)iterations wallTime:(NSTimeInterval)wallTime CPUTime:(NSTimeInterval)CPUTime heapBlockGrowth:(NSInteger)heapBlockGrowth heapByteGrowth:(NSInteger)heapByteGrowth peakFootprint:(NSUInteger)peakFootprint;
+
+@end
+
+@implementation TWTRBenchmarkMeasurement
+
+- (instancetype)initWithName:(NSString *)name iterations:(NSUInteger)iterations wallTime:(NSTimeInterval)wallTime CPUTime:(NSTimeInterval)CPUTime heapBlockGrowth:(NSInteger)heapBlockGrowth heapByteGrowth:(NSInteger)heapByteGrowth peakFootprint:(NSUInteger)peakFootprint
+{
+    self = [super init];
+    if (self) {
+        _name = [name copy];
+        _iterations = iterations;
+        _wallTime = wallTime;
+        _CPUTime = CPUTime;
+        _heapBlockGrowth = heapBlockGrowth;
+        _heapByteGrowth = heapByteGrowth;
+        _peakFootprint = peakFootprint;
+    }
+    return self;
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)dictionaryRepresentation
+{
+    return @{
+        TWTRBenchmarkIterationsKey: @(self.iterations),
+        TWTRBenchmarkWallTimeKey: @(self.wallTime),
+        TWTRBenchmarkCPUTimeKey: @(self.CPUTime),
+        TWTRBenchmarkHeapBlockGrowthKey: @(self.heapBlockGrowth),
+        TWTRBenchmarkHeapByteGrowthKey: @(self.heapByteGrowth),
+        TWTRBenchmarkPeakFootprintKey: @(self.peakFootprint),
+    };
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p; name = %@; wallTime = %.3fms; CPUTime = %.3fms; heapByteGrowth = %ld; peakFootprint = %lu>", [self class], self, self.name, self.wallTime * 1000, self.CPUTime * 1000, (long)self.heapByteGrowth, (unsigned long)self.peakFootprint];
+}
+
+@end
+
+@interface TWTRBenchmarkRecorder ()
+
+@property (nonatomic, readonly) NSMutableDictionary<NSString *, TWTRBenchmarkMeasurement *> *mutableMeasurements;
+
+@end
+
+@implementation TWTRBenchmarkRecorder
+
++ (instancetype)sharedRecorder
+{
+    static TWTRBenchmarkRecorder *sharedRecorder;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedRecorder = [[TWTRBenchmarkRecorder alloc] init];
+    });
+
+    return sharedRecorder;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _regressionThreshold = TWTRBenchmarkDefaultRegressionThreshold;
+        _resultsURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:@"TWTRBenchmarkResults.json"]];
+        _mutableMeasurements = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSDictionary<NSString *, TWTRBenchmarkMeasurement *> *)measurements
+{
+    @synchronized(self)
+    {
+        return [self.mutableMeasurements copy];
+    }
+}
+
+#pragma mark - Measuring
+
+- (TWTRBenchmarkMeasurement *)measureStageNamed:(NSString *)name iterations:(NSUInteger)iterations block:(void (^)(void))block
+{
+    TWTRParameterAssertOrReturnValue(name, nil);
+    TWTRParameterAssertOrReturnValue(iterations > 0, nil);
+    TWTRParameterAssertOrReturnValue(block, nil);
+
+    // Warm up so one-time setup such as lazily built caches is not attributed to the stage
+    @autoreleasepool {
+        block();
+    }
+
+    NSMutableArray<NSNumber *> *wallTimes = [NSMutableArray arrayWithCapacity:iterations];
+    NSMutableArray<NSNumber *> *CPUTimes = [NSMutableArray arrayWithCapacity:iterations];
+    NSMutableArray<NSNumber *> *blockGrowths = [NSMutableArray arrayWithCapacity:iterations];
+    NSMutableArray<NSNumber *> *byteGrowths = [NSMutableArray arrayWithCapacity:iterations];
+    NSUInteger peakFootprint = 0;
+
+    for (NSUInteger i = 0; i < iterations; i++) {
+        malloc_statistics_t heapBefore = TWTRBenchmarkHeapStatistics();
+        NSTimeInterval CPUTimeBefore = TWTRBenchmarkProcessCPUTime();
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+
+        @autoreleasepool {
+            block();
+        }
+
+        CFAbsoluteTime end = CFAbsoluteTimeGetCurrent();
+        NSTimeInterval CPUTimeAfter = TWTRBenchmarkProcessCPUTime();
+        malloc_statistics_t heapAfter = TWTRBenchmarkHeapStatistics();
+
+        [wallTimes addObject:@(end - start)];
+        [CPUTimes addObject:@(CPUTimeAfter - CPUTimeBefore)];
+        [blockGrowths addObject:@((NSInteger)heapAfter.blocks_in_use - (NSInteger)heapBefore.blocks_in_use)];
+        [byteGrowths addObject:@((NSInteger)heapAfter.size_in_use - (NSInteger)heapBefore.size_in_use)];
+        peakFootprint = MAX(peakFootprint, TWTRBenchmarkPhysicalFootprint());
+    }
+
+    TWTRBenchmarkMeasurement *measurement = [[TWTRBenchmarkMeasurement alloc] initWithName:name iterations:iterations wallTime:[TWTRBenchmarkMedian(wallTimes) doubleValue] CPUTime:[TWTRBenchmarkMedian(CPUTimes) doubleValue] heapBlockGrowth:[TWTRBenchmarkMedian(blockGrowths) integerValue] heapByteGrowth:[TWTRBenchmarkMedian(byteGrowths) integerValue] peakFootprint:peakFootprint];
+
+    @synchronized(self)
+    {
+        self.mutableMeasurements[name] = measurement;
+    }
+
+    return measurement;
+}
+
+#pragma mark - Comparing
+
+- (NSArray<NSString *> *)regressionsOfMeasurement:(TWTRBenchmarkMeasurement *)measurement
+{
+    TWTRParameterAssertOrReturnValue(measurement, @[]);
+
+    NSDictionary *baselineStage = self.baseline[TWTRBenchmarkResultsStagesKey][measurement.name];
+    if (![baselineStage isKindOfClass:[NSDictionary class]]) {
+        return @[];
+    }
+
+    NSMutableArray<NSString *> *regressions = [NSMutableArray array];
+    NSDictionary<NSString *, NSNumber *> *current = [measurement dictionaryRepresentation];
+    for (NSString *key in @[TWTRBenchmarkWallTimeKey, TWTRBenchmarkCPUTimeKey]) {
+        double baselineValue = [baselineStage[key] doubleValue];
+        double currentValue = [current[key] doubleValue];
+        if (currentValue < TWTRBenchmarkMinimumComparableTime) {
+            continue;
+        }
+
+        if (currentValue > baselineValue * (1 + self.regressionThreshold)) {
+            [regressions addObject:[NSString stringWithFormat:@"%@ %@ regressed from %.3fms to %.3fms", measurement.name, key, baselineValue * 1000, currentValue * 1000]];
+        }
+    }
+
+    return regressions;
+}
+
+#pragma mark - Results
+
+- (NSDictionary *)results
+{
+    NSMutableDictionary *stages = [NSMutableDictionary dictionary];
+    [self.measurements enumerateKeysAndObjectsUsingBlock:^(NSString *name, TWTRBenchmarkMeasurement *measurement, BOOL *stop) {
+        stages[name] = [measurement dictionaryRepresentation];
+    }];
+
+    UIDevice *device = [UIDevice currentDevice];
+    return @{
+        TWTRBenchmarkResultsVersionKey: @(TWTRBenchmarkResultsVersion),
+        TWTRBenchmarkResultsDeviceKey: @{@"model": device.model, @"systemVersion": device.systemVersion},
+        TWTRBenchmarkResultsStagesKey: stages,
+    };
+}
+
+- (BOOL)writeResultsToURL:(NSURL *)URL error:(NSError **)error
+{
+    TWTRParameterAssertOrReturnValue(URL, NO);
+
+    NSData *data = [NSJSONSerialization dataWithJSONObject:[self results] options:NSJSONWritingPrettyPrinted error:error];
+    if (!data) {
+        return NO;
+    }
+
+    return [data writeToURL:URL options:NSDataWritingAtomic error:error];
+}
+
+- (void)configureFromEnvironment:(NSDictionary<NSString *, NSString *> *)environment
+{
+    NSString *threshold = environment[TWTRBenchmarkThresholdEnvironmentKey];
+    if (threshold.length > 0) {
+        self.regressionThreshold = [threshold doubleValue];
+    }
+
+    NSString *baselinePath = environment[TWTRBenchmarkBaselineEnvironmentKey];
+    if (baselinePath.length > 0) {
+        NSData *data = [NSData dataWithContentsOfFile:baselinePath];
+        id baseline = data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:nil] : nil;
+        if ([baseline isKindOfClass:[NSDictionary class]] && [baseline[TWTRBenchmarkResultsVersionKey] integerValue] == TWTRBenchmarkResultsVersion) {
+            self.baseline = baseline;
+        } else {
+            NSLog(@"[TwitterKit] Ignoring unreadable benchmark baseline at %@", baselinePath);
+        }
+    }
+
+    NSString *outputPath = environment[TWTRBenchmarkOutputEnvironmentKey];
+    if (outputPath.length > 0) {
+        self.resultsURL = [NSURL fileURLWithPath:outputPath];
+    }
+}
+
+@end
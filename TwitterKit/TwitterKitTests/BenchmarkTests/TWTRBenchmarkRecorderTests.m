@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+#import "TWTRBenchmarkRecorder.h"
+
+@interface TWTRBenchmarkRecorderTests : XCTestCase
+
+@property (nonatomic) TWTRBenchmarkRecorder *recorder;
+@property (nonatomic) NSURL *resultsURL;
+
+@end
+
+@implementation TWTRBenchmarkRecorderTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.recorder = [[TWTRBenchmarkRecorder alloc] init];
+    self.resultsURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:@"TWTRBenchmarkRecorderTests.json"]];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtURL:self.resultsURL error:nil];
+    [super tearDown];
+}
+
+- (NSDictionary *)baselineWithStageNamed:(NSString *)name wallTime:(NSTimeInterval)wallTime
+{
+    return @{@"version": @1, @"stages": @{name: @{@"wallTime": @(wallTime), @"CPUTime": @10}}};
+}
+
+- (void)testMeasureStage_warmsUpBeforeMeasuring
+{
+    __block NSUInteger runs = 0;
+    TWTRBenchmarkMeasurement *measurement = [self.recorder measureStageNamed:@"stage" iterations:3 block:^{
+        runs++;
+    }];
+
+    XCTAssertEqual(runs, 4);
+    XCTAssertEqual(measurement.iterations, 3);
+    XCTAssertEqualObjects(self.recorder.measurements[@"stage"], measurement);
+}
+
+- (void)testMeasureStage_recordsMedianWallTime
+{
+    TWTRBenchmarkMeasurement *measurement = [self.recorder measureStageNamed:@"sleep" iterations:3 block:^{
+        [NSThread sleepForTimeInterval:0.01];
+    }];
+
+    XCTAssertGreaterThanOrEqual(measurement.wallTime, 0.01);
+    XCTAssertGreaterThan(measurement.peakFootprint, 0);
+}
+
+- (void)testRegressions_noneWithoutBaseline
+{
+    TWTRBenchmarkMeasurement *measurement = [self.recorder measureStageNamed:@"sleep" iterations:1 block:^{
+        [NSThread sleepForTimeInterval:0.01];
+    }];
+
+    XCTAssertEqualObjects([self.recorder regressionsOfMeasurement:measurement], @[]);
+}
+
+- (void)testRegressions_reportsSlowerThanThreshold
+{
+    self.recorder.baseline = [self baselineWithStageNamed:@"sleep" wallTime:0.001];
+    TWTRBenchmarkMeasurement *measurement = [self.recorder measureStageNamed:@"sleep" iterations:1 block:^{
+        [NSThread sleepForTimeInterval:0.01];
+    }];
+
+    NSArray<NSString *> *regressions = [self.recorder regressionsOfMeasurement:measurement];
+
+    XCTAssertEqual(regressions.count, 1);
+    XCTAssertTrue([regressions.firstObject containsString:@"wallTime"]);
+}
+
+- (void)testRegressions_noneWithinThreshold
+{
+    self.recorder.baseline = [self baselineWithStageNamed:@"sleep" wallTime:10];
+    TWTRBenchmarkMeasurement *measurement = [self.recorder measureStageNamed:@"sleep" iterations:1 block:^{
+        [NSThread sleepForTimeInterval:0.01];
+    }];
+
+    XCTAssertEqualObjects([self.recorder regressionsOfMeasurement:measurement], @[]);
+}
+
+- (void)testWriteResults_writesEachStageAsJSON
+{
+    [self.recorder measureStageNamed:@"stage" iterations:1 block:^{
+    }];
+
+    NSError *error;
+    XCTAssertTrue([self.recorder writeResultsToURL:self.resultsURL error:&error]);
+
+    NSDictionary *results = [NSJSONSerialization JSONObjectWithData:[NSData dataWithContentsOfURL:self.resultsURL] options:0 error:nil];
+    XCTAssertEqualObjects(results[@"version"], @1);
+    XCTAssertEqualObjects(results[@"stages"][@"stage"][@"iterations"], @1);
+    XCTAssertNotNil(results[@"stages"][@"stage"][@"CPUTime"]);
+}
+
+- (void)testConfigureFromEnvironment_readsBaselineAndThreshold
+{
+    NSData *baseline = [NSJSONSerialization dataWithJSONObject:[self baselineWithStageNamed:@"stage" wallTime:1] options:0 error:nil];
+    [baseline writeToURL:self.resultsURL atomically:YES];
+
+    [self.recorder configureFromEnvironment:@{TWTRBenchmarkBaselineEnvironmentKey: self.resultsURL.path, TWTRBenchmarkThresholdEnvironmentKey: @"0.5", TWTRBenchmarkOutputEnvironmentKey: @"/tmp/results.json"}];
+
+    XCTAssertEqualObjects(self.recorder.baseline[@"stages"][@"stage"][@"wallTime"], @1);
+    XCTAssertEqualWithAccuracy(self.recorder.regressionThreshold, 0.5, 0.0001);
+    XCTAssertEqualObjects(self.recorder.resultsURL.path, @"/tmp/results.json");
+}
+
+- (void)testConfigureFromEnvironment_keepsDefaultsWhenUnset
+{
+    NSURL *defaultResultsURL = self.recorder.resultsURL;
+
+    [self.recorder configureFromEnvironment:@{}];
+
+    XCTAssertNil(self.recorder.baseline);
+    XCTAssertEqualWithAccuracy(self.recorder.regressionThreshold, 0.2, 0.0001);
+    XCTAssertEqualObjects(self.recorder.resultsURL, defaultResultsURL);
+}
+
+@end
@@ -0,0 +1,312 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <OCMock/OCMock.h>
+#import <TwitterCore/TWTRAPINetworkErrorsShim.h>
+#import <TwitterCore/TWTRAuthenticationConstants.h>
+#import <TwitterCore/TWTRGCOAuth.h>
+#import <TwitterCore/TWTRMemoryPressureCoordinator.h>
+#import <TwitterCore/TWTRNetworkingPipeline.h>
+#import <TwitterCore/TWTRSession.h>
+#import "TWTRAPIClient_Private.h"
+#import "TWTRAPIConstantsStatus.h"
+#import "TWTRBenchmarkRecorder.h"
+#import "TWTRFixtureLoader.h"
+#import "TWTRMockURLSessionProtocol.h"
+#import "TWTRPersistentStore.h"
+#import "TWTRStubTwitterClient.h"
+#import "TWTRTestCase.h"
+#import "TWTRTestSessionStore.h"
+#import "TWTRTimelineFilter.h"
+#import "TWTRTimelineFilterManager.h"
+#import "TWTRTweet.h"
+#import "TWTRTweetView.h"
+#import "TWTRTweetViewSizeCalculator.h"
+
+static const NSUInteger TWTRBenchmarkStageIterations = 10;
+static const NSUInteger TWTRBenchmarkLoadIterations = 5;
+
+/**
+ *  Network conditions timeline loads are replayed under: a round trip and bandwidth typical of a
+ *  phone on a cellular network.
+ */
+static const NSTimeInterval TWTRBenchmarkLatency = 0.05;
+static const NSUInteger TWTRBenchmarkBandwidth = 1024 * 1024;
+
+static const NSUInteger TWTRBenchmarkPersistentStoreSize = 8 * 1024 * 1024;
+static const CGFloat TWTRBenchmarkTimelineWidth = 375;
+
+/**
+ *  Offline benchmarks of the request and render paths, replaying recorded fixtures. They only run
+ *  when TWTR_BENCHMARK_OUTPUT is set. Results are written as JSON when the suite finishes and
+ *  compared against a baseline when one is given; see TWTRBenchmarkRecorder.h for the environment
+ *  variables.
+ */
+@interface TWTRTimelineBenchmarkTests : TWTRTestCase
+
+@property (nonatomic) TWTRBenchmarkRecorder *recorder;
+@property (nonatomic) id mockAPIClient;
+@property (nonatomic) TWTRAPIClient *APIClient;
+@property (nonatomic, copy) NSArray *userTimelineJSON;
+@property (nonatomic, copy) NSArray<TWTRTweet *> *userTimelineTweets;
+
+@end
+
+@implementation TWTRTimelineBenchmarkTests
+
++ (XCTestSuite *)defaultTestSuite
+{
+    // The benchmarks take a while and overwrite the results, so regular test runs skip them
+    if ([NSProcessInfo processInfo].environment[TWTRBenchmarkOutputEnvironmentKey] == nil) {
+        return [XCTestSuite testSuiteWithName:NSStringFromClass(self)];
+    }
+
+    return [super defaultTestSuite];
+}
+
++ (void)setUp
+{
+    [super setUp];
+    [[TWTRBenchmarkRecorder sharedRecorder] configureFromEnvironment:[NSProcessInfo processInfo].environment];
+}
+
++ (void)tearDown
+{
+    TWTRBenchmarkRecorder *recorder = [TWTRBenchmarkRecorder sharedRecorder];
+
+    NSError *error;
+    if ([recorder writeResultsToURL:recorder.resultsURL error:&error]) {
+        NSLog(@"[TwitterKit] Wrote benchmark results to %@", recorder.resultsURL.path);
+    } else {
+        NSLog(@"[TwitterKit] Could not write benchmark results: %@", error);
+    }
+
+    [super tearDown];
+}
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.recorder = [TWTRBenchmarkRecorder sharedRecorder];
+    self.userTimelineJSON = [NSJSONSerialization JSONObjectWithData:[TWTRFixtureLoader jackUserTimelineData] options:0 error:nil];
+    self.userTimelineTweets = [TWTRTweet tweetsWithJSONArray:self.userTimelineJSON];
+
+    // Requests go through the real pipeline, validator and parsers; only the transport is replaced
+    NSURLSession *URLSession = [TWTRAPIClient URLSessionForMockingWithProtocolClasses:@[[TWTRMockURLSessionProtocol class]]];
+    TWTRNetworkingPipeline *pipeline = [[TWTRNetworkingPipeline alloc] initWithURLSession:URLSession responseValidator:[[TWTRAPIResponseValidator alloc] init]];
+    self.mockAPIClient = OCMClassMock([TWTRAPIClient class]);
+    OCMStub([self.mockAPIClient networkingPipeline]).andReturn(pipeline);
+
+    TWTRSession *session = [[TWTRSession alloc] initWithSessionDictionary:@{TWTRAuthOAuthTokenKey: @"token", TWTRAuthOAuthSecretKey: @"secret", TWTRAuthAppOAuthScreenNameKey: @"jack", TWTRAuthAppOAuthUserIDKey: @"12"}];
+    TWTRTestSessionStore *sessionStore = [[TWTRTestSessionStore alloc] initWithUserSessions:@[session] guestSession:nil];
+    self.APIClient = [[TWTRAPIClient alloc] initWithSessionStore:sessionStore userID:@"12"];
+
+    [TWTRMockURLSessionProtocol setLatency:TWTRBenchmarkLatency];
+    [TWTRMockURLSessionProtocol setBandwidth:TWTRBenchmarkBandwidth];
+}
+
+- (void)tearDown
+{
+    [TWTRMockURLSessionProtocol resetNetworkConditions];
+    XCTAssertTrue([TWTRMockURLSessionProtocol isEmpty]);
+    [self.mockAPIClient stopMocking];
+
+    [super tearDown];
+}
+
+/**
+ *  Measures the stage and fails if it regressed against the baseline.
+ */
+- (TWTRBenchmarkMeasurement *)measureStageNamed:(NSString *)name iterations:(NSUInteger)iterations block:(void (^)(void))block
+{
+    TWTRBenchmarkMeasurement *measurement = [self.recorder measureStageNamed:name iterations:iterations block:block];
+    NSLog(@"[TwitterKit] %@", measurement);
+
+    for (NSString *regression in [self.recorder regressionsOfMeasurement:measurement]) {
+        XCTFail(@"%@", regression);
+    }
+
+    return measurement;
+}
+
+/**
+ *  Replays the fixture for the next request and waits until the load completes.
+ */
+- (void)replayFixtureData:(NSData *)data whileLoading:(void (^)(dispatch_block_t completion))load
+{
+    [TWTRMockURLSessionProtocol pushResponse:[TWTRMockURLResponse responseWithData:data]];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Load completed"];
+    load(^{
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+}
+
+#pragma mark - Parsing
+
+- (void)testBenchmark_decodeUserTimelineJSON
+{
+    NSData *data = [TWTRFixtureLoader jackUserTimelineData];
+
+    [self measureStageNamed:@"decode.userTimeline" iterations:TWTRBenchmarkStageIterations block:^{
+        [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+    }];
+}
+
+- (void)testBenchmark_parseUserTimelineTweets
+{
+    NSArray *JSON = self.userTimelineJSON;
+
+    [self measureStageNamed:@"parse.userTimeline" iterations:TWTRBenchmarkStageIterations block:^{
+        [TWTRTweet tweetsWithJSONArray:JSON];
+    }];
+}
+
+- (void)testBenchmark_parseSearchTweets
+{
+    NSDictionary *JSON = [NSJSONSerialization JSONObjectWithData:[TWTRFixtureLoader blackLivesMatterSearchResultData] options:0 error:nil];
+
+    [self measureStageNamed:@"parse.search" iterations:TWTRBenchmarkStageIterations block:^{
+        [TWTRTweet tweetsWithJSONArray:JSON[@"statuses"]];
+    }];
+}
+
+#pragma mark - Filtering
+
+- (void)testBenchmark_filterUserTimeline
+{
+    TWTRTimelineFilter *filter = [[TWTRTimelineFilter alloc] initWithJSONDictionary:[TWTRFixtureLoader dictFromJSONFile:@"sample_timeline_filter"]];
+    TWTRTimelineFilterManager *filterManager = [[TWTRTimelineFilterManager alloc] initWithFilters:filter];
+    NSArray<TWTRTweet *> *tweets = self.userTimelineTweets;
+
+    [self measureStageNamed:@"filter.userTimeline" iterations:TWTRBenchmarkStageIterations block:^{
+        [filterManager filterTweets:tweets];
+    }];
+}
+
+#pragma mark - Signing
+
+- (void)testBenchmark_signRequests
+{
+    NSDictionary *parameters = @{@"screen_name": @"jack", @"count": @"50", @"tweet_mode": @"extended", @"include_cards": @"true"};
+
+    [self measureStageNamed:@"sign.oauth" iterations:TWTRBenchmarkStageIterations block:^{
+        for (NSUInteger i = 0; i < 100; i++) {
+            [TWTRGCOAuth URLRequestForPath:@"/1.1/statuses/user_timeline.json" GETParameters:parameters scheme:@"https" host:@"api.twitter.com" consumerKey:@"consumer" consumerSecret:@"secret" accessToken:@"token" tokenSecret:@"secret"];
+        }
+    }];
+}
+
+#pragma mark - Persistence
+
+- (void)testBenchmark_persistentStoreWriteAndRead
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"TWTRTimelineBenchmarkTests"];
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+    TWTRPersistentStore *store = [[TWTRPersistentStore alloc] initWithPath:path maxSize:TWTRBenchmarkPersistentStoreSize];
+    NSArray<TWTRTweet *> *tweets = self.userTimelineTweets;
+
+    [self measureStageNamed:@"persistentStore.userTimeline" iterations:TWTRBenchmarkStageIterations block:^{
+        for (TWTRTweet *tweet in tweets) {
+            [store setObject:tweet forKey:tweet.tweetID];
+        }
+        for (TWTRTweet *tweet in tweets) {
+            [store objectForKey:tweet.tweetID];
+        }
+    }];
+
+    [store removeAllObjects];
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+}
+
+#pragma mark - Layout
+
+- (void)testBenchmark_heightsOfUserTimeline
+{
+    NSArray<TWTRTweet *> *tweets = self.userTimelineTweets;
+
+    [self measureStageNamed:@"height.userTimeline.cold" iterations:TWTRBenchmarkStageIterations block:^{
+        // Empties the height and typesetter caches so every height is calculated from scratch
+        [[TWTRMemoryPressureCoordinator sharedCoordinator] trimToBudget:0];
+        for (TWTRTweet *tweet in tweets) {
+            [TWTRTweetViewSizeCalculator heightForTweet:tweet style:TWTRTweetViewStyleCompact fittingWidth:TWTRBenchmarkTimelineWidth showingActions:YES];
+        }
+    }];
+
+    [self measureStageNamed:@"height.userTimeline.cached" iterations:TWTRBenchmarkStageIterations block:^{
+        for (TWTRTweet *tweet in tweets) {
+            [TWTRTweetViewSizeCalculator heightForTweet:tweet style:TWTRTweetViewStyleCompact fittingWidth:TWTRBenchmarkTimelineWidth showingActions:YES];
+        }
+    }];
+}
+
+#pragma mark - End to End
+
+- (void)testBenchmark_loadUserTimeline
+{
+    NSData *data = [TWTRFixtureLoader jackUserTimelineData];
+    __block NSUInteger tweetCount = 0;
+
+    [self measureStageNamed:@"load.userTimeline" iterations:TWTRBenchmarkLoadIterations block:^{
+        [self replayFixtureData:data whileLoading:^(dispatch_block_t completion) {
+            [self.APIClient loadTweetsForUserTimeline:@"jack" userID:nil parameters:nil timelineFilterManager:nil completion:^(NSArray *tweets, TWTRTimelineCursor *cursor, NSError *error) {
+                tweetCount = tweets.count;
+                completion();
+            }];
+        }];
+    }];
+
+    XCTAssertEqual(tweetCount, self.userTimelineTweets.count);
+}
+
+- (void)testBenchmark_loadSearchTimeline
+{
+    NSData *data = [TWTRFixtureLoader blackLivesMatterSearchResultData];
+    __block NSUInteger tweetCount = 0;
+
+    [self measureStageNamed:@"load.search" iterations:TWTRBenchmarkLoadIterations block:^{
+        [self replayFixtureData:data whileLoading:^(dispatch_block_t completion) {
+            [self.APIClient loadTweetsForSearchQuery:@"#BlackLivesMatter" parameters:nil timelineFilterManager:nil completion:^(NSArray *tweets, TWTRTimelineCursor *cursor, NSError *error) {
+                tweetCount = tweets.count;
+                completion();
+            }];
+        }];
+    }];
+
+    XCTAssertGreaterThan(tweetCount, 0);
+}
+
+- (void)testBenchmark_loadStatusesLookup
+{
+    NSData *data = [TWTRFixtureLoader manyTweetsData];
+    __block NSUInteger tweetCount = 0;
+
+    [self measureStageNamed:@"load.statusesLookup" iterations:TWTRBenchmarkLoadIterations block:^{
+        [self replayFixtureData:data whileLoading:^(dispatch_block_t completion) {
+            [self.APIClient loadJSONArrayFromAPIPath:TWTRAPIConstantsStatusLookUpURL parameters:@{@"id": @"1,2,3"} completion:^(NSURLResponse *response, id responseObject, NSError *error) {
+                tweetCount = [TWTRTweet tweetsWithJSONArray:responseObject].count;
+                completion();
+            }];
+        }];
+    }];
+
+    XCTAssertGreaterThan(tweetCount, 0);
+}
+
+@end
@@ -19,6 +19,8 @@
 #import "TWTRTableViewProxy.h"
 #import "TWTRTestCase.h"
 
+static const NSUInteger TWTRBenchmarkIterations = 10000;
+
 @interface TWTRTableViewProxyTests : TWTRTestCase
 
 @property (nonatomic, readonly) id mockTableView;
@@ -63,4 +65,40 @@
     OCMVerifyAll(self.mockTableView);
 }
 
+- (void)testProxiesOnceEnabledAfterInit
+{
+    TWTRTableViewProxy *proxy = self.proxy;
+    [self.proxy reloadData];
+    proxy.enabled = YES;
+
+    [[self.mockTableView reject] reloadData];
+    [self.proxy reloadData];
+    OCMVerifyAll(self.mockTableView);
+}
+
+- (void)testForwardsUnregisteredSelectorsWithReturnValues
+{
+    TWTRTableViewProxy *proxy = self.proxy;
+    proxy.enabled = YES;
+    OCMStub([self.mockTableView numberOfSections]).andReturn(3);
+
+    XCTAssertEqual([self.proxy numberOfSections], 3);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testPerformance_passThroughMessages
+{
+    UITableView *tableView = [[UITableView alloc] init];
+    TWTRTableViewProxy *proxy = [[TWTRTableViewProxy alloc] initWithTableView:tableView selectorsToProxy:@[@"reloadData"]];
+    proxy.enabled = YES;
+    NSIndexPath *indexPath = [NSIndexPath indexPathForRow:0 inSection:0];
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < TWTRBenchmarkIterations; i++) {
+            [(UITableView *)proxy cellForRowAtIndexPath:indexPath];
+        }
+    }];
+}
+
 @end
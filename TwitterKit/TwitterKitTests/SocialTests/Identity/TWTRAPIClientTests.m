@@ -582,6 +582,14 @@
     XCTAssertEqualObjects(self.tweetActionStub.sentRequest.HTTPMethod, @"POST");
 }
 
+- (void)testLikeTweet_sendsInteractivePriority
+{
+    [self.tweetActionStub likeTweetWithID:@"1234"
+                               completion:^(TWTRTweet *tweet, NSError *error){
+                               }];
+    XCTAssertEqualObjects(self.tweetActionStub.sentRequestPriorities.lastObject, @(TWTRNetworkingPipelinePriorityInteractive));
+}
+
 - (void)testUnlikeTweet_requestsProperURL
 {
     [self.tweetActionStub unlikeTweetWithID:@"1234"
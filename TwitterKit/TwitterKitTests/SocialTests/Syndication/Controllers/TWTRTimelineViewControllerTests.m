@@ -16,6 +16,7 @@
  */
 
 #import <OCMock/OCMock.h>
+#import <TwitterCore/TWTRNetworkingPipeline.h>
 #import <UIKit/UIKit.h>
 #import "TWTRFixtureLoader.h"
 #import "TWTRKit.h"
@@ -33,6 +34,8 @@
 #import "TWTRTweetView.h"
 #import "TWTRTweetView_Private.h"
 #import "TWTRTwitter_Private.h"
+#import "TWTRVideoPlaybackConfiguration.h"
+#import "TWTRVideoPlayerOutputView.h"
 
 @interface TWTRTimelineViewController ()
 
@@ -47,6 +50,7 @@
 
 @property (nonatomic) TWTRTimelineViewController *timeline;
 @property (nonatomic) id mockDataSource;
+@property (nonatomic) TWTRStubTwitterClient *stubClient;
 @property (nonatomic) TWTRMoPubAdConfiguration *adConfig;
 
 @end
@@ -64,6 +68,7 @@
 
     TWTRStubTwitterClient *stubClient = [TWTRStubTwitterClient stubTwitterClient];
     stubClient.responseData = [TWTRFixtureLoader manyTweetsData];
+    self.stubClient = stubClient;
 
     self.adConfig = [[TWTRMoPubAdConfiguration alloc] initWithAdUnitID:@"123" keywords:@"foo:bar,baz:qux"];
     TWTRUserTimelineDataSource *dataSource = [[TWTRUserTimelineDataSource alloc] initWithScreenName:@"billgates" APIClient:stubClient];
@@ -111,6 +116,28 @@
     [self waitForExpectationsWithTimeout:1.0 handler:nil];
 }
 
+- (void)testTimelineViewController_LoadsNewestTweetsWithInteractivePriority
+{
+    [self waitForCompletionWithTimeout:1.0
+                                 check:^BOOL {
+                                     return self.stubClient.sentRequestPriorities.count > 0;
+                                 }];
+
+    XCTAssertEqualObjects(self.stubClient.sentRequestPriorities.firstObject, @(TWTRNetworkingPipelinePriorityInteractive));
+}
+
+- (void)testTimelineViewController_LoadsMoreTweetsWithBackgroundPriority
+{
+    [self waitForCompletionWithTimeout:1.0
+                                 check:^BOOL {
+                                     return [self.timeline tableView:self.timeline.tableView numberOfRowsInSection:0] == 7;
+                                 }];
+
+    [self.timeline tableView:self.timeline.tableView willDisplayCell:[[UITableViewCell alloc] init] forRowAtIndexPath:[NSIndexPath indexPathForRow:6 inSection:0]];
+
+    XCTAssertEqualObjects(self.stubClient.sentRequestPriorities.lastObject, @(TWTRNetworkingPipelinePriorityBackground));
+}
+
 - (void)testTimelineViewController_HasAutomaticHeightSet
 {
     NSIndexPath *indexPath = [NSIndexPath indexPathForItem:0 inSection:0];
@@ -227,6 +254,27 @@
     [self waitForExpectationsWithTimeout:1 handler:nil];
 }
 
+- (void)testTimelineViewController_CancelsVideoPrerollForRowThatScrollsAway
+{
+    TWTRStubTimelineDataSource *stubDataSource = [[TWTRStubTimelineDataSource alloc] init];
+    TWTRTweet *videoTweet = [TWTRFixtureLoader videoTweet];
+    stubDataSource.tweets = @[videoTweet];
+    self.timeline.dataSource = stubDataSource;
+    [self.timeline refresh];
+
+    NSString *mediaID = [TWTRVideoPlaybackConfiguration playbackConfigurationForTweet:videoTweet].mediaID;
+    id mockOutputView = OCMClassMock([TWTRVideoPlayerOutputView class]);
+    OCMExpect([mockOutputView cancelPrerollWithPlaybackConfiguration:[OCMArg checkWithBlock:^BOOL(TWTRVideoPlaybackConfiguration *configuration) {
+                                  return [configuration.mediaID isEqualToString:mediaID];
+                              }]]);
+
+    TWTRTweetTableViewCell *cell = [[TWTRTweetTableViewCell alloc] initWithStyle:UITableViewCellStyleDefault reuseIdentifier:@"TwitterReuse"];
+    [self.timeline tableView:self.timeline.tableView didEndDisplayingCell:cell forRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]];
+
+    OCMVerifyAll(mockOutputView);
+    [mockOutputView stopMocking];
+}
+
 - (void)testTimelineViewController_HidesActionsByDefault
 {
     XCTAssert(self.timeline.showTweetActions == NO);
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+#import "TWTRByteRangeIndex.h"
+
+@interface TWTRByteRangeIndexTests : XCTestCase
+
+@property (nonatomic) TWTRByteRangeIndex *index;
+
+@end
+
+@implementation TWTRByteRangeIndexTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.index = [[TWTRByteRangeIndex alloc] init];
+}
+
+- (NSArray<NSValue *> *)rangesFromArray:(NSArray<NSArray<NSNumber *> *> *)array
+{
+    NSMutableArray<NSValue *> *ranges = [NSMutableArray array];
+    for (NSArray<NSNumber *> *pair in array) {
+        [ranges addObject:[NSValue valueWithRange:NSMakeRange(pair[0].unsignedIntegerValue, pair[1].unsignedIntegerValue)]];
+    }
+    return ranges;
+}
+
+- (void)testInit_Empty
+{
+    XCTAssertEqual(self.index.contentLength, NSURLResponseUnknownLength);
+    XCTAssertEqual(self.index.cachedByteCount, 0);
+    XCTAssertFalse(self.index.isComplete);
+    XCTAssertEqualObjects(self.index.ranges, @[]);
+}
+
+- (void)testAddRange_MergesOverlappingAndAdjacentRanges
+{
+    [self.index addRange:NSMakeRange(100, 50)];
+    [self.index addRange:NSMakeRange(0, 10)];
+    [self.index addRange:NSMakeRange(140, 20)];
+    [self.index addRange:NSMakeRange(10, 5)];
+
+    NSArray *expected = [self rangesFromArray:@[@[@0, @15], @[@100, @60]]];
+    XCTAssertEqualObjects(self.index.ranges, expected);
+    XCTAssertEqual(self.index.cachedByteCount, 75);
+}
+
+- (void)testAddRange_IgnoresEmptyRange
+{
+    [self.index addRange:NSMakeRange(10, 0)];
+    XCTAssertEqual(self.index.cachedByteCount, 0);
+}
+
+- (void)testContainsRange
+{
+    [self.index addRange:NSMakeRange(10, 10)];
+
+    XCTAssertTrue([self.index containsRange:NSMakeRange(10, 10)]);
+    XCTAssertTrue([self.index containsRange:NSMakeRange(12, 3)]);
+    XCTAssertTrue([self.index containsRange:NSMakeRange(500, 0)]);
+    XCTAssertFalse([self.index containsRange:NSMakeRange(9, 2)]);
+    XCTAssertFalse([self.index containsRange:NSMakeRange(19, 2)]);
+}
+
+- (void)testContiguousLengthFromOffset
+{
+    [self.index addRange:NSMakeRange(10, 10)];
+    [self.index addRange:NSMakeRange(30, 10)];
+
+    XCTAssertEqual([self.index contiguousLengthFromOffset:0], 0);
+    XCTAssertEqual([self.index contiguousLengthFromOffset:10], 10);
+    XCTAssertEqual([self.index contiguousLengthFromOffset:15], 5);
+    XCTAssertEqual([self.index contiguousLengthFromOffset:20], 0);
+    XCTAssertEqual([self.index contiguousLengthFromOffset:39], 1);
+    XCTAssertEqual([self.index contiguousLengthFromOffset:40], 0);
+}
+
+- (void)testFirstMissingRange_EmptyIndexMissesEverything
+{
+    NSRange missing = [self.index firstMissingRangeInRange:NSMakeRange(5, 10)];
+    XCTAssertTrue(NSEqualRanges(missing, NSMakeRange(5, 10)));
+}
+
+- (void)testFirstMissingRange_StopsAtNextCachedByte
+{
+    [self.index addRange:NSMakeRange(20, 10)];
+
+    NSRange missing = [self.index firstMissingRangeInRange:NSMakeRange(0, 100)];
+    XCTAssertTrue(NSEqualRanges(missing, NSMakeRange(0, 20)));
+}
+
+- (void)testFirstMissingRange_SkipsCachedPrefix
+{
+    [self.index addRange:NSMakeRange(0, 10)];
+    [self.index addRange:NSMakeRange(20, 10)];
+
+    XCTAssertTrue(NSEqualRanges([self.index firstMissingRangeInRange:NSMakeRange(5, 100)], NSMakeRange(10, 10)));
+    XCTAssertTrue(NSEqualRanges([self.index firstMissingRangeInRange:NSMakeRange(22, 100)], NSMakeRange(30, 92)));
+}
+
+- (void)testFirstMissingRange_NotFoundWhenCached
+{
+    [self.index addRange:NSMakeRange(0, 50)];
+
+    XCTAssertEqual([self.index firstMissingRangeInRange:NSMakeRange(10, 20)].location, NSNotFound);
+    XCTAssertEqual([self.index firstMissingRangeInRange:NSMakeRange(100, 0)].location, NSNotFound);
+}
+
+- (void)testFirstMissingRange_MatchesByteByByteScan
+{
+    srand48(7);
+    const NSUInteger length = 200;
+    BOOL cached[length];
+    memset(cached, 0, sizeof(cached));
+
+    for (NSUInteger i = 0; i < 20; i++) {
+        NSUInteger location = (NSUInteger)(drand48() * length);
+        NSUInteger rangeLength = MIN((NSUInteger)(drand48() * 15), length - location);
+        [self.index addRange:NSMakeRange(location, rangeLength)];
+        for (NSUInteger j = location; j < location + rangeLength; j++) {
+            cached[j] = YES;
+        }
+    }
+
+    for (NSUInteger start = 0; start < length; start += 7) {
+        NSRange queried = NSMakeRange(start, MIN(40, length - start));
+        NSRange expected = NSMakeRange(NSNotFound, 0);
+        for (NSUInteger j = queried.location; j < NSMaxRange(queried); j++) {
+            if (!cached[j] && expected.location == NSNotFound) {
+                expected = NSMakeRange(j, 1);
+            } else if (!cached[j] && NSMaxRange(expected) == j) {
+                expected.length++;
+            }
+        }
+
+        NSRange missing = [self.index firstMissingRangeInRange:queried];
+        XCTAssertEqual(missing.location, expected.location, @"start %lu", (unsigned long)start);
+        if (expected.location != NSNotFound) {
+            XCTAssertEqual(missing.length, expected.length, @"start %lu", (unsigned long)start);
+        }
+        XCTAssertEqual([self.index containsRange:queried], expected.location == NSNotFound);
+    }
+}
+
+- (void)testIsComplete
+{
+    self.index.contentLength = 30;
+    [self.index addRange:NSMakeRange(0, 10)];
+    [self.index addRange:NSMakeRange(20, 10)];
+    XCTAssertFalse(self.index.isComplete);
+
+    [self.index addRange:NSMakeRange(10, 10)];
+    XCTAssertTrue(self.index.isComplete);
+}
+
+- (void)testRemoveAllRanges_KeepsContentInformation
+{
+    self.index.contentLength = 30;
+    self.index.contentType = @"video/mp4";
+    [self.index addRange:NSMakeRange(0, 10)];
+
+    [self.index removeAllRanges];
+
+    XCTAssertEqual(self.index.cachedByteCount, 0);
+    XCTAssertEqual(self.index.contentLength, 30);
+    XCTAssertEqualObjects(self.index.contentType, @"video/mp4");
+}
+
+- (void)testCopy_IsIndependent
+{
+    [self.index addRange:NSMakeRange(0, 10)];
+    TWTRByteRangeIndex *copy = [self.index copy];
+
+    [self.index addRange:NSMakeRange(10, 10)];
+
+    XCTAssertEqual(copy.cachedByteCount, 10);
+}
+
+- (void)testCoding_RoundTrips
+{
+    self.index.contentLength = 1000;
+    self.index.contentType = @"video/mp4";
+    [self.index addRange:NSMakeRange(0, 10)];
+    [self.index addRange:NSMakeRange(500, 100)];
+
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:self.index];
+    TWTRByteRangeIndex *decoded = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+
+    XCTAssertEqual(decoded.contentLength, 1000);
+    XCTAssertEqualObjects(decoded.contentType, @"video/mp4");
+    XCTAssertEqualObjects(decoded.ranges, self.index.ranges);
+}
+
+@end
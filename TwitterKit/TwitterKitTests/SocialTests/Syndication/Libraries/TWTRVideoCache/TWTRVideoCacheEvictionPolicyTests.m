@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+#import "TWTRVideoCacheEvictionPolicy.h"
+
+@interface TWTRVideoCacheEvictionPolicyTests : XCTestCase
+
+@property (nonatomic) TWTRVideoCacheEvictionPolicy *policy;
+
+@end
+
+@implementation TWTRVideoCacheEvictionPolicyTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.policy = [[TWTRVideoCacheEvictionPolicy alloc] initWithMaxSize:100];
+}
+
+- (void)testSetSize_TracksTotal
+{
+    [self.policy setSize:30 forKey:@"a"];
+    [self.policy setSize:40 forKey:@"b"];
+    [self.policy setSize:10 forKey:@"a"];
+
+    XCTAssertEqual(self.policy.totalSize, 50);
+}
+
+- (void)testKeysToEvict_NothingWithinQuota
+{
+    [self.policy setSize:60 forKey:@"a"];
+    [self.policy setSize:40 forKey:@"b"];
+
+    XCTAssertEqualObjects([self.policy keysToEvict], @[]);
+}
+
+- (void)testKeysToEvict_LeastRecentlyUsedFirst
+{
+    [self.policy setSize:40 forKey:@"a"];
+    [self.policy setSize:40 forKey:@"b"];
+    [self.policy setSize:40 forKey:@"c"];
+    [self.policy setSize:40 forKey:@"d"];
+
+    NSArray *expected = @[@"a", @"b"];
+    XCTAssertEqualObjects([self.policy keysToEvict], expected);
+}
+
+- (void)testKeysToEvict_TouchMakesMostRecent
+{
+    [self.policy setSize:40 forKey:@"a"];
+    [self.policy setSize:40 forKey:@"b"];
+    [self.policy setSize:40 forKey:@"c"];
+    [self.policy touchKey:@"a"];
+
+    XCTAssertEqualObjects([self.policy keysToEvict], @[@"b"]);
+    NSArray *expected = @[@"b", @"c", @"a"];
+    XCTAssertEqualObjects(self.policy.keys, expected);
+}
+
+- (void)testTouchKey_UnknownKeyIgnored
+{
+    [self.policy touchKey:@"a"];
+    XCTAssertEqualObjects(self.policy.keys, @[]);
+}
+
+- (void)testKeysToEvict_SkipsPinnedKeys
+{
+    [self.policy setSize:40 forKey:@"a"];
+    [self.policy setSize:40 forKey:@"b"];
+    [self.policy setSize:40 forKey:@"c"];
+    [self.policy pinKey:@"a"];
+
+    XCTAssertEqualObjects([self.policy keysToEvict], @[@"b"]);
+}
+
+- (void)testKeysToEvict_PinsNest
+{
+    [self.policy setSize:150 forKey:@"a"];
+    [self.policy pinKey:@"a"];
+    [self.policy pinKey:@"a"];
+    [self.policy unpinKey:@"a"];
+
+    XCTAssertEqualObjects([self.policy keysToEvict], @[]);
+
+    [self.policy unpinKey:@"a"];
+    XCTAssertEqualObjects([self.policy keysToEvict], @[@"a"]);
+}
+
+- (void)testRemoveKey_UpdatesTotal
+{
+    [self.policy setSize:40 forKey:@"a"];
+    [self.policy setSize:80 forKey:@"b"];
+    [self.policy removeKey:@"a"];
+
+    XCTAssertEqual(self.policy.totalSize, 80);
+    XCTAssertEqualObjects([self.policy keysToEvict], @[]);
+}
+
+- (void)testMaxSize_LoweringEvictsMore
+{
+    [self.policy setSize:40 forKey:@"a"];
+    [self.policy setSize:40 forKey:@"b"];
+    self.policy.maxSize = 0;
+
+    NSArray *expected = @[@"a", @"b"];
+    XCTAssertEqualObjects([self.policy keysToEvict], expected);
+}
+
+@end
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+#import "TWTRByteRangeIndex.h"
+#import "TWTRVideoCache.h"
+
+@interface TWTRVideoCacheTests : XCTestCase
+
+@property (nonatomic, copy) NSString *path;
+@property (nonatomic) TWTRVideoCache *cache;
+
+@end
+
+@implementation TWTRVideoCacheTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"video_cache_test"];
+    [[NSFileManager defaultManager] removeItemAtPath:self.path error:NULL];
+    self.cache = [[TWTRVideoCache alloc] initWithPath:self.path maxSize:100];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:self.path error:NULL];
+    [super tearDown];
+}
+
+- (NSData *)dataWithLength:(NSUInteger)length byte:(uint8_t)byte
+{
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    memset(data.mutableBytes, byte, length);
+    return data;
+}
+
+- (void)testInit_BadPathReturnsNil
+{
+    XCTAssertNil([[TWTRVideoCache alloc] initWithPath:@"/bad_path" maxSize:100]);
+}
+
+- (void)testKeyForURL_StableAndDistinct
+{
+    NSURL *URL = [NSURL URLWithString:@"https://video.twimg.com/ext_tw_video/1/pu/vid/320x180/a.mp4"];
+    NSURL *otherURL = [NSURL URLWithString:@"https://video.twimg.com/ext_tw_video/1/pu/vid/640x360/a.mp4"];
+
+    XCTAssertEqualObjects([TWTRVideoCache keyForURL:URL], [TWTRVideoCache keyForURL:[URL copy]]);
+    XCTAssertNotEqualObjects([TWTRVideoCache keyForURL:URL], [TWTRVideoCache keyForURL:otherURL]);
+}
+
+- (void)testStoreData_ReadsBackSparseRanges
+{
+    [self.cache setContentLength:60 contentType:@"video/mp4" forKey:@"a"];
+    [self.cache storeData:[self dataWithLength:10 byte:1] forKey:@"a" offset:0];
+    [self.cache storeData:[self dataWithLength:10 byte:2] forKey:@"a" offset:40];
+
+    XCTAssertEqualObjects([self.cache dataForKey:@"a" range:NSMakeRange(40, 10)], [self dataWithLength:10 byte:2]);
+    XCTAssertEqualObjects([self.cache dataForKey:@"a" range:NSMakeRange(2, 5)], [self dataWithLength:5 byte:1]);
+    XCTAssertNil([self.cache dataForKey:@"a" range:NSMakeRange(5, 10)]);
+    XCTAssertEqual([self.cache indexForKey:@"a"].cachedByteCount, 20);
+    XCTAssertEqual(self.cache.totalSize, 20);
+}
+
+- (void)testIndexForKey_UnknownKeyIsEmpty
+{
+    TWTRByteRangeIndex *index = [self.cache indexForKey:@"missing"];
+
+    XCTAssertEqual(index.contentLength, NSURLResponseUnknownLength);
+    XCTAssertEqual(index.cachedByteCount, 0);
+}
+
+- (void)testSetContentLength_ChangedLengthDropsData
+{
+    [self.cache setContentLength:60 contentType:@"video/mp4" forKey:@"a"];
+    [self.cache storeData:[self dataWithLength:10 byte:1] forKey:@"a" offset:0];
+
+    [self.cache setContentLength:80 contentType:@"video/mp4" forKey:@"a"];
+
+    XCTAssertEqual([self.cache indexForKey:@"a"].cachedByteCount, 0);
+    XCTAssertNil([self.cache dataForKey:@"a" range:NSMakeRange(0, 10)]);
+}
+
+- (void)testStoreData_EvictsLeastRecentlyUsed
+{
+    [self.cache storeData:[self dataWithLength:40 byte:1] forKey:@"a" offset:0];
+    [self.cache storeData:[self dataWithLength:40 byte:2] forKey:@"b" offset:0];
+    [self.cache dataForKey:@"a" range:NSMakeRange(0, 1)];
+    [self.cache storeData:[self dataWithLength:40 byte:3] forKey:@"c" offset:0];
+
+    XCTAssertNotNil([self.cache dataForKey:@"a" range:NSMakeRange(0, 40)]);
+    XCTAssertNil([self.cache dataForKey:@"b" range:NSMakeRange(0, 40)]);
+    XCTAssertNotNil([self.cache dataForKey:@"c" range:NSMakeRange(0, 40)]);
+    XCTAssertEqual(self.cache.totalSize, 80);
+}
+
+- (void)testStoreData_KeysInUseAreNotEvicted
+{
+    [self.cache beginUsingKey:@"a"];
+    [self.cache storeData:[self dataWithLength:80 byte:1] forKey:@"a" offset:0];
+    [self.cache storeData:[self dataWithLength:80 byte:2] forKey:@"b" offset:0];
+
+    XCTAssertNotNil([self.cache dataForKey:@"a" range:NSMakeRange(0, 80)]);
+    XCTAssertNil([self.cache dataForKey:@"b" range:NSMakeRange(0, 80)]);
+
+    [self.cache endUsingKey:@"a"];
+    [self.cache storeData:[self dataWithLength:80 byte:3] forKey:@"c" offset:0];
+    XCTAssertNil([self.cache dataForKey:@"a" range:NSMakeRange(0, 80)]);
+}
+
+- (void)testDataForKey_ShortReadKeepsFileOfKeyInUse
+{
+    [self.cache storeData:[self dataWithLength:20 byte:1] forKey:@"a" offset:0];
+    [self.cache beginUsingKey:@"a"];
+
+    NSString *dataPath = [[self.path stringByAppendingPathComponent:@"a"] stringByAppendingPathExtension:@"data"];
+    NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingAtPath:dataPath];
+    [fileHandle truncateFileAtOffset:10];
+    [fileHandle closeFile];
+
+    XCTAssertNil([self.cache dataForKey:@"a" range:NSMakeRange(0, 20)]);
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:dataPath]);
+
+    [self.cache endUsingKey:@"a"];
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:dataPath]);
+    XCTAssertEqual(self.cache.totalSize, 0);
+}
+
+- (void)testSetMaxSize_EvictsImmediately
+{
+    [self.cache storeData:[self dataWithLength:40 byte:1] forKey:@"a" offset:0];
+    [self.cache storeData:[self dataWithLength:40 byte:2] forKey:@"b" offset:0];
+
+    self.cache.maxSize = 50;
+
+    XCTAssertNil([self.cache dataForKey:@"a" range:NSMakeRange(0, 40)]);
+    XCTAssertEqual(self.cache.totalSize, 40);
+}
+
+- (void)testSynchronizeKey_PersistsAcrossInstances
+{
+    [self.cache setContentLength:60 contentType:@"video/mp4" forKey:@"a"];
+    [self.cache storeData:[self dataWithLength:10 byte:7] forKey:@"a" offset:20];
+    [self.cache synchronizeKey:@"a"];
+
+    TWTRVideoCache *reloadedCache = [[TWTRVideoCache alloc] initWithPath:self.path maxSize:100];
+    TWTRByteRangeIndex *index = [reloadedCache indexForKey:@"a"];
+
+    XCTAssertEqual(index.contentLength, 60);
+    XCTAssertEqualObjects(index.contentType, @"video/mp4");
+    XCTAssertEqualObjects([reloadedCache dataForKey:@"a" range:NSMakeRange(20, 10)], [self dataWithLength:10 byte:7]);
+}
+
+- (void)testReload_DropsDataWithoutIndex
+{
+    [self.cache storeData:[self dataWithLength:10 byte:7] forKey:@"a" offset:0];
+
+    TWTRVideoCache *reloadedCache = [[TWTRVideoCache alloc] initWithPath:self.path maxSize:100];
+
+    XCTAssertNil([reloadedCache dataForKey:@"a" range:NSMakeRange(0, 10)]);
+    XCTAssertEqual(reloadedCache.totalSize, 0);
+}
+
+- (void)testRemoveAllData
+{
+    [self.cache storeData:[self dataWithLength:10 byte:1] forKey:@"a" offset:0];
+    [self.cache storeData:[self dataWithLength:10 byte:2] forKey:@"b" offset:0];
+
+    [self.cache removeAllData];
+
+    XCTAssertEqual(self.cache.totalSize, 0);
+    XCTAssertNil([self.cache dataForKey:@"a" range:NSMakeRange(0, 10)]);
+}
+
+@end
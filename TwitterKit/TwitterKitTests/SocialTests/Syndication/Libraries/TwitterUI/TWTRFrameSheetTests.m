@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <TwitterCore/TWTRMemoryPressureCoordinator.h>
+#import <XCTest/XCTest.h>
+#import "TWTRFrameSheet.h"
+#import "TWTRImageSequenceConfiguration.h"
+
+@interface TWTRFrameSheetTests : XCTestCase
+
+@property (nonatomic) TWTRImageSequenceConfiguration *configuration;
+
+@end
+
+@implementation TWTRFrameSheetTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.configuration = [TWTRImageSequenceConfiguration heartImageSequenceConfigurationWithSize:TWTRHeartImageSequenceSizeRegular];
+}
+
+- (void)tearDown
+{
+    [TWTRFrameSheet removeAllSharedFrameSheets];
+    [super tearDown];
+}
+
+- (UIImage *)sheetImageWithRows:(NSUInteger)rows columns:(NSUInteger)columns frameSize:(CGFloat)frameSize
+{
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(columns * frameSize, rows * frameSize), NO, 1);
+    [[UIColor redColor] setFill];
+    UIRectFill(CGRectMake(0, 0, columns * frameSize, rows * frameSize));
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+
+    return image;
+}
+
+- (void)testFrameArray_slicesFrameCountFrames
+{
+    TWTRFrameSheet *frameSheet = [[TWTRFrameSheet alloc] initWithImage:[self sheetImageWithRows:2 columns:3 frameSize:10] rows:2 columns:3 frameCount:5 imageWidth:10 imageHeight:10];
+
+    NSArray<UIImage *> *frames = [frameSheet frameArray];
+
+    XCTAssertEqual(frames.count, 5);
+    XCTAssertEqual(CGImageGetWidth(frames.firstObject.CGImage), 10);
+    XCTAssertEqual(CGImageGetHeight(frames.lastObject.CGImage), 10);
+}
+
+- (void)testFrameArray_slicedOnce
+{
+    TWTRFrameSheet *frameSheet = [[TWTRFrameSheet alloc] initWithImage:[self sheetImageWithRows:2 columns:2 frameSize:10] rows:2 columns:2 frameCount:4 imageWidth:10 imageHeight:10];
+
+    XCTAssertEqual([frameSheet frameArray], [frameSheet frameArray]);
+}
+
+- (void)testSharedFrameSheet_reusedForSameConfigurationAndScale
+{
+    TWTRFrameSheet *first = [TWTRFrameSheet sharedFrameSheetForImageSequenceConfiguration:self.configuration scale:2];
+    TWTRFrameSheet *second = [TWTRFrameSheet sharedFrameSheetForImageSequenceConfiguration:self.configuration scale:2];
+
+    XCTAssertEqual(first, second);
+}
+
+- (void)testSharedFrameSheet_separateForEachScale
+{
+    TWTRFrameSheet *first = [TWTRFrameSheet sharedFrameSheetForImageSequenceConfiguration:self.configuration scale:2];
+    TWTRFrameSheet *second = [TWTRFrameSheet sharedFrameSheetForImageSequenceConfiguration:self.configuration scale:3];
+
+    XCTAssertNotEqual(first, second);
+}
+
+- (void)testSharedFrameSheet_separateForEachConfiguration
+{
+    TWTRImageSequenceConfiguration *large = [TWTRImageSequenceConfiguration heartImageSequenceConfigurationWithSize:TWTRHeartImageSequenceSizeLarge];
+    TWTRFrameSheet *regularSheet = [TWTRFrameSheet sharedFrameSheetForImageSequenceConfiguration:self.configuration scale:2];
+    TWTRFrameSheet *largeSheet = [TWTRFrameSheet sharedFrameSheetForImageSequenceConfiguration:large scale:2];
+
+    XCTAssertNotEqual(regularSheet, largeSheet);
+    XCTAssertEqual(largeSheet.imageWidth, 63);
+}
+
+- (void)testMemoryCost_zeroUntilSliced
+{
+    TWTRFrameSheet *frameSheet = [[TWTRFrameSheet alloc] initWithImage:[self sheetImageWithRows:2 columns:2 frameSize:10] rows:2 columns:2 frameCount:4 imageWidth:10 imageHeight:10];
+    XCTAssertEqual([frameSheet memoryCost], 0);
+
+    [frameSheet frameArray];
+
+    XCTAssertGreaterThanOrEqual([frameSheet memoryCost], 20 * 20 * 4);
+}
+
+- (void)testSharedFrameSheet_droppedWhenCoordinatorTrims
+{
+    TWTRFrameSheet *first = [TWTRFrameSheet sharedFrameSheetForImageSequenceConfiguration:self.configuration scale:2];
+    [first frameArray];
+
+    [[TWTRMemoryPressureCoordinator sharedCoordinator] trimToBudget:0];
+
+    XCTAssertNotEqual([TWTRFrameSheet sharedFrameSheetForImageSequenceConfiguration:self.configuration scale:2], first);
+}
+
+@end
@@ -77,6 +77,32 @@
     XCTAssertTrue(CGSizeEqualToSize(targetSize, actualSize), @"expeted size %@ but got %@", NSStringFromCGSize(targetSize), NSStringFromCGSize(actualSize));
 }
 
+- (void)testDisplayConfiguration_matchesInitializer
+{
+    TWTRMediaEntityDisplayConfiguration *config = [TWTRMediaEntityDisplayConfiguration displayConfigurationWithMediaEntity:self.obamaMediaEntity targetWidth:900];
+
+    XCTAssertEqualObjects(config.imagePath, self.largeConfig.imagePath);
+    XCTAssertTrue(CGSizeEqualToSize(config.imageSize, self.largeConfig.imageSize));
+    XCTAssertEqualObjects(config.pillText, self.largeConfig.pillText);
+}
+
+- (void)testDisplayConfiguration_sharedBetweenWidthsChoosingSameSize
+{
+    TWTRMediaEntityDisplayConfiguration *first = [TWTRMediaEntityDisplayConfiguration displayConfigurationWithMediaEntity:self.obamaMediaEntity targetWidth:850];
+    TWTRMediaEntityDisplayConfiguration *second = [TWTRMediaEntityDisplayConfiguration displayConfigurationWithMediaEntity:self.obamaMediaEntity targetWidth:900];
+
+    XCTAssertEqual(first, second);
+}
+
+- (void)testDisplayConfiguration_separateForDifferentSizes
+{
+    TWTRMediaEntityDisplayConfiguration *small = [TWTRMediaEntityDisplayConfiguration displayConfigurationWithMediaEntity:self.obamaMediaEntity targetWidth:300];
+    TWTRMediaEntityDisplayConfiguration *large = [TWTRMediaEntityDisplayConfiguration displayConfigurationWithMediaEntity:self.obamaMediaEntity targetWidth:900];
+
+    XCTAssertNotEqual(small, large);
+    XCTAssertEqualObjects(small.imagePath, self.smallConfig.imagePath);
+}
+
 - (void)testVineCard_MediaDisplayConfiguration
 {
     TWTRMediaEntityDisplayConfiguration *mediaConfig = [TWTRMediaEntityDisplayConfiguration mediaEntityDisplayConfigurationWithCardEntity:self.vineTweet.cardEntity];
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+#import "TWTRMediaEntitySize.h"
+#import "TWTRMediaEntitySizeTable.h"
+
+@interface TWTRMediaEntitySizeTableTests : XCTestCase
+
+@property (nonatomic) TWTRMediaEntitySizeTable *table;
+
+@end
+
+@implementation TWTRMediaEntitySizeTableTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    NSDictionary *sizes = @{
+        @"thumb": [self sizeNamed:@"thumb" width:150 resizingMode:TWTRMediaEntitySizeResizingModeCrop],
+        @"small": [self sizeNamed:@"small" width:680 resizingMode:TWTRMediaEntitySizeResizingModeFit],
+        @"large": [self sizeNamed:@"large" width:2048 resizingMode:TWTRMediaEntitySizeResizingModeFit],
+        @"medium": [self sizeNamed:@"medium" width:1200 resizingMode:TWTRMediaEntitySizeResizingModeFit]
+    };
+    self.table = [[TWTRMediaEntitySizeTable alloc] initWithSizes:sizes minimumWidth:300];
+}
+
+- (TWTRMediaEntitySize *)sizeNamed:(NSString *)name width:(CGFloat)width resizingMode:(TWTRMediaEntitySizeResizingMode)resizingMode
+{
+    return [[TWTRMediaEntitySize alloc] initWithName:name resizingMode:resizingMode size:CGSizeMake(width, width)];
+}
+
+- (NSString *)nameOfSizeFittingWidth:(CGFloat)width
+{
+    return [self.table sizeAtIndex:[self.table indexOfSizeFittingWidth:width]].name;
+}
+
+- (void)testCount_excludesCroppedAndNarrowSizes
+{
+    XCTAssertEqual(self.table.count, 3);
+}
+
+- (void)testSizeAtIndex_sortedByWidth
+{
+    XCTAssertEqualObjects([self.table sizeAtIndex:0].name, @"small");
+    XCTAssertEqualObjects([self.table sizeAtIndex:1].name, @"medium");
+    XCTAssertEqualObjects([self.table sizeAtIndex:2].name, @"large");
+}
+
+- (void)testIndexOfSizeFittingWidth_choosesClosestWidth
+{
+    XCTAssertEqualObjects([self nameOfSizeFittingWidth:0], @"small");
+    XCTAssertEqualObjects([self nameOfSizeFittingWidth:900], @"small");
+    XCTAssertEqualObjects([self nameOfSizeFittingWidth:1000], @"medium");
+    XCTAssertEqualObjects([self nameOfSizeFittingWidth:1200], @"medium");
+    XCTAssertEqualObjects([self nameOfSizeFittingWidth:1700], @"large");
+    XCTAssertEqualObjects([self nameOfSizeFittingWidth:5000], @"large");
+}
+
+- (void)testIndexOfSizeFittingWidth_prefersNarrowerOnTie
+{
+    XCTAssertEqualObjects([self nameOfSizeFittingWidth:940], @"small");
+}
+
+- (void)testIndexOfSizeFittingWidth_usesAllSizesWhenNoneAreValid
+{
+    TWTRMediaEntitySizeTable *table = [[TWTRMediaEntitySizeTable alloc] initWithSizes:@{@"thumb": [self sizeNamed:@"thumb" width:150 resizingMode:TWTRMediaEntitySizeResizingModeCrop]} minimumWidth:300];
+
+    XCTAssertEqual(table.count, 1);
+    XCTAssertEqualObjects([table sizeAtIndex:[table indexOfSizeFittingWidth:600]].name, @"thumb");
+}
+
+- (void)testIndexOfSizeFittingWidth_emptyTable
+{
+    TWTRMediaEntitySizeTable *table = [[TWTRMediaEntitySizeTable alloc] initWithSizes:@{} minimumWidth:300];
+
+    XCTAssertEqual([table indexOfSizeFittingWidth:600], NSNotFound);
+}
+
+@end
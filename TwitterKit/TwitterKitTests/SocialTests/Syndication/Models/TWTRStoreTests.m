@@ -15,6 +15,7 @@
  *
  */
 
+#import <TwitterCore/TWTRMemoryPressureCoordinator.h>
 #import <XCTest/XCTest.h>
 #import "TWTRFixtureLoader.h"
 #import "TWTRSampleSubscriber.h"
@@ -22,6 +23,36 @@
 #import "TWTRSubscription.h"
 #import "TWTRTweet.h"
 
+@interface TWTRStore ()
+
+@property (nonatomic, readonly) NSMutableDictionary *subscriptionsByToken;
+@property (nonatomic, readonly) NSMutableDictionary *tokensByObjectKey;
+
+@end
+
+/**
+ *  Unsubscribes from its own -dealloc, the way TWTRTweetView does.
+ */
+@interface TWTRStoreTestsDeallocatingSubscriber : NSObject <TWTRSubscriber>
+
+@property (nonatomic) TWTRStore *store;
+@property (nonatomic, copy) NSString *objectID;
+
+@end
+
+@implementation TWTRStoreTestsDeallocatingSubscriber
+
+- (void)dealloc
+{
+    [_store unsubscribeSubscriber:self fromClass:[TWTRTweet class] objectID:_objectID];
+}
+
+- (void)objectUpdated:(id)object
+{
+}
+
+@end
+
 @interface TWTRStoreTests : XCTestCase
 
 @property (nonatomic) TWTRSampleSubscriber *subscriber;
@@ -49,6 +80,7 @@
     [self.store subscribeSubscriber:self.subscriber toClass:[TWTRTweet class] objectID:@"663898858817089536"];
 
     [self.store notifySubscribersOfChangesToObject:testTweet withID:testTweet.tweetID];
+    [self.store deliverPendingNotifications];
 
     XCTAssertEqualObjects(self.subscriber.latestObject, testTweet);
 }
@@ -60,6 +92,7 @@
     [self.store subscribeSubscriber:self.subscriber2 toClass:[TWTRTweet class] objectID:@"663898858817089536"];
 
     [self.store notifySubscribersOfChangesToObject:testTweet withID:testTweet.tweetID];
+    [self.store deliverPendingNotifications];
 
     XCTAssertEqualObjects(self.subscriber.latestObject, testTweet);
     XCTAssertEqualObjects(self.subscriber2.latestObject, testTweet);
@@ -77,8 +110,144 @@
 
     // Shouldn't notify
     [self.store notifySubscribersOfChangesToObject:testTweet withID:testTweet.tweetID];
+    [self.store deliverPendingNotifications];
 
     XCTAssertNil(self.subscriber.latestObject);
 }
 
+- (void)testUnsubscribe_onlyRemovesMatchingSubscriber
+{
+    TWTRTweet *testTweet = [TWTRFixtureLoader videoTweet];
+    [self.store subscribeSubscriber:self.subscriber toClass:[TWTRTweet class] objectID:testTweet.tweetID];
+    [self.store subscribeSubscriber:self.subscriber2 toClass:[TWTRTweet class] objectID:testTweet.tweetID];
+    [self.store unsubscribeSubscriber:self.subscriber fromClass:[TWTRTweet class] objectID:testTweet.tweetID];
+
+    [self.store notifySubscribersOfChangesToObject:testTweet withID:testTweet.tweetID];
+    [self.store deliverPendingNotifications];
+
+    XCTAssertNil(self.subscriber.latestObject);
+    XCTAssertEqualObjects(self.subscriber2.latestObject, testTweet);
+}
+
+- (void)testUnsubscribe_ignoresUnknownSubscription
+{
+    TWTRTweet *testTweet = [TWTRFixtureLoader videoTweet];
+    [self.store subscribeSubscriber:self.subscriber toClass:[TWTRTweet class] objectID:testTweet.tweetID];
+    [self.store unsubscribeSubscriber:self.subscriber fromClass:[TWTRTweet class] objectID:@"1"];
+
+    [self.store notifySubscribersOfChangesToObject:testTweet withID:testTweet.tweetID];
+    [self.store deliverPendingNotifications];
+
+    XCTAssertEqualObjects(self.subscriber.latestObject, testTweet);
+}
+
+#pragma mark - Coalescing
+
+- (void)testNotify_doesNotDeliverSynchronously
+{
+    TWTRTweet *testTweet = [TWTRFixtureLoader videoTweet];
+    [self.store subscribeSubscriber:self.subscriber toClass:[TWTRTweet class] objectID:testTweet.tweetID];
+
+    [self.store notifySubscribersOfChangesToObject:testTweet withID:testTweet.tweetID];
+
+    XCTAssertNil(self.subscriber.latestObject);
+}
+
+- (void)testNotify_deliversOnLaterMainQueueTurn
+{
+    TWTRTweet *testTweet = [TWTRFixtureLoader videoTweet];
+    [self.store subscribeSubscriber:self.subscriber toClass:[TWTRTweet class] objectID:testTweet.tweetID];
+
+    [self.store notifySubscribersOfChangesToObject:testTweet withID:testTweet.tweetID];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"delivered"];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        XCTAssertEqualObjects(self.subscriber.latestObject, testTweet);
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
+- (void)testNotify_coalescesRepeatedChangesToLatestObject
+{
+    TWTRTweet *firstTweet = [TWTRFixtureLoader videoTweet];
+    TWTRTweet *secondTweet = [firstTweet tweetWithLikeToggled];
+    [self.store subscribeSubscriber:self.subscriber toClass:[TWTRTweet class] objectID:firstTweet.tweetID];
+
+    [self.store notifySubscribersOfChangesToObject:firstTweet withID:firstTweet.tweetID];
+    [self.store notifySubscribersOfChangesToObject:secondTweet withID:secondTweet.tweetID];
+    [self.store deliverPendingNotifications];
+
+    XCTAssertEqual(self.subscriber.updateCount, 1);
+    XCTAssertEqual(self.subscriber.latestObject, secondTweet);
+}
+
+- (void)testNotify_postedFromBackgroundThreadIsDeliveredOnMainThread
+{
+    TWTRTweet *testTweet = [TWTRFixtureLoader videoTweet];
+    [self.store subscribeSubscriber:self.subscriber toClass:[TWTRTweet class] objectID:testTweet.tweetID];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"delivered"];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        [self.store notifySubscribersOfChangesToObject:testTweet withID:testTweet.tweetID];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            XCTAssertEqualObjects(self.subscriber.latestObject, testTweet);
+            [expectation fulfill];
+        });
+    });
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
+#pragma mark - Weak Subscribers
+
+- (void)testNotify_skipsDeallocatedSubscribers
+{
+    TWTRTweet *testTweet = [TWTRFixtureLoader videoTweet];
+
+    @autoreleasepool {
+        TWTRSampleSubscriber *transientSubscriber = [[TWTRSampleSubscriber alloc] init];
+        [self.store subscribeSubscriber:transientSubscriber toClass:[TWTRTweet class] objectID:testTweet.tweetID];
+    }
+    [self.store subscribeSubscriber:self.subscriber toClass:[TWTRTweet class] objectID:testTweet.tweetID];
+
+    XCTAssertNoThrow([self.store notifySubscribersOfChangesToObject:testTweet withID:testTweet.tweetID]);
+    [self.store deliverPendingNotifications];
+
+    XCTAssertEqualObjects(self.subscriber.latestObject, testTweet);
+}
+
+- (void)testUnsubscribe_fromDeallocRemovesSubscription
+{
+    @autoreleasepool {
+        TWTRStoreTestsDeallocatingSubscriber *subscriber = [[TWTRStoreTestsDeallocatingSubscriber alloc] init];
+        subscriber.store = self.store;
+        subscriber.objectID = @"1";
+        [self.store subscribeSubscriber:subscriber toClass:[TWTRTweet class] objectID:@"1"];
+        XCTAssertEqual(self.store.subscriptionsByToken.count, 1);
+    }
+
+    XCTAssertEqual(self.store.subscriptionsByToken.count, 0);
+    XCTAssertEqual(self.store.tokensByObjectKey.count, 0);
+}
+
+- (void)testMemoryPressure_prunesDeallocatedSubscribers
+{
+    TWTRStore *store = [TWTRStore sharedInstance];
+    TWTRMemoryPressureCoordinator *coordinator = [TWTRMemoryPressureCoordinator sharedCoordinator];
+    [store subscribeSubscriber:self.subscriber toClass:[TWTRTweet class] objectID:@"1"];
+    NSUInteger costWithLiveSubscriber = [[coordinator memoryUsage][@"TWTRStore.subscriptions"] unsignedIntegerValue];
+
+    @autoreleasepool {
+        TWTRSampleSubscriber *transientSubscriber = [[TWTRSampleSubscriber alloc] init];
+        [store subscribeSubscriber:transientSubscriber toClass:[TWTRTweet class] objectID:@"2"];
+    }
+    XCTAssertGreaterThan([[coordinator memoryUsage][@"TWTRStore.subscriptions"] unsignedIntegerValue], costWithLiveSubscriber);
+
+    [coordinator trimToBudget:0];
+
+    XCTAssertLessThanOrEqual([[coordinator memoryUsage][@"TWTRStore.subscriptions"] unsignedIntegerValue], costWithLiveSubscriber);
+    XCTAssertGreaterThan([[coordinator memoryUsage][@"TWTRStore.subscriptions"] unsignedIntegerValue], 0);
+    [store unsubscribeSubscriber:self.subscriber fromClass:[TWTRTweet class] objectID:@"1"];
+}
+
 @end
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <TwitterCore/TWTRAPIErrorCode.h>
+#import <XCTest/XCTest.h>
+#import "TWTRFixtureLoader.h"
+#import "TWTRStubTwitterClient.h"
+#import "TWTRTweet.h"
+#import "TWTRTweetLookupBatcher.h"
+
+@interface TWTRTweetLookupBatcherTests : XCTestCase
+
+@property (nonatomic) TWTRStubTwitterClient *stubAPIClient;
+@property (nonatomic) TWTRTweetLookupBatcher *batcher;
+@property (nonatomic) NSMutableArray<TWTRTweet *> *fetchedTweets;
+
+@end
+
+@implementation TWTRTweetLookupBatcherTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.stubAPIClient = [TWTRStubTwitterClient stubTwitterClient];
+    self.stubAPIClient.responseData = [TWTRFixtureLoader manyTweetsData];
+    self.fetchedTweets = [NSMutableArray array];
+
+    NSMutableArray *fetchedTweets = self.fetchedTweets;
+    self.batcher = [[TWTRTweetLookupBatcher alloc] initWithBatchingInterval:0.05
+                                                           maximumBatchSize:100
+                                                               fetchHandler:^(NSArray<TWTRTweet *> *tweets, NSString *perspective) {
+                                                                   [fetchedTweets addObjectsFromArray:tweets];
+                                                               }];
+}
+
+- (void)testLookupsWithinIntervalShareOneRequest
+{
+    XCTestExpectation *firstExpectation = [self expectationWithDescription:@"first lookup"];
+    XCTestExpectation *secondExpectation = [self expectationWithDescription:@"second lookup"];
+
+    [self.batcher loadTweetsWithIDs:@[@"483693675445100546"] APIClient:self.stubAPIClient additionalParameters:nil completion:^(NSArray<TWTRTweet *> *tweets, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects([tweets valueForKey:@"tweetID"], @[@"483693675445100546"]);
+        [firstExpectation fulfill];
+    }];
+    [self.batcher loadTweetsWithIDs:@[@"484071743238066176"] APIClient:self.stubAPIClient additionalParameters:nil completion:^(NSArray<TWTRTweet *> *tweets, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects([tweets valueForKey:@"tweetID"], @[@"484071743238066176"]);
+        [secondExpectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual(self.stubAPIClient.sentRequestsArray.count, 1);
+    NSString *query = [self.stubAPIClient.sentRequest.URL.query stringByRemovingPercentEncoding];
+    XCTAssertTrue([query containsString:@"483693675445100546,484071743238066176"]);
+}
+
+- (void)testDuplicateIDsAreRequestedOnce
+{
+    XCTestExpectation *firstExpectation = [self expectationWithDescription:@"first lookup"];
+    XCTestExpectation *secondExpectation = [self expectationWithDescription:@"second lookup"];
+
+    [self.batcher loadTweetsWithIDs:@[@"483693675445100546", @"483693675445100546"] APIClient:self.stubAPIClient additionalParameters:nil completion:^(NSArray<TWTRTweet *> *tweets, NSError *error) {
+        XCTAssertEqual(tweets.count, 1);
+        [firstExpectation fulfill];
+    }];
+    [self.batcher loadTweetsWithIDs:@[@"483693675445100546"] APIClient:self.stubAPIClient additionalParameters:nil completion:^(NSArray<TWTRTweet *> *tweets, NSError *error) {
+        XCTAssertEqual(tweets.count, 1);
+        [secondExpectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual(self.stubAPIClient.sentRequestsArray.count, 1);
+    NSString *query = [self.stubAPIClient.sentRequest.URL.query stringByRemovingPercentEncoding];
+    XCTAssertFalse([query containsString:@"483693675445100546,483693675445100546"]);
+    XCTAssertEqual(self.fetchedTweets.count, [TWTRTweet tweetsWithJSONArray:[NSJSONSerialization JSONObjectWithData:[TWTRFixtureLoader manyTweetsData] options:0 error:nil]].count);
+}
+
+- (void)testLookupsAreSplitAtMaximumBatchSize
+{
+    NSMutableArray *tweetIDs = [NSMutableArray array];
+    for (NSInteger i = 0; i < 150; i++) {
+        [tweetIDs addObject:[@(i + 1) stringValue]];
+    }
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"lookup"];
+    [self.batcher loadTweetsWithIDs:tweetIDs APIClient:self.stubAPIClient additionalParameters:nil completion:^(NSArray<TWTRTweet *> *tweets, NSError *error) {
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual(self.stubAPIClient.sentRequestsArray.count, 2);
+}
+
+- (void)testDifferentParametersAreNotBatchedTogether
+{
+    XCTestExpectation *firstExpectation = [self expectationWithDescription:@"first lookup"];
+    XCTestExpectation *secondExpectation = [self expectationWithDescription:@"second lookup"];
+
+    [self.batcher loadTweetsWithIDs:@[@"483693675445100546"] APIClient:self.stubAPIClient additionalParameters:@{ @"tweet_mode": @"extended" } completion:^(NSArray<TWTRTweet *> *tweets, NSError *error) {
+        [firstExpectation fulfill];
+    }];
+    [self.batcher loadTweetsWithIDs:@[@"484071743238066176"] APIClient:self.stubAPIClient additionalParameters:nil completion:^(NSArray<TWTRTweet *> *tweets, NSError *error) {
+        [secondExpectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual(self.stubAPIClient.sentRequestsArray.count, 2);
+}
+
+- (void)testMissingTweetsAreOmitted
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"lookup"];
+
+    [self.batcher loadTweetsWithIDs:@[@"483693675445100546", @"meow"] APIClient:self.stubAPIClient additionalParameters:nil completion:^(NSArray<TWTRTweet *> *tweets, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects([tweets valueForKey:@"tweetID"], @[@"483693675445100546"]);
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+}
+
+- (void)testNetworkErrorIsDeliveredToEveryCaller
+{
+    self.stubAPIClient.responseError = [NSError errorWithDomain:TWTRAPIErrorDomain code:0 userInfo:nil];
+
+    XCTestExpectation *firstExpectation = [self expectationWithDescription:@"first lookup"];
+    XCTestExpectation *secondExpectation = [self expectationWithDescription:@"second lookup"];
+
+    [self.batcher loadTweetsWithIDs:@[@"483693675445100546"] APIClient:self.stubAPIClient additionalParameters:nil completion:^(NSArray<TWTRTweet *> *tweets, NSError *error) {
+        XCTAssertNil(tweets);
+        XCTAssertEqualObjects(error.domain, TWTRAPIErrorDomain);
+        [firstExpectation fulfill];
+    }];
+    [self.batcher loadTweetsWithIDs:@[@"483693675445100546", @"484071743238066176"] APIClient:self.stubAPIClient additionalParameters:nil completion:^(NSArray<TWTRTweet *> *tweets, NSError *error) {
+        XCTAssertNil(tweets);
+        XCTAssertEqualObjects(error.domain, TWTRAPIErrorDomain);
+        [secondExpectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertEqual(self.fetchedTweets.count, 0);
+}
+
+@end
@@ -22,6 +22,7 @@
 #import "TWTRTweetMediaEntity.h"
 #import "TWTRTweet_Private.h"
 #import "TWTRVideoDeeplinkConfiguration.h"
+#import "TWTRVideoMetaData.h"
 #import "TWTRVideoPlaybackConfiguration.h"
 
 @interface TWTRVideoPlaybackConfigurationTests : XCTestCase
@@ -54,6 +55,23 @@
     XCTAssertEqualWithAccuracy(videoConfig.aspectRatio, 16.0 / 9.0, 0.1);
     XCTAssertEqual(videoConfig.duration, 5.3);
     XCTAssertEqual(videoConfig.mediaType, TWTRMediaTypeVideo);
+    XCTAssertEqual(videoConfig.videoVariants.count, 6);
+}
+
+- (void)testVideoTweet_VideoURLForRenderedPixelSize
+{
+    TWTRVideoPlaybackConfiguration *videoConfig = [TWTRVideoPlaybackConfiguration playbackConfigurationForTweetMediaEntity:self.videoTweet.media.firstObject];
+
+    XCTAssertEqualObjects([videoConfig videoVariantForRenderedPixelSize:CGSizeMake(1, 1)].URL.absoluteString, @"https://video.twimg.com/ext_tw_video/663898843579179008/pu/vid/320x180/Le46Kr7XaM-DcioQ.mp4");
+}
+
+- (void)testVineCard_VideoURLForRenderedPixelSizeFallsBackToVideoURL
+{
+    TWTRVideoPlaybackConfiguration *videoConfig = [TWTRVideoPlaybackConfiguration playbackConfigurationForCardEntity:self.vineTweet.cardEntity URLEntities:self.vineTweet.urls];
+
+    XCTAssertEqual(videoConfig.videoVariants.count, 0);
+    XCTAssertNil([videoConfig videoVariantForRenderedPixelSize:CGSizeMake(640, 640)]);
+    XCTAssertEqualObjects([videoConfig videoURLForRenderedPixelSize:CGSizeMake(640, 640)], videoConfig.videoURL);
 }
 
 - (void)testVineCard_VideoPlaybackConfiguration
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+#import "TWTRVideoMetaData.h"
+#import "TWTRVideoVariantSelector.h"
+
+static NSString *const TWTRTestVideoURLPrefix = @"https://video.twimg.com/ext_tw_video/663898843579179008/pu";
+
+@interface TWTRVideoVariantSelectorTests : XCTestCase
+
+@property (nonatomic, readonly) TWTRVideoMetaDataVariant *lowVariant;
+@property (nonatomic, readonly) TWTRVideoMetaDataVariant *mediumVariant;
+@property (nonatomic, readonly) TWTRVideoMetaDataVariant *highVariant;
+@property (nonatomic, readonly) TWTRVideoMetaDataVariant *webmVariant;
+@property (nonatomic, readonly) TWTRVideoMetaDataVariant *streamingVariant;
+@property (nonatomic, readonly) NSArray<TWTRVideoMetaDataVariant *> *variants;
+
+@end
+
+@implementation TWTRVideoVariantSelectorTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    _lowVariant = [self variantWithContentType:TWTRMediaTypeMP4 bitrate:@320000 path:@"vid/320x180/low.mp4"];
+    _mediumVariant = [self variantWithContentType:TWTRMediaTypeMP4 bitrate:@832000 path:@"vid/640x360/medium.mp4"];
+    _highVariant = [self variantWithContentType:TWTRMediaTypeMP4 bitrate:@2176000 path:@"vid/1280x720/high.mp4"];
+    _webmVariant = [self variantWithContentType:@"video/webm" bitrate:@832000 path:@"vid/640x360/medium.webm"];
+    _streamingVariant = [self variantWithContentType:TWTRMediaTypeM3u8 bitrate:nil path:@"pl/playlist.m3u8"];
+
+    // Deliberately out of bitrate order, like the API returns them.
+    _variants = @[self.highVariant, self.streamingVariant, self.webmVariant, self.lowVariant, self.mediumVariant];
+}
+
+- (TWTRVideoMetaDataVariant *)variantWithContentType:(NSString *)contentType bitrate:(NSNumber *)bitrate path:(NSString *)path
+{
+    NSMutableDictionary *JSON = [@{@"content_type": contentType, @"url": [NSString stringWithFormat:@"%@/%@", TWTRTestVideoURLPrefix, path]} mutableCopy];
+    JSON[@"bitrate"] = bitrate;
+    return [[TWTRVideoMetaDataVariant alloc] initWithJSONDictionary:JSON];
+}
+
+- (TWTRVideoMetaDataVariant *)variantForSize:(CGSize)size throughput:(double)throughput
+{
+    return [TWTRVideoVariantSelector variantFromVariants:self.variants renderedPixelSize:size throughput:throughput prefersReducedDataUsage:NO];
+}
+
+#pragma mark - Pixel Size
+
+- (void)testPixelSize_ParsedFromURL
+{
+    XCTAssertTrue(CGSizeEqualToSize([TWTRVideoVariantSelector pixelSizeOfVariant:self.lowVariant], CGSizeMake(320, 180)));
+    XCTAssertTrue(CGSizeEqualToSize([TWTRVideoVariantSelector pixelSizeOfVariant:self.highVariant], CGSizeMake(1280, 720)));
+}
+
+- (void)testPixelSize_ZeroWithoutResolutionInURL
+{
+    XCTAssertTrue(CGSizeEqualToSize([TWTRVideoVariantSelector pixelSizeOfVariant:self.streamingVariant], CGSizeZero));
+
+    TWTRVideoMetaDataVariant *variant = [self variantWithContentType:TWTRMediaTypeMP4 bitrate:@1 path:@"vid/640x/video.mp4"];
+    XCTAssertTrue(CGSizeEqualToSize([TWTRVideoVariantSelector pixelSizeOfVariant:variant], CGSizeZero));
+}
+
+#pragma mark - Lowest Bitrate
+
+- (void)testLowestBitrate_IgnoresOtherContentTypes
+{
+    TWTRVideoMetaDataVariant *cheapWebm = [self variantWithContentType:@"video/webm" bitrate:@1 path:@"vid/160x90/tiny.webm"];
+    NSArray *variants = [self.variants arrayByAddingObject:cheapWebm];
+
+    XCTAssertEqual([TWTRVideoVariantSelector lowestBitrateVariantFromVariants:variants], self.lowVariant);
+}
+
+- (void)testLowestBitrate_NilWithoutMP4
+{
+    XCTAssertNil([TWTRVideoVariantSelector lowestBitrateVariantFromVariants:@[self.streamingVariant, self.webmVariant]]);
+}
+
+#pragma mark - Selection
+
+- (void)testSelection_SmallestVariantCoveringView
+{
+    XCTAssertEqual([self variantForSize:CGSizeMake(200, 112) throughput:0], self.lowVariant);
+    XCTAssertEqual([self variantForSize:CGSizeMake(320, 180) throughput:0], self.lowVariant);
+    XCTAssertEqual([self variantForSize:CGSizeMake(321, 181) throughput:0], self.mediumVariant);
+    XCTAssertEqual([self variantForSize:CGSizeMake(1280, 720) throughput:0], self.highVariant);
+}
+
+- (void)testSelection_UnknownSizeUsesSmallest
+{
+    XCTAssertEqual([self variantForSize:CGSizeZero throughput:0], self.lowVariant);
+}
+
+- (void)testSelection_AspectFitIntoDifferentShape
+{
+    // A 16:9 video in a square view is limited by its width.
+    XCTAssertEqual([self variantForSize:CGSizeMake(640, 640) throughput:0], self.mediumVariant);
+    // In a very wide view it is limited by its height.
+    XCTAssertEqual([self variantForSize:CGSizeMake(2000, 360) throughput:0], self.mediumVariant);
+}
+
+- (void)testSelection_LargerThanAllVariantsUsesLargest
+{
+    XCTAssertEqual([self variantForSize:CGSizeMake(2560, 1440) throughput:0], self.highVariant);
+}
+
+- (void)testSelection_LimitedByThroughput
+{
+    CGSize fullscreen = CGSizeMake(1920, 1080);
+
+    XCTAssertEqual([self variantForSize:fullscreen throughput:10000000], self.highVariant);
+    XCTAssertEqual([self variantForSize:fullscreen throughput:2000000], self.mediumVariant);
+    XCTAssertEqual([self variantForSize:fullscreen throughput:500000], self.lowVariant);
+}
+
+- (void)testSelection_KeepsHeadroomBelowThroughput
+{
+    // Exactly the medium bitrate is not enough to sustain it.
+    XCTAssertEqual([self variantForSize:CGSizeMake(640, 360) throughput:832000], self.lowVariant);
+}
+
+- (void)testSelection_NothingSustainableUsesLowest
+{
+    XCTAssertEqual([self variantForSize:CGSizeMake(1280, 720) throughput:1000], self.lowVariant);
+}
+
+- (void)testSelection_ReducedDataUsageUsesLowest
+{
+    TWTRVideoMetaDataVariant *variant = [TWTRVideoVariantSelector variantFromVariants:self.variants renderedPixelSize:CGSizeMake(1280, 720) throughput:10000000 prefersReducedDataUsage:YES];
+    XCTAssertEqual(variant, self.lowVariant);
+}
+
+- (void)testSelection_StreamingOnlyWithoutMP4
+{
+    NSArray *variants = @[self.webmVariant, self.streamingVariant];
+
+    XCTAssertEqual([TWTRVideoVariantSelector variantFromVariants:variants renderedPixelSize:CGSizeMake(640, 360) throughput:0 prefersReducedDataUsage:NO], self.streamingVariant);
+    XCTAssertEqual([TWTRVideoVariantSelector variantFromVariants:variants renderedPixelSize:CGSizeMake(640, 360) throughput:0 prefersReducedDataUsage:YES], self.streamingVariant);
+}
+
+- (void)testSelection_NilWithoutPlayableVariants
+{
+    XCTAssertNil([TWTRVideoVariantSelector variantFromVariants:@[] renderedPixelSize:CGSizeZero throughput:0 prefersReducedDataUsage:NO]);
+    XCTAssertNil([TWTRVideoVariantSelector variantFromVariants:@[self.webmVariant] renderedPixelSize:CGSizeZero throughput:0 prefersReducedDataUsage:NO]);
+}
+
+- (void)testSelection_UnknownResolutionsUseLowest
+{
+    TWTRVideoMetaDataVariant *first = [self variantWithContentType:TWTRMediaTypeMP4 bitrate:@900000 path:@"first.mp4"];
+    TWTRVideoMetaDataVariant *second = [self variantWithContentType:TWTRMediaTypeMP4 bitrate:@300000 path:@"second.mp4"];
+
+    XCTAssertEqual([TWTRVideoVariantSelector variantFromVariants:@[first, second] renderedPixelSize:CGSizeMake(1280, 720) throughput:0 prefersReducedDataUsage:NO], second);
+}
+
+- (void)testSelection_NeverAboveSustainableBitrateAndNeverLargerThanNeeded
+{
+    NSArray<NSValue *> *sizes = @[[NSValue valueWithCGSize:CGSizeZero], [NSValue valueWithCGSize:CGSizeMake(300, 170)], [NSValue valueWithCGSize:CGSizeMake(750, 422)], [NSValue valueWithCGSize:CGSizeMake(1242, 2208)], [NSValue valueWithCGSize:CGSizeMake(2208, 1242)]];
+    NSArray<NSNumber *> *throughputs = @[@0, @100000, @500000, @1200000, @3000000, @50000000];
+    NSArray<TWTRVideoMetaDataVariant *> *ascending = @[self.lowVariant, self.mediumVariant, self.highVariant];
+
+    for (NSValue *sizeValue in sizes) {
+        CGSize size = sizeValue.CGSizeValue;
+        for (NSNumber *throughputNumber in throughputs) {
+            double throughput = throughputNumber.doubleValue;
+            TWTRVideoMetaDataVariant *variant = [self variantForSize:size throughput:throughput];
+            NSUInteger index = [ascending indexOfObject:variant];
+            XCTAssertNotEqual(index, NSNotFound);
+
+            if (index > 0) {
+                XCTAssertTrue(throughput == 0 || variant.bitrate <= throughput, @"%@ at %f", variant.URL, throughput);
+
+                CGSize smallerPixelSize = [TWTRVideoVariantSelector pixelSizeOfVariant:ascending[index - 1]];
+                XCTAssertTrue(smallerPixelSize.width < size.width && smallerPixelSize.height < size.height, @"%@ for %@", variant.URL, NSStringFromCGSize(size));
+            }
+        }
+    }
+}
+
+@end
@@ -24,5 +24,6 @@
 @interface TWTRSampleSubscriber : NSObject <TWTRSubscriber>
 
 @property (nonatomic) id latestObject;
+@property (nonatomic) NSUInteger updateCount;
 
 @end
@@ -22,6 +22,7 @@
 - (void)objectUpdated:(id)object
 {
     self.latestObject = object;
+    self.updateCount++;
 }
 
 @end
@@ -117,4 +117,50 @@ BOOL fillsSuperviewVerically(UIView *subview)
     XCTAssert(isLeftOf(self.view3, self.view4));
 }
 
+#pragma mark - Frame Layout
+
+- (void)testFrames_singleViewFillsBounds
+{
+    NSArray<NSValue *> *frames = [TWTRMultiPhotoLayout framesForViewCount:1 inBounds:self.superview.bounds];
+
+    XCTAssertEqual(frames.count, 1);
+    XCTAssert(CGRectEqualToRect([frames[0] CGRectValue], self.superview.bounds));
+}
+
+- (void)testFrames_twoViewsSplitWidth
+{
+    NSArray<NSValue *> *frames = [TWTRMultiPhotoLayout framesForViewCount:2 inBounds:self.superview.bounds];
+
+    XCTAssertEqual(frames.count, 2);
+    XCTAssert(CGRectEqualToRect([frames[0] CGRectValue], CGRectMake(0, 0, 159.75, 200)));
+    XCTAssert(CGRectEqualToRect([frames[1] CGRectValue], CGRectMake(160.25, 0, 159.75, 200)));
+}
+
+- (void)testFrames_threeViewsStackOnTheRight
+{
+    NSArray<NSValue *> *frames = [TWTRMultiPhotoLayout framesForViewCount:3 inBounds:self.superview.bounds];
+
+    XCTAssertEqual(frames.count, 3);
+    XCTAssert(CGRectEqualToRect([frames[0] CGRectValue], CGRectMake(0, 0, 159.75, 200)));
+    XCTAssert(CGRectEqualToRect([frames[1] CGRectValue], CGRectMake(160.25, 0, 159.75, 99.75)));
+    XCTAssert(CGRectEqualToRect([frames[2] CGRectValue], CGRectMake(160.25, 100.25, 159.75, 99.75)));
+}
+
+- (void)testFrames_emptyForUnsupportedCount
+{
+    XCTAssertEqual([TWTRMultiPhotoLayout framesForViewCount:0 inBounds:self.superview.bounds].count, 0);
+    XCTAssertEqual([TWTRMultiPhotoLayout framesForViewCount:5 inBounds:self.superview.bounds].count, 0);
+}
+
+- (void)testSetFrames_fourViews
+{
+    NSArray *views = @[self.view1, self.view2, self.view3, self.view4];
+    [TWTRMultiPhotoLayout setFramesForViews:views inBounds:self.superview.bounds];
+
+    XCTAssert(isAbove(self.view1, self.view3));
+    XCTAssert(isAbove(self.view2, self.view4));
+    XCTAssert(isLeftOf(self.view1, self.view2));
+    XCTAssert(isLeftOf(self.view3, self.view4));
+}
+
 @end
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+#import "TWTRTypesetterCache.h"
+
+@interface TWTRTypesetterCacheTests : XCTestCase
+
+@property (nonatomic) TWTRTypesetterCache *cache;
+@property (nonatomic) NSAttributedString *text;
+
+@end
+
+@implementation TWTRTypesetterCacheTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.cache = [[TWTRTypesetterCache alloc] initWithCountLimit:2];
+    self.text = [self attributedStringWithString:@"Just setting up my twttr. A slightly longer tweet that will need to wrap over a few lines."];
+}
+
+- (NSAttributedString *)attributedStringWithString:(NSString *)string
+{
+    return [[NSAttributedString alloc] initWithString:string attributes:@{NSFontAttributeName: [UIFont systemFontOfSize:14]}];
+}
+
+- (void)testCopyFramesetter_sharedForEqualStrings
+{
+    CTFramesetterRef first = [self.cache copyFramesetterForAttributedString:self.text];
+    CTFramesetterRef second = [self.cache copyFramesetterForAttributedString:[self.text mutableCopy]];
+
+    XCTAssertTrue(first != NULL);
+    XCTAssertEqual(first, second);
+    XCTAssertEqual(self.cache.count, 1);
+
+    CFRelease(first);
+    CFRelease(second);
+}
+
+- (void)testCopyFramesetter_distinctForDifferentStrings
+{
+    CTFramesetterRef first = [self.cache copyFramesetterForAttributedString:self.text];
+    CTFramesetterRef second = [self.cache copyFramesetterForAttributedString:[self attributedStringWithString:@"Other"]];
+
+    XCTAssertNotEqual(first, second);
+
+    CFRelease(first);
+    CFRelease(second);
+}
+
+- (void)testCopyFramesetter_survivesEviction
+{
+    CTFramesetterRef framesetter = [self.cache copyFramesetterForAttributedString:self.text];
+    [self.cache removeAllObjects];
+
+    CGSize size = CTFramesetterSuggestFrameSizeWithConstraints(framesetter, CFRangeMake(0, 0), NULL, CGSizeMake(100, CGFLOAT_MAX), NULL);
+    XCTAssertGreaterThan(size.height, 0);
+
+    CFRelease(framesetter);
+}
+
+- (void)testLayout_reusedForSameWidthAndLines
+{
+    TWTRTypesetterLayout *first = [self.cache layoutForAttributedString:self.text width:100 numberOfLines:0];
+    TWTRTypesetterLayout *second = [self.cache layoutForAttributedString:[self.text copy] width:100 numberOfLines:0];
+
+    XCTAssertEqual(first, second);
+}
+
+- (void)testLayout_distinctForDifferentWidths
+{
+    TWTRTypesetterLayout *narrow = [self.cache layoutForAttributedString:self.text width:100 numberOfLines:0];
+    TWTRTypesetterLayout *wide = [self.cache layoutForAttributedString:self.text width:300 numberOfLines:0];
+
+    XCTAssertNotEqual(narrow, wide);
+    XCTAssertGreaterThan([narrow.lineRanges count], [wide.lineRanges count]);
+    XCTAssertGreaterThan(narrow.suggestedSize.height, wide.suggestedSize.height);
+}
+
+- (void)testLayout_lineRangesCoverString
+{
+    TWTRTypesetterLayout *layout = [self.cache layoutForAttributedString:self.text width:100 numberOfLines:0];
+
+    NSUInteger location = 0;
+    for (NSValue *value in layout.lineRanges) {
+        XCTAssertEqual([value rangeValue].location, location);
+        location = NSMaxRange([value rangeValue]);
+    }
+    XCTAssertEqual(location, self.text.length);
+}
+
+- (void)testLayout_limitedToNumberOfLines
+{
+    TWTRTypesetterLayout *unlimited = [self.cache layoutForAttributedString:self.text width:100 numberOfLines:0];
+    TWTRTypesetterLayout *limited = [self.cache layoutForAttributedString:self.text width:100 numberOfLines:2];
+
+    XCTAssertEqual([limited.lineRanges count], 2);
+    XCTAssertLessThan(limited.suggestedSize.height, unlimited.suggestedSize.height);
+}
+
+- (void)testLayout_singleLineIgnoresWidth
+{
+    TWTRTypesetterLayout *narrow = [self.cache layoutForAttributedString:self.text width:100 numberOfLines:1];
+    TWTRTypesetterLayout *wide = [self.cache layoutForAttributedString:self.text width:300 numberOfLines:1];
+
+    XCTAssertEqual(narrow, wide);
+    XCTAssertGreaterThan(narrow.suggestedSize.width, 300);
+}
+
+- (void)testLayout_suggestedSizeIsRoundedUp
+{
+    CGSize size = [self.cache layoutForAttributedString:self.text width:100 numberOfLines:0].suggestedSize;
+
+    XCTAssertEqual(size.width, ceil(size.width));
+    XCTAssertEqual(size.height, ceil(size.height));
+}
+
+- (void)testLayout_nilString
+{
+    NSAttributedString *text = nil;
+    TWTRTypesetterLayout *layout = [self.cache layoutForAttributedString:text width:100 numberOfLines:0];
+
+    XCTAssertTrue(CGSizeEqualToSize(layout.suggestedSize, CGSizeZero));
+    XCTAssertEqual(self.cache.count, 0);
+}
+
+- (void)testEviction_leastRecentlyUsedFirst
+{
+    NSAttributedString *second = [self attributedStringWithString:@"Second"];
+    NSAttributedString *third = [self attributedStringWithString:@"Third"];
+
+    TWTRTypesetterLayout *firstLayout = [self.cache layoutForAttributedString:self.text width:100 numberOfLines:0];
+    TWTRTypesetterLayout *secondLayout = [self.cache layoutForAttributedString:second width:100 numberOfLines:0];
+    [self.cache layoutForAttributedString:self.text width:100 numberOfLines:0];
+    [self.cache layoutForAttributedString:third width:100 numberOfLines:0];
+
+    XCTAssertEqual(self.cache.count, 2);
+    XCTAssertEqual([self.cache layoutForAttributedString:self.text width:100 numberOfLines:0], firstLayout);
+    XCTAssertNotEqual([self.cache layoutForAttributedString:second width:100 numberOfLines:0], secondLayout);
+}
+
+- (void)testRemoveAllObjects
+{
+    [self.cache layoutForAttributedString:self.text width:100 numberOfLines:0];
+    [self.cache removeAllObjects];
+
+    XCTAssertEqual(self.cache.count, 0);
+}
+
+- (void)testMemoryCost_growsWithEntries
+{
+    XCTAssertEqual([self.cache memoryCost], 0);
+
+    [self.cache layoutForAttributedString:self.text width:100 numberOfLines:0];
+    NSUInteger singleEntryCost = [self.cache memoryCost];
+    XCTAssertGreaterThan(singleEntryCost, 0);
+
+    [self.cache layoutForAttributedString:[self attributedStringWithString:@"Another tweet"] width:100 numberOfLines:0];
+    XCTAssertGreaterThan([self.cache memoryCost], singleEntryCost);
+}
+
+- (void)testTrimToMemoryCost_evictsLeastRecentlyUsed
+{
+    NSAttributedString *other = [self attributedStringWithString:@"Another tweet"];
+    [self.cache layoutForAttributedString:self.text width:100 numberOfLines:0];
+    [self.cache layoutForAttributedString:other width:100 numberOfLines:0];
+    TWTRTypesetterLayout *recent = [self.cache layoutForAttributedString:other width:100 numberOfLines:0];
+
+    [self.cache trimToMemoryCost:[self.cache memoryCost] - 1];
+
+    XCTAssertEqual(self.cache.count, 1);
+    XCTAssertEqual([self.cache layoutForAttributedString:other width:100 numberOfLines:0], recent);
+}
+
+- (void)testTrimToMemoryCost_zeroEmptiesCache
+{
+    [self.cache layoutForAttributedString:self.text width:100 numberOfLines:0];
+    [self.cache trimToMemoryCost:0];
+
+    XCTAssertEqual(self.cache.count, 0);
+    XCTAssertEqual([self.cache memoryCost], 0);
+}
+
+- (void)testConcurrentAccess
+{
+    dispatch_apply(64, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t iteration) {
+        NSAttributedString *text = [self attributedStringWithString:[NSString stringWithFormat:@"Tweet %zu", iteration % 4]];
+        CTFramesetterRef framesetter = [self.cache copyFramesetterForAttributedString:text];
+        [self.cache layoutForAttributedString:text width:(CGFloat)(100 + iteration % 3) numberOfLines:0];
+        CFRelease(framesetter);
+    });
+
+    XCTAssertLessThanOrEqual(self.cache.count, 2);
+}
+
+@end
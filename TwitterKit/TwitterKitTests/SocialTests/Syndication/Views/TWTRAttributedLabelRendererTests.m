@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+#import "TWTRAttributedLabel.h"
+#import "TWTRAttributedLabelRenderer.h"
+
+@interface TWTRAttributedLabelRendererTests : XCTestCase
+
+@property (nonatomic) TWTRAttributedLabel *label;
+
+@end
+
+@implementation TWTRAttributedLabelRendererTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.label = [[TWTRAttributedLabel alloc] initWithFrame:CGRectMake(0, 0, 200, 60)];
+    self.label.numberOfLines = 0;
+    self.label.textColor = [UIColor blackColor];
+    self.label.text = @"Just setting up my twttr";
+}
+
+- (TWTRAttributedLabelRenderer *)renderer
+{
+    return [[TWTRAttributedLabelRenderer alloc] initWithLabel:self.label attributedString:self.label.attributedText bounds:self.label.bounds];
+}
+
+- (NSData *)pixelDataOfImage:(CGImageRef)image
+{
+    return CFBridgingRelease(CGDataProviderCopyData(CGImageGetDataProvider(image)));
+}
+
+- (BOOL)imageHasVisiblePixels:(CGImageRef)image
+{
+    NSData *data = [self pixelDataOfImage:image];
+    const uint8_t *bytes = data.bytes;
+
+    // Pixels are BGRA with the alpha component last in memory
+    for (NSUInteger i = 3; i < data.length; i += 4) {
+        if (bytes[i] > 0) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (void)testNewImage_sizeMatchesBoundsAtScale
+{
+    CGImageRef image = [[self renderer] newImageWithScale:2];
+
+    XCTAssertEqual(CGImageGetWidth(image), 400);
+    XCTAssertEqual(CGImageGetHeight(image), 120);
+
+    CGImageRelease(image);
+}
+
+- (void)testNewImage_drawsText
+{
+    CGImageRef image = [[self renderer] newImageWithScale:1];
+
+    XCTAssertTrue([self imageHasVisiblePixels:image]);
+
+    CGImageRelease(image);
+}
+
+- (void)testNewImage_emptyStringIsTransparent
+{
+    TWTRAttributedLabelRenderer *renderer = [[TWTRAttributedLabelRenderer alloc] initWithLabel:self.label attributedString:[[NSAttributedString alloc] initWithString:@""] bounds:self.label.bounds];
+    CGImageRef image = [renderer newImageWithScale:1];
+
+    XCTAssertFalse([self imageHasVisiblePixels:image]);
+
+    CGImageRelease(image);
+}
+
+- (void)testNewImage_isDeterministic
+{
+    CGImageRef first = [[self renderer] newImageWithScale:2];
+    CGImageRef second = [[self renderer] newImageWithScale:2];
+
+    XCTAssertEqualObjects([self pixelDataOfImage:first], [self pixelDataOfImage:second]);
+
+    CGImageRelease(first);
+    CGImageRelease(second);
+}
+
+- (void)testNewImage_sameOnBackgroundThread
+{
+    TWTRAttributedLabelRenderer *renderer = [self renderer];
+    CGImageRef mainThreadImage = [renderer newImageWithScale:2];
+    __block NSData *backgroundPixels;
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"rendered"];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        CGImageRef image = [renderer newImageWithScale:2];
+        backgroundPixels = [self pixelDataOfImage:image];
+        CGImageRelease(image);
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    XCTAssertEqualObjects([self pixelDataOfImage:mainThreadImage], backgroundPixels);
+
+    CGImageRelease(mainThreadImage);
+}
+
+- (void)testNewImage_emptyBounds
+{
+    TWTRAttributedLabelRenderer *renderer = [[TWTRAttributedLabelRenderer alloc] initWithLabel:self.label attributedString:self.label.attributedText bounds:CGRectZero];
+
+    XCTAssertTrue([renderer newImageWithScale:2] == NULL);
+}
+
+- (void)testTextRect_matchesLabel
+{
+    CGRect labelTextRect = [self.label textRectForBounds:self.label.bounds limitedToNumberOfLines:self.label.numberOfLines];
+
+    XCTAssertTrue(CGRectEqualToRect([self renderer].textRect, labelTextRect));
+}
+
+- (void)testShadow_resolvedForHighlightedState
+{
+    self.label.shadowColor = [UIColor redColor];
+    self.label.highlightedShadowColor = [UIColor blueColor];
+    XCTAssertEqualObjects([self renderer].shadowColor, [UIColor redColor]);
+
+    self.label.highlighted = YES;
+    XCTAssertEqualObjects([self renderer].shadowColor, [UIColor blueColor]);
+}
+
+- (void)testHighlightedTextColor_resolvedForHighlightedState
+{
+    self.label.highlightedTextColor = [UIColor whiteColor];
+    XCTAssertNil([self renderer].highlightedTextColor);
+
+    self.label.highlighted = YES;
+    XCTAssertEqualObjects([self renderer].highlightedTextColor, [UIColor whiteColor]);
+}
+
+- (void)testDrawHighlight_drawsBackgroundOfRange
+{
+    TWTRAttributedLabelRenderer *renderer = [self renderer];
+    CGMutablePathRef path = CGPathCreateMutable();
+    CGPathAddRect(path, NULL, renderer.textRect);
+    CTFramesetterRef framesetter = CTFramesetterCreateWithAttributedString((__bridge CFAttributedStringRef)self.label.attributedText);
+    CTFrameRef frame = CTFramesetterCreateFrame(framesetter, CFRangeMake(0, 0), path, NULL);
+
+    UIGraphicsBeginImageContextWithOptions(self.label.bounds.size, NO, 1);
+    [renderer drawHighlightOfRange:NSMakeRange(5, 7) withAttributes:@{kTWTRBackgroundFillColorAttributeName: [UIColor redColor]} frame:frame inContext:UIGraphicsGetCurrentContext()];
+    UIImage *highlight = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+
+    XCTAssertTrue([self imageHasVisiblePixels:highlight.CGImage]);
+
+    CFRelease(frame);
+    CFRelease(framesetter);
+    CFRelease(path);
+}
+
+- (void)testDisplaysAsynchronously_setsLayerContents
+{
+    self.label.displaysAsynchronously = YES;
+    [self.label.layer displayIfNeeded];
+
+    NSPredicate *hasContents = [NSPredicate predicateWithBlock:^BOOL(TWTRAttributedLabel *label, NSDictionary *bindings) {
+        return label.layer.sublayers.firstObject.contents != nil;
+    }];
+    [self expectationForPredicate:hasContents evaluatedWithObject:self.label handler:nil];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+- (void)testDisplaysAsynchronously_newTextClearsPreviousContents
+{
+    self.label.displaysAsynchronously = YES;
+    [self.label.layer displayIfNeeded];
+
+    NSPredicate *hasContents = [NSPredicate predicateWithBlock:^BOOL(TWTRAttributedLabel *label, NSDictionary *bindings) {
+        return label.layer.sublayers.firstObject.contents != nil;
+    }];
+    [self expectationForPredicate:hasContents evaluatedWithObject:self.label handler:nil];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    self.label.text = @"Another tweet";
+
+    XCTAssertNil(self.label.layer.sublayers.firstObject.contents);
+}
+
+@end
@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+#import "TWTRAttributedLabel.h"
+#import "TWTRTweetEntity.h"
+#import "TWTRTweetPresenter.h"
+
+@interface TWTRTweetEntityRange ()
+- (instancetype)initWithEntity:(TWTRTweetEntity *)entity textRange:(NSRange)range;
+@end
+
+@interface TWTRAttributedLabel ()
+- (TWTRTweetEntityRange *)entityAtCharacterIndex:(CFIndex)idx;
+- (CFIndex)characterIndexAtPoint:(CGPoint)p;
+- (NSArray<NSValue *> *)entityFrames;
+- (void)setActiveLink:(TWTRTweetEntityRange *)activeLink;
+@end
+
+@interface TWTRAttributedLabelTests : XCTestCase
+
+@property (nonatomic) TWTRAttributedLabel *label;
+
+@end
+
+@implementation TWTRAttributedLabelTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.label = [[TWTRAttributedLabel alloc] initWithFrame:CGRectMake(0, 0, 300, 100)];
+    self.label.numberOfLines = 0;
+    self.label.verticalAlignment = TWTRAttributedLabelVerticalAlignmentTop;
+    self.label.text = @"Hello #twitterkit and @TwitterDev";
+}
+
+- (TWTRTweetEntityRange *)entityRangeWithRange:(NSRange)range
+{
+    TWTRTweetEntity *entity = [[TWTRTweetEntity alloc] initWithStartIndex:(NSInteger)range.location endIndex:(NSInteger)NSMaxRange(range)];
+    return [[TWTRTweetEntityRange alloc] initWithEntity:entity textRange:range];
+}
+
+#pragma mark - Entity Index
+
+- (void)testEntityAtCharacterIndex_findsContainingEntity
+{
+    TWTRTweetEntityRange *hashtag = [self entityRangeWithRange:NSMakeRange(6, 11)];
+    TWTRTweetEntityRange *mention = [self entityRangeWithRange:NSMakeRange(22, 11)];
+    [self.label addLinksForEntityRanges:@[mention, hashtag]];
+
+    XCTAssertNil([self.label entityAtCharacterIndex:0]);
+    XCTAssertNil([self.label entityAtCharacterIndex:5]);
+    XCTAssertEqual([self.label entityAtCharacterIndex:6], hashtag);
+    XCTAssertEqual([self.label entityAtCharacterIndex:16], hashtag);
+    XCTAssertNil([self.label entityAtCharacterIndex:17]);
+    XCTAssertEqual([self.label entityAtCharacterIndex:22], mention);
+    XCTAssertEqual([self.label entityAtCharacterIndex:32], mention);
+    XCTAssertNil([self.label entityAtCharacterIndex:33]);
+}
+
+- (void)testEntityAtCharacterIndex_prefersLastAddedOverlappingEntity
+{
+    TWTRTweetEntityRange *outer = [self entityRangeWithRange:NSMakeRange(0, 20)];
+    TWTRTweetEntityRange *inner = [self entityRangeWithRange:NSMakeRange(6, 4)];
+    [self.label addLinksForEntityRanges:@[outer, inner]];
+
+    XCTAssertEqual([self.label entityAtCharacterIndex:2], outer);
+    XCTAssertEqual([self.label entityAtCharacterIndex:7], inner);
+    XCTAssertEqual([self.label entityAtCharacterIndex:12], outer);
+}
+
+- (void)testEntityAtCharacterIndex_findsEntityBehindLongerEarlierRange
+{
+    TWTRTweetEntityRange *longRange = [self entityRangeWithRange:NSMakeRange(0, 30)];
+    TWTRTweetEntityRange *shortRange = [self entityRangeWithRange:NSMakeRange(2, 2)];
+    [self.label addLinksForEntityRanges:@[longRange, shortRange]];
+
+    XCTAssertEqual([self.label entityAtCharacterIndex:25], longRange);
+}
+
+- (void)testEntityAtCharacterIndex_notFound
+{
+    [self.label addLinksForEntityRanges:@[[self entityRangeWithRange:NSMakeRange(0, 5)]]];
+
+    XCTAssertNil([self.label entityAtCharacterIndex:NSNotFound]);
+}
+
+- (void)testEntityAtCharacterIndex_resetBySettingText
+{
+    [self.label addLinksForEntityRanges:@[[self entityRangeWithRange:NSMakeRange(0, 5)]]];
+    self.label.text = @"Hello";
+
+    XCTAssertNil([self.label entityAtCharacterIndex:0]);
+}
+
+#pragma mark - Hit Testing
+
+- (void)testEntityAtPoint_findsEntityOnFirstLine
+{
+    TWTRTweetEntityRange *entityRange = [self entityRangeWithRange:NSMakeRange(0, self.label.attributedText.length)];
+    [self.label addLinksForEntityRanges:@[entityRange]];
+
+    XCTAssertEqual([self.label entityAtPoint:CGPointMake(2, 5)], entityRange);
+}
+
+- (void)testEntityAtPoint_outsideBounds
+{
+    [self.label addLinksForEntityRanges:@[[self entityRangeWithRange:NSMakeRange(0, self.label.attributedText.length)]]];
+
+    XCTAssertNil([self.label entityAtPoint:CGPointMake(-10, 5)]);
+    XCTAssertNil([self.label entityAtPoint:CGPointMake(2, 500)]);
+}
+
+- (void)testEntityAtPoint_besideText
+{
+    [self.label addLinksForEntityRanges:@[[self entityRangeWithRange:NSMakeRange(0, self.label.attributedText.length)]]];
+
+    XCTAssertNil([self.label entityAtPoint:CGPointMake(295, 5)]);
+}
+
+- (void)testCharacterIndexAtPoint_belowLastLine
+{
+    XCTAssertEqual([self.label characterIndexAtPoint:CGPointMake(2, 95)], (CFIndex)NSNotFound);
+}
+
+- (void)testCharacterIndexAtPoint_followsTextChanges
+{
+    self.label.textAlignment = NSTextAlignmentLeft;
+    self.label.text = @"A";
+    XCTAssertEqual([self.label characterIndexAtPoint:CGPointMake(200, 5)], (CFIndex)NSNotFound);
+
+    self.label.text = @"A much longer line of text that fills the label";
+    XCTAssertNotEqual([self.label characterIndexAtPoint:CGPointMake(200, 5)], (CFIndex)NSNotFound);
+}
+
+#pragma mark - Entity Frames
+
+- (void)testEntityFrames_onePerEntityInsideBounds
+{
+    TWTRTweetEntityRange *hashtag = [self entityRangeWithRange:NSMakeRange(6, 11)];
+    TWTRTweetEntityRange *mention = [self entityRangeWithRange:NSMakeRange(22, 11)];
+    [self.label addLinksForEntityRanges:@[hashtag, mention]];
+
+    NSArray<NSValue *> *frames = [self.label entityFrames];
+    XCTAssertEqual([frames count], 2);
+
+    for (NSValue *value in frames) {
+        CGRect frame = [value CGRectValue];
+        XCTAssertGreaterThan(CGRectGetWidth(frame), 0);
+        XCTAssertGreaterThan(CGRectGetHeight(frame), 0);
+        XCTAssertTrue(CGRectContainsRect(CGRectInset(self.label.bounds, -1, -1), frame));
+    }
+}
+
+- (void)testEntityFrames_containPointsThatHitTheEntity
+{
+    TWTRTweetEntityRange *hashtag = [self entityRangeWithRange:NSMakeRange(6, 11)];
+    [self.label addLinksForEntityRanges:@[hashtag]];
+
+    CGRect frame = [[self.label entityFrames].firstObject CGRectValue];
+
+    XCTAssertEqual([self.label entityAtPoint:CGPointMake(CGRectGetMidX(frame), CGRectGetMidY(frame))], hashtag);
+}
+
+- (void)testEntityFrames_spanWrappedLines
+{
+    self.label.frame = CGRectMake(0, 0, 60, 300);
+    self.label.text = @"Hello #twitterkit and @TwitterDev";
+    TWTRTweetEntityRange *entityRange = [self entityRangeWithRange:NSMakeRange(0, self.label.attributedText.length)];
+    TWTRTweetEntityRange *firstWord = [self entityRangeWithRange:NSMakeRange(0, 5)];
+    [self.label addLinksForEntityRanges:@[entityRange, firstWord]];
+
+    NSArray<NSValue *> *frames = [self.label entityFrames];
+
+    XCTAssertGreaterThan(CGRectGetHeight([frames[0] CGRectValue]), CGRectGetHeight([frames[1] CGRectValue]));
+}
+
+- (void)testEntityFrames_invalidatedByBoundsChanges
+{
+    [self.label addLinksForEntityRanges:@[[self entityRangeWithRange:NSMakeRange(22, 11)]]];
+    CGRect wideFrame = [[self.label entityFrames].firstObject CGRectValue];
+
+    self.label.frame = CGRectMake(0, 0, 100, 300);
+    CGRect narrowFrame = [[self.label entityFrames].firstObject CGRectValue];
+
+    XCTAssertFalse(CGRectEqualToRect(wideFrame, narrowFrame));
+}
+
+- (void)testAccessibilityElements_linkElementPerEntity
+{
+    [self.label addLinksForEntityRanges:@[[self entityRangeWithRange:NSMakeRange(6, 11)], [self entityRangeWithRange:NSMakeRange(22, 11)]]];
+
+    XCTAssertEqual([self.label accessibilityElementCount], 3);
+    XCTAssertEqualObjects([[self.label accessibilityElementAtIndex:0] accessibilityLabel], @"#twitterkit");
+    XCTAssertEqualObjects([[self.label accessibilityElementAtIndex:1] accessibilityLabel], @"@TwitterDev");
+}
+
+#pragma mark - Link Highlighting
+
+- (CALayer *)visibleHighlightLayer
+{
+    for (CALayer *layer in self.label.layer.sublayers) {
+        if ([layer isKindOfClass:NSClassFromString(@"TWTRAttributedLabelHighlightLayer")] && !layer.hidden) {
+            return layer;
+        }
+    }
+    return nil;
+}
+
+- (void)testActiveLink_doesNotChangeText
+{
+    TWTRTweetEntityRange *hashtag = [self entityRangeWithRange:NSMakeRange(6, 11)];
+    [self.label addLinksForEntityRanges:@[hashtag]];
+    NSAttributedString *attributedText = self.label.attributedText;
+    NSArray<NSValue *> *entityFrames = [self.label entityFrames];
+
+    [self.label setActiveLink:hashtag];
+
+    XCTAssertEqual(self.label.attributedText, attributedText);
+    XCTAssertEqual([self.label entityFrames], entityFrames);
+}
+
+- (void)testActiveLink_showsAndHidesHighlight
+{
+    TWTRTweetEntityRange *hashtag = [self entityRangeWithRange:NSMakeRange(6, 11)];
+    [self.label addLinksForEntityRanges:@[hashtag]];
+
+    [self.label setActiveLink:hashtag];
+    XCTAssertNotNil([self visibleHighlightLayer]);
+    XCTAssertTrue(CGRectEqualToRect([self visibleHighlightLayer].frame, self.label.bounds));
+
+    [self.label setActiveLink:nil];
+    XCTAssertNil([self visibleHighlightLayer]);
+}
+
+- (void)testActiveLink_ignoresRangeOutsideText
+{
+    [self.label setActiveLink:[self entityRangeWithRange:NSMakeRange(30, 20)]];
+
+    XCTAssertNil([self visibleHighlightLayer]);
+}
+
+- (void)testActiveLink_hiddenBySettingText
+{
+    TWTRTweetEntityRange *hashtag = [self entityRangeWithRange:NSMakeRange(6, 11)];
+    [self.label addLinksForEntityRanges:@[hashtag]];
+    [self.label setActiveLink:hashtag];
+
+    self.label.text = @"Another tweet";
+
+    XCTAssertNil([self visibleHighlightLayer]);
+}
+
+@end
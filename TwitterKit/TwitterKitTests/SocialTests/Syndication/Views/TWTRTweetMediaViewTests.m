@@ -18,6 +18,7 @@
 #import <XCTest/XCTest.h>
 #import "TWTRFixtureLoader.h"
 #import "TWTRImageTestHelper.h"
+#import "TWTRPlayIcon.h"
 #import "TWTRTweet.h"
 #import "TWTRTweetImageView.h"
 #import "TWTRTweetMediaView.h"
@@ -210,6 +211,50 @@
     XCTAssertEqualObjects(self.videoMediaView.accessibilityLabel, @"Video Attachment");
 }
 
+#pragma mark - Reuse
+
+- (void)testConfigure_reusesImageViews
+{
+    TWTRTweetImageView *imageView = self.imageMediaView.imageViews.firstObject;
+
+    [self.imageMediaView configureWithTweet:[TWTRFixtureLoader obamaTweet] style:TWTRTweetViewStyleRegular];
+
+    XCTAssertEqual(self.imageMediaView.imageViews.count, 1);
+    XCTAssertEqual(self.imageMediaView.imageViews.firstObject, imageView);
+}
+
+- (void)testConfigure_hidesUnusedImageViews
+{
+    TWTRTweetImageView *imageView = self.imageMediaView.imageViews.firstObject;
+    NSUInteger subviewCount = self.imageMediaView.subviews.count;
+
+    [self.imageMediaView configureWithTweet:[TWTRFixtureLoader gatesTweet] style:TWTRTweetViewStyleRegular];
+
+    XCTAssertEqual(self.imageMediaView.imageViews.count, 0);
+    XCTAssertTrue(imageView.hidden);
+    XCTAssertNil(imageView.image);
+    XCTAssertEqual(self.imageMediaView.subviews.count, subviewCount);
+}
+
+- (void)testConfigure_doesNotStackPlayIcons
+{
+    [self.videoMediaView configureWithTweet:self.videoTweet style:TWTRTweetViewStyleRegular];
+    [self.videoMediaView configureWithTweet:self.videoTweet style:TWTRTweetViewStyleRegular];
+
+    NSIndexSet *playIconIndexes = [self.videoMediaView.imageViews.firstObject.subviews indexesOfObjectsPassingTest:^BOOL(UIView *subview, NSUInteger idx, BOOL *stop) {
+        return [subview isKindOfClass:[TWTRPlayIcon class]];
+    }];
+    XCTAssertEqual(playIconIndexes.count, 1);
+}
+
+- (void)testLayoutSubviews_fillsBoundsWithSingleImage
+{
+    self.imageMediaView.frame = CGRectMake(0, 0, 300, 150);
+    [self.imageMediaView layoutIfNeeded];
+
+    XCTAssertTrue(CGRectEqualToRect(self.imageMediaView.imageViews.firstObject.frame, self.imageMediaView.bounds));
+}
+
 @end
 
 @implementation TWTRTweetMediaViewDelegateStub
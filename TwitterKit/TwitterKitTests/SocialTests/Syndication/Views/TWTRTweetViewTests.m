@@ -501,6 +501,22 @@
     OCMVerifyAll(mockContentView);
 }
 
+- (void)testInlineVideoPixelSize_matchesLaidOutMediaView
+{
+    TWTRTweetView *tweetView = [[TWTRTweetView alloc] initWithTweet:self.obamaTweet style:TWTRTweetViewStyleCompact];
+    tweetView.frame = CGRectMake(0, 0, 320, 400);
+    [tweetView layoutIfNeeded];
+
+    CGSize pixelSize = [tweetView inlineVideoPixelSizeForTweet:self.videoTweet];
+
+    [tweetView configureWithTweet:self.videoTweet];
+    [tweetView layoutIfNeeded];
+    CGFloat scale = [UIScreen mainScreen].scale;
+    CGSize mediaViewSize = tweetView.contentView.mediaView.bounds.size;
+    XCTAssertEqualWithAccuracy(pixelSize.width, mediaViewSize.width * scale, 0.5);
+    XCTAssertEqualWithAccuracy(pixelSize.height, mediaViewSize.height * scale, scale);
+}
+
 - (void)testPauseVideo_quoteTweetWithPlayableMedia
 {
     id mockTweetView = OCMPartialMock(self.regularTweetView);
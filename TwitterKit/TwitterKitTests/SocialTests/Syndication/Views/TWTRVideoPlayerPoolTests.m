@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+#import "TWTRVideoPlayerPool.h"
+
+@interface TWTRVideoPlayerPoolTestsPlayer : NSObject
+
+@property (nonatomic, copy) NSURL *URL;
+@property (nonatomic) NSUInteger resetCount;
+
+@end
+
+@implementation TWTRVideoPlayerPoolTestsPlayer
+@end
+
+@interface TWTRVideoPlayerPoolTestsProvider : NSObject <TWTRVideoPlayerProviding>
+
+@property (nonatomic) NSUInteger createdPlayerCount;
+@property (nonatomic, readonly) NSMutableArray<TWTRVideoPlayerPoolTestsPlayer *> *prerollingPlayers;
+@property (nonatomic, readonly) NSMutableArray<void (^)(void)> *prerollCompletions;
+@property (nonatomic, readonly) NSMutableArray<TWTRVideoPlayerPoolTestsPlayer *> *cancelledPlayers;
+
+- (void)finishPrerollOfPlayerAtIndex:(NSUInteger)index;
+
+@end
+
+@implementation TWTRVideoPlayerPoolTestsProvider
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _prerollingPlayers = [NSMutableArray array];
+        _prerollCompletions = [NSMutableArray array];
+        _cancelledPlayers = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (id)playerWithURL:(NSURL *)URL
+{
+    self.createdPlayerCount++;
+
+    TWTRVideoPlayerPoolTestsPlayer *player = [[TWTRVideoPlayerPoolTestsPlayer alloc] init];
+    player.URL = URL;
+    return player;
+}
+
+- (void)prerollPlayer:(id)player completion:(void (^)(void))completion
+{
+    [self.prerollingPlayers addObject:player];
+    [self.prerollCompletions addObject:completion];
+}
+
+- (void)cancelPrerollOfPlayer:(id)player
+{
+    NSUInteger index = [self.prerollingPlayers indexOfObjectIdenticalTo:player];
+    if (index != NSNotFound) {
+        [self.prerollingPlayers removeObjectAtIndex:index];
+        [self.prerollCompletions removeObjectAtIndex:index];
+    }
+    [self.cancelledPlayers addObject:player];
+}
+
+- (void)resetPlayer:(id)player
+{
+    ((TWTRVideoPlayerPoolTestsPlayer *)player).resetCount++;
+}
+
+- (void)finishPrerollOfPlayerAtIndex:(NSUInteger)index
+{
+    void (^completion)(void) = self.prerollCompletions[index];
+    [self.prerollingPlayers removeObjectAtIndex:index];
+    [self.prerollCompletions removeObjectAtIndex:index];
+    completion();
+}
+
+@end
+
+@interface TWTRVideoPlayerPoolTests : XCTestCase
+
+@property (nonatomic) TWTRVideoPlayerPoolTestsProvider *provider;
+@property (nonatomic) TWTRVideoPlayerPool *pool;
+
+@end
+
+@implementation TWTRVideoPlayerPoolTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.provider = [[TWTRVideoPlayerPoolTestsProvider alloc] init];
+    self.pool = [[TWTRVideoPlayerPool alloc] initWithPlayerProvider:self.provider capacity:2 maximumConcurrentPrerolls:1];
+}
+
+- (NSURL *)URLForMediaID:(NSString *)mediaID
+{
+    return [NSURL URLWithString:[NSString stringWithFormat:@"https://video.twimg.com/%@.mp4", mediaID]];
+}
+
+- (void)testCheckOut_afterCheckIn_returnsSamePlayer
+{
+    id player = [self.pool checkOutPlayerForMediaID:@"1" URL:[self URLForMediaID:@"1"]];
+    [self.pool checkInPlayer:player forMediaID:@"1" URL:[self URLForMediaID:@"1"]];
+
+    id reusedPlayer = [self.pool checkOutPlayerForMediaID:@"1" URL:[self URLForMediaID:@"1"]];
+
+    XCTAssertEqual(reusedPlayer, player);
+    XCTAssertEqual([player resetCount], 1);
+    XCTAssertEqual(self.provider.createdPlayerCount, 1);
+    XCTAssertEqual(self.pool.idlePlayerCount, 0);
+}
+
+- (void)testCheckOut_withDifferentURL_createsNewPlayer
+{
+    id player = [self.pool checkOutPlayerForMediaID:@"1" URL:[self URLForMediaID:@"1"]];
+    [self.pool checkInPlayer:player forMediaID:@"1" URL:[self URLForMediaID:@"1"]];
+
+    id otherPlayer = [self.pool checkOutPlayerForMediaID:@"1" URL:[self URLForMediaID:@"1-hd"]];
+
+    XCTAssertNotEqual(otherPlayer, player);
+    XCTAssertEqual(self.pool.idlePlayerCount, 0);
+}
+
+- (void)testCheckIn_beyondCapacity_evictsLeastRecentlyUsedPlayer
+{
+    for (NSString *mediaID in @[@"1", @"2", @"3"]) {
+        id player = [self.pool checkOutPlayerForMediaID:mediaID URL:[self URLForMediaID:mediaID]];
+        [self.pool checkInPlayer:player forMediaID:mediaID URL:[self URLForMediaID:mediaID]];
+    }
+
+    XCTAssertEqual(self.pool.idlePlayerCount, 2);
+
+    [self.pool checkOutPlayerForMediaID:@"1" URL:[self URLForMediaID:@"1"]];
+
+    XCTAssertEqual(self.provider.createdPlayerCount, 4);
+}
+
+- (void)testPreroll_respectsConcurrencyLimitAndStartsNewestFirst
+{
+    self.pool = [[TWTRVideoPlayerPool alloc] initWithPlayerProvider:self.provider capacity:3 maximumConcurrentPrerolls:1];
+
+    [self.pool prerollPlayerForMediaID:@"1" URL:[self URLForMediaID:@"1"]];
+    [self.pool prerollPlayerForMediaID:@"2" URL:[self URLForMediaID:@"2"]];
+    [self.pool prerollPlayerForMediaID:@"3" URL:[self URLForMediaID:@"3"]];
+
+    XCTAssertEqual(self.provider.prerollingPlayers.count, 1);
+    XCTAssertEqualObjects(self.provider.prerollingPlayers.firstObject.URL, [self URLForMediaID:@"1"]);
+
+    [self.provider finishPrerollOfPlayerAtIndex:0];
+
+    XCTAssertEqual(self.provider.prerollingPlayers.count, 1);
+    XCTAssertEqualObjects(self.provider.prerollingPlayers.firstObject.URL, [self URLForMediaID:@"3"]);
+}
+
+- (void)testPreroll_beyondCapacity_cancelsEvictedPreroll
+{
+    [self.pool prerollPlayerForMediaID:@"1" URL:[self URLForMediaID:@"1"]];
+    id prerollingPlayer = self.provider.prerollingPlayers.firstObject;
+
+    [self.pool prerollPlayerForMediaID:@"2" URL:[self URLForMediaID:@"2"]];
+    [self.pool prerollPlayerForMediaID:@"3" URL:[self URLForMediaID:@"3"]];
+
+    XCTAssertEqual(self.pool.idlePlayerCount, 2);
+    XCTAssertEqualObjects(self.provider.cancelledPlayers, @[prerollingPlayer]);
+    XCTAssertEqualObjects(self.provider.prerollingPlayers.firstObject.URL, [self URLForMediaID:@"2"]);
+}
+
+- (void)testPreroll_thenCheckOut_returnsPrerolledPlayer
+{
+    [self.pool prerollPlayerForMediaID:@"1" URL:[self URLForMediaID:@"1"]];
+    id prerolledPlayer = self.provider.prerollingPlayers.firstObject;
+    [self.provider finishPrerollOfPlayerAtIndex:0];
+
+    XCTAssertEqual([self.pool checkOutPlayerForMediaID:@"1" URL:[self URLForMediaID:@"1"]], prerolledPlayer);
+    XCTAssertEqual(self.provider.createdPlayerCount, 1);
+}
+
+- (void)testCheckOut_whilePrerolling_freesPrerollSlot
+{
+    [self.pool prerollPlayerForMediaID:@"1" URL:[self URLForMediaID:@"1"]];
+    [self.pool prerollPlayerForMediaID:@"2" URL:[self URLForMediaID:@"2"]];
+
+    [self.pool checkOutPlayerForMediaID:@"1" URL:[self URLForMediaID:@"1"]];
+
+    XCTAssertEqual(self.provider.prerollingPlayers.count, 2);
+    XCTAssertEqual(self.provider.cancelledPlayers.count, 0);
+}
+
+- (void)testCancelPreroll_stopsRunningPrerollAndKeepsPlayer
+{
+    [self.pool prerollPlayerForMediaID:@"1" URL:[self URLForMediaID:@"1"]];
+    id player = self.provider.prerollingPlayers.firstObject;
+
+    [self.pool cancelPrerollForMediaID:@"1"];
+
+    XCTAssertEqualObjects(self.provider.cancelledPlayers, @[player]);
+    XCTAssertEqual([self.pool checkOutPlayerForMediaID:@"1" URL:[self URLForMediaID:@"1"]], player);
+}
+
+- (void)testRemoveAllIdlePlayers_cancelsPrerollsAndEmptiesPool
+{
+    [self.pool prerollPlayerForMediaID:@"1" URL:[self URLForMediaID:@"1"]];
+    [self.pool prerollPlayerForMediaID:@"2" URL:[self URLForMediaID:@"2"]];
+
+    [self.pool removeAllIdlePlayers];
+
+    XCTAssertEqual(self.pool.idlePlayerCount, 0);
+    XCTAssertEqual(self.provider.prerollingPlayers.count, 0);
+    XCTAssertEqual(self.provider.cancelledPlayers.count, 1);
+}
+
+@end
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+#import "TWTRSEAutoCompletionIndex.h"
+#import "TWTRSETwitterUser.h"
+#import "TWTRTwitterText.h"
+
+static const NSTimeInterval TWTRSEAutoCompletionIndexTestsHalfLife = 24 * 60 * 60;
+
+@interface TWTRSEAutoCompletionIndexTestsUser : NSObject <TWTRSETwitterUser>
+
+@property (nonatomic) long long userID;
+@property (nonatomic, copy) NSString *username;
+@property (nonatomic, copy) NSString *fullName;
+@property (nonatomic, copy) NSURL *avatarURL;
+@property (nonatomic) BOOL verified;
+
+@end
+
+@implementation TWTRSEAutoCompletionIndexTestsUser
+
++ (instancetype)userWithID:(long long)userID username:(NSString *)username
+{
+    TWTRSEAutoCompletionIndexTestsUser *user = [[self alloc] init];
+    user.userID = userID;
+    user.username = username;
+    return user;
+}
+
+@end
+
+@interface TWTRSEAutoCompletionIndexTests : XCTestCase
+
+@property (nonatomic) TWTRSEAutoCompletionIndex *index;
+@property (nonatomic) NSDate *now;
+@property (nonatomic) NSURL *fileURL;
+
+@end
+
+@implementation TWTRSEAutoCompletionIndexTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.index = [[TWTRSEAutoCompletionIndex alloc] initWithHalfLife:TWTRSEAutoCompletionIndexTestsHalfLife capacity:4];
+    self.now = [NSDate dateWithTimeIntervalSinceReferenceDate:500000000];
+    self.fileURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:@"TWTRSEAutoCompletionIndexTests.plist"];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtURL:self.fileURL error:nil];
+
+    [super tearDown];
+}
+
+- (NSDate *)daysAgo:(NSUInteger)days
+{
+    return [self.now dateByAddingTimeInterval:-(NSTimeInterval)days * TWTRSEAutoCompletionIndexTestsHalfLife];
+}
+
+- (void)testHashtags_matchPrefixCaseInsensitively
+{
+    [self.index recordUseOfHashtag:@"#TwitterKit" date:self.now];
+    [self.index recordUseOfHashtag:@"#twitter" date:self.now];
+    [self.index recordUseOfHashtag:@"#swift" date:self.now];
+
+    NSArray<NSString *> *results = [self.index hashtagsMatchingPrefix:@"#TWITT" limit:10];
+
+    XCTAssertEqualObjects([NSSet setWithArray:results], ([NSSet setWithArray:@[@"#TwitterKit", @"#twitter"]]));
+    XCTAssertEqualObjects([self.index hashtagsMatchingPrefix:@"#sw" limit:10], @[@"#swift"]);
+    XCTAssertEqualObjects([self.index hashtagsMatchingPrefix:@"#x" limit:10], @[]);
+}
+
+- (void)testHashtags_rankRecentUsesFirst
+{
+    [self.index recordUseOfHashtag:@"#old" date:[self daysAgo:10]];
+    [self.index recordUseOfHashtag:@"#new" date:self.now];
+
+    XCTAssertEqualObjects([self.index hashtagsMatchingPrefix:@"#" limit:10], (@[@"#new", @"#old"]));
+}
+
+- (void)testHashtags_rankFrequentUsesFirst
+{
+    [self.index recordUseOfHashtag:@"#once" date:self.now];
+    [self.index recordUseOfHashtag:@"#often" date:[self daysAgo:1]];
+    [self.index recordUseOfHashtag:@"#often" date:[self daysAgo:1]];
+    [self.index recordUseOfHashtag:@"#often" date:[self daysAgo:1]];
+
+    XCTAssertEqualObjects([self.index hashtagsMatchingPrefix:@"#o" limit:10], (@[@"#often", @"#once"]));
+}
+
+- (void)testSeenHashtags_rankAfterUsedOnesInRemoteOrder
+{
+    [self.index addHashtags:@[@"#first", @"#second"]];
+    [self.index recordUseOfHashtag:@"#used" date:[self daysAgo:30]];
+
+    XCTAssertEqualObjects([self.index hashtagsMatchingPrefix:@"" limit:10], (@[@"#used", @"#first", @"#second"]));
+    XCTAssertEqualObjects([self.index hashtagsMatchingPrefix:@"" limit:2], (@[@"#used", @"#first"]));
+}
+
+- (void)testCapacity_evictsLowestRankedEntry
+{
+    [self.index recordUseOfHashtag:@"#a" date:self.now];
+    [self.index recordUseOfHashtag:@"#b" date:self.now];
+    [self.index recordUseOfHashtag:@"#c" date:self.now];
+    [self.index addHashtags:@[@"#seen"]];
+    [self.index recordUseOfHashtag:@"#d" date:self.now];
+
+    NSArray<NSString *> *results = [self.index hashtagsMatchingPrefix:@"" limit:10];
+
+    XCTAssertEqual(results.count, 4);
+    XCTAssertFalse([results containsObject:@"#seen"]);
+}
+
+- (void)testUsers_matchUsernamePrefixAndKeepLatestUser
+{
+    [self.index addUsers:@[[TWTRSEAutoCompletionIndexTestsUser userWithID:1 username:@"jack"], [TWTRSEAutoCompletionIndexTestsUser userWithID:2 username:@"TwitterAPI"]]];
+    TWTRSEAutoCompletionIndexTestsUser *updatedUser = [TWTRSEAutoCompletionIndexTestsUser userWithID:2 username:@"TwitterAPI"];
+    [self.index recordUseOfUser:updatedUser date:self.now];
+
+    NSArray<id<TWTRSETwitterUser>> *results = [self.index usersMatchingPrefix:@"twitter" limit:10];
+
+    XCTAssertEqual(results.count, 1);
+    XCTAssertEqual(results.firstObject, updatedUser);
+}
+
+- (void)testRecordUseOfEntitiesInText_recordsHashtagsAndKnownUsers
+{
+    [self.index addUsers:@[[TWTRSEAutoCompletionIndexTestsUser userWithID:1 username:@"jack"], [TWTRSEAutoCompletionIndexTestsUser userWithID:2 username:@"jane"]]];
+
+    [self.index recordUseOfEntitiesInText:@"Hello @Jane and @unknown #TwitterKit" twitterText:[TWTRTwitterText class] date:self.now];
+
+    XCTAssertEqualObjects([self.index hashtagsMatchingPrefix:@"#twitterkit" limit:10], @[@"#TwitterKit"]);
+    XCTAssertEqualObjects([self.index usersMatchingPrefix:@"ja" limit:10].firstObject.username, @"jane");
+    XCTAssertEqual([self.index usersMatchingPrefix:@"unknown" limit:10].count, 0);
+}
+
+#pragma mark - Persistence
+
+- (void)testFileURL_restoresRankingInNewIndex
+{
+    TWTRSEAutoCompletionIndex *index = [[TWTRSEAutoCompletionIndex alloc] initWithHalfLife:TWTRSEAutoCompletionIndexTestsHalfLife capacity:4 fileURL:self.fileURL];
+    [index addHashtags:@[@"#seen"]];
+    [index recordUseOfHashtag:@"#old" date:[self daysAgo:10]];
+    [index recordUseOfHashtag:@"#new" date:self.now];
+    [index flush];
+
+    TWTRSEAutoCompletionIndex *restoredIndex = [[TWTRSEAutoCompletionIndex alloc] initWithHalfLife:TWTRSEAutoCompletionIndexTestsHalfLife capacity:4 fileURL:self.fileURL];
+
+    XCTAssertEqualObjects([restoredIndex hashtagsMatchingPrefix:@"#" limit:10], (@[@"#new", @"#old", @"#seen"]));
+}
+
+- (void)testFileURL_restoresUsers
+{
+    TWTRSEAutoCompletionIndex *index = [[TWTRSEAutoCompletionIndex alloc] initWithHalfLife:TWTRSEAutoCompletionIndexTestsHalfLife capacity:4 fileURL:self.fileURL];
+    TWTRSEAutoCompletionIndexTestsUser *user = [TWTRSEAutoCompletionIndexTestsUser userWithID:2 username:@"TwitterAPI"];
+    user.fullName = @"Twitter API";
+    user.avatarURL = [NSURL URLWithString:@"https://pbs.twimg.com/profile_images/2.png"];
+    user.verified = YES;
+    [index recordUseOfUser:user date:self.now];
+    [index flush];
+
+    TWTRSEAutoCompletionIndex *restoredIndex = [[TWTRSEAutoCompletionIndex alloc] initWithHalfLife:TWTRSEAutoCompletionIndexTestsHalfLife capacity:4 fileURL:self.fileURL];
+    id<TWTRSETwitterUser> restoredUser = [restoredIndex usersMatchingPrefix:@"twitter" limit:10].firstObject;
+
+    XCTAssertEqual(restoredUser.userID, 2);
+    XCTAssertEqualObjects(restoredUser.username, @"TwitterAPI");
+    XCTAssertEqualObjects(restoredUser.fullName, @"Twitter API");
+    XCTAssertEqualObjects(restoredUser.avatarURL, user.avatarURL);
+    XCTAssertTrue(restoredUser.verified);
+}
+
+- (void)testFileURL_coalescesUsesIntoOneWrite
+{
+    TWTRSEAutoCompletionIndex *index = [[TWTRSEAutoCompletionIndex alloc] initWithHalfLife:TWTRSEAutoCompletionIndexTestsHalfLife capacity:4 fileURL:self.fileURL];
+    [index recordUseOfHashtag:@"#first" date:self.now];
+    [index recordUseOfHashtag:@"#second" date:self.now];
+
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:self.fileURL.path]);
+
+    [index flush];
+    TWTRSEAutoCompletionIndex *restoredIndex = [[TWTRSEAutoCompletionIndex alloc] initWithHalfLife:TWTRSEAutoCompletionIndexTestsHalfLife capacity:4 fileURL:self.fileURL];
+
+    XCTAssertEqualObjects([restoredIndex hashtagsMatchingPrefix:@"#" limit:10], (@[@"#second", @"#first"]));
+}
+
+- (void)testFileURL_unreadableFileStartsEmpty
+{
+    [[@"not a property list" dataUsingEncoding:NSUTF8StringEncoding] writeToURL:self.fileURL atomically:YES];
+
+    TWTRSEAutoCompletionIndex *index = [[TWTRSEAutoCompletionIndex alloc] initWithHalfLife:TWTRSEAutoCompletionIndexTestsHalfLife capacity:4 fileURL:self.fileURL];
+
+    XCTAssertEqualObjects([index hashtagsMatchingPrefix:@"" limit:10], @[]);
+}
+
+@end
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+#import "TWTRSEEntityTokenIndex.h"
+#import "TWTRTwitterText.h"
+
+@interface TWTRSEEntityTokenIndexTests : XCTestCase
+
+@property (nonatomic) TWTRSEEntityTokenIndex *index;
+
+@end
+
+@implementation TWTRSEEntityTokenIndexTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.index = [[TWTRSEEntityTokenIndex alloc] initWithTwitterText:[TWTRTwitterText class]];
+}
+
+- (NSRange)fullEntityRangeIntersectingRange:(NSRange)range inText:(NSString *)text
+{
+    for (TWTRTwitterTextEntity *entity in [TWTRTwitterText entitiesInText:text]) {
+        if (0 != NSIntersectionRange(entity.range, range).length) {
+            return entity.range;
+        }
+    }
+
+    return NSMakeRange(NSNotFound, 0);
+}
+
+- (void)assertIndexMatchesFullExtractionForText:(NSString *)text
+{
+    for (NSUInteger location = 0; location < text.length; location++) {
+        NSRange range = NSMakeRange(location, 1);
+        NSRange expected = [self fullEntityRangeIntersectingRange:range inText:text];
+        NSRange actual = [self.index entityRangeIntersectingRange:range inText:text];
+        XCTAssertTrue(NSEqualRanges(actual, expected), @"%@ at %lu: %@ != %@", text, (unsigned long)location, NSStringFromRange(actual), NSStringFromRange(expected));
+    }
+}
+
+- (void)testEmptyRange_returnsNotFound
+{
+    NSRange range = [self.index entityRangeIntersectingRange:NSMakeRange(1, 0) inText:@"#hashtag"];
+
+    XCTAssertEqual(range.location, NSNotFound);
+}
+
+- (void)testTextWithoutEntities_returnsNotFound
+{
+    NSRange range = [self.index entityRangeIntersectingRange:NSMakeRange(0, 5) inText:@"hello world"];
+
+    XCTAssertEqual(range.location, NSNotFound);
+}
+
+- (void)testEntities_areFoundAfterEditsBeforeThem
+{
+    NSRange range = [self.index entityRangeIntersectingRange:NSMakeRange(7, 2) inText:@"hello @jack and #swift"];
+    XCTAssertTrue(NSEqualRanges(range, NSMakeRange(6, 5)));
+
+    range = [self.index entityRangeIntersectingRange:NSMakeRange(10, 2) inText:@"hello you @jack and #swift"];
+    XCTAssertTrue(NSEqualRanges(range, NSMakeRange(10, 5)));
+
+    range = [self.index entityRangeIntersectingRange:NSMakeRange(21, 1) inText:@"hello you @jack and #swift"];
+    XCTAssertTrue(NSEqualRanges(range, NSMakeRange(20, 6)));
+}
+
+- (void)testDeletingWhitespaceBetweenTokens_rejoinsURL
+{
+    [self assertIndexMatchesFullExtractionForText:@"see https://t witter.com/jack now"];
+    [self assertIndexMatchesFullExtractionForText:@"see https://twitter.com/jack now"];
+    [self assertIndexMatchesFullExtractionForText:@"see https://twitter.com /jack now"];
+}
+
+- (void)testTyping_matchesFullExtraction
+{
+    NSString *text = @"Hey @twitterapi, #TwitterKit is at https://dev.twitter.com $TWTR 🐦\n@jack/list";
+    NSMutableString *typed = [NSMutableString string];
+
+    [text enumerateSubstringsInRange:NSMakeRange(0, text.length) options:NSStringEnumerationByComposedCharacterSequences usingBlock:^(NSString *substring, NSRange substringRange, NSRange enclosingRange, BOOL *stop) {
+        [typed appendString:substring];
+        [self assertIndexMatchesFullExtractionForText:typed];
+    }];
+}
+
+- (void)testRandomEdits_matchFullExtraction
+{
+    NSArray<NSString *> *insertions = @[@"a", @"b ", @" ", @"\n", @"@", @"#", @"$", @"_", @"jack", @"https://", @"twitter.com", @"/path", @"🐦", @"é"];
+    NSMutableString *text = [NSMutableString string];
+    srand48(42);
+
+    for (NSUInteger i = 0; i < 500; i++) {
+        NSUInteger location = (NSUInteger)(drand48() * (text.length + 1));
+        NSUInteger length = MIN((NSUInteger)(drand48() * 4), text.length - location);
+        NSRange range = [text rangeOfComposedCharacterSequencesForRange:NSMakeRange(location, length)];
+        NSString *insertion = drand48() < 0.7 ? insertions[(NSUInteger)(drand48() * insertions.count)] : @"";
+
+        [text replaceCharactersInRange:range withString:insertion];
+        [self assertIndexMatchesFullExtractionForText:[text copy]];
+    }
+}
+
+@end
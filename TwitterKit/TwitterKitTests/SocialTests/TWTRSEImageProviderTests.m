@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <UIKit/UIKit.h>
+#import <XCTest/XCTest.h>
+#import "TWTRSEImageProvider.h"
+
+@interface TWTRSEImageProviderTests : XCTestCase
+
+@property (nonatomic) NSURL *sourceURL;
+@property (nonatomic) NSItemProvider *itemProvider;
+
+@end
+
+@implementation TWTRSEImageProviderTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat defaultFormat];
+    format.scale = 1;
+    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:CGSizeMake(2400, 1600) format:format];
+    NSData *data = [renderer JPEGDataWithCompressionQuality:0.8
+                                                    actions:^(UIGraphicsImageRendererContext *context) {
+                                                        [[UIColor orangeColor] setFill];
+                                                        [context fillRect:CGRectMake(0, 0, 2400, 1600)];
+                                                    }];
+
+    NSString *fileName = [[[NSUUID UUID] UUIDString] stringByAppendingPathExtension:@"jpg"];
+    self.sourceURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:fileName]];
+    [data writeToURL:self.sourceURL atomically:YES];
+
+    self.itemProvider = [[NSItemProvider alloc] initWithContentsOfURL:self.sourceURL];
+}
+
+- (void)tearDown
+{
+    [TWTRSEImageProvider reset];
+    [[NSFileManager defaultManager] removeItemAtURL:self.sourceURL error:nil];
+
+    [super tearDown];
+}
+
+- (void)testImageProvider_isReusedForTheSameItemProvider
+{
+    TWTRSEImageProvider *imageProvider = [TWTRSEImageProvider imageProviderWithItemProvider:self.itemProvider];
+
+    XCTAssertEqual(imageProvider, [TWTRSEImageProvider imageProviderWithItemProvider:self.itemProvider]);
+    XCTAssertEqual(imageProvider, [TWTRSEImageProvider existingImageProviderForItemProvider:self.itemProvider]);
+    XCTAssertNil([TWTRSEImageProvider existingImageProviderForItemProvider:[[NSItemProvider alloc] init]]);
+}
+
+- (void)testLoad_downsamplesFileToPreferredSize
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"image loaded"];
+    CGSize preferredSize = CGSizeMake(100, 100);
+    CGFloat maxPixelSize = 100 * [UIScreen mainScreen].scale;
+
+    TWTRSEImageProvider *imageProvider = [TWTRSEImageProvider imageProviderWithItemProvider:self.itemProvider];
+    [imageProvider loadWithOptions:@{NSItemProviderPreferredImageSizeKey: [NSValue valueWithCGSize:preferredSize]}
+        success:^(UIImage *image) {
+            XCTAssertLessThanOrEqual(MAX(CGImageGetWidth(image.CGImage), CGImageGetHeight(image.CGImage)), maxPixelSize);
+            [expectation fulfill];
+        }
+        failure:^(NSError *error) {
+            XCTFail(@"%@", error);
+            [expectation fulfill];
+        }];
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+- (UIImage *)loadImageWithProvider:(TWTRSEImageProvider *)imageProvider preferredSize:(CGSize)preferredSize
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"image loaded"];
+    __block UIImage *loadedImage;
+
+    [imageProvider loadWithOptions:@{NSItemProviderPreferredImageSizeKey: [NSValue valueWithCGSize:preferredSize]}
+        success:^(UIImage *image) {
+            loadedImage = image;
+            [expectation fulfill];
+        }
+        failure:^(NSError *error) {
+            XCTFail(@"%@", error);
+            [expectation fulfill];
+        }];
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    return loadedImage;
+}
+
+- (void)testLoad_reusesCachedImageForSmallerSize
+{
+    TWTRSEImageProvider *imageProvider = [TWTRSEImageProvider imageProviderWithItemProvider:self.itemProvider];
+    UIImage *largeImage = [self loadImageWithProvider:imageProvider preferredSize:CGSizeMake(200, 200)];
+
+    XCTAssertEqual([self loadImageWithProvider:imageProvider preferredSize:CGSizeMake(100, 100)], largeImage);
+}
+
+- (void)testLoad_decodesAgainForLargerSize
+{
+    TWTRSEImageProvider *imageProvider = [TWTRSEImageProvider imageProviderWithItemProvider:self.itemProvider];
+    UIImage *smallImage = [self loadImageWithProvider:imageProvider preferredSize:CGSizeMake(100, 100)];
+    UIImage *largeImage = [self loadImageWithProvider:imageProvider preferredSize:CGSizeMake(200, 200)];
+
+    XCTAssertGreaterThan(CGImageGetWidth(largeImage.CGImage), CGImageGetWidth(smallImage.CGImage));
+}
+
+@end
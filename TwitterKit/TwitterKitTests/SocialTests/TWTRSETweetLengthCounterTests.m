@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2017 Twitter, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+#import "TWTRSETweetLengthCounter.h"
+#import "TWTRTwitterText.h"
+
+@interface TWTRSETweetLengthCounterTests : XCTestCase
+
+@property (nonatomic) TWTRSETweetLengthCounter *counter;
+
+@end
+
+@implementation TWTRSETweetLengthCounterTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.counter = [[TWTRSETweetLengthCounter alloc] initWithTwitterText:[TWTRTwitterText class]];
+}
+
+- (void)assertCounterMatchesFullCountForText:(NSString *)text
+{
+    XCTAssertEqual([self.counter remainingCharacterCountForText:text], [TWTRTwitterText remainingCharacterCount:text], @"%@", text);
+}
+
+- (void)testEmptyText_returnsCharacterLimit
+{
+    XCTAssertEqual([self.counter remainingCharacterCountForText:@""], [TWTRTwitterText remainingCharacterCount:@""]);
+}
+
+- (void)testTyping_matchesFullCount
+{
+    NSString *text = @"Check out https://dev.twitter.com/twitterkit and twitter.com 🐦 café\nso good";
+    NSMutableString *typed = [NSMutableString string];
+
+    [text enumerateSubstringsInRange:NSMakeRange(0, text.length) options:NSStringEnumerationByComposedCharacterSequences usingBlock:^(NSString *substring, NSRange substringRange, NSRange enclosingRange, BOOL *stop) {
+        [typed appendString:substring];
+        [self assertCounterMatchesFullCountForText:typed];
+    }];
+}
+
+- (void)testDeletingWhitespaceBetweenTokens_rejoinsURL
+{
+    [self assertCounterMatchesFullCountForText:@"see https://t witter.com/jack now"];
+    [self assertCounterMatchesFullCountForText:@"see https://twitter.com/jack now"];
+    [self assertCounterMatchesFullCountForText:@"see https://twitter.com /jack now"];
+}
+
+- (void)testEditsInTheMiddle_matchFullCount
+{
+    [self assertCounterMatchesFullCountForText:@"one two three four five"];
+    [self assertCounterMatchesFullCountForText:@"one two http://example.com four five"];
+    [self assertCounterMatchesFullCountForText:@"one  two http://example.com four five"];
+    [self assertCounterMatchesFullCountForText:@"one four five"];
+    [self assertCounterMatchesFullCountForText:@"  one four five 🐦"];
+    [self assertCounterMatchesFullCountForText:@"five"];
+    [self assertCounterMatchesFullCountForText:@""];
+}
+
+- (void)testRandomEdits_matchFullCount
+{
+    NSArray<NSString *> *insertions = @[@"a", @"b ", @" ", @"\n", @"https://", @"twitter.com", @"/path", @"🐦", @"é"];
+    NSMutableString *text = [NSMutableString string];
+    srand48(42);
+
+    for (NSUInteger i = 0; i < 500; i++) {
+        NSUInteger location = (NSUInteger)(drand48() * (text.length + 1));
+        NSUInteger length = MIN((NSUInteger)(drand48() * 4), text.length - location);
+        NSRange range = [text rangeOfComposedCharacterSequencesForRange:NSMakeRange(location, length)];
+        NSString *insertion = drand48() < 0.7 ? insertions[(NSUInteger)(drand48() * insertions.count)] : @"";
+
+        [text replaceCharactersInRange:range withString:insertion];
+        [self assertCounterMatchesFullCountForText:[text copy]];
+    }
+}
+
+@end
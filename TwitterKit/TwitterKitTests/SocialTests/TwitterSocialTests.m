@@ -20,6 +20,7 @@
 #import <TwitterCore/TWTRAuthenticationConstants.h>
 #import <TwitterCore/TWTRAuthenticator.h>
 #import <TwitterCore/TWTRGuestSession.h>
+#import <TwitterCore/TWTRMemoryPressureCoordinator.h>
 #import <TwitterCore/TWTRSession.h>
 #import <TwitterCore/TWTRSessionStore.h>
 #import <TwitterCore/TWTRSessionStore_Private.h>
@@ -40,6 +41,7 @@
 
 @interface TWTRTwitter ()
 - (void)performWebBasedLogin:(UIViewController *)viewController completion:(TWTRLogInCompletion)completion;
+- (void)runBackgroundStartupPhases;
 @end
 
 @interface TwitterTests : TWTRTestCase
@@ -103,6 +105,64 @@
     XCTAssertNotEqual(firstTwitter, secondTwitter, @"sharedInstance returned pointer to old memory address after reseting");
 }
 
+- (void)testStart_reportsStartupPhaseDurations
+{
+    NSPredicate *finished = [NSPredicate predicateWithBlock:^BOOL(TWTRTwitter *twitter, NSDictionary *bindings) {
+        return twitter.startupPhaseDurations[TWTRStartupPhaseSessionValidation] != nil;
+    }];
+    [self expectationForPredicate:finished evaluatedWithObject:self.twitterKit handler:nil];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    NSDictionary *durations = self.twitterKit.startupPhaseDurations;
+    NSArray *phases = @[TWTRStartupPhaseConfiguration, TWTRStartupPhaseResources, TWTRStartupPhaseImageCache, TWTRStartupPhaseSessionLoading, TWTRStartupPhaseSessionMigration, TWTRStartupPhaseSessionValidation];
+    for (NSString *phase in phases) {
+        XCTAssertNotNil(durations[phase], @"Missing phase %@", phase);
+    }
+    XCTAssertNotNil(self.twitterKit.imageLoader);
+}
+
+- (void)testAccessors_availableBeforeStartupFinishes
+{
+    XCTAssertNotNil(self.twitterKit.sessionStore);
+
+    TWTRImageLoader *imageLoader = self.twitterKit.imageLoader;
+    XCTAssertNotNil(imageLoader);
+    XCTAssertEqual(self.twitterKit.imageLoader, imageLoader);
+}
+
+- (void)testSaveSession_postsLoginNotificationBeforeStartupFinishes
+{
+    [TWTRTwitter resetSharedInstance];
+    TWTRTwitter *twitter = [[TWTRTwitter alloc] init];
+    id mockTwitter = OCMPartialMock(twitter);
+    OCMStub([mockTwitter runBackgroundStartupPhases]);  // Keeps every background phase pending
+    [twitter startWithConsumerKey:@"k" consumerSecret:@"s"];
+
+    [self expectationForNotification:TWTRUserDidLogInNotification
+                              object:nil
+                             handler:^BOOL(NSNotification *notification) {
+                                 return [notification.userInfo[TWTRLoggedInUserIDKey] isEqualToString:self.session.userID];
+                             }];
+    [twitter.sessionStore saveSession:self.session withVerification:NO completion:^(id<TWTRAuthSession> session, NSError *error){
+    }];
+    [self waitForExpectationsWithTimeout:1 handler:nil];
+
+    XCTAssertNil(twitter.startupPhaseDurations[TWTRStartupPhaseSessionMigration]);
+    [twitter.sessionStore logOutUserID:self.session.userID];
+    [[TWTRAPIClient networkingPipeline] resume];
+    [mockTwitter stopMocking];
+}
+
+- (void)testCacheMemoryBudget_forwardsToSharedCoordinator
+{
+    NSUInteger originalBudget = self.twitterKit.cacheMemoryBudget;
+    self.twitterKit.cacheMemoryBudget = 1024;
+
+    XCTAssertEqual([TWTRMemoryPressureCoordinator sharedCoordinator].memoryBudget, 1024);
+    XCTAssertEqualObjects(self.twitterKit.cacheMemoryUsage, [[TWTRMemoryPressureCoordinator sharedCoordinator] memoryUsage]);
+    self.twitterKit.cacheMemoryBudget = originalBudget;
+}
+
 - (void)testApplicationInstallID
 {
     NSString *appID = [TWTRAppInstallationUUID appInstallationUUID];
@@ -214,6 +274,30 @@
     XCTAssertEqualObjects(loggedOutID, session.userID);
 }
 
+- (void)testNotificationPostedOnMainThreadWhenUserLoggedOutInBackground
+{
+    NSString *userID = [[NSUUID UUID] UUIDString];
+    TWTRSession *session = [[TWTRSession alloc] initWithAuthToken:@"auth_toke" authTokenSecret:@"secret" userName:@"user" userID:userID];
+    [self.twitterKit.sessionStore saveSession:session
+                             withVerification:NO
+                                   completion:^(id a, id b){
+                                   }];
+
+    XCTestExpectation *expectation = [self expectationForNotification:TWTRUserDidLogOutNotification
+                                                               object:nil
+                                                              handler:^BOOL(NSNotification *note) {
+                                                                  XCTAssertTrue([NSThread isMainThread]);
+                                                                  return [note.userInfo[TWTRLoggedOutUserIDKey] isEqualToString:userID];
+                                                              }];
+
+    TWTRSessionStore *sessionStore = self.twitterKit.sessionStore;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        [sessionStore logOutUserID:userID];
+    });
+
+    [self waitForExpectations:@[expectation] timeout:5];
+}
+
 #pragma mark - Mobile SSO
 
 - (void)testMobileSSO_completesOnSuccess
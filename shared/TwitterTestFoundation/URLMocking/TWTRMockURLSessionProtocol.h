@@ -17,6 +17,11 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, copy, readonly, nullable) NSString *responseString;
 
+/**
+ The response body or nil if an error should be returned.
+ */
+@property (nonatomic, copy, readonly, nullable) NSData *responseData;
+
 /**
  The status code for this response.
  */
@@ -36,13 +41,23 @@ NS_ASSUME_NONNULL_BEGIN
 + (instancetype)responseWithString:(NSString *)string statusCode:(NSInteger)statusCode;
 + (instancetype)responseWithString:(NSString *)string statusCode:(NSInteger)statusCode headerFields:(NSDictionary *)headerFields;
 
+/**
+ Returns a response replaying a recorded payload, e.g. a fixture file, byte for byte.
+ */
++ (instancetype)responseWithData:(NSData *)data;
++ (instancetype)responseWithData:(NSData *)data statusCode:(NSInteger)statusCode headerFields:(NSDictionary *)headerFields;
+
 @end
 
 /**
  The TWTRMockURLSessionProtocl is a FIFO stack based protocol. It will pop
  a response off the stack to return. If the stack is empty the protocol will
- act as if it cannot reach the server. This class is not thread safe and can
- only handle a single request at a time.
+ act as if it cannot reach the server. Responses may be pushed from any thread
+ but are popped in the order the requests start, so concurrent requests should
+ expect identical responses.
+
+ By default responses are delivered as soon as the request starts. Set a latency
+ and bandwidth to simulate a real network, e.g. when benchmarking load times.
  */
 @interface TWTRMockURLSessionProtocol : NSURLProtocol
 
@@ -59,6 +74,24 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (BOOL)isEmpty;
 
+/**
+ Delay before the response headers of every request are delivered. Defaults to 0.
+ */
++ (void)setLatency:(NSTimeInterval)latency;
++ (NSTimeInterval)latency;
+
+/**
+ Bytes per second at which response bodies are delivered, in chunks. Defaults to 0,
+ which delivers the whole body at once.
+ */
++ (void)setBandwidth:(NSUInteger)bytesPerSecond;
++ (NSUInteger)bandwidth;
+
+/**
+ Restores immediate delivery.
+ */
++ (void)resetNetworkConditions;
+
 @end
 
 NS_ASSUME_NONNULL_END
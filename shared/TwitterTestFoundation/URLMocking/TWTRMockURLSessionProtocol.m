@@ -9,13 +9,21 @@
 #import <TwitterCore/TWTRAssertionMacros.h>
 #import "TWTRMockURLSessionProtocol.h"
 
+/**
+ How often a chunk of the body is delivered when bandwidth is limited.
+ */
+static const NSTimeInterval TWTRMockURLSessionProtocolChunkInterval = 0.05;
+
+static NSTimeInterval TWTRMockURLSessionProtocolLatency = 0;
+static NSUInteger TWTRMockURLSessionProtocolBandwidth = 0;
+
 @implementation TWTRMockURLResponse
 
-- (instancetype)initWithResponseString:(NSString *)string code:(NSInteger)statusCode error:(NSError *)error headerFields:(NSDictionary *)headerFields
+- (instancetype)initWithResponseData:(NSData *)data code:(NSInteger)statusCode error:(NSError *)error headerFields:(NSDictionary *)headerFields
 {
     self = [super init];
     if (self) {
-        _responseString = [string copy];
+        _responseData = [data copy];
         _statusCode = statusCode;
         _error = error;
         _headerFields = [headerFields copy];
@@ -32,7 +40,7 @@
 {
     TWTRParameterAssertOrReturnValue(error, nil);
     TWTRParameterAssertOrReturnValue(headerFields, nil);
-    return [[self alloc] initWithResponseString:nil code:0 error:error headerFields:headerFields];
+    return [[self alloc] initWithResponseData:nil code:0 error:error headerFields:headerFields];
 }
 
 + (instancetype)responseWithString:(NSString *)string
@@ -49,16 +57,42 @@
 {
     TWTRParameterAssertOrReturnValue(string, nil);
     TWTRParameterAssertOrReturnValue(headerFields, nil);
-    return [[self alloc] initWithResponseString:string code:statusCode error:nil headerFields:headerFields];
+    return [[self alloc] initWithResponseData:[string dataUsingEncoding:NSUTF8StringEncoding] code:statusCode error:nil headerFields:headerFields];
+}
+
++ (instancetype)responseWithData:(NSData *)data
+{
+    return [self responseWithData:data statusCode:200 headerFields:@{}];
+}
+
++ (instancetype)responseWithData:(NSData *)data statusCode:(NSInteger)statusCode headerFields:(NSDictionary *)headerFields
+{
+    TWTRParameterAssertOrReturnValue(data, nil);
+    TWTRParameterAssertOrReturnValue(headerFields, nil);
+    return [[self alloc] initWithResponseData:data code:statusCode error:nil headerFields:headerFields];
+}
+
+- (NSString *)responseString
+{
+    return _responseData ? [[NSString alloc] initWithData:_responseData encoding:NSUTF8StringEncoding] : nil;
 }
 
 @end
 
+@interface TWTRMockURLSessionProtocol ()
+
+@property (atomic, getter=isStopped) BOOL stopped;
+
+@end
+
 @implementation TWTRMockURLSessionProtocol
 
 + (BOOL)isEmpty
 {
-    return [[self responses] count] == 0;
+    @synchronized(self)
+    {
+        return [[self responses] count] == 0;
+    }
 }
 
 + (NSMutableArray *)responses
@@ -74,20 +108,76 @@
 + (void)pushResponse:(TWTRMockURLResponse *)response
 {
     TWTRParameterAssertOrReturn(response);
-    [[self responses] addObject:response];
+    @synchronized(self)
+    {
+        [[self responses] addObject:response];
+    }
 }
 
 + (nullable TWTRMockURLResponse *)popResponse;
 {
-    NSMutableArray *responses = [self responses];
-    if (responses.count == 0) {
-        return nil;
+    @synchronized(self)
+    {
+        NSMutableArray *responses = [self responses];
+        if (responses.count == 0) {
+            return nil;
+        }
+
+        TWTRMockURLResponse *response = responses[0];
+        [responses removeObjectAtIndex:0];
+
+        return response;
     }
-    
-    TWTRMockURLResponse *response = responses[0];
-    [responses removeObjectAtIndex:0];
+}
+
+#pragma mark - Network Conditions
+
++ (void)setLatency:(NSTimeInterval)latency
+{
+    @synchronized(self)
+    {
+        TWTRMockURLSessionProtocolLatency = MAX(latency, 0);
+    }
+}
+
++ (NSTimeInterval)latency
+{
+    @synchronized(self)
+    {
+        return TWTRMockURLSessionProtocolLatency;
+    }
+}
+
++ (void)setBandwidth:(NSUInteger)bytesPerSecond
+{
+    @synchronized(self)
+    {
+        TWTRMockURLSessionProtocolBandwidth = bytesPerSecond;
+    }
+}
+
++ (NSUInteger)bandwidth
+{
+    @synchronized(self)
+    {
+        return TWTRMockURLSessionProtocolBandwidth;
+    }
+}
+
++ (void)resetNetworkConditions
+{
+    [self setLatency:0];
+    [self setBandwidth:0];
+}
 
-    return response;
++ (dispatch_queue_t)deliveryQueue
+{
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.twittertestfoundation.mock-url-protocol.delivery", DISPATCH_QUEUE_SERIAL);
+    });
+    return queue;
 }
 
 #pragma mark - Protocol Overrides
@@ -122,20 +212,79 @@
         failureError = response.error;
     }
     
-    if (failureError) {
-        [self.client URLProtocol:self didFailWithError:failureError];
-    } else {
-        NSURLResponse *HTTPResponse = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL statusCode:response.statusCode HTTPVersion:@"HTTP/1.1" headerFields:response.headerFields];
-        [self.client URLProtocol:self didReceiveResponse:HTTPResponse cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+    NSTimeInterval latency = [[self class] latency];
+    NSUInteger bandwidth = [[self class] bandwidth];
 
-        NSData *data = [response.responseString dataUsingEncoding:NSUTF8StringEncoding];
-        [self.client URLProtocol:self didLoadData:data];
-        [self.client URLProtocolDidFinishLoading:self];
+    if (latency == 0 && bandwidth == 0) {
+        [self deliverResponse:response error:failureError];
+        return;
     }
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(latency * NSEC_PER_SEC)), [[self class] deliveryQueue], ^{
+        if (failureError || bandwidth == 0) {
+            [self deliverResponse:response error:failureError];
+        } else {
+            [self deliverHeadersOfResponse:response];
+            [self deliverBodyOfResponse:response fromOffset:0 bandwidth:bandwidth];
+        }
+    });
 }
 
 - (void)stopLoading
 {
+    self.stopped = YES;
+}
+
+#pragma mark - Delivery
+
+- (void)deliverResponse:(TWTRMockURLResponse *)response error:(NSError *)error
+{
+    if (self.isStopped) {
+        return;
+    }
+
+    if (error) {
+        [self.client URLProtocol:self didFailWithError:error];
+    } else {
+        [self deliverHeadersOfResponse:response];
+        if (response.responseData) {
+            [self.client URLProtocol:self didLoadData:response.responseData];
+        }
+        [self.client URLProtocolDidFinishLoading:self];
+    }
+}
+
+- (void)deliverHeadersOfResponse:(TWTRMockURLResponse *)response
+{
+    NSURLResponse *HTTPResponse = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL statusCode:response.statusCode HTTPVersion:@"HTTP/1.1" headerFields:response.headerFields];
+    [self.client URLProtocol:self didReceiveResponse:HTTPResponse cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+}
+
+/**
+ Delivers the body one chunk per interval so that it takes as long as it would at the given bandwidth.
+ */
+- (void)deliverBodyOfResponse:(TWTRMockURLResponse *)response fromOffset:(NSUInteger)offset bandwidth:(NSUInteger)bandwidth
+{
+    if (self.isStopped) {
+        return;
+    }
+
+    NSData *data = response.responseData;
+    NSUInteger chunkLength = MAX((NSUInteger)(bandwidth * TWTRMockURLSessionProtocolChunkInterval), 1);
+    NSUInteger length = MIN(chunkLength, data.length - offset);
+
+    if (length > 0) {
+        [self.client URLProtocol:self didLoadData:[data subdataWithRange:NSMakeRange(offset, length)]];
+    }
+
+    if (offset + length >= data.length) {
+        [self.client URLProtocolDidFinishLoading:self];
+        return;
+    }
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(TWTRMockURLSessionProtocolChunkInterval * NSEC_PER_SEC)), [[self class] deliveryQueue], ^{
+        [self deliverBodyOfResponse:response fromOffset:offset + length bandwidth:bandwidth];
+    });
 }
 
 - (NSError *)errorForNoResponse:(NSURLRequest *)request
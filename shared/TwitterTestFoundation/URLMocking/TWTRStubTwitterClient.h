@@ -47,6 +47,11 @@
  *  All network requests we are sending
  */
 @property (nonatomic) NSMutableArray *sentRequestsArray;
+
+/*
+ *  The networking pipeline priority of each request in `sentRequestsArray`, as `TWTRNetworkingPipelinePriority` values.
+ */
+@property (nonatomic) NSMutableArray<NSNumber *> *sentRequestPriorities;
 /**
  *  A stub API client suitable for inspecting requests and
  *  stubbing responses.
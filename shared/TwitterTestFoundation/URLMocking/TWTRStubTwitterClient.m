@@ -20,6 +20,7 @@
     TWTRTestSessionStore *sessionStore = [[TWTRTestSessionStore alloc] initWithUserSessions:@[] guestSession:nil];
     TWTRStubTwitterClient *client = [[TWTRStubTwitterClient alloc] initWithSessionStore:sessionStore userID:@"1"];
     client.sentRequestsArray = [NSMutableArray new];
+    client.sentRequestPriorities = [NSMutableArray new];
     return client;
 }
 
@@ -40,6 +41,8 @@
 - (NSProgress *)sendTwitterRequest:(NSURLRequest *)request queue:(dispatch_queue_t)queue completion:(TWTRNetworkCompletion)completion
 {
     self.sentRequest = request;
+    [self.sentRequestsArray addObject:request];
+    [self.sentRequestPriorities addObject:@([[self class] currentRequestPriority])];
     if (self.responseError) {
         completion(nil, nil, self.responseError);
     } else {